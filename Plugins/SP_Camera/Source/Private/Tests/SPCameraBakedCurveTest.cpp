@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPBakedCurve.h"
+#include "Curves/CurveVector.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+// Checks the baked camera adjustment curve tables against the curves they were baked from
+
+namespace SPCameraBakedCurveTest
+{
+	/** A camera to pivot adjustment shaped like the ones the third person camera uses, in centimetres over 0..1 */
+	static UCurveVector* MakeAdjustmentCurve()
+	{
+		UCurveVector* const Curve = NewObject<UCurveVector>(GetTransientPackage());
+		auto AddKey = [](FRichCurve& Channel, float Time, float Value)
+		{
+			const FKeyHandle Key = Channel.AddKey(Time, Value);
+			Channel.SetKeyInterpMode(Key, RCIM_Cubic);
+		};
+
+		AddKey(Curve->FloatCurves[0], 0.f, -150.f);
+		AddKey(Curve->FloatCurves[0], 0.4f, 0.f);
+		AddKey(Curve->FloatCurves[0], 1.f, 120.f);
+
+		AddKey(Curve->FloatCurves[1], 0.f, 0.f);
+		AddKey(Curve->FloatCurves[1], 0.5f, 40.f);
+		AddKey(Curve->FloatCurves[1], 1.f, 0.f);
+
+		AddKey(Curve->FloatCurves[2], 0.f, 80.f);
+		AddKey(Curve->FloatCurves[2], 0.25f, 20.f);
+		AddKey(Curve->FloatCurves[2], 0.7f, -30.f);
+		AddKey(Curve->FloatCurves[2], 1.f, -35.f);
+
+		for (FRichCurve& Channel : Curve->FloatCurves)
+		{
+			Channel.AutoSetTangents();
+		}
+		return Curve;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraBakedCurveTest, "SP.Camera.BakedCurves",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraBakedCurveTest::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraBakedCurveTest;
+
+	UCurveVector* const Curve = MakeAdjustmentCurve();
+
+	FSPBakedCurveVector Baked;
+	TestFalse(TEXT("Nothing baked yet"), Baked.IsBakedFrom(Curve));
+	Baked.Bake(Curve);
+	TestTrue(TEXT("Baked from the curve"), Baked.IsBakedFrom(Curve));
+
+	// 64 samples put cubic keys a couple of millimetres off at most, not something anyone sees on a camera boom
+	double MaxError = 0.0;
+	constexpr int32 NumChecks = 10000;
+	for (int32 CheckIdx = 0; CheckIdx <= NumChecks; ++CheckIdx)
+	{
+		const float Time = float(CheckIdx) / NumChecks;
+		MaxError = FMath::Max(MaxError, (Baked.Eval(Time) - Curve->GetVectorValue(Time)).GetAbsMax());
+	}
+	AddInfo(FString::Printf(TEXT("Largest difference from the curve over 0..1: %f"), MaxError));
+	TestTrue(TEXT("Table follows the curve within half a centimetre"), MaxError < 0.5);
+
+	TestTrue(TEXT("Exact at the start"), Baked.Eval(0.f).Equals(Curve->GetVectorValue(0.f), 1.e-3));
+	TestTrue(TEXT("Exact at the end"), Baked.Eval(1.f).Equals(Curve->GetVectorValue(1.f), 1.e-3));
+	TestTrue(TEXT("Clamps before the range"), Baked.Eval(-5.f).Equals(Baked.Eval(0.f)));
+	TestTrue(TEXT("Clamps after the range"), Baked.Eval(5.f).Equals(Baked.Eval(1.f)));
+
+	// keys past 0..1 widen the range
+	Curve->FloatCurves[0].AddKey(2.f, 300.f);
+	TestTrue(TEXT("Still looks baked from the same curve until rebaked"), Baked.IsBakedFrom(Curve));
+	Baked.Bake(Curve);
+	TestEqual(TEXT("Range covers the new key"), Baked.GetEndTime(), 2.f, 1.e-4f);
+	TestEqual(TEXT("Range still covers 0"), Baked.GetStartTime(), 0.f);
+	TestEqual(TEXT("New key is sampled"), Baked.Eval(2.f).X, 300.0, 1.e-2);
+
+	TestFalse(TEXT("Another curve needs its own bake"), Baked.IsBakedFrom(MakeAdjustmentCurve()));
+	Baked.Reset();
+	TestFalse(TEXT("Reset forgets the curve"), Baked.IsBakedFrom(Curve));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraBakedCurveBenchmark, "SP.Camera.BakedCurvesBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraBakedCurveBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraBakedCurveTest;
+
+	constexpr int32 NumEvals = 1000000;
+
+	UCurveVector* const Curve = MakeAdjustmentCurve();
+	FSPBakedCurveVector Baked;
+	Baked.Bake(Curve);
+
+	// the sums keep the optimizer from dropping the loops
+	double StartTime = FPlatformTime::Seconds();
+	FVector CurveSum = FVector::ZeroVector;
+	for (int32 EvalIdx = 0; EvalIdx < NumEvals; ++EvalIdx)
+	{
+		CurveSum += Curve->GetVectorValue(float(EvalIdx % 1000) / 1000.f);
+	}
+	const double CurveMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	FVector BakedSum = FVector::ZeroVector;
+	for (int32 EvalIdx = 0; EvalIdx < NumEvals; ++EvalIdx)
+	{
+		BakedSum += Baked.Eval(float(EvalIdx % 1000) / 1000.f);
+	}
+	const double BakedMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(TEXT("%d evaluations: curve %.3f ms, baked table %.3f ms"), NumEvals, CurveMilliseconds, BakedMilliseconds));
+
+	TestTrue(TEXT("Table is faster than the curve"), BakedMilliseconds < CurveMilliseconds);
+	TestTrue(TEXT("Same average value as the curve"), (CurveSum / NumEvals).Equals(BakedSum / NumEvals, 0.1));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraTestWorld.h"
+#include "SPCameraCollisionSnapshot.h"
+#include "CollisionQueryParams.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+// Sweeps camera feelers through a cluttered room both against the physics scene and against a collision snapshot, and compares the two
+
+namespace SPCameraCollisionSnapshotTest
+{
+	constexpr float SnapshotRadius = 1000.f;
+
+	/** A floor and a few hundred boxes of all sizes and angles around the origin, like furniture in a dense interior */
+	static bool SpawnClutter(FAutomationTestBase& Test, UWorld* World)
+	{
+		UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (!Test.TestNotNull(TEXT("Engine cube mesh"), Cube))
+		{
+			return false;
+		}
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		auto SpawnBox = [World, Cube, &SpawnParameters](const FTransform& Transform)
+		{
+			// static components won't take a mesh once registered
+			AStaticMeshActor* const Box = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParameters);
+			Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			Box->GetStaticMeshComponent()->SetStaticMesh(Cube);
+			Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Static);
+		};
+
+		SpawnBox(FTransform(FRotator::ZeroRotator, FVector(0.0, 0.0, -250.0), FVector(40.0, 40.0, 1.0)));
+
+		FRandomStream Random(7);
+		for (int32 BoxIdx = 0; BoxIdx < 300; ++BoxIdx)
+		{
+			const FVector Location(Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-1500.f, 1500.f), Random.FRandRange(-200.f, 400.f));
+			const FRotator Rotation(Random.FRandRange(-30.f, 30.f), Random.FRandRange(0.f, 360.f), Random.FRandRange(-30.f, 30.f));
+			SpawnBox(FTransform(Rotation, Location, FVector(Random.FRandRange(0.2f, 2.f), Random.FRandRange(0.2f, 2.f), Random.FRandRange(0.2f, 2.f))));
+		}
+		return true;
+	}
+
+	struct FFeeler
+	{
+		FVector Start;
+		FVector End;
+		float Radius;
+	};
+
+	/** Feelers from around a pivot near the origin out to camera boom lengths, with the radii the third person camera uses */
+	static TArray<FFeeler> MakeFeelers(int32 NumFeelers, int32 Seed)
+	{
+		static const float Radii[] = { 0.f, 12.f, 15.f };
+
+		FRandomStream Random(Seed);
+		TArray<FFeeler> Feelers;
+		for (int32 FeelerIdx = 0; FeelerIdx < NumFeelers; ++FeelerIdx)
+		{
+			const FVector Start = Random.GetUnitVector() * Random.FRandRange(0.f, 150.f);
+			Feelers.Add({ Start, Start + Random.GetUnitVector() * Random.FRandRange(200.f, 600.f), Radii[FeelerIdx % UE_ARRAY_COUNT(Radii)] });
+		}
+		return Feelers;
+	}
+
+	static bool SweepScene(const UWorld* World, const FFeeler& Feeler, FHitResult& OutHit)
+	{
+		const FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPenetration), false);
+		return World->SweepSingleByChannel(OutHit, Feeler.Start, Feeler.End, FQuat::Identity, ECC_Camera, FCollisionShape::MakeSphere(Feeler.Radius), SphereParams);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraCollisionSnapshotTest, "SP.Camera.CollisionSnapshot",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraCollisionSnapshotTest::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraCollisionSnapshotTest;
+
+	const FSPCameraScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	if (!SpawnClutter(*this, World))
+	{
+		return false;
+	}
+
+	FSPCameraCollisionSnapshot Snapshot;
+	TestFalse(TEXT("Nothing captured yet"), Snapshot.IsCaptured());
+	Snapshot.Capture(World, FVector::ZeroVector, SnapshotRadius, ECC_Camera);
+	TestTrue(TEXT("Captured"), Snapshot.IsCaptured());
+	TestTrue(TEXT("Snapshot holds the clutter around the pivot"), Snapshot.GetNumBodies() > 10);
+	AddInfo(FString::Printf(TEXT("%d bodies in the snapshot"), Snapshot.GetNumBodies()));
+
+	// every feeler should come out the same as against the scene, to within sweep precision
+	int32 NumHits = 0;
+	int32 NumMismatches = 0;
+	double MaxTimeError = 0.0;
+	for (const FFeeler& Feeler : MakeFeelers(2000, 11))
+	{
+		if (!TestTrue(TEXT("Feelers stay inside the snapshot"), Snapshot.Covers(Feeler.Start, Feeler.End, Feeler.Radius)))
+		{
+			return false;
+		}
+
+		FHitResult SceneHit, SnapshotHit;
+		const bool bSceneHit = SweepScene(World, Feeler, SceneHit);
+		const bool bSnapshotHit = Snapshot.SweepSingle(SnapshotHit, Feeler.Start, Feeler.End, Feeler.Radius);
+		if (bSceneHit != bSnapshotHit)
+		{
+			++NumMismatches;
+			continue;
+		}
+
+		if (bSceneHit)
+		{
+			++NumHits;
+			MaxTimeError = FMath::Max(MaxTimeError, double(FMath::Abs(SceneHit.Time - SnapshotHit.Time)));
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("%d of 2000 feelers hit, %d disagreed, largest hit time difference %f"), NumHits, NumMismatches, MaxTimeError));
+	TestTrue(TEXT("Clutter gets in the way of plenty of feelers"), NumHits > 200);
+	TestTrue(TEXT("Snapshot and scene agree on what's hit"), NumMismatches <= 2);
+	TestTrue(TEXT("Hits land in the same place, a boom length is a few metres so 1% is a few centimetres"), MaxTimeError < 0.01);
+
+	TestFalse(TEXT("Feelers leaving the snapshot aren't covered"), Snapshot.Covers(FVector::ZeroVector, FVector(SnapshotRadius, 0.0, 0.0), 0.f));
+	TestFalse(TEXT("Fat feelers reaching the edge aren't covered"), Snapshot.Covers(FVector::ZeroVector, FVector(SnapshotRadius - 10.0, 0.0, 0.0), 15.f));
+
+	// high above the clutter, a box that moves after the capture is found where it went once the transforms are refreshed
+	UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	AStaticMeshActor* const MovingBox = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform(FVector(300.0, 0.0, 3000.0)));
+	MovingBox->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	MovingBox->GetStaticMeshComponent()->SetStaticMesh(Cube);
+
+	const FVector MovingStart(0.0, 0.0, 3000.0);
+	const FVector MovingEnd(800.0, 0.0, 3000.0);
+	Snapshot.Capture(World, MovingStart, SnapshotRadius, ECC_Camera);
+	FHitResult MovingHit;
+	TestTrue(TEXT("Moving box captured"), Snapshot.SweepSingle(MovingHit, MovingStart, MovingEnd, 12.f));
+	TestEqual(TEXT("Moving box hit at its near face"), MovingHit.Location.X, 238.0, 1.0);
+	TestTrue(TEXT("Hit reports the box"), MovingHit.GetActor() == MovingBox);
+	TestFalse(TEXT("Sweeps ignoring the box go through it"), Snapshot.SweepSingle(MovingHit, MovingStart, MovingEnd, 12.f, MovingBox));
+
+	MovingBox->SetActorLocation(FVector(500.0, 0.0, 3000.0));
+	Snapshot.RefreshTransforms(World);
+	TestTrue(TEXT("Moved box still hit"), Snapshot.SweepSingle(MovingHit, MovingStart, MovingEnd, 12.f));
+	TestEqual(TEXT("Moved box hit where it went"), MovingHit.Location.X, 438.0, 1.0);
+
+	MovingBox->Destroy();
+	Snapshot.RefreshTransforms(World);
+	TestFalse(TEXT("Destroyed box no longer hit"), Snapshot.SweepSingle(MovingHit, MovingStart, MovingEnd, 12.f));
+
+	Snapshot.Reset();
+	TestFalse(TEXT("Reset covers nothing"), Snapshot.Covers(FVector::ZeroVector, FVector(1.0, 0.0, 0.0), 0.f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraCollisionSnapshotBenchmark, "SP.Camera.CollisionSnapshotBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraCollisionSnapshotBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraCollisionSnapshotTest;
+
+	// a third person camera's dozen feelers a frame, recapturing every 10 frames as SP.Camera.CollisionSnapshotInterval does by default
+	constexpr int32 NumFrames = 2000;
+	constexpr int32 FeelersPerFrame = 12;
+	constexpr int32 CaptureInterval = 10;
+
+	const FSPCameraScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	if (!SpawnClutter(*this, World))
+	{
+		return false;
+	}
+
+	const TArray<FFeeler> Feelers = MakeFeelers(NumFrames * FeelersPerFrame, 23);
+
+	// the hit counts keep the optimizer from dropping the loops
+	double StartTime = FPlatformTime::Seconds();
+	int32 NumSceneHits = 0;
+	for (const FFeeler& Feeler : Feelers)
+	{
+		FHitResult Hit;
+		NumSceneHits += SweepScene(World, Feeler, Hit) ? 1 : 0;
+	}
+	const double SceneMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	FSPCameraCollisionSnapshot Snapshot;
+	int32 NumSnapshotHits = 0;
+	for (int32 FeelerIdx = 0; FeelerIdx < Feelers.Num(); ++FeelerIdx)
+	{
+		if (FeelerIdx % (FeelersPerFrame * CaptureInterval) == 0)
+		{
+			Snapshot.Capture(World, FVector::ZeroVector, SnapshotRadius, ECC_Camera);
+		}
+		else if (FeelerIdx % FeelersPerFrame == 0)
+		{
+			Snapshot.RefreshTransforms(World);
+		}
+
+		const FFeeler& Feeler = Feelers[FeelerIdx];
+		FHitResult Hit;
+		NumSnapshotHits += Snapshot.SweepSingle(Hit, Feeler.Start, Feeler.End, Feeler.Radius) ? 1 : 0;
+	}
+	const double SnapshotMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(TEXT("%d frames of %d feelers among %d bodies: scene %.3f ms, snapshot %.3f ms including %d captures"),
+		NumFrames, FeelersPerFrame, Snapshot.GetNumBodies(), SceneMilliseconds, SnapshotMilliseconds, NumFrames / CaptureInterval));
+	TestTrue(TEXT("Snapshot finds the same number of hits, give or take sweep precision"), FMath::Abs(NumSceneHits - NumSnapshotHits) <= Feelers.Num() / 1000);
+
+	return true;
+}
+
+#endif
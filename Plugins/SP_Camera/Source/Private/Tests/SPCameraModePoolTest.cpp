@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraRigHarness.h"
+#include "SPCameraMode.h"
+#include "SPPlayerCameraManager.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+// Switches a camera manager between view targets and counts how many camera mode instances it had to create
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraModePoolTest, "SP.Camera.ModePool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraModePoolTest::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	FSPCameraRigHarness Rig;
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+	{
+		return false;
+	}
+
+	// no alternate camera mode is configured, so plain actors get the default mode
+	UWorld* const World = Rig.GetWorld();
+	ASPPlayerCameraManager* const CameraManager = Rig.GetCameraManager();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* TargetA = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	AActor* TargetB = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(FVector(500.0, 0.0, 0.0)), SpawnParameters);
+	if (!TestNotNull(TEXT("View targets"), TargetA) || !TestNotNull(TEXT("View targets"), TargetB))
+	{
+		return false;
+	}
+
+	// hard cuts, so nothing lingers in the blend stack between switches
+	FTViewTarget ViewTarget;
+	auto SwitchTo = [CameraManager, &ViewTarget](AActor* NewTarget)
+	{
+		ViewTarget.Target = NewTarget;
+		CameraManager->SkipBlends();
+		CameraManager->UpdateViewTarget(ViewTarget, DeltaTime);
+	};
+
+	CameraManager->PrewarmCameraModes({ USPCameraMode::StaticClass() }, 2);
+	TestEqual(TEXT("Pre-warming creates the instances"), CameraManager->GetNumCameraModeInstancesCreated(), 2);
+	TestEqual(TEXT("Pre-warmed instances wait in the pool"), CameraManager->GetNumPooledCameraModeInstances(), 2);
+
+	// live view targets keep their instances
+	for (int32 Switch = 0; Switch < 100; ++Switch)
+	{
+		SwitchTo((Switch % 2 == 0) ? TargetA : TargetB);
+	}
+	TestEqual(TEXT("Switching between two targets allocates nothing past the pre-warm"), CameraManager->GetNumCameraModeInstancesCreated(), 2);
+	TestEqual(TEXT("Both pre-warmed instances in use"), CameraManager->GetNumPooledCameraModeInstances(), 0);
+	TestEqual(TEXT("Same target finds the same instance"), CameraManager->GetBestCameraMode(TargetA), CameraManager->GetBestCameraMode(TargetA));
+	TestNotEqual(TEXT("Each target has its own instance"), CameraManager->GetBestCameraMode(TargetA), CameraManager->GetBestCameraMode(TargetB));
+
+	// short lived view targets hand their instance back once they're gone
+	USPCameraMode* RecycledMode = nullptr;
+	for (int32 Switch = 0; Switch < 50; ++Switch)
+	{
+		AActor* const ShortLivedTarget = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(FVector(0.0, 200.0 * Switch, 0.0)), SpawnParameters);
+		SwitchTo(ShortLivedTarget);
+
+		USPCameraMode* const CameraMode = CameraManager->GetCameraModeInstances()[CameraManager->GetBestCameraMode(ShortLivedTarget)].CameraMode;
+		if (Switch == 1)
+		{
+			TestTrue(TEXT("The next short lived target recycles the previous one's mode"), CameraMode == RecycledMode);
+			TestEqual(TEXT("Recycled modes are back to their defaults"), CameraMode->FOV, GetDefault<USPCameraMode>()->FOV);
+		}
+		RecycledMode = CameraMode;
+		CameraMode->FOV = 10.f;
+
+		SwitchTo(TargetA);
+		ShortLivedTarget->Destroy();
+	}
+	TestEqual(TEXT("Repeated short lived targets allocate one instance in total"), CameraManager->GetNumCameraModeInstancesCreated(), 3);
+	TestEqual(TEXT("Instances don't pile up"), CameraManager->GetCameraModeInstances().Num(), 3);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraTestWorld.h"
+#include "SPCameraOcclusionFade.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+
+// Runs a camera up against a character, jittering across the fade distance, and counts how often the hidden actors list changes
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraOcclusionFadeTest, "SP.Camera.OcclusionFade",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraOcclusionFadeTest::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	const FSPCameraScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	APlayerController* PC = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), FTransform::Identity, SpawnParameters);
+	ACharacter* Near = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FTransform(FVector(0.0, 0.0, 100.0)), SpawnParameters);
+	ACharacter* Behind = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FTransform(FVector(300.0, 0.0, 100.0)), SpawnParameters);
+	ACharacter* Far = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), FTransform(FVector(5000.0, 0.0, 100.0)), SpawnParameters);
+	if (!TestNotNull(TEXT("Player controller"), PC) || !TestNotNull(TEXT("Characters"), Near) || !TestNotNull(TEXT("Characters"), Behind) || !TestNotNull(TEXT("Characters"), Far))
+	{
+		return false;
+	}
+
+	FSPCameraOcclusionFade OcclusionFade;
+	const float CapsuleRadius = Near->GetCapsuleComponent()->GetScaledCapsuleRadius();
+
+	// camera behind Near, DistToCapsule from its capsule
+	int32 NumHiddenActorsChanges = 0;
+	int32 NumThresholdCrossings = 0;
+	bool bWasInsideThreshold = false;
+	bool bSawPartialFade = false;
+	TArray<TObjectPtr<AActor>> LastHiddenActors;
+	auto StepCamera = [&](float DistToCapsule)
+	{
+		OcclusionFade.Update(PC, FVector(-(CapsuleRadius + DistToCapsule), 0.0, 100.0), DeltaTime);
+
+		if (PC->HiddenActors != LastHiddenActors)
+		{
+			++NumHiddenActorsChanges;
+			LastHiddenActors = PC->HiddenActors;
+		}
+
+		// hiding whenever the camera is inside the fade out distance would toggle on every one of these
+		const bool bInsideThreshold = DistToCapsule < OcclusionFade.FadeOutDistance;
+		NumThresholdCrossings += (bInsideThreshold != bWasInsideThreshold) ? 1 : 0;
+		bWasInsideThreshold = bInsideThreshold;
+
+		const float FadeAmount = OcclusionFade.GetFadeAmount(Near);
+		bSawPartialFade |= (FadeAmount > 0.f && FadeAmount < 1.f);
+	};
+
+	// well clear, then jittering back and forth across the fade out distance for two seconds, then clear again
+	for (int32 Frame = 0; Frame < 60; ++Frame)
+	{
+		StepCamera(100.f);
+	}
+	TestEqual(TEXT("Nothing fades with the camera clear"), OcclusionFade.GetFadeAmount(Near), 0.f);
+	TestEqual(TEXT("Only characters near the camera are tracked"), OcclusionFade.GetNumTrackedCharacters(), 2);
+
+	for (int32 Frame = 0; Frame < 120; ++Frame)
+	{
+		StepCamera(25.f + 12.f * FMath::Sin(UE_TWO_PI * 3.f * Frame * DeltaTime));
+	}
+	TestEqual(TEXT("Jittering inside the fade in distance keeps the character faded"), OcclusionFade.GetFadeAmount(Near), 1.f);
+	TestTrue(TEXT("Faded character is hidden"), PC->HiddenActors.Contains(Near));
+	TestFalse(TEXT("Characters further away are left alone"), PC->HiddenActors.Contains(Behind) || PC->HiddenActors.Contains(Far));
+
+	for (int32 Frame = 0; Frame < 60; ++Frame)
+	{
+		StepCamera(100.f);
+	}
+	TestEqual(TEXT("Character fades back in once the camera moves away"), OcclusionFade.GetFadeAmount(Near), 0.f);
+	TestFalse(TEXT("Character is shown again"), PC->HiddenActors.Contains(Near));
+
+	TestTrue(TEXT("Characters fade rather than pop"), bSawPartialFade);
+	TestEqual(TEXT("Hidden actors change once on the way in and once on the way out"), NumHiddenActorsChanges, 2);
+	AddInfo(FString::Printf(TEXT("%d hidden actors changes, hiding on the fade out distance alone would have made %d"), NumHiddenActorsChanges, NumThresholdCrossings));
+
+	// a cut to a camera actor puts everything back straight away
+	for (int32 Frame = 0; Frame < 30; ++Frame)
+	{
+		StepCamera(0.f);
+	}
+	OcclusionFade.Reset(PC);
+	TestTrue(TEXT("Reset shows every character"), PC->HiddenActors.IsEmpty());
+	TestEqual(TEXT("Reset clears the fade"), OcclusionFade.GetFadeAmount(Near), 0.f);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,253 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraRigHarness.h"
+#include "SPCam_ThirdPerson.h"
+#include "SPCameraMode.h"
+#include "SPPlayerCameraManager.h"
+#include "Camera/CameraComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+
+FSPCameraRigHarness::FSPCameraRigHarness()
+{
+	UWorld* const World = GetWorld();
+	Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	PlayerController = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), FTransform::Identity, SpawnParameters);
+	CameraManager = World->SpawnActor<ASPPlayerCameraManager>(ASPPlayerCameraManager::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (CameraManager)
+	{
+		CameraManager->PCOwner = PlayerController;
+
+		// the alternate camera picks the mode class for every view target, see SetViewTarget
+		CameraManager->bUsingAltCameraMode = true;
+	}
+}
+
+FSPCameraRigHarness::~FSPCameraRigHarness() = default;
+
+bool FSPCameraRigHarness::IsReady() const
+{
+	return GetWorld() && PlayerController && CameraManager && Cube;
+}
+
+AActor* FSPCameraRigHarness::AddViewTarget(FSPCameraRigTrajectory Trajectory, bool bWithCameraComponent)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// a movable root and nothing to collide with
+	AStaticMeshActor* const Target = GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Trajectory(Time), SpawnParameters);
+	Target->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Target->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	if (bWithCameraComponent)
+	{
+		UCameraComponent* const Camera = NewObject<UCameraComponent>(Target);
+		Camera->SetupAttachment(Target->GetRootComponent());
+		Camera->RegisterComponent();
+		Target->AddInstanceComponent(Camera);
+	}
+
+	Targets.Add({ Target, MoveTemp(Trajectory) });
+	return Target;
+}
+
+AStaticMeshActor* FSPCameraRigHarness::AddBox(const FTransform& Transform)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// static components won't take a mesh once registered
+	AStaticMeshActor* const Box = GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParameters);
+	Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Box->GetStaticMeshComponent()->SetStaticMesh(Cube);
+	return Box;
+}
+
+USPCameraMode* FSPCameraRigHarness::SetViewTarget(AActor* Target, TSubclassOf<USPCameraMode> CameraModeClass)
+{
+	CameraManager->AltCameraMode = CameraModeClass;
+	ViewTarget.Target = Target;
+	return CameraManager->GetCameraModeInstances()[CameraManager->GetBestCameraMode(Target)].CameraMode;
+}
+
+const FSPCameraRigFrame& FSPCameraRigHarness::Step(float DeltaTime)
+{
+	Time += DeltaTime;
+	for (const FScriptedTarget& Target : Targets)
+	{
+		if (AActor* const Actor = Target.Actor.Get())
+		{
+			// scripted movement has no velocity of its own, predictive camera features need one
+			const FTransform NewTransform = Target.Trajectory(Time);
+			if (DeltaTime > 0.f)
+			{
+				Actor->GetRootComponent()->ComponentVelocity = (NewTransform.GetLocation() - Actor->GetActorLocation()) / DeltaTime;
+			}
+			Actor->SetActorTransform(NewTransform);
+		}
+	}
+
+	double CostSeconds = 0.0;
+	auto UpdateCamera = [this, DeltaTime, &CostSeconds]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		CameraManager->UpdateViewTarget(ViewTarget, DeltaTime);
+		CostSeconds = FPlatformTime::Seconds() - StartTime;
+	};
+
+	if (bTickWorld)
+	{
+		// after the actors tick and before the world runs this frame's async traces, like the player controllers' cameras
+		const FDelegateHandle PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddLambda([this, &UpdateCamera](UWorld* TickedWorld, ELevelTick, float)
+		{
+			if (TickedWorld == GetWorld())
+			{
+				UpdateCamera();
+			}
+		});
+		GetWorld()->Tick(LEVELTICK_All, DeltaTime);
+		FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	}
+	else
+	{
+		UpdateCamera();
+	}
+
+	FSPCameraRigFrame& Frame = Frames.AddDefaulted_GetRef();
+	Frame.Time = Time;
+	Frame.DeltaTime = DeltaTime;
+	Frame.Location = ViewTarget.POV.Location;
+	Frame.Rotation = ViewTarget.POV.Rotation;
+	Frame.FOV = ViewTarget.POV.FOV;
+	Frame.CostSeconds = CostSeconds;
+
+	const TArray<FActiveSPCamera>& BlendStack = CameraManager->GetCameraBlendStack();
+	for (const FActiveSPCamera& CamEntry : BlendStack)
+	{
+		Frame.BlendWeights.Add(CamEntry.BlendWeight);
+	}
+	if (const USPCam_ThirdPerson* const ThirdPerson = BlendStack.IsEmpty() ? nullptr : Cast<USPCam_ThirdPerson>(BlendStack[0].Camera))
+	{
+		Frame.DistBlockedPct = ThirdPerson->GetPenetrationBlockedPct();
+	}
+
+	return Frame;
+}
+
+void FSPCameraRigHarness::RunFor(double Duration, float DeltaTime)
+{
+	RunFor(Duration, [DeltaTime]() { return DeltaTime; });
+}
+
+void FSPCameraRigHarness::RunFor(double Duration, TFunctionRef<float()> NextDeltaTime)
+{
+	const double EndTime = Time + Duration;
+	while (Time < EndTime - UE_KINDA_SMALL_NUMBER)
+	{
+		Step(float(FMath::Min<double>(NextDeltaTime(), EndTime - Time)));
+	}
+}
+
+const FSPCameraRigFrame* FSPCameraRigHarness::FindFrameAt(double AtTime) const
+{
+	return Frames.FindByPredicate([AtTime](const FSPCameraRigFrame& Frame) { return FMath::IsNearlyEqual(Frame.Time, AtTime, 1.e-4); });
+}
+
+double FSPCameraRigHarness::GetMaxThirdDerivative(double FromTime, TFunctionRef<FVector(const FSPCameraRigFrame& Frame, const FSPCameraRigFrame& PrevFrame)> Delta) const
+{
+	// velocities sit between frames, accelerations between velocities, jerks between accelerations
+	double MaxJerk = 0.0;
+	FVector PrevVelocity, PrevAcceleration;
+	double PrevVelocityTime = 0.0, PrevAccelerationTime = 0.0;
+	int32 NumVelocities = 0;
+
+	for (int32 FrameIdx = 1; FrameIdx < Frames.Num(); ++FrameIdx)
+	{
+		const FSPCameraRigFrame& Frame = Frames[FrameIdx];
+		const FSPCameraRigFrame& PrevFrame = Frames[FrameIdx - 1];
+		if (PrevFrame.Time < FromTime || Frame.DeltaTime <= 0.f)
+		{
+			continue;
+		}
+
+		const FVector Velocity = Delta(Frame, PrevFrame) / Frame.DeltaTime;
+		const double VelocityTime = Frame.Time - 0.5 * Frame.DeltaTime;
+		if (NumVelocities > 0)
+		{
+			const FVector Acceleration = (Velocity - PrevVelocity) / (VelocityTime - PrevVelocityTime);
+			const double AccelerationTime = 0.5 * (VelocityTime + PrevVelocityTime);
+			if (NumVelocities > 1)
+			{
+				const FVector Jerk = (Acceleration - PrevAcceleration) / (AccelerationTime - PrevAccelerationTime);
+				MaxJerk = FMath::Max(MaxJerk, Jerk.Size());
+			}
+			PrevAcceleration = Acceleration;
+			PrevAccelerationTime = AccelerationTime;
+		}
+
+		PrevVelocity = Velocity;
+		PrevVelocityTime = VelocityTime;
+		++NumVelocities;
+	}
+
+	return MaxJerk;
+}
+
+double FSPCameraRigHarness::GetMaxJerk(double FromTime) const
+{
+	return GetMaxThirdDerivative(FromTime, [](const FSPCameraRigFrame& Frame, const FSPCameraRigFrame& PrevFrame)
+	{
+		return Frame.Location - PrevFrame.Location;
+	});
+}
+
+double FSPCameraRigHarness::GetMaxAngularJerk(double FromTime) const
+{
+	// the short way round, so crossing +-180 isn't a jump
+	return GetMaxThirdDerivative(FromTime, [](const FSPCameraRigFrame& Frame, const FSPCameraRigFrame& PrevFrame)
+	{
+		const FRotator RotationDelta = (Frame.Rotation - PrevFrame.Rotation).GetNormalized();
+		return FVector(RotationDelta.Pitch, RotationDelta.Yaw, RotationDelta.Roll);
+	});
+}
+
+double FSPCameraRigHarness::GetAverageCostSeconds(double FromTime) const
+{
+	double TotalCost = 0.0;
+	int32 NumFrames = 0;
+	for (const FSPCameraRigFrame& Frame : Frames)
+	{
+		if (Frame.Time >= FromTime)
+		{
+			TotalCost += Frame.CostSeconds;
+			++NumFrames;
+		}
+	}
+	return NumFrames > 0 ? TotalCost / NumFrames : 0.0;
+}
+
+double FSPCameraRigHarness::GetMaxCostSeconds(double FromTime) const
+{
+	double MaxCost = 0.0;
+	for (const FSPCameraRigFrame& Frame : Frames)
+	{
+		if (Frame.Time >= FromTime)
+		{
+			MaxCost = FMath::Max(MaxCost, Frame.CostSeconds);
+		}
+	}
+	return MaxCost;
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreMinimal.h"
+#include "SPCameraTestWorld.h"
+#include "Camera/PlayerCameraManager.h"
+
+class AActor;
+class APlayerController;
+class ASPPlayerCameraManager;
+class AStaticMeshActor;
+class UStaticMesh;
+class UWorld;
+class USPCameraMode;
+
+/** What the camera manager produced on one step of FSPCameraRigHarness */
+struct FSPCameraRigFrame
+{
+	double Time = 0.0;
+	float DeltaTime = 0.f;
+
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float FOV = 0.f;
+
+	/** Normalized blend weight of every camera in the blend stack, the active one first */
+	TArray<float, TInlineAllocator<4>> BlendWeights;
+
+	/** Penetration avoidance of the active camera, 1 when nothing is in the way or it isn't a third person camera */
+	float DistBlockedPct = 1.f;
+
+	/** Wall clock time UpdateViewTarget took */
+	double CostSeconds = 0.0;
+};
+
+/** Where a scripted view target is at a time */
+using FSPCameraRigTrajectory = TFunction<FTransform(double Time)>;
+
+/**
+ * Runs an ASPPlayerCameraManager in a throwaway game world without the game: view targets follow scripted trajectories,
+ * UpdateViewTarget is stepped at whatever delta times the test picks and every step is recorded.
+ */
+class FSPCameraRigHarness
+{
+public:
+	FSPCameraRigHarness();
+	~FSPCameraRigHarness();
+
+	FSPCameraRigHarness(const FSPCameraRigHarness&) = delete;
+	FSPCameraRigHarness& operator=(const FSPCameraRigHarness&) = delete;
+
+	/** False if the world or the camera manager couldn't be set up */
+	bool IsReady() const;
+
+	/** Spawns a view target moved along Trajectory every step, with a camera component for attached cameras to look through if asked. Its velocity follows the trajectory. */
+	AActor* AddViewTarget(FSPCameraRigTrajectory Trajectory, bool bWithCameraComponent = false);
+
+	/** Spawns a box with the engine cube for the cameras to collide with */
+	AStaticMeshActor* AddBox(const FTransform& Transform);
+
+	/** Switches the camera to Target, viewed through a CameraModeClass camera mode, from the next step on. Returns that camera mode. */
+	USPCameraMode* SetViewTarget(AActor* Target, TSubclassOf<USPCameraMode> CameraModeClass);
+
+	/** Moves the view targets along their trajectories, then updates the camera manager by DeltaTime */
+	const FSPCameraRigFrame& Step(float DeltaTime);
+
+	/** Ticks the world every step and updates the camera from within the tick, where the game would. Async traces only come back this way */
+	void SetTickWorld(bool bInTickWorld) { bTickWorld = bInTickWorld; }
+
+	/** Steps for Duration at a fixed delta time, the last step cut short to end on Duration exactly */
+	void RunFor(double Duration, float DeltaTime);
+
+	/** Steps for Duration with delta times from NextDeltaTime, the last step cut short to end on Duration exactly */
+	void RunFor(double Duration, TFunctionRef<float()> NextDeltaTime);
+
+	const TArray<FSPCameraRigFrame>& GetFrames() const { return Frames; }
+	double GetTime() const { return Time; }
+
+	/** The frame recorded at Time, if there is one */
+	const FSPCameraRigFrame* FindFrameAt(double AtTime) const;
+
+	/** Largest third derivative of camera location from FromTime on, in cm/s^3, by finite differences over the recorded delta times */
+	double GetMaxJerk(double FromTime = 0.0) const;
+
+	/** Largest third derivative of camera rotation from FromTime on, in deg/s^3 */
+	double GetMaxAngularJerk(double FromTime = 0.0) const;
+
+	/** Average and largest UpdateViewTarget cost from FromTime on */
+	double GetAverageCostSeconds(double FromTime = 0.0) const;
+	double GetMaxCostSeconds(double FromTime = 0.0) const;
+
+	UWorld* GetWorld() const { return TestWorld.GetWorld(); }
+	ASPPlayerCameraManager* GetCameraManager() const { return CameraManager; }
+
+private:
+	double GetMaxThirdDerivative(double FromTime, TFunctionRef<FVector(const FSPCameraRigFrame& Frame, const FSPCameraRigFrame& PrevFrame)> Delta) const;
+
+	struct FScriptedTarget
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FSPCameraRigTrajectory Trajectory;
+	};
+
+	FSPCameraScopedTestWorld TestWorld;
+	APlayerController* PlayerController = nullptr;
+	ASPPlayerCameraManager* CameraManager = nullptr;
+	UStaticMesh* Cube = nullptr;
+
+	TArray<FScriptedTarget> Targets;
+	FTViewTarget ViewTarget;
+
+	TArray<FSPCameraRigFrame> Frames;
+	double Time = 0.0;
+	bool bTickWorld = false;
+};
+
+#endif
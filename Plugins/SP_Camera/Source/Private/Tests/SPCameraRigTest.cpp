@@ -0,0 +1,475 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraRigHarness.h"
+#include "SPCam_AttachedCamera.h"
+#include "SPCam_ThirdPerson.h"
+#include "SPPlayerCameraManager.h"
+#include "CineCameraComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+// Drives the camera manager along scripted view target paths with FSPCameraRigHarness and checks what comes out
+
+namespace SPCameraRigTest
+{
+	/** Laps of a 10m circle at 6m/s, bobbing up and down a little */
+	static FTransform CirclePath(double Time)
+	{
+		constexpr double Radius = 1000.0;
+		constexpr double Speed = 600.0;
+
+		const double Angle = Time * Speed / Radius;
+		const FVector Location(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 100.0 + 50.0 * FMath::Sin(UE_DOUBLE_PI * Time));
+		return FTransform(FRotator(0.0, FMath::RadiansToDegrees(Angle) + 90.0, 0.0), Location);
+	}
+
+	/** Frames where the camera boom changed length faster than a penetration blend would move it */
+	struct FSnapStats
+	{
+		int32 NumSnaps = 0;
+		double MaxSnap = 0.0;
+	};
+
+	static FSnapStats MeasureSnaps(const TArray<FSPCameraRigFrame>& Frames, TFunctionRef<FVector(double Time)> TargetLocation, double SnapSpeed)
+	{
+		FSnapStats Stats;
+		for (int32 FrameIdx = 1; FrameIdx < Frames.Num(); ++FrameIdx)
+		{
+			const FSPCameraRigFrame& Frame = Frames[FrameIdx];
+			const FSPCameraRigFrame& PrevFrame = Frames[FrameIdx - 1];
+			const double BoomChange = FMath::Abs(FVector::Dist(Frame.Location, TargetLocation(Frame.Time)) - FVector::Dist(PrevFrame.Location, TargetLocation(PrevFrame.Time)));
+			if (BoomChange > SnapSpeed * Frame.DeltaTime)
+			{
+				++Stats.NumSnaps;
+				Stats.MaxSnap = FMath::Max(Stats.MaxSnap, BoomChange);
+			}
+		}
+		return Stats;
+	}
+
+	/** The autofocus settings are protected, set them the way the editor does */
+	static FBoolProperty* GetUseAutofocusProperty()
+	{
+		return FindFProperty<FBoolProperty>(USPCameraMode::StaticClass(), TEXT("bUseAutofocus"));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigThirdPersonTest, "SP.Camera.Rig.ThirdPerson",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigThirdPersonTest::RunTest(const FString& Parameters)
+{
+	FSPCameraRigHarness Rig;
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+	{
+		return false;
+	}
+
+	AActor* const Target = Rig.AddViewTarget(&SPCameraRigTest::CirclePath);
+	Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+	Rig.RunFor(5.0, 1.f / 60.f);
+
+	// the first second has the camera catching up from the origin
+	constexpr double SettleTime = 1.0;
+	const double MaxJerk = Rig.GetMaxJerk(SettleTime);
+	const double MaxAngularJerk = Rig.GetMaxAngularJerk(SettleTime);
+	TestTrue(FString::Printf(TEXT("Camera location is smooth, jerk %.0f cm/s^3"), MaxJerk), MaxJerk < 50000.0);
+	TestTrue(FString::Printf(TEXT("Camera rotation is smooth, jerk %.0f deg/s^3"), MaxAngularJerk), MaxAngularJerk < 5000.0);
+
+	for (const FSPCameraRigFrame& Frame : Rig.GetFrames())
+	{
+		if (Frame.Time < SettleTime)
+		{
+			continue;
+		}
+
+		const double Distance = FVector::Dist(Frame.Location, SPCameraRigTest::CirclePath(Frame.Time).GetLocation());
+		if (!TestTrue(FString::Printf(TEXT("Camera keeps up with the target at %.2fs, %.0fcm away"), Frame.Time, Distance), Distance > 100.0 && Distance < 600.0)
+			|| !TestEqual(TEXT("Nothing to avoid in an empty world"), Frame.DistBlockedPct, 1.f))
+		{
+			break;
+		}
+	}
+
+	// timings depend on the machine, reported here and held to a budget in SP.Camera.Rig.Cost
+	AddInfo(FString::Printf(TEXT("UpdateViewTarget average %.3fms, worst %.3fms"), Rig.GetAverageCostSeconds(SettleTime) * 1000.0, Rig.GetMaxCostSeconds(SettleTime) * 1000.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigCostTest, "SP.Camera.Rig.Cost",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraRigCostTest::RunTest(const FString& Parameters)
+{
+	// the camera aims for 1ms a frame, twice that leaves room for slow or busy machines and still catches a real regression
+	constexpr double BudgetSeconds = 0.002;
+
+	FSPCameraRigHarness Rig;
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+	{
+		return false;
+	}
+
+	// pillars just outside the circle give the penetration feelers something to trace against
+	for (int32 PillarIdx = 0; PillarIdx < 8; ++PillarIdx)
+	{
+		Rig.AddBox(FTransform(FRotator::ZeroRotator, FRotator(0.f, 45.f * PillarIdx, 0.f).RotateVector(FVector(1300.0, 0.0, 200.0)), FVector(1.0, 1.0, 4.0)));
+	}
+
+	AActor* const Target = Rig.AddViewTarget(&SPCameraRigTest::CirclePath);
+	Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+	Rig.RunFor(10.0, 1.f / 60.f);
+
+	constexpr double SettleTime = 1.0;
+	const double AverageCost = Rig.GetAverageCostSeconds(SettleTime);
+	AddInfo(FString::Printf(TEXT("UpdateViewTarget average %.3fms, worst %.3fms"), AverageCost * 1000.0, Rig.GetMaxCostSeconds(SettleTime) * 1000.0));
+	TestTrue(FString::Printf(TEXT("UpdateViewTarget averages %.3fms, within %.1fms"), AverageCost * 1000.0, BudgetSeconds * 1000.0), AverageCost < BudgetSeconds);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigAutofocusTest, "SP.Camera.Rig.Autofocus",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigAutofocusTest::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr int32 NumSettleFrames = 30;
+
+	FSPCameraRigHarness Rig;
+	FBoolProperty* const UseAutofocusProperty = SPCameraRigTest::GetUseAutofocusProperty();
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()) || !TestNotNull(TEXT("bUseAutofocus property"), UseAutofocusProperty))
+	{
+		return false;
+	}
+
+	// autofocus traces are async, they need the world to tick
+	Rig.SetTickWorld(true);
+
+	const FVector TargetLocation(0.0, 0.0, 100.0);
+	AActor* const Target = Rig.AddViewTarget([TargetLocation](double Time) { return FTransform(TargetLocation); });
+	USPCameraMode* const CameraMode = Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+	CameraMode->bUseCineCam = true;
+	CameraMode->bUseCineCamSettings = true;
+	UseAutofocusProperty->SetPropertyValue_InContainer(CameraMode, true);
+
+	const FSPCameraModeInstance* const ModeInstance = Rig.GetCameraManager()->GetCameraModeInstances().FindByPredicate([CameraMode](const FSPCameraModeInstance& Instance) { return Instance.CameraMode == CameraMode; });
+	const UCineCameraComponent* const CineCamera = ModeInstance ? ModeInstance->CineCameraComponent : nullptr;
+	if (!TestNotNull(TEXT("Cine camera"), CineCamera))
+	{
+		return false;
+	}
+
+	// nothing in the way, the traces miss and the focus is on the target
+	Rig.RunFor(2.0, DeltaTime);
+	const FSPCameraRigFrame SettledFrame = Rig.GetFrames().Last();
+	const float TargetDepth = float(FVector::DotProduct(TargetLocation - SettledFrame.Location, SettledFrame.Rotation.Vector()));
+	TestTrue(FString::Printf(TEXT("Focus on the target at %.1fcm, %.1fcm deep"), CineCamera->FocusSettings.ManualFocusDistance, TargetDepth),
+		FMath::IsNearlyEqual(CineCamera->FocusSettings.ManualFocusDistance, TargetDepth, 5.f));
+
+	// a pane halfway there that the focus traces hit and penetration avoidance doesn't, so the camera stays put
+	constexpr double PaneThickness = 5.0;
+	const FVector PaneLocation = FMath::Lerp(SettledFrame.Location, TargetLocation, 0.5);
+	AStaticMeshActor* const Pane = Rig.AddBox(FTransform(SettledFrame.Rotation, PaneLocation, FVector(PaneThickness / 100.0, 3.0, 3.0)));
+	Pane->GetStaticMeshComponent()->SetCollisionResponseToChannel(ECC_Camera, ECR_Ignore);
+	const float PaneDepth = float(FVector::DotProduct(PaneLocation - SettledFrame.Location, SettledFrame.Rotation.Vector()) - 0.5 * PaneThickness);
+
+	int32 SettledAfterFrames = INDEX_NONE;
+	for (int32 Frame = 0; Frame < NumSettleFrames && SettledAfterFrames == INDEX_NONE; ++Frame)
+	{
+		Rig.Step(DeltaTime);
+		if (FMath::IsNearlyEqual(CineCamera->FocusSettings.ManualFocusDistance, PaneDepth, 5.f))
+		{
+			SettledAfterFrames = Frame + 1;
+		}
+	}
+	TestTrue(FString::Printf(TEXT("Focus moves to the blocker at %.1fcm within %d frames, at %.1fcm"), PaneDepth, NumSettleFrames, CineCamera->FocusSettings.ManualFocusDistance),
+		SettledAfterFrames != INDEX_NONE);
+	TestTrue(TEXT("The camera didn't move in front of the blocker"), Rig.GetFrames().Last().Location.Equals(SettledFrame.Location, 1.0));
+	AddInfo(FString::Printf(TEXT("Focus settled on the blocker after %d frames"), SettledAfterFrames));
+
+	CameraMode->ResetToDefaultSettings();
+	TestFalse(TEXT("Resetting to the default settings turns autofocus back off"), UseAutofocusProperty->GetPropertyValue_InContainer(CameraMode));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigHitchInvarianceTest, "SP.Camera.Rig.HitchInvariance",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigHitchInvarianceTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumCheckpoints = 5;
+
+	// where the camera is on each whole second, running the same path at a steady 60Hz or at an erratic frame rate with hitches
+	auto RunPath = [this](TFunctionRef<float(double Time)> NextDeltaTime, TArray<FSPCameraRigFrame>& OutCheckpoints)
+	{
+		FSPCameraRigHarness Rig;
+		if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+		{
+			return false;
+		}
+
+		AActor* const Target = Rig.AddViewTarget(&SPCameraRigTest::CirclePath);
+		Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+		for (int32 Checkpoint = 1; Checkpoint <= NumCheckpoints; ++Checkpoint)
+		{
+			Rig.RunFor(1.0, [&Rig, &NextDeltaTime]() { return NextDeltaTime(Rig.GetTime()); });
+			OutCheckpoints.Add(Rig.GetFrames().Last());
+		}
+		return true;
+	};
+
+	TArray<FSPCameraRigFrame> Steady;
+	if (!RunPath([](double Time) { return 1.f / 60.f; }, Steady))
+	{
+		return false;
+	}
+
+	FRandomStream Random(42);
+	bool bHitchedShort = false, bHitchedLong = false;
+	TArray<FSPCameraRigFrame> Hitchy;
+	const bool bRanHitchy = RunPath([&Random, &bHitchedShort, &bHitchedLong](double Time)
+	{
+		if (!bHitchedShort && Time >= 1.5)
+		{
+			bHitchedShort = true;
+			return 0.1f;
+		}
+		if (!bHitchedLong && Time >= 3.5)
+		{
+			bHitchedLong = true;
+			return 0.25f;
+		}
+		return Random.FRandRange(1.f / 90.f, 1.f / 30.f);
+	}, Hitchy);
+	if (!bRanHitchy)
+	{
+		return false;
+	}
+
+	for (int32 Checkpoint = 0; Checkpoint < NumCheckpoints; ++Checkpoint)
+	{
+		const FSPCameraRigFrame& Expected = Steady[Checkpoint];
+		const FSPCameraRigFrame& Actual = Hitchy[Checkpoint];
+		const double LocationError = FVector::Dist(Expected.Location, Actual.Location);
+		const double RotationError = (Expected.Rotation - Actual.Rotation).GetNormalized().Euler().GetAbsMax();
+
+		// right after the long hitch the substeps haven't caught every interpolator up yet
+		const double MaxRotationError = Expected.Time > 3.5 && Expected.Time < 4.5 ? 1.0 : 0.5;
+		TestTrue(FString::Printf(TEXT("Camera location at %.0fs doesn't depend on frame rate, %.2fcm off"), Expected.Time, LocationError), LocationError < 5.0);
+		TestTrue(FString::Printf(TEXT("Camera rotation at %.0fs doesn't depend on frame rate, %.2f deg off"), Expected.Time, RotationError), RotationError < MaxRotationError);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigBlendTest, "SP.Camera.Rig.Blend",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigBlendTest::RunTest(const FString& Parameters)
+{
+	FSPCameraRigHarness Rig;
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+	{
+		return false;
+	}
+
+	// two cameras facing nearly opposite ways across the +-180 yaw seam
+	const FTransform TransformA(FRotator(0.0, 170.0, 0.0), FVector(0.0, 0.0, 100.0));
+	const FTransform TransformB(FRotator(0.0, -170.0, 0.0), FVector(500.0, 0.0, 100.0));
+	AActor* const TargetA = Rig.AddViewTarget([TransformA](double) { return TransformA; }, true);
+	AActor* const TargetB = Rig.AddViewTarget([TransformB](double) { return TransformB; }, true);
+
+	Rig.SetViewTarget(TargetA, USPCam_AttachedCamera::StaticClass());
+	Rig.RunFor(1.0, 1.f / 60.f);
+
+	const int32 FirstBlendFrame = Rig.GetFrames().Num();
+	USPCameraMode* const ModeB = Rig.SetViewTarget(TargetB, USPCam_AttachedCamera::StaticClass());
+	ModeB->TransitionInTime = 0.5f;
+	Rig.RunFor(1.0, 1.f / 60.f);
+
+	const TArray<FSPCameraRigFrame>& Frames = Rig.GetFrames();
+	float PrevTopWeight = 0.f;
+	double MaxStep = 0.0;
+	for (int32 FrameIdx = FirstBlendFrame; FrameIdx < Frames.Num(); ++FrameIdx)
+	{
+		const FSPCameraRigFrame& Frame = Frames[FrameIdx];
+		if (!TestTrue(TEXT("Something in the blend stack"), Frame.BlendWeights.Num() > 0))
+		{
+			return false;
+		}
+
+		float TotalWeight = 0.f;
+		for (const float Weight : Frame.BlendWeights)
+		{
+			TotalWeight += Weight;
+		}
+		TestEqual(FString::Printf(TEXT("Blend weights add up to 1 at %.2fs"), Frame.Time), TotalWeight, 1.f, 1.e-3f);
+		TestTrue(FString::Printf(TEXT("Incoming camera only gains weight at %.2fs"), Frame.Time), Frame.BlendWeights[0] >= PrevTopWeight - UE_KINDA_SMALL_NUMBER);
+		PrevTopWeight = Frame.BlendWeights[0];
+
+		// blending 170 to -170 should go through 180, not all the way round through 0
+		TestTrue(FString::Printf(TEXT("Blend takes the short way round at %.2fs, yaw %.1f"), Frame.Time, Frame.Rotation.Yaw), FMath::Abs(FRotator::NormalizeAxis(Frame.Rotation.Yaw)) >= 169.5);
+
+		MaxStep = FMath::Max(MaxStep, FVector::Dist(Frame.Location, Frames[FrameIdx - 1].Location));
+	}
+
+	TestTrue(FString::Printf(TEXT("Blend doesn't jump, largest step %.1fcm"), MaxStep), MaxStep < 60.0);
+	TestEqual(TEXT("Outgoing camera leaves the blend stack once blended out"), Frames.Last().BlendWeights.Num(), 1);
+	TestTrue(TEXT("Blend ends on the new camera"), Frames.Last().Location.Equals(TransformB.GetLocation(), 1.0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigPenetrationTest, "SP.Camera.Rig.Penetration",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigPenetrationTest::RunTest(const FString& Parameters)
+{
+	FSPCameraRigHarness Rig;
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+	{
+		return false;
+	}
+
+	// walks sideways past a wall standing between the target and the camera behind it
+	AActor* const Target = Rig.AddViewTarget([](double Time)
+	{
+		return FTransform(FVector(0.0, -800.0 + 400.0 * Time, 100.0));
+	});
+	Rig.AddBox(FTransform(FRotator::ZeroRotator, FVector(-250.0, 0.0, 200.0), FVector(1.0, 2.0, 4.0)));
+
+	Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+	Rig.RunFor(4.0, 1.f / 60.f);
+
+	float MinBlockedPct = 1.f;
+	for (const FSPCameraRigFrame& Frame : Rig.GetFrames())
+	{
+		MinBlockedPct = FMath::Min(MinBlockedPct, Frame.DistBlockedPct);
+	}
+
+	TestTrue(FString::Printf(TEXT("Camera pulls in passing the wall, %.2f of the way out"), MinBlockedPct), MinBlockedPct < 0.9f);
+	TestEqual(TEXT("Camera is all the way back out past the wall"), Rig.GetFrames().Last().DistBlockedPct, 1.f, 1.e-3f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigPredictiveCollisionTest, "SP.Camera.Rig.PredictiveCollision",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigPredictiveCollisionTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* const PredictiveCollisionCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SP.Camera.PredictiveCollision"));
+	if (!TestNotNull(TEXT("SP.Camera.PredictiveCollision"), PredictiveCollisionCVar))
+	{
+		return false;
+	}
+	const int32 SavedPredictiveCollision = PredictiveCollisionCVar->GetInt();
+	ON_SCOPE_EXIT
+	{
+		PredictiveCollisionCVar->Set(SavedPredictiveCollision);
+	};
+
+	// drone speed sideways past a row of pillars standing between the target and the camera behind it
+	auto TargetLocation = [](double Time)
+	{
+		return FVector(0.0, -2000.0 + 1500.0 * Time, 100.0);
+	};
+
+	// a boom moving more than 10 m/s is a pop, the penetration blends move it a couple of metres a second
+	constexpr double SnapSpeed = 1000.0;
+
+	auto RunPath = [this, PredictiveCollisionCVar, &TargetLocation](int32 PredictiveCollision, SPCameraRigTest::FSnapStats& OutStats)
+	{
+		PredictiveCollisionCVar->Set(PredictiveCollision);
+
+		FSPCameraRigHarness Rig;
+		if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()))
+		{
+			return false;
+		}
+
+		AActor* const Target = Rig.AddViewTarget([&TargetLocation](double Time) { return FTransform(TargetLocation(Time)); });
+		for (int32 PillarIdx = 0; PillarIdx < 5; ++PillarIdx)
+		{
+			Rig.AddBox(FTransform(FRotator::ZeroRotator, FVector(-200.0, -1200.0 + 600.0 * PillarIdx, 200.0), FVector(0.6, 0.6, 4.0)));
+		}
+
+		// predictive collision is off by default, the cvar decides between the two runs
+		USPCameraMode* const CameraMode = Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+		if (FBoolProperty* const PredictiveCollisionProperty = FindFProperty<FBoolProperty>(USPCam_ThirdPerson::StaticClass(), TEXT("bDoPredictiveCollision")))
+		{
+			PredictiveCollisionProperty->SetPropertyValue_InContainer(CameraMode, true);
+		}
+		Rig.RunFor(2.6, 1.f / 60.f);
+
+		// the first frames have the camera catching up from the origin
+		TArray<FSPCameraRigFrame> Frames = Rig.GetFrames();
+		Frames.RemoveAll([](const FSPCameraRigFrame& Frame) { return Frame.Time < 0.25; });
+		OutStats = SPCameraRigTest::MeasureSnaps(Frames, TargetLocation, SnapSpeed);
+		return TestTrue(TEXT("Pillars get in the way"), Frames.ContainsByPredicate([](const FSPCameraRigFrame& Frame) { return Frame.DistBlockedPct < 0.9f; }));
+	};
+
+	SPCameraRigTest::FSnapStats Reactive, Predictive;
+	if (!RunPath(0, Reactive) || !RunPath(1, Predictive))
+	{
+		return false;
+	}
+
+	AddInfo(FString::Printf(TEXT("Reactive: %d snaps, largest %.1fcm. Predictive: %d snaps, largest %.1fcm."), Reactive.NumSnaps, Reactive.MaxSnap, Predictive.NumSnaps, Predictive.MaxSnap));
+	TestTrue(TEXT("Predictive collision snaps no more often"), Predictive.NumSnaps <= Reactive.NumSnaps);
+	TestTrue(TEXT("Predictive collision snaps less far"), Predictive.MaxSnap < Reactive.MaxSnap);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraRigPredictiveCollisionHeadOnTest, "SP.Camera.Rig.PredictiveCollisionHeadOn",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraRigPredictiveCollisionHeadOnTest::RunTest(const FString& Parameters)
+{
+	FSPCameraRigHarness Rig;
+	FBoolProperty* const PredictiveCollisionProperty = FindFProperty<FBoolProperty>(USPCam_ThirdPerson::StaticClass(), TEXT("bDoPredictiveCollision"));
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()) || !TestNotNull(TEXT("bDoPredictiveCollision property"), PredictiveCollisionProperty))
+	{
+		return false;
+	}
+
+	// straight at a wall and stopping 3 m short, the predicted safe locations end up inside it while the camera line behind stays clear
+	auto TargetLocation = [](double Time)
+	{
+		return FVector(FMath::Min(1500.0 * Time, 1000.0), 0.0, 100.0);
+	};
+	AActor* const Target = Rig.AddViewTarget([&TargetLocation](double Time) { return FTransform(TargetLocation(Time)); });
+	Rig.AddBox(FTransform(FRotator::ZeroRotator, FVector(1400.0, 0.0, 200.0), FVector(2.0, 10.0, 10.0)));
+
+	USPCameraMode* const CameraMode = Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+	PredictiveCollisionProperty->SetPropertyValue_InContainer(CameraMode, true);
+	Rig.RunFor(1.5, 1.f / 60.f);
+
+	float MinBlockedPct = 1.f;
+	for (const FSPCameraRigFrame& Frame : Rig.GetFrames())
+	{
+		MinBlockedPct = Frame.Time >= 0.25 ? FMath::Min(MinBlockedPct, Frame.DistBlockedPct) : MinBlockedPct;
+	}
+	TestEqual(TEXT("A wall ahead of the view target doesn't pull the camera in behind it"), MinBlockedPct, 1.f, 1.e-3f);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraShakeBatch.h"
+#include "Camera/CameraShakeBase.h"
+#include "Camera/CameraTypes.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "WaveOscillatorCameraShakePattern.h"
+
+// Plays looping wave oscillator shakes both as regular camera shakes and through a shake batch, and compares the two
+
+namespace SPCameraShakeBatchTest
+{
+	/** A walk cycle like handheld shake, with zero initial offsets so both ways of playing it start in step */
+	static UWaveOscillatorCameraShakePattern* MakePattern(float FrequencyScale)
+	{
+		UWaveOscillatorCameraShakePattern* const Pattern = NewObject<UWaveOscillatorCameraShakePattern>(GetTransientPackage());
+		Pattern->Duration = 0.f;
+		Pattern->BlendInTime = 0.f;
+		Pattern->BlendOutTime = 0.f;
+
+		FWaveOscillator* const Oscillators[] = { &Pattern->X, &Pattern->Y, &Pattern->Z, &Pattern->Pitch, &Pattern->Yaw, &Pattern->Roll, &Pattern->FOV };
+		for (int32 Idx = 0; Idx < UE_ARRAY_COUNT(Oscillators); ++Idx)
+		{
+			Oscillators[Idx]->Amplitude = 0.5f + 0.25f * Idx;
+			Oscillators[Idx]->Frequency = FrequencyScale * (1.f + 0.3f * Idx);
+			Oscillators[Idx]->InitialOffsetType = EInitialWaveOscillatorOffsetType::Zero;
+		}
+		return Pattern;
+	}
+
+	/** The same pattern played the regular way, one camera shake object evaluating it */
+	static UCameraShakeBase* MakeShake(UWaveOscillatorCameraShakePattern* Pattern)
+	{
+		UCameraShakeBase* const Shake = NewObject<UCameraShakeBase>(GetTransientPackage());
+		Shake->SetRootShakePattern(DuplicateObject(Pattern, Shake));
+		Shake->StartShake(nullptr, 1.f, ECameraShakePlaySpace::CameraLocal);
+		return Shake;
+	}
+
+	static FMinimalViewInfo MakePOV()
+	{
+		FMinimalViewInfo POV;
+		POV.Location = FVector(100.0, -200.0, 150.0);
+		POV.Rotation = FRotator(-15.0, 60.0, 0.0);
+		POV.FOV = 90.f;
+		return POV;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraShakeBatchTest, "SP.Camera.ShakeBatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraShakeBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraShakeBatchTest;
+
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	UWaveOscillatorCameraShakePattern* const Pattern = MakePattern(1.f);
+	UCameraShakeBase* const Shake = MakeShake(Pattern);
+
+	FSPCameraShakeBatch Batch;
+	const int32 Handle = Batch.Start(Pattern);
+	Batch.SetWeight(Handle, 0.7f);
+
+	// a single shake moves the camera the same either way
+	bool bMatches = true;
+	for (int32 Frame = 0; Frame < 600 && bMatches; ++Frame)
+	{
+		FMinimalViewInfo ShakePOV = MakePOV();
+		Shake->UpdateAndApplyCameraShake(DeltaTime, 0.7f, ShakePOV);
+
+		FMinimalViewInfo BatchPOV = MakePOV();
+		Batch.Apply(DeltaTime, BatchPOV);
+
+		bMatches = ShakePOV.Location.Equals(BatchPOV.Location, 0.01) && ShakePOV.Rotation.Equals(BatchPOV.Rotation, 0.01) && FMath::IsNearlyEqual(ShakePOV.FOV, BatchPOV.FOV, 0.01f);
+		if (!bMatches)
+		{
+			AddError(FString::Printf(TEXT("Frame %d: camera shake %s %s %.3f, batch %s %s %.3f"), Frame,
+				*ShakePOV.Location.ToString(), *ShakePOV.Rotation.ToString(), ShakePOV.FOV, *BatchPOV.Location.ToString(), *BatchPOV.Rotation.ToString(), BatchPOV.FOV));
+		}
+	}
+
+	// only sine waves can be batched, noise plays as a regular camera shake
+	TestTrue(TEXT("A looping sine wave pattern is batchable"), FSPCameraShakeBatch::IsBatchable(Pattern));
+	UWaveOscillatorCameraShakePattern* const NoisePattern = MakePattern(1.f);
+	NoisePattern->Yaw.Waveform = EOscillatorWaveform::PerlinNoise;
+	TestFalse(TEXT("A pattern with a Perlin noise oscillator isn't batchable"), FSPCameraShakeBatch::IsBatchable(NoisePattern));
+	NoisePattern->Yaw.Amplitude = 0.f;
+	TestTrue(TEXT("Unless that oscillator is silent"), FSPCameraShakeBatch::IsBatchable(NoisePattern));
+
+	// shakes too faint to see hold still
+	Batch.SetWeight(Handle, 0.001f);
+	FMinimalViewInfo SuspendedPOV = MakePOV();
+	Batch.Apply(DeltaTime, SuspendedPOV);
+	TestEqual(TEXT("A faint shake is suspended"), Batch.GetNumSuspended(), 1);
+	TestTrue(TEXT("A suspended shake leaves the camera alone"), SuspendedPOV.Location.Equals(MakePOV().Location) && SuspendedPOV.FOV == MakePOV().FOV);
+
+	// modes switching back and forth reuse the shakes they stopped
+	Batch.Stop(Handle, true);
+	TestEqual(TEXT("Stopping immediately ends the shake"), Batch.GetNumActive(), 0);
+	for (int32 Switch = 0; Switch < 50; ++Switch)
+	{
+		Batch.Stop(Batch.Start(Pattern), true);
+	}
+	TestEqual(TEXT("Restarting a stopped shake creates nothing"), Batch.GetNumCreated(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraShakeBatchBenchmark, "SP.Camera.ShakeBatchBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraShakeBatchBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraShakeBatchTest;
+
+	// a blend stack of modes each playing their own ambient shake, the oldest ones nearly blended out
+	constexpr int32 NumFrames = 20000;
+	constexpr float DeltaTime = 1.f / 60.f;
+	const float BlendWeights[] = { 0.45f, 0.25f, 0.15f, 0.1f, 0.03f, 0.008f, 0.005f, 0.002f };
+	constexpr int32 NumModes = UE_ARRAY_COUNT(BlendWeights);
+
+	TArray<UCameraShakeBase*> Shakes;
+	FSPCameraShakeBatch Batch;
+	for (int32 ModeIdx = 0; ModeIdx < NumModes; ++ModeIdx)
+	{
+		UWaveOscillatorCameraShakePattern* const Pattern = MakePattern(1.f + 0.1f * ModeIdx);
+		Shakes.Add(MakeShake(Pattern));
+		Batch.SetWeight(Batch.Start(Pattern), BlendWeights[ModeIdx]);
+	}
+
+	// the summed FOVs keep the optimizer from dropping the loops
+	double StartTime = FPlatformTime::Seconds();
+	double ShakeFOVs = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		FMinimalViewInfo POV = MakePOV();
+		for (int32 ModeIdx = 0; ModeIdx < NumModes; ++ModeIdx)
+		{
+			Shakes[ModeIdx]->UpdateAndApplyCameraShake(DeltaTime, BlendWeights[ModeIdx], POV);
+		}
+		ShakeFOVs += POV.FOV;
+	}
+	const double ShakeMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	double BatchFOVs = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		FMinimalViewInfo POV = MakePOV();
+		Batch.Apply(DeltaTime, POV);
+		BatchFOVs += POV.FOV;
+	}
+	const double BatchMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(TEXT("%d frames of %d blended shakes: camera shakes %.3f ms, batch %.3f ms with %d suspended (FOV sums %.1f, %.1f)"),
+		NumFrames, NumModes, ShakeMilliseconds, BatchMilliseconds, Batch.GetNumSuspended(), ShakeFOVs, BatchFOVs));
+	TestEqual(TEXT("Shakes under SP.Camera.ShakeLODThreshold are suspended"), Batch.GetNumSuspended(), 3);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraRigHarness.h"
+#include "SPCam_ThirdPerson.h"
+#include "SPCameraMode.h"
+#include "SPPlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+// Times the camera manager while third person modes on several view targets blend into each other
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraStackBenchmark, "SP.Camera.StackBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraStackBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.f / 60.f;
+	constexpr int32 NumTargets = 6;
+	constexpr int32 FramesPerSwitch = 8;
+	constexpr int32 NumWarmupFrames = 120;
+	constexpr int32 NumFrames = 1200;
+
+	FSPCameraRigHarness Rig;
+	IConsoleVariable* const ParallelUpdateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SP.Camera.ParallelUpdate"));
+	IConsoleVariable* const OutgoingUpdateIntervalCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("SP.Camera.OutgoingUpdateInterval"));
+	if (!TestTrue(TEXT("Rig set up"), Rig.IsReady()) || !TestNotNull(TEXT("Camera cvars"), ParallelUpdateCVar) || !TestNotNull(TEXT("Camera cvars"), OutgoingUpdateIntervalCVar))
+	{
+		return false;
+	}
+
+	const int32 SavedParallelUpdate = ParallelUpdateCVar->GetInt();
+	const int32 SavedOutgoingUpdateInterval = OutgoingUpdateIntervalCVar->GetInt();
+	ON_SCOPE_EXIT
+	{
+		ParallelUpdateCVar->Set(SavedParallelUpdate, ECVF_SetByCode);
+		OutgoingUpdateIntervalCVar->Set(SavedOutgoingUpdateInterval, ECVF_SetByCode);
+	};
+
+	// every view target gets a third person camera, which traces for penetration against the floor and the pillars
+	Rig.AddBox(FTransform(FRotator::ZeroRotator, FVector(0.0, 0.0, -50.0), FVector(60.0, 60.0, 1.0)));
+
+	TArray<AActor*> Targets;
+	for (int32 TargetIdx = 0; TargetIdx < NumTargets; ++TargetIdx)
+	{
+		const float StartYaw = 360.f * TargetIdx / NumTargets;
+		Rig.AddBox(FTransform(FRotator::ZeroRotator, FRotator(0.f, StartYaw, 0.f).RotateVector(FVector(1300.0, 0.0, 200.0)), FVector(1.0, 1.0, 4.0)));
+
+		// circling the middle at 12 degrees a second
+		AActor* const Target = Rig.AddViewTarget([StartYaw](double Time)
+		{
+			const FRotator Around(0.f, StartYaw + float(Time) * 12.f, 0.f);
+			return FTransform(Around, Around.RotateVector(FVector(1000.0, 0.0, 100.0)));
+		});
+		Targets.Add(Target);
+
+		// long blends so outgoing cameras pile up in the stack. The stock third person camera only reads the snapshot, it can run in parallel
+		USPCameraMode* const CameraMode = Rig.SetViewTarget(Target, USPCam_ThirdPerson::StaticClass());
+		CameraMode->TransitionInTime = 1.f;
+		CastChecked<USPCam_ThirdPerson>(CameraMode)->SetAllowParallelUpdate(true);
+	}
+
+	ASPPlayerCameraManager* const CameraManager = Rig.GetCameraManager();
+	int32 Frame = 0;
+	auto RunFrames = [&](int32 NumFramesToRun, int32& OutStackDepthSum)
+	{
+		OutStackDepthSum = 0;
+		for (int32 Step = 0; Step < NumFramesToRun; ++Step, ++Frame)
+		{
+			Rig.SetViewTarget(Targets[(Frame / FramesPerSwitch) % Targets.Num()], USPCam_ThirdPerson::StaticClass());
+			Rig.Step(DeltaTime);
+			OutStackDepthSum += CameraManager->GetNumCamerasInBlendStack();
+		}
+	};
+
+	struct FConfig
+	{
+		const TCHAR* Name;
+		int32 ParallelUpdate;
+		int32 OutgoingUpdateInterval;
+	};
+	const FConfig Configs[] =
+	{
+		{ TEXT("serial"), 0, 1 },
+		{ TEXT("parallel"), 1, 1 },
+		{ TEXT("parallel, low weight outgoing every 4th frame"), 1, 4 },
+	};
+
+	for (const FConfig& Config : Configs)
+	{
+		ParallelUpdateCVar->Set(Config.ParallelUpdate, ECVF_SetByCode);
+		OutgoingUpdateIntervalCVar->Set(Config.OutgoingUpdateInterval, ECVF_SetByCode);
+
+		int32 StackDepthSum = 0;
+		RunFrames(NumWarmupFrames, StackDepthSum);
+
+		// the rig times UpdateViewTarget alone, moving the view targets isn't the camera's cost
+		const double StartTime = Rig.GetTime();
+		RunFrames(NumFrames, StackDepthSum);
+		const double Microseconds = Rig.GetAverageCostSeconds(StartTime + 0.5 * DeltaTime) * 1000000.0;
+
+		const float AverageStackDepth = float(StackDepthSum) / NumFrames;
+		AddInfo(FString::Printf(TEXT("%s: %.2f us per frame, %.2f cameras in the stack on average"), Config.Name, Microseconds, AverageStackDepth));
+
+		TestTrue(FString::Printf(TEXT("%s: several cameras blending"), Config.Name), AverageStackDepth > 3.f);
+		const FSPCameraRigFrame& LastFrame = Rig.GetFrames().Last();
+		TestFalse(FString::Printf(TEXT("%s: camera ends up somewhere sensible"), Config.Name), LastFrame.Location.ContainsNaN() || LastFrame.Rotation.ContainsNaN());
+	}
+
+	return true;
+}
+
+#endif
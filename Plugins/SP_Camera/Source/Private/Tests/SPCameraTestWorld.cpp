@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraTestWorld.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+FSPCameraScopedTestWorld::FSPCameraScopedTestWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+}
+
+FSPCameraScopedTestWorld::~FSPCameraScopedTestWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+#endif
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/** A throwaway game world with its own world context, so the engine treats it like the game's. Destroyed along with the context when it goes out of scope. */
+class FSPCameraScopedTestWorld
+{
+public:
+	FSPCameraScopedTestWorld();
+	~FSPCameraScopedTestWorld();
+
+	FSPCameraScopedTestWorld(const FSPCameraScopedTestWorld&) = delete;
+	FSPCameraScopedTestWorld& operator=(const FSPCameraScopedTestWorld&) = delete;
+
+	UWorld* GetWorld() const { return World; }
+
+private:
+	UWorld* World = nullptr;
+};
+
+#endif
@@ -0,0 +1,400 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SPCameraViewBlend.h"
+#include "Camera/CameraTypes.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UnrealType.h"
+
+// Blends camera stacks with the masked view blend and with the whole view info blend the camera manager used before it, and compares the two
+
+namespace SPCameraViewBlendTest
+{
+	/** The camera manager's blend before post process masks: whole view infos, f-stop and focal distance blended by hand */
+	static void BlendWholeViews(TConstArrayView<const FMinimalViewInfo*> POVs, TConstArrayView<float> Weights, FMinimalViewInfo& OutPOV)
+	{
+		const FMinimalViewInfo& TopPOV = *POVs[0];
+		FMinimalViewInfo BlendedPOV = TopPOV;
+		BlendedPOV.ApplyBlendWeight(Weights[0]);
+
+		float SkippedFocalDistWeight = 0.f;
+
+		BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFstop |= TopPOV.PostProcessSettings.bOverride_DepthOfFieldFstop;
+		const float TopFStop = TopPOV.PostProcessSettings.bOverride_DepthOfFieldFstop ? TopPOV.PostProcessSettings.DepthOfFieldFstop : 22.f;
+		BlendedPOV.PostProcessSettings.DepthOfFieldFstop = TopFStop * Weights[0];
+
+		if (TopPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
+		{
+			BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance = true;
+			BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance = TopPOV.PostProcessSettings.DepthOfFieldFocalDistance * Weights[0];
+		}
+		else
+		{
+			SkippedFocalDistWeight += Weights[0];
+			BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance = 0.f;
+		}
+
+		for (int32 StackIdx = 1; StackIdx < POVs.Num(); ++StackIdx)
+		{
+			const FMinimalViewInfo& CamPOV = *POVs[StackIdx];
+			BlendedPOV.AddWeightedViewInfo(CamPOV, Weights[StackIdx]);
+
+			BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFstop |= CamPOV.PostProcessSettings.bOverride_DepthOfFieldFstop;
+			const float FStop = CamPOV.PostProcessSettings.bOverride_DepthOfFieldFstop ? CamPOV.PostProcessSettings.DepthOfFieldFstop : 8.f;
+			BlendedPOV.PostProcessSettings.DepthOfFieldFstop += FStop * Weights[StackIdx];
+
+			if (CamPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
+			{
+				BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance = true;
+				BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance += CamPOV.PostProcessSettings.DepthOfFieldFocalDistance * Weights[StackIdx];
+			}
+			else
+			{
+				SkippedFocalDistWeight += Weights[StackIdx];
+			}
+		}
+
+		if (BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
+		{
+			BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance /= (1.f - SkippedFocalDistWeight);
+		}
+
+		OutPOV = BlendedPOV;
+	}
+
+	/** A cine cam mode's view, as UCineCameraComponent::GetCameraView fills it in */
+	static FMinimalViewInfo MakePOV(int32 Seed, bool bOverrideFstop, bool bOverrideFocalDistance)
+	{
+		FMinimalViewInfo POV;
+		POV.Location = FVector(100.0 * Seed, -50.0 * Seed, 200.0 + 10.0 * Seed);
+		POV.Rotation = FRotator(-10.0 - Seed, 30.0 * Seed, 0.0);
+		POV.FOV = 60.f + 5.f * Seed;
+		POV.DesiredFOV = POV.FOV + 1.f;
+		POV.AspectRatio = 1.777f + 0.1f * Seed;
+		POV.OrthoWidth = 512.f + 100.f * Seed;
+		POV.OrthoNearClipPlane = 1.f + Seed;
+		POV.OrthoFarClipPlane = 10000.f + 1000.f * Seed;
+		POV.PerspectiveNearClipPlane = 10.f + Seed;
+		POV.PostProcessBlendWeight = 0.5f + 0.1f * Seed;
+		POV.OffCenterProjectionOffset = FVector2D(0.01 * Seed, -0.02 * Seed);
+		POV.bConstrainAspectRatio = Seed == 1;
+		POV.PostProcessSettings.bOverride_DepthOfFieldFstop = bOverrideFstop;
+		POV.PostProcessSettings.DepthOfFieldFstop = 2.8f + Seed;
+		POV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance = bOverrideFocalDistance;
+		POV.PostProcessSettings.DepthOfFieldFocalDistance = 300.f + 100.f * Seed;
+		POV.PostProcessSettings.bOverride_DepthOfFieldSensorWidth = true;
+		POV.PostProcessSettings.DepthOfFieldSensorWidth = 24.f + Seed;
+		return POV;
+	}
+
+	/** Floating point fields, and structs of them, match up to rounding. The masked blend sums them in the same order as the engine, but not in the same code */
+	static bool AreFieldsNearlyIdentical(const FProperty* Property, const void* A, const void* B)
+	{
+		const FNumericProperty* const NumericProperty = CastField<FNumericProperty>(Property);
+		if (NumericProperty && NumericProperty->IsFloatingPoint())
+		{
+			const double ValueA = NumericProperty->GetFloatingPointPropertyValue(A);
+			const double ValueB = NumericProperty->GetFloatingPointPropertyValue(B);
+			return FMath::IsNearlyEqual(ValueA, ValueB, 1e-4 * FMath::Max(1.0, FMath::Abs(ValueA)));
+		}
+
+		if (const FStructProperty* const StructProperty = CastField<FStructProperty>(Property))
+		{
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+				{
+					if (!AreFieldsNearlyIdentical(*It, It->ContainerPtrToValuePtr<void>(A, Index), It->ContainerPtrToValuePtr<void>(B, Index)))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		return Property->Identical(A, B);
+	}
+
+	static bool IsViewFieldNearlyIdentical(const FProperty* Property, const FMinimalViewInfo& A, const FMinimalViewInfo& B)
+	{
+		for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+		{
+			if (!AreFieldsNearlyIdentical(Property, Property->ContainerPtrToValuePtr<void>(&A, Index), Property->ContainerPtrToValuePtr<void>(&B, Index)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Every view field but the post process settings that differs between two views, empty if they match */
+	static FString DescribeViewDifferences(const FMinimalViewInfo& A, const FMinimalViewInfo& B)
+	{
+		FString Differences;
+		const UScriptStruct* const ViewStruct = FMinimalViewInfo::StaticStruct();
+		for (TFieldIterator<FProperty> It(ViewStruct); It; ++It)
+		{
+			if (It->GetFName() != GET_MEMBER_NAME_CHECKED(FMinimalViewInfo, PostProcessSettings) && !IsViewFieldNearlyIdentical(*It, A, B))
+			{
+				Differences += It->GetName() + TEXT(" ");
+			}
+		}
+
+		// not a property, the iterator doesn't see it
+		if (ViewStruct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FMinimalViewInfo, OffCenterProjectionOffset)) == nullptr && !A.OffCenterProjectionOffset.Equals(B.OffCenterProjectionOffset, 1e-4))
+		{
+			Differences += TEXT("OffCenterProjectionOffset ");
+		}
+		return Differences;
+	}
+
+	/** Gives a view field a value that depends on Seed. False for types the test doesn't know how to vary */
+	static bool SetFieldValue(const FProperty* Property, void* Value, int32 Seed)
+	{
+		if (const FBoolProperty* const BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			// only the first outgoing view sets it, telling apart fields that are or'ed from ones staying the incoming view's
+			BoolProperty->SetPropertyValue(Value, Seed == 1);
+			return true;
+		}
+
+		if (const FEnumProperty* const EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			const UEnum* const Enum = EnumProperty->GetEnum();
+			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, Enum->GetValueByIndex(Seed % FMath::Max(Enum->NumEnums() - 1, 1)));
+			return true;
+		}
+
+		if (const FNumericProperty* const NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->IsFloatingPoint())
+			{
+				NumericProperty->SetFloatingPointPropertyValue(Value, 0.5 + 1.25 * Seed);
+			}
+			else if (const UEnum* const Enum = NumericProperty->GetIntPropertyEnum())
+			{
+				NumericProperty->SetIntPropertyValue(Value, Enum->GetValueByIndex(Seed % FMath::Max(Enum->NumEnums() - 1, 1)));
+			}
+			else
+			{
+				NumericProperty->SetIntPropertyValue(Value, int64(Seed + 1));
+			}
+			return true;
+		}
+
+		if (const FStructProperty* const StructProperty = CastField<FStructProperty>(Property))
+		{
+			// vectors, rotators and the like, every member varied a little differently
+			int32 NumMembers = 0;
+			for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+			{
+				for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+				{
+					if (!SetFieldValue(*It, It->ContainerPtrToValuePtr<void>(Value, Index), Seed + 3 * NumMembers++))
+					{
+						return false;
+					}
+				}
+			}
+			return NumMembers > 0;
+		}
+
+		return false;
+	}
+
+	static const TArray<FName>& GetDefaultMaskSettings()
+	{
+		static const TArray<FName> Names = { GET_MEMBER_NAME_CHECKED(FPostProcessSettings, DepthOfFieldFstop), GET_MEMBER_NAME_CHECKED(FPostProcessSettings, DepthOfFieldFocalDistance) };
+		return Names;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraViewBlendTest, "SP.Camera.ViewBlend",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraViewBlendTest::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraViewBlendTest;
+
+	const FSPPostProcessBlendMask DefaultMask = FSPCameraViewBlend::MakePostProcessMask(GetDefaultMaskSettings());
+	TestEqual(TEXT("Settings without a value to weigh aren't blendable"),
+		FSPCameraViewBlend::MakePostProcessMask({ GET_MEMBER_NAME_CHECKED(FPostProcessSettings, AutoExposureMethod), FName(TEXT("NotASetting")) }).CountSetBits(), 0);
+	TestEqual(TEXT("Both depth of field settings are blendable"), DefaultMask.CountSetBits(), 2);
+
+	// with the default masks every mix of overrides blends the way it always has
+	const float Weights[] = { 0.55f, 0.3f, 0.15f };
+	for (int32 Overrides = 0; Overrides < 64; ++Overrides)
+	{
+		const FMinimalViewInfo POVs[] = { MakePOV(0, !!(Overrides & 1), !!(Overrides & 2)), MakePOV(1, !!(Overrides & 4), !!(Overrides & 8)), MakePOV(2, !!(Overrides & 16), !!(Overrides & 32)) };
+
+		FMinimalViewInfo Expected;
+		BlendWholeViews({ &POVs[0], &POVs[1], &POVs[2] }, Weights, Expected);
+
+		FMinimalViewInfo Blended = POVs[0];
+		FSPCameraViewBlend::Blend({ { &POVs[0], &DefaultMask, Weights[0] }, { &POVs[1], &DefaultMask, Weights[1] }, { &POVs[2], &DefaultMask, Weights[2] } }, Blended);
+
+		// the view fields are weighed the way the engine weighs them, they match up to rounding
+		const FString ViewDifferences = DescribeViewDifferences(Blended, Expected);
+		const FPostProcessSettings& ExpectedSettings = Expected.PostProcessSettings;
+		const FPostProcessSettings& BlendedSettings = Blended.PostProcessSettings;
+		const bool bMatches = ViewDifferences.IsEmpty()
+			&& BlendedSettings.bOverride_DepthOfFieldFstop == ExpectedSettings.bOverride_DepthOfFieldFstop
+			&& FMath::IsNearlyEqual(BlendedSettings.DepthOfFieldFstop, ExpectedSettings.DepthOfFieldFstop, 0.001f)
+			&& BlendedSettings.bOverride_DepthOfFieldFocalDistance == ExpectedSettings.bOverride_DepthOfFieldFocalDistance
+			&& (!ExpectedSettings.bOverride_DepthOfFieldFocalDistance || FMath::IsNearlyEqual(BlendedSettings.DepthOfFieldFocalDistance, ExpectedSettings.DepthOfFieldFocalDistance, 0.01f))
+			&& BlendedSettings.DepthOfFieldSensorWidth == ExpectedSettings.DepthOfFieldSensorWidth;
+		if (!bMatches)
+		{
+			AddError(FString::Printf(TEXT("Overrides %d: f/%.3f at %.3f blended, f/%.3f at %.3f before, view fields differing: %s"), Overrides,
+				BlendedSettings.DepthOfFieldFstop, BlendedSettings.DepthOfFieldFocalDistance, ExpectedSettings.DepthOfFieldFstop, ExpectedSettings.DepthOfFieldFocalDistance,
+				ViewDifferences.IsEmpty() ? TEXT("none") : *ViewDifferences));
+		}
+	}
+
+	// settings beyond depth of field blend across the modes overriding them, the rest stay the incoming mode's
+	const FSPPostProcessBlendMask GradingMask = FSPCameraViewBlend::MakePostProcessMask(
+		{ GET_MEMBER_NAME_CHECKED(FPostProcessSettings, BloomIntensity), GET_MEMBER_NAME_CHECKED(FPostProcessSettings, SceneColorTint) });
+	FMinimalViewInfo Incoming = MakePOV(0, true, true);
+	Incoming.PostProcessSettings.bOverride_BloomIntensity = true;
+	Incoming.PostProcessSettings.BloomIntensity = 1.f;
+	Incoming.PostProcessSettings.bOverride_SceneColorTint = true;
+	Incoming.PostProcessSettings.SceneColorTint = FLinearColor(1.f, 0.f, 0.f, 1.f);
+	Incoming.PostProcessSettings.VignetteIntensity = 0.2f;
+	FMinimalViewInfo Outgoing = MakePOV(1, true, true);
+	Outgoing.PostProcessSettings.bOverride_BloomIntensity = true;
+	Outgoing.PostProcessSettings.BloomIntensity = 3.f;
+	Outgoing.PostProcessSettings.bOverride_VignetteIntensity = true;
+	Outgoing.PostProcessSettings.VignetteIntensity = 0.8f;
+	const FMinimalViewInfo NotOverriding = MakePOV(2, true, true);
+
+	FMinimalViewInfo Blended = Incoming;
+	FSPCameraViewBlend::Blend({ { &Incoming, &GradingMask, 0.6f }, { &Outgoing, &GradingMask, 0.2f }, { &NotOverriding, &GradingMask, 0.2f } }, Blended);
+	TestEqual(TEXT("Masked settings blend across the modes overriding them"), Blended.PostProcessSettings.BloomIntensity, 1.5f, 0.001f);
+	TestTrue(TEXT("Masked colors blend too"), Blended.PostProcessSettings.SceneColorTint.Equals(FLinearColor(1.f, 0.f, 0.f, 1.f)));
+	TestEqual(TEXT("Settings outside the masks are the incoming mode's"), Blended.PostProcessSettings.VignetteIntensity, 0.2f);
+	TestFalse(TEXT("Settings outside the masks keep the incoming mode's override flag"), Blended.PostProcessSettings.bOverride_VignetteIntensity != 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraViewBlendFieldsTest, "SP.Camera.ViewBlendFields",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FSPCameraViewBlendFieldsTest::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraViewBlendTest;
+
+	// the masked blend weighs the view fields itself, rather than through copies of the views. Every field the view info has varies on its own here,
+	// so one the engine starts weighing, or a new one, shows up as blending differently from AddWeightedViewInfo
+	const FSPPostProcessBlendMask DefaultMask = FSPCameraViewBlend::MakePostProcessMask(GetDefaultMaskSettings());
+	const float Weights[] = { 0.55f, 0.3f, 0.15f };
+	const FMinimalViewInfo BasePOV = MakePOV(0, true, true);
+
+	int32 NumFields = 0;
+	for (TFieldIterator<FProperty> It(FMinimalViewInfo::StaticStruct()); It; ++It)
+	{
+		if (It->GetFName() == GET_MEMBER_NAME_CHECKED(FMinimalViewInfo, PostProcessSettings))
+		{
+			continue;
+		}
+
+		FMinimalViewInfo POVs[] = { BasePOV, BasePOV, BasePOV };
+		bool bVaried = true;
+		for (int32 StackIdx = 0; StackIdx < UE_ARRAY_COUNT(POVs); ++StackIdx)
+		{
+			for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+			{
+				bVaried &= SetFieldValue(*It, It->ContainerPtrToValuePtr<void>(&POVs[StackIdx], Index), StackIdx);
+			}
+		}
+		if (!bVaried)
+		{
+			AddError(FString::Printf(TEXT("FMinimalViewInfo::%s has a type the test can't vary, so whether the view blend weighs it goes unchecked"), *It->GetName()));
+			continue;
+		}
+
+		FMinimalViewInfo Expected;
+		BlendWholeViews({ &POVs[0], &POVs[1], &POVs[2] }, Weights, Expected);
+
+		FMinimalViewInfo Blended = POVs[0];
+		FSPCameraViewBlend::Blend({ { &POVs[0], &DefaultMask, Weights[0] }, { &POVs[1], &DefaultMask, Weights[1] }, { &POVs[2], &DefaultMask, Weights[2] } }, Blended);
+
+		if (!IsViewFieldNearlyIdentical(*It, Blended, Expected))
+		{
+			AddError(FString::Printf(TEXT("FMinimalViewInfo::%s blends differently from AddWeightedViewInfo, see SPCameraViewBlend::WeighViewFields"), *It->GetName()));
+		}
+		++NumFields;
+	}
+	TestTrue(TEXT("The view info has fields besides the post process settings"), NumFields > 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSPCameraViewBlendBenchmark, "SP.Camera.ViewBlendBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FSPCameraViewBlendBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace SPCameraViewBlendTest;
+
+	// a long transition, four cine cam modes blending at once
+	constexpr int32 NumFrames = 20000;
+	constexpr int32 NumModes = 4;
+	const float Weights[NumModes] = { 0.4f, 0.3f, 0.2f, 0.1f };
+
+	const FSPPostProcessBlendMask DefaultMask = FSPCameraViewBlend::MakePostProcessMask(GetDefaultMaskSettings());
+	TArray<FMinimalViewInfo> POVs;
+	TArray<const FMinimalViewInfo*> POVPtrs;
+	TArray<FSPCameraViewBlendEntry> Entries;
+	POVs.Reserve(NumModes);
+	for (int32 ModeIdx = 0; ModeIdx < NumModes; ++ModeIdx)
+	{
+		POVs.Add(MakePOV(ModeIdx, true, true));
+	}
+	for (int32 ModeIdx = 0; ModeIdx < NumModes; ++ModeIdx)
+	{
+		POVPtrs.Add(&POVs[ModeIdx]);
+		Entries.Add({ &POVs[ModeIdx], &DefaultMask, Weights[ModeIdx] });
+	}
+
+	// the summed f-stops keep the optimizer from dropping the loops
+	FMinimalViewInfo OutPOV;
+	double StartTime = FPlatformTime::Seconds();
+	double WholeViewFStops = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		BlendWholeViews(POVPtrs, Weights, OutPOV);
+		WholeViewFStops += OutPOV.PostProcessSettings.DepthOfFieldFstop;
+	}
+	const double WholeViewMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// the camera manager's OutVT starts out as the incoming mode's view, one copy it keeps as that mode's LastPOV too
+	StartTime = FPlatformTime::Seconds();
+	double MaskedFStops = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		OutPOV = POVs[0];
+		FSPCameraViewBlend::Blend(Entries, OutPOV);
+		MaskedFStops += OutPOV.PostProcessSettings.DepthOfFieldFstop;
+	}
+	const double MaskedMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	// whole view blending copies the incoming view, one view per outgoing mode in AddWeightedViewInfo, and the result.
+	// the masked blend only has that first copy, reads the view fields in place and weighs two post process settings
+	const int32 WholeViewBytesCopied = (NumModes + 1) * static_cast<int32>(sizeof(FMinimalViewInfo));
+	const int32 MaskedBytesCopied = static_cast<int32>(sizeof(FMinimalViewInfo));
+
+	AddInfo(FString::Printf(TEXT("%d frames of %d blending modes: whole views %.3f ms copying %d bytes a frame, masked %.3f ms copying %d bytes a frame (f-stop sums %.1f, %.1f)"),
+		NumFrames, NumModes, WholeViewMilliseconds, WholeViewBytesCopied, MaskedMilliseconds, MaskedBytesCopied, WholeViewFStops, MaskedFStops));
+	TestEqual(TEXT("Both blends agree"), MaskedFStops, WholeViewFStops, NumFrames * 0.001);
+
+	return true;
+}
+
+#endif
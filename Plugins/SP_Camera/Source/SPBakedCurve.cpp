@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SPBakedCurve.h"
+
+#include "Curves/CurveVector.h"
+#include "Math/VectorRegister.h"
+
+void FSPBakedCurveVector::Bake(const UCurveVector* Curve, float MinTime, float MaxTime)
+{
+	Source = Curve;
+	bBaked = (Curve != nullptr);
+	if (!bBaked)
+	{
+		return;
+	}
+
+	float KeyMinTime = 0.f;
+	float KeyMaxTime = 0.f;
+	Curve->GetTimeRange(KeyMinTime, KeyMaxTime);
+	if (KeyMinTime <= KeyMaxTime)
+	{
+		MinTime = FMath::Min(MinTime, KeyMinTime);
+		MaxTime = FMath::Max(MaxTime, KeyMaxTime);
+	}
+
+	StartTime = MinTime;
+	SampleSpacing = FMath::Max(MaxTime - MinTime, UE_KINDA_SMALL_NUMBER) / (NumSamples - 1);
+	InvSampleSpacing = 1.f / SampleSpacing;
+
+	for (int32 SampleIdx = 0; SampleIdx < NumSamples; ++SampleIdx)
+	{
+		const FVector Value = Curve->GetVectorValue(StartTime + SampleIdx * SampleSpacing);
+		Samples[SampleIdx] = FVector4f(FVector3f(Value), 0.f);
+	}
+}
+
+void FSPBakedCurveVector::Reset()
+{
+	Source = nullptr;
+	bBaked = false;
+}
+
+FVector FSPBakedCurveVector::Eval(float Time) const
+{
+	if (!bBaked)
+	{
+		return FVector::ZeroVector;
+	}
+
+	const float SamplePosition = FMath::Clamp((Time - StartTime) * InvSampleSpacing, 0.f, float(NumSamples - 1));
+	const int32 SampleIdx = FMath::Min(FMath::FloorToInt32(SamplePosition), NumSamples - 2);
+	const float Alpha = SamplePosition - SampleIdx;
+
+	const VectorRegister4Float A = VectorLoadAligned(&Samples[SampleIdx].X);
+	const VectorRegister4Float B = VectorLoadAligned(&Samples[SampleIdx + 1].X);
+	const VectorRegister4Float Lerped = VectorMultiplyAdd(VectorSubtract(B, A), VectorSetFloat1(Alpha), A);
+
+	FVector4f Result;
+	VectorStoreAligned(Lerped, &Result.X);
+	return FVector(Result.X, Result.Y, Result.Z);
+}
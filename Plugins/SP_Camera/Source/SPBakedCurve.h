@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UCurveVector;
+
+/**
+ * A vector curve sampled at evenly spaced times, so evaluating it is an index and one vector lerp rather than a key search and a cubic per channel.
+ * Times outside the baked range clamp to its ends.
+ */
+class FSPBakedCurveVector
+{
+public:
+	static constexpr int32 NumSamples = 64;
+
+	/** Samples Curve across its key range, widened to cover [MinTime, MaxTime] */
+	void Bake(const UCurveVector* Curve, float MinTime = 0.f, float MaxTime = 1.f);
+
+	void Reset();
+
+	/** True if the table holds samples of Curve */
+	bool IsBakedFrom(const UCurveVector* Curve) const
+	{
+		return bBaked && (Curve == Source.Get());
+	}
+
+	FVector Eval(float Time) const;
+
+	float GetStartTime() const { return StartTime; }
+	float GetEndTime() const { return StartTime + (NumSamples - 1) * SampleSpacing; }
+
+private:
+	TWeakObjectPtr<const UCurveVector> Source;
+	bool bBaked = false;
+
+	float StartTime = 0.f;
+	float SampleSpacing = 1.f;
+	float InvSampleSpacing = 1.f;
+
+	FVector4f Samples[NumSamples];
+};
@@ -10,12 +10,19 @@
 #include "GameFramework/Character.h"
 #include "SPPlayerCameraManager.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkinnedAsset.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Controller.h"
 
 static int DrawCameraDebugInfo = 0;
 FAutoConsoleVariableRef CVar_DrawCameraDebugInfo(TEXT("SP.DrawCameraDebugInfo"), DrawCameraDebugInfo, TEXT("True to draw camera debugging info."), ECVF_Cheat);
 
+static int32 SPCameraPredictiveCollision = 1;
+static FAutoConsoleVariableRef CVar_SPCameraPredictiveCollision(TEXT("SP.Camera.PredictiveCollision"), SPCameraPredictiveCollision, TEXT("True to let third person cameras with bDoPredictiveCollision ease in ahead of walls their view target is heading toward."), ECVF_Default);
+
+static int32 SPCameraBakedCurves = 1;
+static FAutoConsoleVariableRef CVar_SPCameraBakedCurves(TEXT("SP.Camera.BakedCurves"), SPCameraBakedCurves, TEXT("True to evaluate third person camera adjustment curves from tables baked when the camera becomes active, false to evaluate the curve assets directly."), ECVF_Default);
+
 USPCam_ThirdPerson::USPCam_ThirdPerson()
 {
 	CameraToPivot.SetTranslation(FVector(-300.f, 0.f, 0.f));
@@ -49,6 +56,7 @@ USPCam_ThirdPerson::USPCam_ThirdPerson()
 	bValidateSafeLoc = true;
 	bPreventCameraPenetration = true;
 	bDoPredictiveAvoidance = true;
+	bDoPredictiveCollision = false;
 }
 
 FQuat USPCam_ThirdPerson::GetAutoFollowPivotToWorldRotation(const AActor* FollowActor) const
@@ -66,8 +74,31 @@ float USPCam_ThirdPerson::GetViewTargetMeshHeightOffset(const AActor* ViewTarget
 		if (CharMesh)
 		{
 			const float BaseRelZ = PlayerCamera->BasePelvisRelativeZ;
-			const float CurRelZ = CharMesh->GetBoneLocation(PlayerCamera->PelvisBoneName, EBoneSpaces::ComponentSpace).Z;
-			return CurRelZ - BaseRelZ;
+
+			// meshes following a leader pose keep their bones on the leader, let the component map those
+			if (CharMesh->LeaderPoseComponent.IsValid())
+			{
+				return CharMesh->GetBoneLocation(PlayerCamera->PelvisBoneName, EBoneSpaces::ComponentSpace).Z - BaseRelZ;
+			}
+
+			const USkinnedAsset* const MeshAsset = CharMesh->GetSkinnedAsset();
+			if ((PelvisBoneCache.Mesh.Get() != CharMesh) || (PelvisBoneCache.MeshAsset.Get() != MeshAsset) || (PelvisBoneCache.BoneName != PlayerCamera->PelvisBoneName))
+			{
+				PelvisBoneCache.Mesh = CharMesh;
+				PelvisBoneCache.MeshAsset = MeshAsset;
+				PelvisBoneCache.BoneName = PlayerCamera->PelvisBoneName;
+				PelvisBoneCache.BoneIndex = CharMesh->GetBoneIndex(PlayerCamera->PelvisBoneName);
+			}
+
+			const TArray<FTransform>& ComponentSpaceTransforms = CharMesh->GetComponentSpaceTransforms();
+			if (ComponentSpaceTransforms.IsValidIndex(PelvisBoneCache.BoneIndex))
+			{
+				const float CurRelZ = ComponentSpaceTransforms[PelvisBoneCache.BoneIndex].GetLocation().Z;
+				return CurRelZ - BaseRelZ;
+			}
+
+			// same as GetBoneLocation for a bone the mesh doesn't have
+			return -BaseRelZ;
 		}
 	}
 
@@ -88,17 +119,23 @@ FTransform USPCam_ThirdPerson::ComputeCameraToWorld(const AActor* ViewTarget, FT
 	{
 		const float Pitch = PivotToWorld.Rotator().Pitch;
 		const float PitchAlpha = FMath::GetRangePct(PivotPitchLimits, Pitch);
-		const FVector PitchAdjustmentOffset = CameraToPivot_PitchAdjustmentCurve->GetVectorValue(PitchAlpha) * CameraToPivot_PitchAdjustmentCurveScale;
+		const FVector PitchAdjustmentValue = (SPCameraBakedCurves && BakedPitchAdjustmentCurve.IsBakedFrom(CameraToPivot_PitchAdjustmentCurve))
+			? BakedPitchAdjustmentCurve.Eval(PitchAlpha)
+			: CameraToPivot_PitchAdjustmentCurve->GetVectorValue(PitchAlpha);
+		const FVector PitchAdjustmentOffset = PitchAdjustmentValue * CameraToPivot_PitchAdjustmentCurveScale;
 		AdjustedCameraToPivot.AddToTranslation(PitchAdjustmentOffset);
 	}
 
 	// maybe adjust based on speed
 	if (CameraToPivot_SpeedAdjustmentCurve)
 	{
-		const float CurSpeed = ViewTarget ? ViewTarget->GetVelocity().Size() : 0.f;
+		const float CurSpeed = ViewTarget ? ViewTargetSnapshot.Velocity.Size() : 0.f;
 		const float SpeedAlpha = FMath::Clamp(FMath::GetRangePct(CameraToPivot_SpeedAdjustment_SpeedRange, CurSpeed), 0.f, 1.f);
 
-		const FVector SpeedAdjustmentOffset = CameraToPivot_SpeedAdjustmentCurve->GetVectorValue(SpeedAlpha) * CameraToPivot_SpeedAdjustmentCurveScale;
+		const FVector SpeedAdjustmentValue = (SPCameraBakedCurves && BakedSpeedAdjustmentCurve.IsBakedFrom(CameraToPivot_SpeedAdjustmentCurve))
+			? BakedSpeedAdjustmentCurve.Eval(SpeedAlpha)
+			: CameraToPivot_SpeedAdjustmentCurve->GetVectorValue(SpeedAlpha);
+		const FVector SpeedAdjustmentOffset = SpeedAdjustmentValue * CameraToPivot_SpeedAdjustmentCurveScale;
 		AdjustedCameraToPivot.AddToTranslation(SpeedAdjustmentOffset);
 	}
 	
@@ -107,7 +144,7 @@ FTransform USPCam_ThirdPerson::ComputeCameraToWorld(const AActor* ViewTarget, FT
 
 void USPCam_ThirdPerson::ComputePredictiveLookAtPoint(FVector& LookAtPointOutput, const AActor* ViewTarget, float DeltaTime)
 {
-	LookAtPointOutput = LookAtPointOutput + ViewTarget->GetVelocity() * PredictiveLookatTime;
+	LookAtPointOutput = LookAtPointOutput + ViewTargetSnapshot.Velocity * PredictiveLookatTime;
 }
 
 FVector USPCam_ThirdPerson::ComputeWorldLookAtPosition(const FVector IdealWorldLookAt, float DeltaTime)
@@ -127,20 +164,18 @@ FRotator USPCam_ThirdPerson::ComputeSmoothPivotRotation(const FRotator IdealPivo
 
 FTransform USPCam_ThirdPerson::ComputePivotToWorld(const AActor* ViewTarget) const
 {
-	const AController* const PC = PlayerCamera ? Cast<APlayerController>(PlayerCamera->PCOwner) : nullptr;
-	if (PC == nullptr)
+	if (!ViewTargetSnapshot.bCanUpdate)
 	{
 		return LastPivotToWorld;
 	}
 
-	FTransform ViewTargetToWorld = GetViewTargetToWorld(ViewTarget);
-	const float MeshZOffset = GetViewTargetMeshHeightOffset(ViewTarget);
-	ViewTargetToWorld.AddToTranslation(FVector(0.f, 0.f, MeshZOffset));
+	FTransform ViewTargetToWorld = ViewTargetSnapshot.ViewTargetToWorld;
+	ViewTargetToWorld.AddToTranslation(FVector(0.f, 0.f, ViewTargetSnapshot.MeshHeightOffset));
 
 	FTransform PivotToWorld = GetPivotToViewTarget(ViewTarget) * ViewTargetToWorld;
 
 	// use control rotation by default, this may get overridden below
-	PivotToWorld.SetRotation(PlayerCamera->PCOwner->GetControlRotation().Quaternion());
+	PivotToWorld.SetRotation(ViewTargetSnapshot.ControlRotation.Quaternion());
 
 	if (AutoFollowMode == ECameraAutoFollowMode::FullFollow)
 	{
@@ -154,14 +189,14 @@ FTransform USPCam_ThirdPerson::ComputePivotToWorld(const AActor* ViewTarget) con
 			if (LazyFollowDelay_TimeRemaining > 0.f)
 			{
 				// user is rotating the camera or we are in the delay period, let that happen
-				PivotToWorld.SetRotation(PC->GetControlRotation().Quaternion());
+				PivotToWorld.SetRotation(ViewTargetSnapshot.ControlRotation.Quaternion());
 			}
 			else
 			{
 				FRotator NewPivotRot = FRotator::ZeroRotator;
 				if (LazyFollowLaziness <= 0.f)
 				{
-					NewPivotRot = ViewTarget->GetActorRotation();
+					NewPivotRot = ViewTargetSnapshot.ViewTargetToWorld.Rotator();
 				}
 				else
 				{
@@ -181,7 +216,7 @@ FTransform USPCam_ThirdPerson::ComputePivotToWorld(const AActor* ViewTarget) con
 				{
 					// only take the yaw from the auto follow rotation
 					float const LazyAutoFollowYaw = NewPivotRot.Yaw;
-					float const ControlPitch = PlayerCamera->PCOwner->GetControlRotation().Pitch;
+					float const ControlPitch = ViewTargetSnapshot.ControlRotation.Pitch;
 					FRotator const NewP2W(ControlPitch, LazyAutoFollowYaw, 0.f);
 					PivotToWorld.SetRotation(NewP2W.Quaternion());
 				}
@@ -212,24 +247,62 @@ FTransform USPCam_ThirdPerson::ComputePivotToWorld(const AActor* ViewTarget) con
 	return PivotToWorld;
 }
 
+bool USPCam_ThirdPerson::SupportsParallelUpdate() const
+{
+	// subclass hooks may read the live view target, they have to opt in. Debug drawing has to stay on the game thread
+	return bAllowParallelUpdate && !(bDrawDebugPivot || bDrawDebugLookat || bDrawDebugSafeLoc || bDrawDebugPenetrationAvoidance || DrawCameraDebugInfo);
+}
+
 void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, FTViewTarget& OutVT)
 {
-	// let super do any updates it wants (e.g. camera shakes), but we will fully determine the POV below
+	TGuardValue<bool> SerialUpdateGuard(bIsSerialUpdate, true);
 	Super::UpdateCamera(ViewTarget, CineCamComp, DeltaTime, OutVT);
+}
 
+void USPCam_ThirdPerson::CaptureViewTargetSnapshot(AActor* ViewTarget)
+{
+	Super::CaptureViewTargetSnapshot(ViewTarget);
+
+	ViewTargetSnapshot.MeshHeightOffset = GetViewTargetMeshHeightOffset(ViewTarget);
+
+	// the curves can be swapped at runtime, ComputeCamera evaluates them off the game thread
+	BakeAdjustmentCurves();
+}
+
+void USPCam_ThirdPerson::BakeAdjustmentCurves(bool bForce)
+{
+	if (!SPCameraBakedCurves)
+	{
+		return;
+	}
+
+	// both curves are evaluated at 0..1, see their property comments
+	if (bForce || !BakedPitchAdjustmentCurve.IsBakedFrom(CameraToPivot_PitchAdjustmentCurve))
+	{
+		BakedPitchAdjustmentCurve.Bake(CameraToPivot_PitchAdjustmentCurve);
+	}
+	if (bForce || !BakedSpeedAdjustmentCurve.IsBakedFrom(CameraToPivot_SpeedAdjustmentCurve))
+	{
+		BakedSpeedAdjustmentCurve.Bake(CameraToPivot_SpeedAdjustmentCurve);
+	}
+}
+
+void USPCam_ThirdPerson::ComputeCamera(class AActor* ViewTarget, float DeltaTime, FTViewTarget& OutVT)
+{
+	// super's updates (e.g. camera shakes) ran in BeginCameraUpdate, but we will fully determine the POV below
 	UWorld const* const World = ViewTarget ? ViewTarget->GetWorld() : nullptr;
 	if (World)
 	{
 		// if the pawn is pending destroy, the position of the pawn gets reset and camera will be teleported to weird positions.
 		// so just use the old FOV without any update
-		if (!IsValid(ViewTarget) || !PlayerCamera || !PlayerCamera->PCOwner)
+		if (!ViewTargetSnapshot.bCanUpdate)
 		{
 			return;
 		}
 
 		AdjustAutoFollowMode(ViewTarget);
 
-		if ((AutoFollowMode == ECameraAutoFollowMode::LazyFollow) && !LastControlRotation.Equals(PlayerCamera->PCOwner->GetControlRotation(), 0.1f))
+		if ((AutoFollowMode == ECameraAutoFollowMode::LazyFollow) && !LastControlRotation.Equals(ViewTargetSnapshot.ControlRotation, 0.1f))
 		{
 			LazyFollowDelay_TimeRemaining = LazyFollowDelayAfterUserControl;
 		}
@@ -243,8 +316,8 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 
 		LastUnsmoothedPivotToWorld = PivotToWorld;
 
-		// set control rotation back to pivot rotation, so controls keep making sense
-		PlayerCamera->PCOwner->SetControlRotation(PivotToWorld.GetRotation().Rotator());
+		// control rotation goes back to pivot rotation in FinishCameraUpdate, so controls keep making sense
+		PendingControlRotation = PivotToWorld.GetRotation().Rotator();
 
 		// Smooth the pivot transform to feel good
 		FTransform SmoothedPivotToWorld = PivotToWorld;
@@ -278,14 +351,14 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 			FRotator FinalCameraRot = CameraToWorld.Rotator();
 			if (bUseLookatPoint)
 			{
-				FVector IdealWorldLookat = ViewTarget->GetTransform().TransformPosition(LookatOffsetLocal);
+				FVector IdealWorldLookat = ViewTargetSnapshot.ViewTargetToWorld.TransformPosition(LookatOffsetLocal);
 				if (bDoPredictiveLookat)
 				{
-					if (ACharacter* VTChar = Cast<ACharacter>(ViewTarget))
+					if (ViewTargetSnapshot.bIsCharacter)
 					{
-						if (UCharacterMovementComponent* CharMoveComp = VTChar->GetCharacterMovement())
+						if (ViewTargetSnapshot.bHasCharacterMovement)
 						{
-							IdealWorldLookat = IdealWorldLookat + CharMoveComp->Velocity * PredictiveLookatTime;
+							IdealWorldLookat = IdealWorldLookat + ViewTargetSnapshot.CharacterMovementVelocity * PredictiveLookatTime;
 						}
 					}
 					else
@@ -324,7 +397,11 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 			OutVT.POV.FOV = ComputeFinalFOV(ViewTarget);
 		}
 
-		PlayerCamera->ApplyCameraModifiers(DeltaTime, OutVT.POV);
+		// modifiers only run on the game thread, a parallel update applies them in FinishCameraUpdate instead
+		if (bIsSerialUpdate)
+		{
+			PlayerCamera->ApplyCameraModifiers(DeltaTime, OutVT.POV);
+		}
 
 		FVector DesiredCamLoc = OutVT.POV.Location;
 
@@ -337,12 +414,12 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 		{
 			// find "worst" location, or location we will shoot the penetration tests from
 
-			FTransform ViewTargetTransform = GetViewTargetToWorld(ViewTarget);
+			const FVector ViewTargetLocation = ViewTargetSnapshot.ViewTargetToWorld.GetLocation();
+			const FQuat ViewTargetQuat = ViewTargetSnapshot.ViewTargetToWorld.GetRotation();
 
-			const float MeshZOffset = GetViewTargetMeshHeightOffset(ViewTarget);
-			FVector IdealSafeLocationLocal = ViewTarget->GetActorLocation() + ViewTarget->GetActorQuat().RotateVector(SafeLocationOffset) + FVector(0.f, 0.f, MeshZOffset);
+			FVector IdealSafeLocationLocal = ViewTargetLocation + ViewTargetQuat.RotateVector(SafeLocationOffset) + FVector(0.f, 0.f, ViewTargetSnapshot.MeshHeightOffset);
 		
-			const FMatrix CamSpaceToWorld = FQuatRotationTranslationMatrix(ViewTarget->GetActorQuat(), ViewTarget->GetActorLocation());
+			const FMatrix CamSpaceToWorld = FQuatRotationTranslationMatrix(ViewTargetQuat, ViewTargetLocation);
 			IdealSafeLocationLocal = CamSpaceToWorld.InverseTransformPosition(IdealSafeLocationLocal);
 
 			const FVector SafeLocationLocal = SafeLocationInterpolator.Eval(IdealSafeLocationLocal, DeltaTime);
@@ -357,7 +434,7 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 			// adjust worst location origin to prevent any penetration
 			if (bValidateSafeLoc)
 			{
-				PreventCameraPenetration(ViewTarget, SafeLocPenetrationAvoidanceRays, ViewTarget->GetActorLocation(), IdealSafeLocation, DeltaTime, ValidatedSafeLocation, LastSafeLocBlockedPct, true);
+				PreventCameraPenetration(ViewTarget, SafeLocPenetrationAvoidanceRays, ViewTargetLocation, IdealSafeLocation, DeltaTime, ValidatedSafeLocation, LastSafeLocBlockedPct, true);
 			}
 
 #if ENABLE_DRAW_DEBUG
@@ -371,10 +448,35 @@ void USPCam_ThirdPerson::UpdateCamera(class AActor* ViewTarget, UCineCameraCompo
 			// note: we skip predictive avoidance while this mode is blending out
 			bool const bSingleRayPenetrationCheck = !bDoPredictiveAvoidance || !bIsActive;
 			PreventCameraPenetration(ViewTarget, CameraPenetrationAvoidanceRays, ValidatedSafeLocation, DesiredCamLoc, DeltaTime, ValidatedCameraLocation, LastPenetrationBlockedPct, bSingleRayPenetrationCheck);
+
+			if (bDoPredictiveCollision && SPCameraPredictiveCollision && bIsActive)
+			{
+				PreventPredictedCameraPenetration(ViewTarget, ValidatedSafeLocation, DesiredCamLoc, DeltaTime, ValidatedCameraLocation, LastPenetrationBlockedPct);
+			}
 		}
 
 		OutVT.POV.Location = ValidatedCameraLocation;
-			   		 
+	}
+}
+
+void USPCam_ThirdPerson::FinishCameraUpdate(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, FTViewTarget& OutVT)
+{
+	if (ViewTargetSnapshot.bHasWorld)
+	{
+		if (!ViewTargetSnapshot.bCanUpdate)
+		{
+			return;
+		}
+
+		// set control rotation back to pivot rotation, so controls keep making sense
+		PlayerCamera->PCOwner->SetControlRotation(PendingControlRotation);
+
+		// modifiers can't run alongside other modes, so after a parallel update they offset the penetration checked location
+		if (!bIsSerialUpdate)
+		{
+			PlayerCamera->ApplyCameraModifiers(DeltaTime, OutVT.POV);
+		}
+
 		LastCameraToWorld = FTransform(OutVT.POV.Rotation, OutVT.POV.Location);
 		LastControlRotation = PlayerCamera->PCOwner->GetControlRotation();
 	}
@@ -390,11 +492,17 @@ void USPCam_ThirdPerson::OnBecomeActive(AActor* ViewTarget, USPCameraMode* Previ
 
 	if (!bAlreadyInStack)
 	{
+		// rebake in case the curve assets were edited since the last time
+		BakeAdjustmentCurves(true);
+
 		SkipNextInterpolation();
 		LastCameraToWorld = PlayerCamera ? FTransform(PlayerCamera->GetCameraRotation(), PlayerCamera->GetCameraLocation()) : FTransform::Identity;
 
 		LazyFollowDelay_TimeRemaining = 0.f;
 	}
+
+	// blocks found while the mode was last active, or blending out, say nothing about where it's going now
+	ResetPredictiveCollision();
 }
 
 void USPCam_ThirdPerson::SkipNextInterpolation()
@@ -409,6 +517,23 @@ void USPCam_ThirdPerson::SkipNextInterpolation()
 	CameraToPivotTranslationInterpolator.Reset();
 
 	bSkipNextPredictivePenetrationAvoidanceBlend = true;
+	ResetPredictiveCollision();
+}
+
+void USPCam_ThirdPerson::ResetToDefaultSettings_Implementation()
+{
+	Super::ResetToDefaultSettings_Implementation();
+
+	ResetPredictiveCollision();
+}
+
+void USPCam_ThirdPerson::ResetPredictiveCollision()
+{
+	for (float& PredictiveBlockedPct : PredictiveBlockedPcts)
+	{
+		PredictiveBlockedPct = 1.f;
+	}
+	NextPredictiveCollisionStep = 0;
 }
 
 FTransform USPCam_ThirdPerson::GetCameraToPivot(const AActor* ViewTarget) const
@@ -420,8 +545,6 @@ FTransform USPCam_ThirdPerson::GetCameraToPivot(const AActor* ViewTarget) const
 
 void USPCam_ThirdPerson::PreventCameraPenetration(AActor* Target, TArray<FPenetrationAvoidanceRay>& Rays, const FVector& SafeLoc, const FVector& IdealCameraLoc, float DeltaTime, FVector& OutCameraLoc, float& DistBlockedPct, bool bSingleRayOnly)
 {
-	UWorld* const World = PlayerCamera->GetWorld();
-
 	float HardBlockedPct = DistBlockedPct;
 	float SoftBlockedPct = DistBlockedPct;
 
@@ -431,9 +554,6 @@ void USPCam_ThirdPerson::PreventCameraPenetration(AActor* Target, TArray<FPenetr
 	BaseRayMatrix.GetScaledAxes(BaseRayLocalFwd, BaseRayLocalRight, BaseRayLocalUp);
 	float DistBlockedPctThisFrame = 1.f;
 
-	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPenetration), false, Target);
-	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
-	
 	BlockingActors.Empty();
 
 	for (auto& Ray : Rays)
@@ -455,19 +575,16 @@ void USPCam_ThirdPerson::PreventCameraPenetration(AActor* Target, TArray<FPenetr
 					RayTarget = SafeLoc + RotatedRay;
 				}
 
-				SphereShape.Sphere.Radius = Ray.Radius;
-				ECollisionChannel TraceChannel = ECC_Camera;
-
 				FHitResult Hit;
 				const FVector TraceStart = SafeLoc;
 				const FVector TraceEnd = RayTarget;
-				bool bHit = World->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				bool bHit = SweepPenetrationFeeler(Hit, TraceStart, TraceEnd, Ray.Radius, Target);
 				Ray.FramesUntilNextTrace = Ray.TraceInterval;
 
 #if ENABLE_DRAW_DEBUG
 				if (bDrawDebugPenetrationAvoidance)
 				{
-					::DrawDebugLineTraceSingle(World, TraceStart, TraceEnd, EDrawDebugTrace::ForDuration, bHit, Hit, FColor::White, FColor::Red, 0.1f);
+					::DrawDebugLineTraceSingle(PlayerCamera->GetWorld(), TraceStart, TraceEnd, EDrawDebugTrace::ForDuration, bHit, Hit, FColor::White, FColor::Red, 0.1f);
 				}
 #endif
 
@@ -549,3 +666,82 @@ void USPCam_ThirdPerson::PreventCameraPenetration(AActor* Target, TArray<FPenetr
 	bSkipNextPredictivePenetrationAvoidanceBlend = false;
 }
 
+bool USPCam_ThirdPerson::SweepPenetrationFeeler(FHitResult& OutHit, const FVector& Start, const FVector& End, float Radius, AActor* Target) const
+{
+	const ECollisionChannel TraceChannel = ECC_Camera;
+	const FCollisionShape SphereShape = FCollisionShape::MakeSphere(Radius);
+
+	// feelers inside the shared snapshot skip the physics scene, see SP.Camera.CollisionSnapshot
+	const FSPCameraCollisionSnapshot* const CollisionSnapshot = PlayerCamera->GetCollisionSnapshot();
+	if (CollisionSnapshot && CollisionSnapshot->GetChannel() == TraceChannel && CollisionSnapshot->Covers(Start, End, Radius))
+	{
+		return CollisionSnapshot->SweepSingle(OutHit, Start, End, Radius, Target);
+	}
+
+	const FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPenetration), false, Target);
+	return PlayerCamera->GetWorld()->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+}
+
+void USPCam_ThirdPerson::PreventPredictedCameraPenetration(AActor* Target, const FVector& SafeLoc, const FVector& IdealCameraLoc, float DeltaTime, FVector& OutCameraLoc, float& DistBlockedPct)
+{
+	const int32 NumSteps = FMath::Clamp(PredictiveCollisionSteps, 1, MaxPredictiveCollisionSteps);
+	const FVector Velocity = ViewTargetSnapshot.Velocity;
+	if (PredictiveCollisionTime <= 0.f || Velocity.IsNearlyZero())
+	{
+		for (float& PredictiveBlockedPct : PredictiveBlockedPcts)
+		{
+			PredictiveBlockedPct = 1.f;
+		}
+		return;
+	}
+
+	// one step a frame, the others keep what they found the last time round
+	const int32 Step = NextPredictiveCollisionStep % NumSteps;
+	NextPredictiveCollisionStep = (Step + 1) % NumSteps;
+	{
+		const FPenetrationAvoidanceRay* const PrimaryRay = CameraPenetrationAvoidanceRays.FindByPredicate([](const FPenetrationAvoidanceRay& Ray) { return Ray.bPrimaryRay; });
+		const float Radius = PrimaryRay ? PrimaryRay->Radius : 0.f;
+		FVector PredictedOffset = Velocity * (PredictiveCollisionTime * (Step + 1) / NumSteps);
+
+		// the view target stops at whatever is in its way, a predicted safe location inside a wall would start the feeler inside it
+		FHitResult SafeLocHit;
+		if (SweepPenetrationFeeler(SafeLocHit, SafeLoc, SafeLoc + PredictedOffset, Radius, Target))
+		{
+			PredictedOffset = SafeLocHit.bStartPenetrating ? FVector::ZeroVector : SafeLocHit.Location - SafeLoc;
+		}
+
+		const FVector TraceStart = SafeLoc + PredictedOffset;
+		const FVector TraceEnd = IdealCameraLoc + PredictedOffset;
+
+		// a feeler starting in penetration has Time 0 whatever the camera line looks like, it would slam the camera into the safe location
+		FHitResult Hit;
+		const bool bHit = SweepPenetrationFeeler(Hit, TraceStart, TraceEnd, Radius, Target) && !Hit.bStartPenetrating;
+		PredictiveBlockedPcts[Step] = bHit ? Hit.Time : 1.f;
+
+#if ENABLE_DRAW_DEBUG
+		if (bDrawDebugPenetrationAvoidance)
+		{
+			::DrawDebugLineTraceSingle(PlayerCamera->GetWorld(), TraceStart, TraceEnd, EDrawDebugTrace::ForDuration, bHit, Hit, FColor::Cyan, FColor::Orange, 0.1f);
+		}
+#endif
+	}
+
+	// further steps ease in slower, a wall a whole PredictiveCollisionTime away has that long to be reached
+	float PredictedBlockedPct = DistBlockedPct;
+	for (int32 StepIdx = 0; StepIdx < NumSteps; ++StepIdx)
+	{
+		const float StepBlockedPct = PredictiveBlockedPcts[StepIdx];
+		if (StepBlockedPct < PredictedBlockedPct)
+		{
+			const float TimeToContact = PredictiveCollisionTime * (StepIdx + 1) / NumSteps;
+			PredictedBlockedPct -= (PredictedBlockedPct - StepBlockedPct) * FMath::Min(DeltaTime / TimeToContact, 1.f);
+		}
+	}
+
+	if (PredictedBlockedPct < DistBlockedPct)
+	{
+		DistBlockedPct = PredictedBlockedPct;
+		OutCameraLoc = SafeLoc + (IdealCameraLoc - SafeLoc) * DistBlockedPct;
+	}
+}
+
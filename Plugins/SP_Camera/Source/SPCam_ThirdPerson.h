@@ -3,12 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SPBakedCurve.h"
 #include "SPCameraMode.h"
 #include "SPInterpolators.h"
 
 #include "SPCam_ThirdPerson.generated.h"
 
 class UCurveVector;
+class USkeletalMeshComponent;
+class USkinnedAsset;
 
 /**
  * Auto follow types this camera mode supports
@@ -86,13 +89,33 @@ public:
 	USPCam_ThirdPerson();
 
 	//~ Begin USPCameraMode Interface
+	virtual bool SupportsParallelUpdate() const override;
 	virtual void UpdateCamera(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, struct FTViewTarget& OutVT) override;
+	virtual void ComputeCamera(class AActor* ViewTarget, float DeltaTime, struct FTViewTarget& OutVT) override;
+	virtual void FinishCameraUpdate(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, struct FTViewTarget& OutVT) override;
 	virtual void OnBecomeActive(AActor* ViewTarget, USPCameraMode* PreviouslyActiveMode, bool bAlreadyInStack) override;
 	virtual void SkipNextInterpolation() override;
+	virtual void ResetToDefaultSettings_Implementation() override;
 	//~ End USPCameraModeInterface
 
+	/** See bAllowParallelUpdate */
+	void SetAllowParallelUpdate(bool bAllow)
+	{
+		bAllowParallelUpdate = bAllow;
+	}
+
+	/** How far out along the ideal camera line penetration avoidance lets the camera go, 1 when nothing is in the way */
+	float GetPenetrationBlockedPct() const
+	{
+		return LastPenetrationBlockedPct;
+	}
+
 protected:
 
+	//~ Begin USPCameraMode Interface
+	virtual void CaptureViewTargetSnapshot(AActor* ViewTarget) override;
+	//~ End USPCameraModeInterface
+
 	/** Transform for the Pivot, in the ViewTarget's space. This is the point the camera rotates around. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraSettings")
 	FTransform PivotToViewTarget;
@@ -233,6 +256,22 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PenetrationAvoidance")
 	float PenetrationBlendOutTime = 0.25f;
 
+	/**
+	 * If true, sweeps where the camera will be PredictiveCollisionTime ahead at the view target's current velocity and eases in toward anything found there,
+	 * so fast view targets don't pop the camera in when the regular feelers reach a wall. Off by default, it changes how the camera moves near walls
+	 * and costs two more sweeps a frame
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PenetrationAvoidance")
+	uint32 bDoPredictiveCollision : 1;
+
+	/** How far ahead, in seconds, predictive collision looks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PenetrationAvoidance", meta = (EditCondition = bDoPredictiveCollision))
+	float PredictiveCollisionTime = 0.3f;
+
+	/** Predictive collision looks ahead at this many evenly spaced times up to PredictiveCollisionTime, sweeping one of them per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PenetrationAvoidance", meta = (EditCondition = bDoPredictiveCollision, ClampMin = "1", ClampMax = "4"))
+	int32 PredictiveCollisionSteps = 3;
+
 	/** Cache of camera safe location calculated on the previous update */
 	UPROPERTY(transient)
 	FVector LastSafeLocationLocal;
@@ -244,6 +283,26 @@ protected:
 	/** When true, any blending of the block percentage when calculating penetration avoidance is skipped */
 	bool bSkipNextPredictivePenetrationAvoidanceBlend = false;
 
+	static constexpr int32 MaxPredictiveCollisionSteps = 4;
+
+	/** Blocked percentage last found at each predictive collision step, 1 when clear */
+	float PredictiveBlockedPcts[MaxPredictiveCollisionSteps] = { 1.f, 1.f, 1.f, 1.f };
+
+	/** Predictive collision step to sweep next frame */
+	int32 NextPredictiveCollisionStep = 0;
+
+	/** Forgets what the predictive collision steps found, the next one swept is the nearest */
+	void ResetPredictiveCollision();
+
+	/** Sweeps a penetration feeler, against the camera manager's collision snapshot when it covers the sweep and the physics scene otherwise */
+	bool SweepPenetrationFeeler(FHitResult& OutHit, const FVector& Start, const FVector& End, float Radius, AActor* Target) const;
+
+	/**
+	 * Sweeps one predictive collision step and eases DistBlockedPct in toward every step's blocked percentage, at a rate that would get the camera
+	 * there by the time the view target is. Only ever brings the camera in, PreventCameraPenetration blends it back out.
+	 */
+	virtual void PreventPredictedCameraPenetration(AActor* Target, const FVector& SafeLoc, const FVector& IdealCameraLoc, float DeltaTime, FVector& OutCameraLoc, float& DistBlockedPct);
+
 	/**
 	* Handles traces to make sure camera does not penetrate geometry and tries to find the best location for the camera.
 	* Also handles interpolating back smoothly to ideal/desired position.
@@ -262,13 +321,13 @@ protected:
 		return LastPivotToWorld;
 	};
 
-	/**  Returns the pivot's transform in view target space */
+	/**  Returns the pivot's transform in view target space. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual FTransform GetPivotToViewTarget(const AActor* ViewTarget) const
 	{
 		return PivotToViewTarget;
 	};
 
-	/** Returns camera-to-pivot, before any smoothing. */
+	/** Returns camera-to-pivot, before any smoothing. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual FTransform GetBaseCameraToPivot(const AActor* ViewTarget) const
 	{
 		return CameraToPivot;
@@ -292,25 +351,25 @@ protected:
 	/** Computes the camera's goal transform in world space */
 	FTransform ComputeCameraToWorld(const AActor* ViewTarget, FTransform const& PivotToWorld) const;
 
-	/** Computes the final FOV value during camera updates. Override as needed.*/
+	/** Computes the final FOV value during camera updates. Override as needed. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual float ComputeFinalFOV(const AActor* ViewTarget) const
 	{
 		return FOV;
 	}
 
-	/** Computes the final Yaw Modifier applied to the camera's rotation. Override as needed. */
+	/** Computes the final Yaw Modifier applied to the camera's rotation. Override as needed. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual float ComputeYawModifier(const AActor* ViewTarget, float DeltaTime)
 	{
 		return 0.0f;
 	}
 
-	/** Computes the final Roll Modifier applied to the camera's rotation. Override as needed. */
+	/** Computes the final Roll Modifier applied to the camera's rotation. Override as needed. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual float ComputeRollModifier(const AActor* ViewTarget, float DeltaTime)
 	{
 		return 0.0f;
 	}
 
-	/** Updates auto follow mode settings based on gameplay logic. Override as needed. */
+	/** Updates auto follow mode settings based on gameplay logic. Override as needed. May run on a worker thread when bAllowParallelUpdate is set, overrides then read ViewTargetSnapshot instead of ViewTarget. */
 	virtual void AdjustAutoFollowMode(const AActor* ViewTarget) {};
 
 	/** Computes the camera look at point's goal position based on gameplay logic. Override as needed. */
@@ -332,6 +391,37 @@ protected:
 	/** Cache of previous owner PlayerController's control rotation */
 	FRotator LastControlRotation;	
 
+	/** Control rotation worked out by ComputeCamera, handed to the owning PlayerController in FinishCameraUpdate */
+	FRotator PendingControlRotation = FRotator::ZeroRotator;
+
+	/** Set for the length of UpdateCamera, ComputeCamera then runs on the game thread and applies the camera modifiers before the penetration checks */
+	bool bIsSerialUpdate = false;
+
+	/** Bakes the CameraToPivot adjustment curves that changed since they were last baked */
+	void BakeAdjustmentCurves(bool bForce = false);
+
+	/** CameraToPivot adjustment curves as tables, see SP.Camera.BakedCurves */
+	FSPBakedCurveVector BakedPitchAdjustmentCurve;
+	FSPBakedCurveVector BakedSpeedAdjustmentCurve;
+
+	/** Pelvis bone lookup for GetViewTargetMeshHeightOffset, resolved again when the mesh, its asset or the bone name changes */
+	struct FPelvisBoneCache
+	{
+		TWeakObjectPtr<const USkeletalMeshComponent> Mesh;
+		TWeakObjectPtr<const USkinnedAsset> MeshAsset;
+		FName BoneName;
+		int32 BoneIndex = INDEX_NONE;
+	};
+	mutable FPelvisBoneCache PelvisBoneCache;
+
+
+	/**
+	 * Lets the SPCameraManager run ComputeCamera on a worker thread, alongside the other modes in the blend stack. Only enable it for classes
+	 * whose overrides of the hooks ComputeCamera calls read ViewTargetSnapshot and never the view target or other game thread state.
+	 * Debug drawing keeps the update on the game thread regardless.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+	bool bAllowParallelUpdate = false;
 
 	/** When enabled, debug visuals will be rendered for the camera pivot point */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
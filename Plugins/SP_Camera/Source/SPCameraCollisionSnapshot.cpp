@@ -0,0 +1,258 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SPCameraCollisionSnapshot.h"
+
+#include "Chaos/GeometryQueries.h"
+#include "Chaos/ImplicitObject.h"
+#include "Chaos/Sphere.h"
+#include "CollisionQueryParams.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "Physics/PhysicsFiltering.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+struct FSPCameraCollisionSnapshot::FCapturedBody
+{
+	/** Holding a reference keeps the shapes alive even if the body is destroyed or rebuilt before the next capture */
+	TArray<Chaos::FImplicitObjectPtr, TInlineAllocator<1>> Shapes;
+	FTransform Transform;
+	FBox Bounds;
+
+	/** Only compared against the body instance on refreshes, never dereferenced */
+	FPhysicsActorHandle ActorHandle = nullptr;
+	int32 BodyIndex = INDEX_NONE;
+
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	TWeakObjectPtr<AActor> Owner;
+	const AActor* OwnerKey = nullptr;
+	bool bMovable = false;
+};
+
+namespace SPCameraCollisionSnapshot
+{
+	/** Sweeps against one captured shape, giving the distance along Dir and the world space contact */
+	static bool SweepShape(const Chaos::FImplicitObject& Shape, const FTransform& Transform, const FVector& Start, const FVector& Dir, double Length, float SweepRadius,
+		double& OutDistance, FVector& OutPosition, FVector& OutNormal)
+	{
+		Chaos::FReal Distance = 0.0;
+		Chaos::FVec3 Position, Normal;
+		int32 FaceIndex = INDEX_NONE;
+
+		if (SweepRadius <= 0.f)
+		{
+			// rays go in the shape's space, a sphere sweep takes both transforms
+			if (!Shape.Raycast(Transform.InverseTransformPositionNoScale(Start), Transform.InverseTransformVectorNoScale(Dir), Length, 0.0, Distance, Position, Normal, FaceIndex))
+			{
+				return false;
+			}
+			Position = Transform.TransformPositionNoScale(Position);
+			Normal = Transform.TransformVectorNoScale(Normal);
+		}
+		else
+		{
+			Chaos::FVec3 FaceNormal;
+			const Chaos::FSphere Sphere(Chaos::FVec3(0.0), SweepRadius);
+			if (!Chaos::SweepQuery(Shape, Transform, Sphere, FTransform(Start), Dir, Length, Distance, Position, Normal, FaceIndex, FaceNormal, 0.0, false))
+			{
+				return false;
+			}
+		}
+
+		OutDistance = Distance;
+		OutPosition = Position;
+		OutNormal = Normal;
+		return true;
+	}
+
+	static FBox GetBounds(TConstArrayView<Chaos::FImplicitObjectPtr> Shapes, const FTransform& Transform)
+	{
+		FBox Bounds(ForceInit);
+		for (const Chaos::FImplicitObjectPtr& Shape : Shapes)
+		{
+			const Chaos::FAABB3 LocalBounds = Shape->BoundingBox();
+			Bounds += FBox(LocalBounds.Min(), LocalBounds.Max()).TransformBy(Transform);
+		}
+		return Bounds;
+	}
+}
+
+FSPCameraCollisionSnapshot::FSPCameraCollisionSnapshot() = default;
+FSPCameraCollisionSnapshot::~FSPCameraCollisionSnapshot() = default;
+
+void FSPCameraCollisionSnapshot::Capture(const UWorld* World, const FVector& InCenter, float InRadius, ECollisionChannel InChannel)
+{
+	Reset();
+	if (World == nullptr || World->GetPhysicsScene() == nullptr)
+	{
+		return;
+	}
+
+	TArray<FOverlapResult> Overlaps;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CameraCollisionSnapshot), false);
+	World->OverlapMultiByChannel(Overlaps, InCenter, FQuat::Identity, InChannel, FCollisionShape::MakeSphere(InRadius), QueryParams);
+
+	// one read lock for the whole capture, sweeps read the copies without it
+	FPhysicsCommand::ExecuteRead(World->GetPhysicsScene(), [this, &Overlaps]()
+	{
+		TArray<FPhysicsShapeHandle> ShapeHandles;
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			// sweeps only block, the same as the feelers' SweepSingleByChannel
+			UPrimitiveComponent* const Component = Overlap.GetComponent();
+			if (!Overlap.bBlockingHit || Component == nullptr)
+			{
+				continue;
+			}
+
+			// welded components share their parent's body, which only needs capturing once
+			const FBodyInstance* const BodyInstance = Component->GetBodyInstance(NAME_None, true, Overlap.ItemIndex);
+			if (BodyInstance == nullptr || !BodyInstance->IsValidBodyInstance()
+				|| Bodies.ContainsByPredicate([BodyInstance](const FCapturedBody& Body) { return Body.ActorHandle == BodyInstance->ActorHandle; }))
+			{
+				continue;
+			}
+
+			FCapturedBody Body;
+			ShapeHandles.Reset();
+			BodyInstance->GetAllShapes_AssumesLocked(ShapeHandles);
+			for (const FPhysicsShapeHandle& ShapeHandle : ShapeHandles)
+			{
+				// scene sweeps that don't trace complex only see the simple shapes
+				if (FPhysicsInterface::IsQueryShape(ShapeHandle) && (FPhysicsInterface::GetQueryFilter(ShapeHandle).Word3 & EPDF_SimpleCollision) != 0)
+				{
+					Body.Shapes.Emplace(const_cast<Chaos::FImplicitObject*>(&ShapeHandle.GetGeometry()));
+				}
+			}
+
+			if (Body.Shapes.Num() == 0)
+			{
+				continue;
+			}
+
+			Body.Transform = FPhysicsInterface::GetGlobalPose_AssumesLocked(BodyInstance->ActorHandle);
+			Body.ActorHandle = BodyInstance->ActorHandle;
+			Body.BodyIndex = Overlap.ItemIndex;
+			Body.Component = Component;
+			Body.Owner = Component->GetOwner();
+			Body.OwnerKey = Component->GetOwner();
+			Body.bMovable = Component->Mobility == EComponentMobility::Movable;
+			Body.Bounds = SPCameraCollisionSnapshot::GetBounds(Body.Shapes, Body.Transform);
+			Bodies.Add(MoveTemp(Body));
+		}
+	});
+
+	Center = InCenter;
+	Radius = InRadius;
+	Channel = InChannel;
+	bCaptured = true;
+}
+
+void FSPCameraCollisionSnapshot::RefreshTransforms(const UWorld* World)
+{
+	if (!bCaptured || World == nullptr || World->GetPhysicsScene() == nullptr || !Bodies.ContainsByPredicate([](const FCapturedBody& Body) { return Body.bMovable; }))
+	{
+		return;
+	}
+
+	FPhysicsCommand::ExecuteRead(World->GetPhysicsScene(), [this]()
+	{
+		for (int32 BodyIdx = Bodies.Num() - 1; BodyIdx >= 0; --BodyIdx)
+		{
+			FCapturedBody& Body = Bodies[BodyIdx];
+			if (!Body.bMovable)
+			{
+				continue;
+			}
+
+			// a body that went away or was recreated since the capture is dropped, the next capture picks it up again
+			const UPrimitiveComponent* const Component = Body.Component.Get();
+			const FBodyInstance* const BodyInstance = Component ? Component->GetBodyInstance(NAME_None, true, Body.BodyIndex) : nullptr;
+			if (BodyInstance == nullptr || BodyInstance->ActorHandle != Body.ActorHandle)
+			{
+				Bodies.RemoveAtSwap(BodyIdx);
+				continue;
+			}
+
+			Body.Transform = FPhysicsInterface::GetGlobalPose_AssumesLocked(Body.ActorHandle);
+			Body.Bounds = SPCameraCollisionSnapshot::GetBounds(Body.Shapes, Body.Transform);
+		}
+	});
+}
+
+void FSPCameraCollisionSnapshot::Reset()
+{
+	Bodies.Reset();
+	Radius = 0.f;
+	bCaptured = false;
+}
+
+bool FSPCameraCollisionSnapshot::Covers(const FVector& Start, const FVector& End, float SweepRadius) const
+{
+	// the sphere is convex, so both ends inside means the whole sweep is
+	const float InnerRadiusSquared = FMath::Square(FMath::Max(Radius - SweepRadius, 0.f));
+	return bCaptured && FVector::DistSquared(Start, Center) <= InnerRadiusSquared && FVector::DistSquared(End, Center) <= InnerRadiusSquared;
+}
+
+bool FSPCameraCollisionSnapshot::SweepSingle(FHitResult& OutHit, const FVector& Start, const FVector& End, float SweepRadius, const AActor* IgnoreActor) const
+{
+	const FVector Delta = End - Start;
+	const double Length = Delta.Size();
+	const FVector Dir = Length > UE_KINDA_SMALL_NUMBER ? Delta / Length : FVector::ForwardVector;
+	const double SweepLength = FMath::Max(Length, double(UE_KINDA_SMALL_NUMBER));
+
+	const FCapturedBody* HitBody = nullptr;
+	double HitDistance = 0.0;
+	FVector HitPosition, HitNormal;
+	for (const FCapturedBody& Body : Bodies)
+	{
+		if ((IgnoreActor && Body.OwnerKey == IgnoreActor) || !Body.Component.IsValid())
+		{
+			continue;
+		}
+
+		// bounds first, most bodies in the snapshot are nowhere near any one feeler
+		const FBox Bounds = Body.Bounds.ExpandBy(SweepRadius);
+		if (!Bounds.IsInside(Start) && !FMath::LineBoxIntersection(Bounds, Start, End, Delta))
+		{
+			continue;
+		}
+
+		for (const Chaos::FImplicitObjectPtr& Shape : Body.Shapes)
+		{
+			double Distance;
+			FVector Position, Normal;
+			if (SPCameraCollisionSnapshot::SweepShape(*Shape, Body.Transform, Start, Dir, SweepLength, SweepRadius, Distance, Position, Normal)
+				&& (HitBody == nullptr || Distance < HitDistance))
+			{
+				HitBody = &Body;
+				HitDistance = Distance;
+				HitPosition = Position;
+				HitNormal = Normal;
+			}
+		}
+	}
+
+	OutHit = FHitResult(1.f);
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	if (HitBody == nullptr)
+	{
+		return false;
+	}
+
+	// a sweep that starts touching reports no distance, the same as scene queries flagging it as starting in penetration
+	const double ClampedDistance = FMath::Clamp(HitDistance, 0.0, Length);
+	OutHit.bBlockingHit = true;
+	OutHit.bStartPenetrating = HitDistance <= 0.0;
+	OutHit.Time = Length > UE_KINDA_SMALL_NUMBER ? float(ClampedDistance / Length) : 0.f;
+	OutHit.Distance = float(ClampedDistance);
+	OutHit.Location = Start + Dir * ClampedDistance;
+	OutHit.ImpactPoint = HitPosition;
+	OutHit.Normal = HitNormal;
+	OutHit.ImpactNormal = HitNormal;
+	OutHit.Component = HitBody->Component;
+	OutHit.HitObjectHandle = FActorInstanceHandle(HitBody->Owner.Get());
+	OutHit.Item = HitBody->BodyIndex;
+	return true;
+}
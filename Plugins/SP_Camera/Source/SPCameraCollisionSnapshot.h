@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+class UPrimitiveComponent;
+class UWorld;
+
+/**
+ * The blocking collision in a sphere around the camera, gathered with one overlap query so camera feelers can sweep the few bodies in it
+ * one by one instead of going through the scene's broadphase for every feeler.
+ * The bodies' geometry and transforms are copied out of the physics scene when captured, so sweeps take no physics lock. Movable bodies are
+ * moved along by RefreshTransforms, but collision that comes into the sphere, or is turned on or off, after the capture is missed until the
+ * next one. Read only between captures and refreshes, so camera modes computing in parallel can share it.
+ */
+class FSPCameraCollisionSnapshot
+{
+public:
+	FSPCameraCollisionSnapshot();
+	~FSPCameraCollisionSnapshot();
+
+	/** Gathers everything blocking Channel within Radius of Center. Nothing is left out, each sweep skips the actor it ignores */
+	void Capture(const UWorld* World, const FVector& InCenter, float InRadius, ECollisionChannel InChannel);
+
+	/** Moves the captured movable bodies to where the physics scene has them now, taking its read lock once */
+	void RefreshTransforms(const UWorld* World);
+
+	void Reset();
+
+	bool IsCaptured() const
+	{
+		return bCaptured;
+	}
+
+	/** True if a sweep of a SweepRadius sphere from Start to End stays inside the captured sphere, and so can't hit anything that wasn't gathered */
+	bool Covers(const FVector& Start, const FVector& End, float SweepRadius) const;
+
+	/**
+	 * First blocking hit sweeping a SweepRadius sphere, or a line if it's 0, from Start to End against the captured bodies, as
+	 * UWorld::SweepSingleByChannel would report it. Safe on any thread.
+	 */
+	bool SweepSingle(FHitResult& OutHit, const FVector& Start, const FVector& End, float SweepRadius, const AActor* IgnoreActor = nullptr) const;
+
+	const FVector& GetCenter() const { return Center; }
+	float GetRadius() const { return Radius; }
+	ECollisionChannel GetChannel() const { return Channel; }
+	int32 GetNumBodies() const { return Bodies.Num(); }
+
+private:
+	/** A body's simple collision shapes and where they are, defined with the physics types it holds */
+	struct FCapturedBody;
+
+	TArray<FCapturedBody> Bodies;
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.f;
+	ECollisionChannel Channel = ECC_Camera;
+	bool bCaptured = false;
+};
@@ -2,11 +2,21 @@
 
 #include "SPCameraMode.h"
 
+#include "Algo/Sort.h"
 #include "Camera/CameraShakeBase.h"
 #include "DrawDebugHelpers.h"
 
+#include "SPCameraShakeBatch.h"
 #include "SPPlayerCameraManager.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 SPCameraAutofocus = 1;
+static FAutoConsoleVariableRef CVar_SPCameraAutofocus(TEXT("SP.Camera.Autofocus"), SPCameraAutofocus,
+	TEXT("True to let camera modes with bUseAutofocus measure focus distance with async traces, false to always focus on the view target's location."), ECVF_Default);
 
 USPCameraMode::USPCameraMode()
 	: TransitionInTime(0.5f)
@@ -23,6 +33,11 @@ void USPCameraMode::SkipNextInterpolation()
 {
 	bSkipNextInterpolation = true;
 	ShakeScaleInterpolator.Reset();
+
+	// traces from before a cut measured a different view
+	AutofocusInterpolator.Reset();
+	PendingAutofocusTraces.Reset();
+	AutofocusDistance = 0.f;
 }
 
 void USPCameraMode::OnBecomeActive(AActor* ViewTarget, USPCameraMode* PreviouslyActiveMode, bool bAlreadyInStack)
@@ -49,7 +64,11 @@ void USPCameraMode::OnBecomeActive(AActor* ViewTarget, USPCameraMode* Previously
 
 void USPCameraMode::OnBecomeInactive(AActor* ViewTarget, USPCameraMode* NewActiveMode)
 {
-	StopAmbientCameraShake(false);
+	// batched shakes fade out with this mode's blend weight instead, until it leaves the stack
+	if (AmbientShakeHandle == INDEX_NONE)
+	{
+		StopAmbientCameraShake(false);
+	}
 
 	bIsActive = false;
 }
@@ -68,7 +87,8 @@ void USPCameraMode::ApplyCineCamSettings(FTViewTarget& OutVT, UCineCameraCompone
 		if (bUseCineCamSettings)
 		{
 			CineCamComp->SetCurrentFocalLength(CineCam_CurrentFocalLength);
-			const float FocusDistance = GetDesiredFocusDistance(OutVT.Target, LastCameraToWorld) + CineCam_FocusDistanceAdjustment;
+			const float FocusDistance = (bUseAutofocus && SPCameraAutofocus ? UpdateAutofocus(OutVT.Target, LastCameraToWorld, DeltaTime) : GetDesiredFocusDistance(OutVT.Target, LastCameraToWorld))
+				+ CineCam_FocusDistanceAdjustment;
 			CineCamComp->FocusSettings.ManualFocusDistance = FocusDistance;
 			CineCamComp->FocusSettings.FocusMethod = ECameraFocusMethod::Manual;
 			CineCamComp->CurrentAperture = CineCam_CurrentAperture;
@@ -106,8 +126,71 @@ float USPCameraMode::GetDesiredFocusDistance(AActor* ViewTarget, const FTransfor
 	return (FocusPoint - ViewToWorld.GetLocation()).Size();
 }
 
+float USPCameraMode::UpdateAutofocus(AActor* ViewTarget, const FTransform& ViewToWorld, float DeltaTime)
+{
+	const float DesiredFocusDistance = GetDesiredFocusDistance(ViewTarget, ViewToWorld);
+	UWorld* const World = ViewTarget ? ViewTarget->GetWorld() : nullptr;
+	if (World == nullptr || DesiredFocusDistance <= UE_KINDA_SMALL_NUMBER)
+	{
+		PendingAutofocusTraces.Reset();
+		return DesiredFocusDistance;
+	}
+
+	// last frame's traces, as depth along the view so the off center ones measure the same focal plane as the center one.
+	// anything that didn't come back (world paused, mode blended out for a while) is just dropped
+	float Depths[5];
+	int32 NumDepths = 0;
+	for (const FTraceHandle& Handle : PendingAutofocusTraces)
+	{
+		FTraceDatum TraceData;
+		if (World->QueryTraceData(Handle, TraceData))
+		{
+			const FVector TraceDir = (TraceData.End - TraceData.Start).GetSafeNormal();
+			const FVector HitLocation = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit ? TraceData.OutHits[0].Location : TraceData.End;
+			Depths[NumDepths++] = float(FVector::DotProduct(HitLocation - TraceData.Start, ViewToWorld.GetUnitAxis(EAxis::X)));
+		}
+	}
+	PendingAutofocusTraces.Reset();
+
+	// median, one stray ray through a gap or into a thin pole doesn't move the focus
+	if (NumDepths > 0)
+	{
+		Algo::Sort(MakeArrayView(Depths, NumDepths));
+		AutofocusDistance = FMath::Max(Depths[NumDepths / 2], 1.f);
+	}
+	else if (AutofocusDistance <= 0.f)
+	{
+		AutofocusDistance = DesiredFocusDistance;
+	}
+
+	// center trace at the view target, four around it in the view plane. misses come back as the view target's distance
+	const FVector TraceStart = ViewToWorld.GetLocation();
+	const FVector FocusPoint = TraceStart + (ViewTarget->GetActorLocation() - TraceStart).GetSafeNormal() * DesiredFocusDistance;
+	const float PatternRadius = DesiredFocusDistance * FMath::Tan(FMath::DegreesToRadians(AutofocusPatternAngle));
+	const FVector Right = ViewToWorld.GetUnitAxis(EAxis::Y) * PatternRadius;
+	const FVector Up = ViewToWorld.GetUnitAxis(EAxis::Z) * PatternRadius;
+	const FVector TraceEnds[] = { FocusPoint, FocusPoint + Right, FocusPoint - Right, FocusPoint + Up, FocusPoint - Up };
+
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SPCamera_Autofocus), false);
+	for (const FVector& TraceEnd : TraceEnds)
+	{
+		PendingAutofocusTraces.Add(World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, AutofocusTraceChannel, QueryParams));
+	}
+
+	return AutofocusInterpolator.Eval(AutofocusDistance, DeltaTime);
+}
+
 void USPCameraMode::UpdateCamera(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, FTViewTarget& OutVT)
 {
+	BeginCameraUpdate(ViewTarget, DeltaTime, OutVT);
+	ComputeCamera(ViewTarget, DeltaTime, OutVT);
+	FinishCameraUpdate(ViewTarget, CineCamComp, DeltaTime, OutVT);
+}
+
+void USPCameraMode::BeginCameraUpdate(class AActor* ViewTarget, float DeltaTime, FTViewTarget& OutVT)
+{
+	CaptureViewTargetSnapshot(ViewTarget);
+
 	if (ViewTarget && bUseViewTargetCameraComponent)
 	{
 		if (UCameraComponent* const Cam = ViewTarget->FindComponentByClass<UCameraComponent>())
@@ -116,10 +199,10 @@ void USPCameraMode::UpdateCamera(class AActor* ViewTarget, UCineCameraComponent*
 		}
 	}
 
-	if (CameraShakeInstance)
+	if (CameraShakeInstance || AmbientShakeHandle != INDEX_NONE)
 	{
 		// cover all the else clauses below
-		CameraShakeInstance->ShakeScale = 1.f;
+		float ShakeScale = 1.f;
 
 		if (bScaleShakeWithViewTargetVelocity)
 		{
@@ -127,28 +210,73 @@ void USPCameraMode::UpdateCamera(class AActor* ViewTarget, UCineCameraComponent*
 			{
 				const float Speed = ViewTarget->GetVelocity().Size();
 				const float GoalScale = FMath::GetMappedRangeValueClamped(ShakeScaling_SpeedRange, ShakeScaling_ScaleRange, Speed);
-				CameraShakeInstance->ShakeScale = ShakeScaleInterpolator.Eval(GoalScale, DeltaTime);
+				ShakeScale = ShakeScaleInterpolator.Eval(GoalScale, DeltaTime);
 
 				if (bDrawDebugShake)
 				{
 #if ENABLE_DRAW_DEBUG
 					::FlushDebugStrings(ViewTarget->GetWorld());
-					::DrawDebugString(ViewTarget->GetWorld(), ViewTarget->GetActorLocation() + FVector(0, 0, 60.f), FString::Printf(TEXT("%f"), CameraShakeInstance->ShakeScale), nullptr, FColor::Yellow);
+					::DrawDebugString(ViewTarget->GetWorld(), ViewTarget->GetActorLocation() + FVector(0, 0, 60.f), FString::Printf(TEXT("%f"), ShakeScale), nullptr, FColor::Yellow);
 #endif
 				}
 			}
 		}
+
+		if (CameraShakeInstance)
+		{
+			CameraShakeInstance->ShakeScale = ShakeScale;
+		}
+		else
+		{
+			PlayerCamera->GetCameraShakeBatch().SetScale(AmbientShakeHandle, ShakeScale);
+		}
 	}
 }
 
+void USPCameraMode::CaptureViewTargetSnapshot(AActor* ViewTarget)
+{
+	APlayerController* const PC = GetOwningPC();
+
+	ViewTargetSnapshot = FSPCameraViewTargetSnapshot();
+	ViewTargetSnapshot.bHasWorld = ViewTarget && ViewTarget->GetWorld();
+	ViewTargetSnapshot.bCanUpdate = ViewTargetSnapshot.bHasWorld && IsValid(ViewTarget) && PC;
+	if (ViewTarget)
+	{
+		ViewTargetSnapshot.ViewTargetToWorld = ViewTarget->GetActorTransform();
+		ViewTargetSnapshot.Velocity = ViewTarget->GetVelocity();
+
+		if (const ACharacter* const Char = Cast<ACharacter>(ViewTarget))
+		{
+			ViewTargetSnapshot.bIsCharacter = true;
+			if (const UCharacterMovementComponent* const CharMoveComp = Char->GetCharacterMovement())
+			{
+				ViewTargetSnapshot.bHasCharacterMovement = true;
+				ViewTargetSnapshot.CharacterMovementVelocity = CharMoveComp->Velocity;
+			}
+		}
+	}
+	if (PC)
+	{
+		ViewTargetSnapshot.ControlRotation = PC->GetControlRotation();
+	}
+}
 
 void USPCameraMode::StartAmbientCameraShake()
 {
-	if (CameraShakeInstance == nullptr)
+	// a batched shake still fading out with this mode picks up where it was
+	if (CameraShakeInstance == nullptr && AmbientShakeHandle == INDEX_NONE)
 	{
 		if (PlayerCamera && (CameraShakeClass != nullptr))
 		{
-			CameraShakeInstance = PlayerCamera->StartCameraShake(CameraShakeClass, 1.f);
+			const UWaveOscillatorCameraShakePattern* const BatchablePattern = FSPCameraShakeBatch::IsEnabled() ? FSPCameraShakeBatch::GetBatchablePattern(CameraShakeClass) : nullptr;
+			if (BatchablePattern)
+			{
+				AmbientShakeHandle = PlayerCamera->GetCameraShakeBatch().Start(BatchablePattern);
+			}
+			else
+			{
+				CameraShakeInstance = PlayerCamera->StartCameraShake(CameraShakeClass, 1.f);
+			}
 		}
 	}
 }
@@ -159,6 +287,36 @@ void USPCameraMode::StopAmbientCameraShake(bool bImmediate)
 		PlayerCamera->StopCameraShake(CameraShakeInstance, bImmediate);
 		CameraShakeInstance = nullptr;
 	}
+
+	if (AmbientShakeHandle != INDEX_NONE)
+	{
+		PlayerCamera->GetCameraShakeBatch().Stop(AmbientShakeHandle, bImmediate);
+		AmbientShakeHandle = INDEX_NONE;
+	}
+}
+
+void USPCameraMode::SetAmbientShakeWeight(float Weight)
+{
+	if (AmbientShakeHandle != INDEX_NONE)
+	{
+		PlayerCamera->GetCameraShakeBatch().SetWeight(AmbientShakeHandle, Weight);
+	}
+}
+
+const FSPPostProcessBlendMask& USPCameraMode::GetPostProcessBlendMask()
+{
+	if (!bPostProcessBlendMaskBuilt)
+	{
+		PostProcessBlendMask = FSPCameraViewBlend::MakePostProcessMask(BlendedPostProcessSettings);
+		bPostProcessBlendMaskBuilt = true;
+	}
+	return PostProcessBlendMask;
+}
+
+void USPCameraMode::OnRemovedFromStack()
+{
+	// fully blended out, the shake has faded with it
+	StopAmbientCameraShake(true);
 }
 
 bool USPCameraMode::ShouldLockOutgoingPOV() const
@@ -177,9 +335,15 @@ void USPCameraMode::ResetToDefaultSettings_Implementation()
 	CineCam_CurrentAperture = ThisCDO->CineCam_CurrentAperture;
 	CineCam_FocusDistanceAdjustment = ThisCDO->CineCam_FocusDistanceAdjustment;
 	bUseCustomFocusDistance = ThisCDO->bUseCustomFocusDistance;
+	bUseAutofocus = ThisCDO->bUseAutofocus;
+	AutofocusTraceChannel = ThisCDO->AutofocusTraceChannel;
+	AutofocusPatternAngle = ThisCDO->AutofocusPatternAngle;
+	AutofocusInterpolator = ThisCDO->AutofocusInterpolator;
 	TransitionInTime = ThisCDO->TransitionInTime;
 	TransitionParams = ThisCDO->TransitionParams;
 	ShakeScaling_SpeedRange  = ThisCDO->ShakeScaling_SpeedRange;
 	ShakeScaling_ScaleRange = ThisCDO->ShakeScaling_ScaleRange;
 	ShakeScaleInterpolator = ThisCDO->ShakeScaleInterpolator;
+	BlendedPostProcessSettings = ThisCDO->BlendedPostProcessSettings;
+	bPostProcessBlendMaskBuilt = false;
 }
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include "Camera/PlayerCameraManager.h"
 #include "CineCameraComponent.h"
 #include "CoreMinimal.h"
+#include "SPCameraViewBlend.h"
 #include "SPInterpolators.h"
+#include "WorldCollision.h"
 
 #include "SPCameraMode.generated.h"
 
@@ -13,6 +15,32 @@ class ASPPlayerCameraManager;
 class ASPPlayerController;
 class UCameraShakeBase;
 
+/**
+ * View target state captured on the game thread at the start of a camera update, so the rest of the update can read it from any thread
+ */
+struct FSPCameraViewTargetSnapshot
+{
+	/** True when there is a view target in a world to update against */
+	bool bHasWorld = false;
+
+	/** True when the view target is valid and there is an owning player controller */
+	bool bCanUpdate = false;
+
+	FTransform ViewTargetToWorld;
+	FVector Velocity = FVector::ZeroVector;
+
+	/** Set for character view targets, whose movement component velocity is used for predictive look at */
+	bool bIsCharacter = false;
+	bool bHasCharacterMovement = false;
+	FVector CharacterMovementVelocity = FVector::ZeroVector;
+
+	/** Vertical offset of the view target's mesh, for modes that follow the pelvis */
+	float MeshHeightOffset = 0.f;
+
+	/** Owning player controller's control rotation */
+	FRotator ControlRotation = FRotator::ZeroRotator;
+};
+
 /**
  * Base class for Camera Mode implementations. Has functions and settings for camera activation, updating, and whether or not to use cine cam properties
  */
@@ -33,11 +61,26 @@ public:
 	/** Notify camera that it is no longer the primary camera.  Might still be processing as it blends out. */
 	virtual void OnBecomeInactive(AActor* ViewTarget, USPCameraMode* NewActiveMode);
 
-	/** Called by the SPCameraManager in UpdateViewTarget, camera mode implementations can use this to tailor their update logic as needed*/
+	/** Called by the SPCameraManager in UpdateViewTarget, camera mode implementations can use this to tailor their update logic as needed. Runs BeginCameraUpdate, ComputeCamera and FinishCameraUpdate in a row by default. */
 	virtual void UpdateCamera(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, struct FTViewTarget& OutVT);
 
+	/**
+	 * True if ComputeCamera is safe to run on a worker thread, letting the SPCameraManager compute several blending modes at once.
+	 * Modes returning true only read ViewTargetSnapshot and write their own state and OutVT in ComputeCamera, anything else waits for FinishCameraUpdate.
+	 */
+	virtual bool SupportsParallelUpdate() const { return false; }
+
+	/** Game thread. Base camera mode update (view target camera, shake scaling) and the snapshot ComputeCamera reads */
+	virtual void BeginCameraUpdate(class AActor* ViewTarget, float DeltaTime, struct FTViewTarget& OutVT);
+
+	/** Computes this mode's POV. Runs on a worker thread when SupportsParallelUpdate is true */
+	virtual void ComputeCamera(class AActor* ViewTarget, float DeltaTime, struct FTViewTarget& OutVT) {}
+
+	/** Game thread. Applies ComputeCamera's results to the world and player controller */
+	virtual void FinishCameraUpdate(class AActor* ViewTarget, UCineCameraComponent* CineCamComp, float DeltaTime, struct FTViewTarget& OutVT) {}
+
 	/** Called when this mode is fully blended out and removed from the stack, as in it has no more influence */
-	virtual void OnRemovedFromStack() {};
+	virtual void OnRemovedFromStack();
 
 	/** Returns camera transition time for this camera mode */
 	float GetTransitionTime() const;
@@ -114,6 +157,12 @@ public:
 	/** Stops the specified ambient camera shake. Set immediate to true to ignore any blendouts and stop now */
 	void StopAmbientCameraShake(bool bImmediate);
 
+	/** Scales a batched ambient shake by this mode's weight in the blend stack, see FSPCameraShakeBatch */
+	void SetAmbientShakeWeight(float Weight);
+
+	/** BlendedPostProcessSettings as a mask for FSPCameraViewBlend */
+	const FSPPostProcessBlendMask& GetPostProcessBlendMask();
+
 protected:
 
 	/** Flag to keep track of whether the current camera mode is active */
@@ -127,6 +176,9 @@ protected:
 	UPROPERTY(transient)
 	UCameraShakeBase* CameraShakeInstance = nullptr;
 
+	/** FSPCameraShakeBatch handle of the ambient shake, when CameraShakeClass could be batched instead of creating CameraShakeInstance */
+	int32 AmbientShakeHandle = INDEX_NONE;
+
 	/** When true, camera shake will be scaled using the ShakeScaling_SpeedRange and the ShakeScaling_ScaleRange */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CameraShake")
 	bool bScaleShakeWithViewTargetVelocity = false;
@@ -155,6 +207,32 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CineCam", meta = (EditCondition = bUseCineCamSettings))
 	bool bUseCustomFocusDistance;
 
+	/**
+	 * When true, focus distance is measured with a small pattern of async traces around the view target instead of taken to its actor location,
+	 * so the focus lands on whatever is actually in front of the camera there. Results arrive a frame late and are smoothed by AutofocusInterpolator.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CineCam", meta = (EditCondition = bUseCineCamSettings))
+	bool bUseAutofocus = false;
+
+	/** Collision channel the autofocus traces run against */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CineCam", meta = (EditCondition = bUseAutofocus))
+	TEnumAsByte<ECollisionChannel> AutofocusTraceChannel = ECC_Visibility;
+
+	/** Angle in degrees between the center autofocus trace and the four around it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CineCam", meta = (EditCondition = bUseAutofocus, ClampMin = "0.0", ClampMax = "30.0"))
+	float AutofocusPatternAngle = 2.f;
+
+	/** Smooths the traced focus distance so single frames of hits and misses don't pump the depth of field */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CineCam", meta = (EditCondition = bUseAutofocus))
+	FIIRInterpolatorFloat AutofocusInterpolator = FIIRInterpolatorFloat(8.f);
+
+	/**
+	 * Post process settings this mode overrides, by FPostProcessSettings member name. Only these are blended with the other modes in the blend stack,
+	 * everything else comes from the incoming mode. Settings need a bOverride_ flag and a float, vector or color value to blend.
+	 */
+	UPROPERTY(EditAnywhere, Category = "PostProcess")
+	TArray<FName> BlendedPostProcessSettings = { GET_MEMBER_NAME_CHECKED(FPostProcessSettings, DepthOfFieldFstop), GET_MEMBER_NAME_CHECKED(FPostProcessSettings, DepthOfFieldFocalDistance) };
+
 	/** When true, custom view pitch limits will be used for this camera mode */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera Manager Overrides")
 	bool bOverrideViewPitchMinAndMax = false;
@@ -176,9 +254,28 @@ protected:
 	/** Attempts to determine the camera mode's desired focus distance, whether it be calculated normally or if a custom focus distance method is used  */
 	virtual float GetDesiredFocusDistance(AActor* ViewTarget, const FTransform& ViewToWorld) const;
 
+	/** Collects last frame's autofocus traces and issues this frame's, returns the smoothed focus distance. Game thread. */
+	float UpdateAutofocus(AActor* ViewTarget, const FTransform& ViewToWorld, float DeltaTime);
+
+	/** Autofocus traces issued last frame, read back on the next */
+	TArray<FTraceHandle, TInlineAllocator<5>> PendingAutofocusTraces;
+
+	/** Last robust estimate from the autofocus traces, held while traces are in flight */
+	float AutofocusDistance = 0.f;
+
+	/** Built from BlendedPostProcessSettings on first use */
+	FSPPostProcessBlendMask PostProcessBlendMask;
+	bool bPostProcessBlendMaskBuilt = false;
+
 	/** When true, camera modes will reset certain interpolators. Useful for hard cuts or unique camera situations */
 	bool bSkipNextInterpolation = false;
 
 	/** Camera to world transform that is cached and can be used when something wants to easily access the camera's transform */
 	FTransform LastCameraToWorld;
+
+	/** Fills ViewTargetSnapshot from the view target, on the game thread */
+	virtual void CaptureViewTargetSnapshot(AActor* ViewTarget);
+
+	/** View target state for the current update, see BeginCameraUpdate */
+	FSPCameraViewTargetSnapshot ViewTargetSnapshot;
 };
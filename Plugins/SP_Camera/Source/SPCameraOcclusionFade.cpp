@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SPCameraOcclusionFade.h"
+
+#include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+
+namespace SPCameraOcclusionFade
+{
+	/** Distance from Location to the surface of Character's capsule, negative inside it. Assumes an upright capsule. */
+	static bool GetDistanceToCapsule(const ACharacter* Character, const FVector& Location, float& OutDistance)
+	{
+		const UCapsuleComponent* const Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+		if (Capsule == nullptr)
+		{
+			return false;
+		}
+
+		const FVector CapsuleCenter = Capsule->GetComponentLocation();
+		const FVector Offset = FVector(0.f, 0.f, Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
+		OutDistance = FMath::PointDistToSegment(Location, CapsuleCenter - Offset, CapsuleCenter + Offset) - Capsule->GetScaledCapsuleRadius();
+		return true;
+	}
+}
+
+void FSPCameraOcclusionFade::Update(APlayerController* PC, const FVector& CameraLocation, float DeltaTime)
+{
+	// a camera that moved far since the last refresh may be up against characters that weren't candidates then
+	TimeUntilRefresh -= DeltaTime;
+	if (TimeUntilRefresh <= 0.f || FVector::DistSquared(CameraLocation, LastRefreshLocation) > FMath::Square(CandidateRadius * 0.5f))
+	{
+		RefreshCandidates(PC, CameraLocation);
+	}
+
+	const float FadeStep = FadeTime > 0.f ? DeltaTime / FadeTime : 1.f;
+	for (int32 Idx = TrackedCharacters.Num() - 1; Idx >= 0; --Idx)
+	{
+		FTrackedCharacter& Tracked = TrackedCharacters[Idx];
+
+		float Distance = 0.f;
+		if (!SPCameraOcclusionFade::GetDistanceToCapsule(Tracked.Character.Get(), CameraLocation, Distance))
+		{
+			TrackedCharacters.RemoveAtSwap(Idx);
+			continue;
+		}
+
+		if (Distance < FadeOutDistance)
+		{
+			Tracked.bOccluding = true;
+		}
+		else if (Distance > FadeInDistance)
+		{
+			Tracked.bOccluding = false;
+		}
+
+		const float TargetFadeAmount = Tracked.bOccluding ? 1.f : 0.f;
+		SetFadeAmount(Tracked, FMath::Clamp(TargetFadeAmount, Tracked.FadeAmount - FadeStep, Tracked.FadeAmount + FadeStep), PC);
+	}
+}
+
+void FSPCameraOcclusionFade::Reset(APlayerController* PC)
+{
+	for (FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		SetFadeAmount(Tracked, 0.f, PC);
+	}
+	TrackedCharacters.Reset();
+	TimeUntilRefresh = 0.f;
+}
+
+float FSPCameraOcclusionFade::GetFadeAmount(const ACharacter* Character) const
+{
+	const FTrackedCharacter* const Tracked = TrackedCharacters.FindByPredicate([Character](const FTrackedCharacter& Entry) { return Entry.Character.Get() == Character; });
+	return Tracked ? Tracked->FadeAmount : 0.f;
+}
+
+void FSPCameraOcclusionFade::RefreshCandidates(APlayerController* PC, const FVector& CameraLocation)
+{
+	TimeUntilRefresh = CandidateRefreshInterval;
+	LastRefreshLocation = CameraLocation;
+
+	UWorld* const World = PC ? PC->GetWorld() : nullptr;
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	// characters still faded stay until they've faded back in, whatever their distance
+	TrackedCharacters.RemoveAllSwap([](const FTrackedCharacter& Tracked)
+	{
+		return !Tracked.Character.IsValid() || (Tracked.FadeAmount <= 0.f && !Tracked.bHidden);
+	});
+
+	for (TActorIterator<ACharacter> It(World); It; ++It)
+	{
+		ACharacter* const Character = *It;
+		float Distance = 0.f;
+		if (SPCameraOcclusionFade::GetDistanceToCapsule(Character, CameraLocation, Distance) && Distance < CandidateRadius
+			&& !TrackedCharacters.ContainsByPredicate([Character](const FTrackedCharacter& Tracked) { return Tracked.Character.Get() == Character; }))
+		{
+			TrackedCharacters.Add({ Character });
+		}
+	}
+}
+
+void FSPCameraOcclusionFade::SetFadeAmount(FTrackedCharacter& Tracked, float NewFadeAmount, APlayerController* PC)
+{
+	ACharacter* const Character = Tracked.Character.Get();
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	// render state only changes when the fade does, not every frame a character sits faded
+	if (NewFadeAmount != Tracked.FadeAmount)
+	{
+		Tracked.FadeAmount = NewFadeAmount;
+		Character->ForEachComponent<UPrimitiveComponent>(false, [this, NewFadeAmount](UPrimitiveComponent* Primitive)
+		{
+			Primitive->SetScalarParameterForCustomPrimitiveData(FadeParameterName, NewFadeAmount);
+		});
+	}
+
+	const bool bShouldHide = bHideWhenFaded && Tracked.FadeAmount >= 1.f;
+	if (PC && bShouldHide != Tracked.bHidden)
+	{
+		Tracked.bHidden = bShouldHide;
+		if (bShouldHide)
+		{
+			PC->HiddenActors.AddUnique(Character);
+		}
+		else
+		{
+			PC->HiddenActors.Remove(Character);
+		}
+	}
+}
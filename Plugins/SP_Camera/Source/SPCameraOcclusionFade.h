@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "SPCameraOcclusionFade.generated.h"
+
+class ACharacter;
+class APlayerController;
+
+/**
+ * Fades out characters the camera gets too close to, rather than popping them in and out of the player controller's HiddenActors.
+ * Characters near the camera are kept in a candidate list refreshed a few times a second, and start fading once the camera comes within
+ * FadeOutDistance of their capsule, only fading back in past the wider FadeInDistance.
+ * The fade amount, 0 fully visible to 1 fully faded, goes to the FadeParameterName custom primitive data of the character's primitives for
+ * materials with a dithered opacity mask. Fully faded characters are also hidden, for materials without one.
+ */
+USTRUCT(BlueprintType)
+struct FSPCameraOcclusionFade
+{
+	GENERATED_BODY()
+
+	/** Characters start fading out when the camera is closer than this to their capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	float FadeOutDistance = 15.f;
+
+	/** Faded characters fade back in once the camera is further than this from their capsule. Wider than FadeOutDistance so a camera sitting on the edge doesn't flicker. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	float FadeInDistance = 40.f;
+
+	/** Seconds for a full fade out or in, 0 to pop */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade", meta = (ClampMin = "0.0"))
+	float FadeTime = 0.15f;
+
+	/** Custom primitive data parameter the fade amount is written to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	FName FadeParameterName = TEXT("CameraOcclusionFade");
+
+	/** When true, fully faded characters are added to the player controller's HiddenActors until they start fading back in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	bool bHideWhenFaded = true;
+
+	/** Characters within this of the camera are checked every frame, the rest wait for the next candidate refresh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	float CandidateRadius = 500.f;
+
+	/** Seconds between candidate refreshes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OcclusionFade")
+	float CandidateRefreshInterval = 0.25f;
+
+	/** Fades characters around CameraLocation, on the game thread after the camera has moved */
+	void Update(APlayerController* PC, const FVector& CameraLocation, float DeltaTime);
+
+	/** Fades every tracked character straight back in and forgets them */
+	void Reset(APlayerController* PC);
+
+	/** 0 fully visible to 1 fully faded, 0 for untracked characters */
+	float GetFadeAmount(const ACharacter* Character) const;
+
+	int32 GetNumTrackedCharacters() const
+	{
+		return TrackedCharacters.Num();
+	}
+
+private:
+	struct FTrackedCharacter
+	{
+		TWeakObjectPtr<ACharacter> Character;
+		float FadeAmount = 0.f;
+		bool bOccluding = false;
+		bool bHidden = false;
+	};
+
+	void RefreshCandidates(APlayerController* PC, const FVector& CameraLocation);
+	void SetFadeAmount(FTrackedCharacter& Tracked, float NewFadeAmount, APlayerController* PC);
+
+	TArray<FTrackedCharacter> TrackedCharacters;
+	FVector LastRefreshLocation = FVector::ZeroVector;
+	float TimeUntilRefresh = 0.f;
+};
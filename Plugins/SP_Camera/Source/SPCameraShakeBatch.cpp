@@ -0,0 +1,240 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SPCameraShakeBatch.h"
+
+#include "Camera/CameraShakeBase.h"
+#include "Camera/CameraTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+#include "WaveOscillatorCameraShakePattern.h"
+
+static int32 SPCameraBatchedShakes = 1;
+static FAutoConsoleVariableRef CVar_SPCameraBatchedShakes(TEXT("SP.Camera.BatchedShakes"), SPCameraBatchedShakes,
+	TEXT("True to evaluate camera modes' looping wave oscillator ambient shakes together, weighted by blend weight, instead of as separate camera shakes. Takes effect the next time a mode starts its shake."), ECVF_Default);
+
+static float SPCameraShakeLODThreshold = 0.01f;
+static FAutoConsoleVariableRef CVar_SPCameraShakeLODThreshold(TEXT("SP.Camera.ShakeLODThreshold"), SPCameraShakeLODThreshold,
+	TEXT("Batched ambient shakes whose blend weight times shake scale is below this are suspended rather than evaluated."), ECVF_Default);
+
+namespace SPCameraShakeBatch
+{
+	/** Oscillators in FShake lane order, null for the unused last rotation lane */
+	static void GetOscillators(const UWaveOscillatorCameraShakePattern* Pattern, const FWaveOscillator* (&OutOscillators)[2][4])
+	{
+		OutOscillators[0][0] = &Pattern->X;
+		OutOscillators[0][1] = &Pattern->Y;
+		OutOscillators[0][2] = &Pattern->Z;
+		OutOscillators[0][3] = &Pattern->FOV;
+		OutOscillators[1][0] = &Pattern->Pitch;
+		OutOscillators[1][1] = &Pattern->Yaw;
+		OutOscillators[1][2] = &Pattern->Roll;
+		OutOscillators[1][3] = nullptr;
+	}
+}
+
+bool FSPCameraShakeBatch::IsEnabled()
+{
+	return SPCameraBatchedShakes != 0;
+}
+
+const UWaveOscillatorCameraShakePattern* FSPCameraShakeBatch::GetBatchablePattern(TSubclassOf<UCameraShakeBase> ShakeClass)
+{
+	const UCameraShakeBase* const ShakeCDO = ShakeClass ? ShakeClass->GetDefaultObject<UCameraShakeBase>() : nullptr;
+	const UWaveOscillatorCameraShakePattern* const Pattern = ShakeCDO ? Cast<UWaveOscillatorCameraShakePattern>(ShakeCDO->GetRootShakePattern()) : nullptr;
+
+	return IsBatchable(Pattern) ? Pattern : nullptr;
+}
+
+bool FSPCameraShakeBatch::IsBatchable(const UWaveOscillatorCameraShakePattern* Pattern)
+{
+	// shakes that end on their own need the regular camera shake to end them
+	if (Pattern == nullptr || Pattern->Duration > 0.f)
+	{
+		return false;
+	}
+
+	// silent oscillators don't matter whatever their waveform
+	const FWaveOscillator* Oscillators[2][4];
+	SPCameraShakeBatch::GetOscillators(Pattern, Oscillators);
+	for (int32 Group = 0; Group < 2; ++Group)
+	{
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const FWaveOscillator* const Oscillator = Oscillators[Group][Lane];
+			if (Oscillator && Oscillator->Amplitude != 0.f && Oscillator->Waveform != EOscillatorWaveform::SineWave)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void FSPCameraShakeBatch::InitShake(FShake& Shake, const UWaveOscillatorCameraShakePattern* Pattern) const
+{
+	const FWaveOscillator* Oscillators[2][4];
+	SPCameraShakeBatch::GetOscillators(Pattern, Oscillators);
+
+	// FOV isn't affected by the location multipliers
+	const float AmplitudeMultipliers[2][4] = { { Pattern->LocationAmplitudeMultiplier, Pattern->LocationAmplitudeMultiplier, Pattern->LocationAmplitudeMultiplier, 1.f }, { Pattern->RotationAmplitudeMultiplier, Pattern->RotationAmplitudeMultiplier, Pattern->RotationAmplitudeMultiplier, 0.f } };
+	const float FrequencyMultipliers[2][4] = { { Pattern->LocationFrequencyMultiplier, Pattern->LocationFrequencyMultiplier, Pattern->LocationFrequencyMultiplier, 1.f }, { Pattern->RotationFrequencyMultiplier, Pattern->RotationFrequencyMultiplier, Pattern->RotationFrequencyMultiplier, 0.f } };
+
+	for (int32 Group = 0; Group < 2; ++Group)
+	{
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const FWaveOscillator* const Oscillator = Oscillators[Group][Lane];
+			Shake.Amplitudes[Group][Lane] = Oscillator ? Oscillator->Amplitude * AmplitudeMultipliers[Group][Lane] : 0.f;
+			Shake.AngularFrequencies[Group][Lane] = Oscillator ? Oscillator->Frequency * FrequencyMultipliers[Group][Lane] * UE_TWO_PI : 0.f;
+		}
+	}
+
+	Shake.Pattern = Pattern;
+	Shake.BlendInTime = Pattern->BlendInTime;
+	Shake.BlendOutTime = Pattern->BlendOutTime;
+}
+
+int32 FSPCameraShakeBatch::Start(const UWaveOscillatorCameraShakePattern* Pattern)
+{
+	if (Pattern == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	// a stopped shake of the same pattern only needs new phases
+	int32 Handle = Shakes.IndexOfByPredicate([Pattern](const FShake& Shake) { return !Shake.bInUse && Shake.Pattern.Get() == Pattern; });
+	if (Handle == INDEX_NONE)
+	{
+		Handle = Shakes.IndexOfByPredicate([](const FShake& Shake) { return !Shake.bInUse; });
+		if (Handle == INDEX_NONE)
+		{
+			Handle = Shakes.AddDefaulted();
+		}
+		InitShake(Shakes[Handle], Pattern);
+	}
+
+	FShake& Shake = Shakes[Handle];
+	const FWaveOscillator* Oscillators[2][4];
+	SPCameraShakeBatch::GetOscillators(Pattern, Oscillators);
+	for (int32 Group = 0; Group < 2; ++Group)
+	{
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			const FWaveOscillator* const Oscillator = Oscillators[Group][Lane];
+			Shake.Phases[Group][Lane] = (Oscillator && Oscillator->InitialOffsetType == EInitialWaveOscillatorOffsetType::Random) ? FMath::FRand() * UE_TWO_PI : 0.f;
+		}
+	}
+
+	Shake.Scale = 1.f;
+	Shake.Weight = 1.f;
+	Shake.BlendAlpha = Shake.BlendInTime > 0.f ? 0.f : 1.f;
+	Shake.bInUse = true;
+	Shake.bStopping = false;
+	return Handle;
+}
+
+void FSPCameraShakeBatch::Stop(int32 Handle, bool bImmediate)
+{
+	if (Shakes.IsValidIndex(Handle))
+	{
+		FShake& Shake = Shakes[Handle];
+		Shake.bStopping = true;
+		Shake.bInUse = !bImmediate && (Shake.BlendOutTime > 0.f);
+	}
+}
+
+void FSPCameraShakeBatch::SetScale(int32 Handle, float Scale)
+{
+	if (Shakes.IsValidIndex(Handle))
+	{
+		Shakes[Handle].Scale = Scale;
+	}
+}
+
+void FSPCameraShakeBatch::SetWeight(int32 Handle, float Weight)
+{
+	if (Shakes.IsValidIndex(Handle))
+	{
+		Shakes[Handle].Weight = Weight;
+	}
+}
+
+void FSPCameraShakeBatch::Apply(float DeltaTime, FMinimalViewInfo& InOutPOV)
+{
+	NumSuspended = 0;
+
+	const VectorRegister4Float DeltaTimes = VectorSetFloat1(DeltaTime);
+	const VectorRegister4Float TwoPi = VectorSetFloat1(UE_TWO_PI);
+	const VectorRegister4Float InvTwoPi = VectorSetFloat1(1.f / UE_TWO_PI);
+	VectorRegister4Float Sums[2] = { VectorZeroFloat(), VectorZeroFloat() };
+	bool bAnyApplied = false;
+
+	for (FShake& Shake : Shakes)
+	{
+		if (!Shake.bInUse)
+		{
+			continue;
+		}
+
+		if (Shake.bStopping)
+		{
+			Shake.BlendAlpha -= DeltaTime / Shake.BlendOutTime;
+			if (Shake.BlendAlpha <= 0.f)
+			{
+				Shake.bInUse = false;
+				continue;
+			}
+		}
+		else if (Shake.BlendAlpha < 1.f)
+		{
+			Shake.BlendAlpha = FMath::Min(Shake.BlendAlpha + DeltaTime / Shake.BlendInTime, 1.f);
+		}
+
+		// suspended shakes hold their phase, nobody can tell where a shake this faint was
+		const float Contribution = Shake.Scale * Shake.Weight * Shake.BlendAlpha;
+		if (Contribution < SPCameraShakeLODThreshold)
+		{
+			++NumSuspended;
+			continue;
+		}
+
+		const VectorRegister4Float ContributionRegister = VectorSetFloat1(Contribution);
+		for (int32 Group = 0; Group < 2; ++Group)
+		{
+			// advance and wrap each oscillator, so long running shakes don't lose precision
+			VectorRegister4Float Phases = VectorMultiplyAdd(VectorLoadAligned(&Shake.AngularFrequencies[Group].X), DeltaTimes, VectorLoadAligned(&Shake.Phases[Group].X));
+			Phases = VectorNegateMultiplyAdd(VectorFloor(VectorMultiply(Phases, InvTwoPi)), TwoPi, Phases);
+			VectorStoreAligned(Phases, &Shake.Phases[Group].X);
+
+			const VectorRegister4Float Values = VectorMultiply(VectorLoadAligned(&Shake.Amplitudes[Group].X), VectorSin(Phases));
+			Sums[Group] = VectorMultiplyAdd(Values, ContributionRegister, Sums[Group]);
+		}
+		bAnyApplied = true;
+	}
+
+	if (!bAnyApplied)
+	{
+		return;
+	}
+
+	// camera space, as camera shakes play by default
+	FVector4f LocationAndFOV, Rotation;
+	VectorStoreAligned(Sums[0], &LocationAndFOV.X);
+	VectorStoreAligned(Sums[1], &Rotation.X);
+
+	const FRotationMatrix CameraRot(InOutPOV.Rotation);
+	const FRotationMatrix OffsetRot(FRotator(Rotation.X, Rotation.Y, Rotation.Z));
+	InOutPOV.Location += CameraRot.TransformVector(FVector(LocationAndFOV.X, LocationAndFOV.Y, LocationAndFOV.Z));
+	InOutPOV.Rotation = (OffsetRot * CameraRot).Rotator();
+	InOutPOV.FOV += LocationAndFOV.W;
+}
+
+int32 FSPCameraShakeBatch::GetNumActive() const
+{
+	int32 NumActive = 0;
+	for (const FShake& Shake : Shakes)
+	{
+		NumActive += Shake.bInUse ? 1 : 0;
+	}
+	return NumActive;
+}
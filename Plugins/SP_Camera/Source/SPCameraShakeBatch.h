@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+class UCameraShakeBase;
+class UWaveOscillatorCameraShakePattern;
+struct FMinimalViewInfo;
+
+/**
+ * Evaluates the looping wave oscillator ambient shakes of every camera mode in the blend stack in one pass, instead of one camera shake object each.
+ * Each shake is weighted by its mode's blend weight and shake scale, and shakes contributing less than SP.Camera.ShakeLODThreshold are suspended
+ * rather than evaluated. Stopped shakes stay in the batch for the next mode starting the same shake, so switching modes doesn't create any.
+ */
+class FSPCameraShakeBatch
+{
+public:
+	/** True if camera modes should batch their ambient shakes, see SP.Camera.BatchedShakes */
+	static bool IsEnabled();
+
+	/** The shake's pattern if it can be batched, see IsBatchable. Null for anything else, which should play as a regular camera shake. */
+	static const UWaveOscillatorCameraShakePattern* GetBatchablePattern(TSubclassOf<UCameraShakeBase> ShakeClass);
+
+	/** True for looping wave oscillator patterns whose oscillators are all sine waves, the batch doesn't evaluate Perlin noise */
+	static bool IsBatchable(const UWaveOscillatorCameraShakePattern* Pattern);
+
+	/** Starts a shake playing Pattern, blending in over its BlendInTime. Returns its handle. */
+	int32 Start(const UWaveOscillatorCameraShakePattern* Pattern);
+
+	/** Stops a shake, blending out over its pattern's BlendOutTime unless bImmediate. The handle is no longer valid after this. */
+	void Stop(int32 Handle, bool bImmediate);
+
+	void SetScale(int32 Handle, float Scale);
+	void SetWeight(int32 Handle, float Weight);
+
+	/** Advances every shake by DeltaTime and applies their sum to InOutPOV in camera space */
+	void Apply(float DeltaTime, FMinimalViewInfo& InOutPOV);
+
+	/** Shakes started and not yet fully stopped */
+	int32 GetNumActive() const;
+
+	/** Active shakes skipped by the last Apply for contributing too little */
+	int32 GetNumSuspended() const { return NumSuspended; }
+
+	/** Shakes ever created, stopped ones are reused */
+	int32 GetNumCreated() const { return Shakes.Num(); }
+
+private:
+	/** Location X Y Z and FOV in the first lanes, rotation pitch yaw roll in the second */
+	struct FShake
+	{
+		FVector4f Amplitudes[2];
+		FVector4f AngularFrequencies[2];
+		FVector4f Phases[2];
+
+		TWeakObjectPtr<const UWaveOscillatorCameraShakePattern> Pattern;
+		float Scale = 1.f;
+		float Weight = 1.f;
+		float BlendAlpha = 0.f;
+		float BlendInTime = 0.f;
+		float BlendOutTime = 0.f;
+		bool bInUse = false;
+		bool bStopping = false;
+	};
+
+	void InitShake(FShake& Shake, const UWaveOscillatorCameraShakePattern* Pattern) const;
+
+	TArray<FShake> Shakes;
+	int32 NumSuspended = 0;
+};
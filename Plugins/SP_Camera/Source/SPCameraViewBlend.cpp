@@ -0,0 +1,261 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SPCameraViewBlend.h"
+
+#include "Camera/CameraTypes.h"
+#include "Engine/Scene.h"
+#include "UObject/UnrealType.h"
+
+namespace SPCameraViewBlend
+{
+	struct FBlendableSetting
+	{
+		FName Name;
+		const FBoolProperty* OverrideProperty = nullptr;
+		const FProperty* ValueProperty = nullptr;
+		int32 NumComponents = 1;
+		bool bDoubleComponents = false;
+
+		/** Value of entries that don't override the setting, when they still count towards the blend */
+		bool bHasFallback = false;
+		float IncomingFallback = 0.f;
+		float OutgoingFallback = 0.f;
+	};
+
+	static TArray<FBlendableSetting> BuildBlendableSettings()
+	{
+		const UScriptStruct* const SettingsStruct = FPostProcessSettings::StaticStruct();
+		const FString OverridePrefix(TEXT("bOverride_"));
+
+		TArray<FBlendableSetting> Settings;
+		for (TFieldIterator<FBoolProperty> It(SettingsStruct); It; ++It)
+		{
+			const FString OverrideName = It->GetName();
+			if (!OverrideName.StartsWith(OverridePrefix))
+			{
+				continue;
+			}
+
+			FBlendableSetting Setting;
+			Setting.Name = FName(*OverrideName.RightChop(OverridePrefix.Len()));
+			Setting.OverrideProperty = *It;
+			Setting.ValueProperty = SettingsStruct->FindPropertyByName(Setting.Name);
+
+			if (Setting.ValueProperty == nullptr)
+			{
+				continue;
+			}
+			else if (Setting.ValueProperty->IsA<FFloatProperty>())
+			{
+				Setting.NumComponents = 1;
+			}
+			else if (Setting.ValueProperty->IsA<FDoubleProperty>())
+			{
+				Setting.NumComponents = 1;
+				Setting.bDoubleComponents = true;
+			}
+			else if (const FStructProperty* const StructProperty = CastField<FStructProperty>(Setting.ValueProperty))
+			{
+				if (StructProperty->Struct == TBaseStructure<FLinearColor>::Get())
+				{
+					Setting.NumComponents = 4;
+				}
+				else if (StructProperty->Struct == TBaseStructure<FVector4>::Get())
+				{
+					Setting.NumComponents = 4;
+					Setting.bDoubleComponents = true;
+				}
+				else if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+				{
+					Setting.NumComponents = 3;
+					Setting.bDoubleComponents = true;
+				}
+				else if (StructProperty->Struct == TBaseStructure<FVector2D>::Get())
+				{
+					Setting.NumComponents = 2;
+					Setting.bDoubleComponents = true;
+				}
+				else
+				{
+					continue;
+				}
+			}
+			else
+			{
+				// enums, textures and the like have nothing to weigh
+				continue;
+			}
+
+			// what the blend stack has always assumed for modes leaving the f-stop alone, wide open coming in and f/8 going out
+			if (Setting.Name == GET_MEMBER_NAME_CHECKED(FPostProcessSettings, DepthOfFieldFstop))
+			{
+				Setting.bHasFallback = true;
+				Setting.IncomingFallback = 22.f;
+				Setting.OutgoingFallback = 8.f;
+			}
+
+			Settings.Add(Setting);
+		}
+		return Settings;
+	}
+
+	static const TArray<FBlendableSetting>& GetBlendableSettings()
+	{
+		static const TArray<FBlendableSetting> Settings = BuildBlendableSettings();
+		return Settings;
+	}
+
+	/** Sums one view field over the entries, multiplying and adding the way ApplyBlendWeight and AddWeightedViewInfo do */
+	template<typename FieldType>
+	static void WeighViewField(TConstArrayView<FSPCameraViewBlendEntry> Entries, FieldType FMinimalViewInfo::* Field, FMinimalViewInfo& OutPOV)
+	{
+		FieldType Sum = Entries[0].POV->*Field * Entries[0].Weight;
+		for (int32 EntryIdx = 1; EntryIdx < Entries.Num(); ++EntryIdx)
+		{
+			Sum += Entries[EntryIdx].POV->*Field * Entries[EntryIdx].Weight;
+		}
+		OutPOV.*Field = Sum;
+	}
+
+	/**
+	 * The view fields FMinimalViewInfo::ApplyBlendWeight and AddWeightedViewInfo weigh, read from each entry in place. Those copy every outgoing view
+	 * whole, post process settings included. SPCameraViewBlendTest checks every FMinimalViewInfo property against them, so keep this in step.
+	 */
+	static void WeighViewFields(TConstArrayView<FSPCameraViewBlendEntry> Entries, FMinimalViewInfo& OutPOV)
+	{
+		WeighViewField(Entries, &FMinimalViewInfo::Location, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::FOV, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::DesiredFOV, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::FirstPersonFOV, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::FirstPersonScale, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::OrthoWidth, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::OrthoNearClipPlane, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::OrthoFarClipPlane, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::PerspectiveNearClipPlane, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::AspectRatio, OutPOV);
+		WeighViewField(Entries, &FMinimalViewInfo::OffCenterProjectionOffset, OutPOV);
+
+		// rotations are normalized before they're weighed
+		FRotator Rotation = Entries[0].POV->Rotation.GetNormalized() * Entries[0].Weight;
+		bool bConstrainAspectRatio = Entries[0].POV->bConstrainAspectRatio;
+		bool bUseFieldOfViewForLOD = Entries[0].POV->bUseFieldOfViewForLOD;
+		bool bUseFirstPersonParameters = Entries[0].POV->bUseFirstPersonParameters;
+		for (int32 EntryIdx = 1; EntryIdx < Entries.Num(); ++EntryIdx)
+		{
+			const FMinimalViewInfo& EntryPOV = *Entries[EntryIdx].POV;
+			Rotation += EntryPOV.Rotation.GetNormalized() * Entries[EntryIdx].Weight;
+			bConstrainAspectRatio |= EntryPOV.bConstrainAspectRatio;
+			bUseFieldOfViewForLOD |= EntryPOV.bUseFieldOfViewForLOD;
+			bUseFirstPersonParameters |= EntryPOV.bUseFirstPersonParameters;
+		}
+		OutPOV.Rotation = Rotation;
+		OutPOV.bConstrainAspectRatio = bConstrainAspectRatio;
+		OutPOV.bUseFieldOfViewForLOD = bUseFieldOfViewForLOD;
+		OutPOV.bUseFirstPersonParameters = bUseFirstPersonParameters;
+	}
+
+	static void BlendSetting(const FBlendableSetting& Setting, int32 SettingIdx, TConstArrayView<FSPCameraViewBlendEntry> Entries, FPostProcessSettings& OutSettings)
+	{
+		double Sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+		float ContributingWeight = 0.f;
+		bool bAnyOverride = false;
+
+		for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); ++EntryIdx)
+		{
+			const FSPCameraViewBlendEntry& Entry = Entries[EntryIdx];
+			const FPostProcessSettings& EntrySettings = Entry.POV->PostProcessSettings;
+			const bool bOverrides = Entry.PostProcessMask && Entry.PostProcessMask->IsValidIndex(SettingIdx) && (*Entry.PostProcessMask)[SettingIdx]
+				&& Setting.OverrideProperty->GetPropertyValue_InContainer(&EntrySettings);
+
+			if (bOverrides)
+			{
+				const void* const Value = Setting.ValueProperty->ContainerPtrToValuePtr<void>(&EntrySettings);
+				for (int32 Component = 0; Component < Setting.NumComponents; ++Component)
+				{
+					const double ComponentValue = Setting.bDoubleComponents ? static_cast<const double*>(Value)[Component] : static_cast<const float*>(Value)[Component];
+					Sums[Component] += ComponentValue * Entry.Weight;
+				}
+				ContributingWeight += Entry.Weight;
+				bAnyOverride = true;
+			}
+			else if (Setting.bHasFallback)
+			{
+				Sums[0] += (EntryIdx == 0 ? Setting.IncomingFallback : Setting.OutgoingFallback) * Entry.Weight;
+				ContributingWeight += Entry.Weight;
+			}
+		}
+
+		// nobody overrides it, the incoming mode's value stands
+		if (!bAnyOverride && !Setting.bHasFallback)
+		{
+			return;
+		}
+
+		// entries that don't override the setting are left out, the others share their weight
+		const double Normalization = (Setting.bHasFallback || ContributingWeight <= 0.f) ? 1.0 : 1.0 / ContributingWeight;
+		void* const OutValue = Setting.ValueProperty->ContainerPtrToValuePtr<void>(&OutSettings);
+		for (int32 Component = 0; Component < Setting.NumComponents; ++Component)
+		{
+			if (Setting.bDoubleComponents)
+			{
+				static_cast<double*>(OutValue)[Component] = Sums[Component] * Normalization;
+			}
+			else
+			{
+				static_cast<float*>(OutValue)[Component] = float(Sums[Component] * Normalization);
+			}
+		}
+
+		if (bAnyOverride)
+		{
+			Setting.OverrideProperty->SetPropertyValue_InContainer(&OutSettings, true);
+		}
+	}
+}
+
+FSPPostProcessBlendMask FSPCameraViewBlend::MakePostProcessMask(TConstArrayView<FName> SettingNames)
+{
+	const TArray<SPCameraViewBlend::FBlendableSetting>& Settings = SPCameraViewBlend::GetBlendableSettings();
+
+	FSPPostProcessBlendMask Mask(false, Settings.Num());
+	for (const FName SettingName : SettingNames)
+	{
+		const int32 SettingIdx = Settings.IndexOfByPredicate([SettingName](const SPCameraViewBlend::FBlendableSetting& Setting) { return Setting.Name == SettingName; });
+		if (SettingIdx != INDEX_NONE)
+		{
+			Mask[SettingIdx] = true;
+		}
+	}
+	return Mask;
+}
+
+int32 FSPCameraViewBlend::GetNumBlendablePostProcessSettings()
+{
+	return SPCameraViewBlend::GetBlendableSettings().Num();
+}
+
+void FSPCameraViewBlend::Blend(TConstArrayView<FSPCameraViewBlendEntry> Entries, FMinimalViewInfo& OutPOV)
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	SPCameraViewBlend::WeighViewFields(Entries, OutPOV);
+
+	FSPPostProcessBlendMask BlendedSettings(false, GetNumBlendablePostProcessSettings());
+	for (const FSPCameraViewBlendEntry& Entry : Entries)
+	{
+		if (Entry.PostProcessMask)
+		{
+			BlendedSettings.CombineWithBitwiseOR(*Entry.PostProcessMask, EBitwiseOperatorFlags::MaintainSize);
+		}
+	}
+
+	// only what some mode overrides is read or written
+	const TArray<SPCameraViewBlend::FBlendableSetting>& Settings = SPCameraViewBlend::GetBlendableSettings();
+	for (TConstSetBitIterator<TInlineAllocator<16>> It(BlendedSettings); It; ++It)
+	{
+		SPCameraViewBlend::BlendSetting(Settings[It.GetIndex()], It.GetIndex(), Entries, OutPOV.PostProcessSettings);
+	}
+}
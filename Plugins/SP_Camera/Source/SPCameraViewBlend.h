@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+struct FMinimalViewInfo;
+
+/** Post process settings a camera mode overrides, one bit per entry in FSPCameraViewBlend's table of blendable settings */
+using FSPPostProcessBlendMask = TBitArray<TInlineAllocator<16>>;
+
+/** A camera mode's view in the blend stack, as FSPCameraViewBlend reads it */
+struct FSPCameraViewBlendEntry
+{
+	const FMinimalViewInfo* POV = nullptr;
+	const FSPPostProcessBlendMask* PostProcessMask = nullptr;
+	float Weight = 0.f;
+};
+
+/**
+ * Blends the views of a camera blend stack without copying them or weighing every post process setting. View fields are weighed in place, the way
+ * FMinimalViewInfo::ApplyBlendWeight and AddWeightedViewInfo weigh them. Post process settings stay the incoming mode's, except for those in any
+ * entry's mask, which are blended across the entries overriding them.
+ */
+class FSPCameraViewBlend
+{
+public:
+	/**
+	 * Mask of the named FPostProcessSettings members. Only members with a bOverride_ flag and a float, double, vector or color value can be
+	 * blended, other names are ignored.
+	 */
+	static FSPPostProcessBlendMask MakePostProcessMask(TConstArrayView<FName> SettingNames);
+
+	/** Number of post process settings masks can refer to */
+	static int32 GetNumBlendablePostProcessSettings();
+
+	/**
+	 * Blends Entries into OutPOV, the incoming entry first and weights normalized. OutPOV is expected to be the incoming entry's view already,
+	 * so only the weighed view fields and masked post process settings are read from the entries and written.
+	 */
+	static void Blend(TConstArrayView<FSPCameraViewBlendEntry> Entries, FMinimalViewInfo& OutPOV);
+};
@@ -2,15 +2,38 @@
 
 #include "SPPlayerCameraManager.h"
 
+#include "Async/ParallelFor.h"
 #include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
 #include "CineCameraComponent.h"
-#include "Components/CapsuleComponent.h"
 #include "Engine/Canvas.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 
+static int32 SPCameraParallelUpdate = 1;
+static FAutoConsoleVariableRef CVar_SPCameraParallelUpdate(TEXT("SP.Camera.ParallelUpdate"), SPCameraParallelUpdate,
+	TEXT("True to compute the camera modes in the blend stack in parallel while blending between several. Modes that don't support it still update on the game thread."), ECVF_Default);
+
+static int32 SPCameraOutgoingUpdateInterval = 1;
+static FAutoConsoleVariableRef CVar_SPCameraOutgoingUpdateInterval(TEXT("SP.Camera.OutgoingUpdateInterval"), SPCameraOutgoingUpdateInterval,
+	TEXT("Outgoing camera modes blended below SP.Camera.OutgoingUpdateWeight update once every this many frames and hold their last POV in between. 1 updates them every frame."), ECVF_Default);
+
+static float SPCameraOutgoingUpdateWeight = 0.25f;
+static FAutoConsoleVariableRef CVar_SPCameraOutgoingUpdateWeight(TEXT("SP.Camera.OutgoingUpdateWeight"), SPCameraOutgoingUpdateWeight,
+	TEXT("Blend weight below which outgoing camera modes update at SP.Camera.OutgoingUpdateInterval."), ECVF_Default);
+
+static int32 SPCameraCollisionSnapshot = 0;
+static FAutoConsoleVariableRef CVar_SPCameraCollisionSnapshot(TEXT("SP.Camera.CollisionSnapshot"), SPCameraCollisionSnapshot,
+	TEXT("True to gather the collision around the view target every few frames and run camera penetration feelers against it rather than the physics scene, without its lock. Collision moving into range is missed until the next capture."), ECVF_Default);
+
+static int32 SPCameraCollisionSnapshotInterval = 10;
+static FAutoConsoleVariableRef CVar_SPCameraCollisionSnapshotInterval(TEXT("SP.Camera.CollisionSnapshotInterval"), SPCameraCollisionSnapshotInterval,
+	TEXT("Frames between collision snapshot captures, see SP.Camera.CollisionSnapshot."), ECVF_Default);
+
+static float SPCameraCollisionSnapshotRadius = 1000.f;
+static FAutoConsoleVariableRef CVar_SPCameraCollisionSnapshotRadius(TEXT("SP.Camera.CollisionSnapshotRadius"), SPCameraCollisionSnapshotRadius,
+	TEXT("Radius of the collision snapshot around the view target. Feelers reaching outside it sweep the physics scene as usual."), ECVF_Default);
+
 ASPPlayerCameraManager::ASPPlayerCameraManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -18,6 +41,13 @@ ASPPlayerCameraManager::ASPPlayerCameraManager(const FObjectInitializer& ObjectI
 	DefaultMaxPitchLimit = ViewPitchMax;
 }
 
+void ASPPlayerCameraManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PrewarmCameraModes(PrewarmedCameraModeClasses);
+}
+
 /** for displayDebug only */
 static FString BlendVolumeDebugModeName;
 static float BlendVolumeDebugBlendWeight;
@@ -96,13 +126,14 @@ void ASPPlayerCameraManager::UpdateCameraInStack(int32 StackIdx, float DeltaTime
 
 		// if this is an outgoing camera who wants to lock outgoing, just
 		// return the last POV and be done
-		if ((StackIdx >= 1) && CamEntry.bLockOutgoingPOV)
+		if (((StackIdx >= 1) && CamEntry.bLockOutgoingPOV) || ShouldHoldOutgoingPOV(StackIdx, DeltaTime))
 		{
 			OutVT.POV = CamEntry.LastPOV;
 			return;
 		}
 		else
 		{
+			const float CameraDeltaTime = ConsumeCameraDeltaTime(StackIdx, DeltaTime);
 			const int32 InstanceIdx = CamEntry.InstanceIndex;
 			if (CameraModeInstances.IsValidIndex(InstanceIdx))
 			{
@@ -111,7 +142,7 @@ void ASPPlayerCameraManager::UpdateCameraInStack(int32 StackIdx, float DeltaTime
 				{
 					ModeInstance.CameraMode->SkipNextInterpolation();
 				}
-				ModeInstance.UpdateCamera(DeltaTime, OutVT);
+				ModeInstance.UpdateCamera(CameraDeltaTime, OutVT);
 			}
 
 			CamEntry.LastPOV = OutVT.POV;
@@ -120,6 +151,168 @@ void ASPPlayerCameraManager::UpdateCameraInStack(int32 StackIdx, float DeltaTime
 	}
 }
 
+void ASPPlayerCameraManager::RefreshCollisionSnapshot(AActor* ViewTarget)
+{
+	if (!SPCameraCollisionSnapshot || ViewTarget == nullptr)
+	{
+		CollisionSnapshot.Reset();
+		return;
+	}
+
+	// a quarter of the radius leaves the usual camera boom inside it until the next capture
+	const FVector ViewTargetLocation = ViewTarget->GetActorLocation();
+	++FramesSinceCollisionSnapshot;
+	if (!CollisionSnapshot.IsCaptured()
+		|| FramesSinceCollisionSnapshot >= SPCameraCollisionSnapshotInterval
+		|| FVector::DistSquared(ViewTargetLocation, CollisionSnapshot.GetCenter()) > FMath::Square(SPCameraCollisionSnapshotRadius * 0.25f))
+	{
+		// the view target is captured too, outgoing modes following other actors can still run into it
+		CollisionSnapshot.Capture(GetWorld(), ViewTargetLocation, SPCameraCollisionSnapshotRadius, ECC_Camera);
+		FramesSinceCollisionSnapshot = 0;
+	}
+	else
+	{
+		CollisionSnapshot.RefreshTransforms(GetWorld());
+	}
+}
+
+void ASPPlayerCameraManager::UpdateCameraStack(float DeltaTime, FTViewTarget& OutVT)
+{
+	// captured up front on the game thread, modes computing in parallel only read it
+	RefreshCollisionSnapshot(OutVT.Target);
+
+	if (!SPCameraParallelUpdate || (CameraBlendStack.Num() < 2))
+	{
+		for (int32 StackIdx = 0; StackIdx < CameraBlendStack.Num(); ++StackIdx)
+		{
+			UpdateCameraInStack(StackIdx, DeltaTime, OutVT);
+		}
+
+		// each mode started from the previous one's view here, the blend starts from the incoming one's
+		if (CameraBlendStack.Num() > 1)
+		{
+			OutVT.POV = CameraBlendStack[0].LastPOV;
+		}
+		return;
+	}
+
+	// every mode starts from the same view target here, rather than from the previous mode's result
+	struct FStackEntryUpdate
+	{
+		FSPCameraModeInstance* ModeInstance = nullptr;
+		FTViewTarget VT;
+		float DeltaTime = 0.f;
+		bool bHoldPOV = false;
+		bool bParallel = false;
+	};
+
+	TArray<FStackEntryUpdate, TInlineAllocator<8>> EntryUpdates;
+	EntryUpdates.SetNum(CameraBlendStack.Num());
+	TArray<int32, TInlineAllocator<8>> ParallelEntries;
+
+	// game thread: snapshot the view targets of modes that can compute in parallel
+	for (int32 StackIdx = 0; StackIdx < CameraBlendStack.Num(); ++StackIdx)
+	{
+		FActiveSPCamera& CamEntry = CameraBlendStack[StackIdx];
+		FStackEntryUpdate& EntryUpdate = EntryUpdates[StackIdx];
+
+		if (((StackIdx >= 1) && CamEntry.bLockOutgoingPOV) || ShouldHoldOutgoingPOV(StackIdx, DeltaTime))
+		{
+			EntryUpdate.bHoldPOV = true;
+			continue;
+		}
+
+		EntryUpdate.VT = OutVT;
+		EntryUpdate.DeltaTime = ConsumeCameraDeltaTime(StackIdx, DeltaTime);
+		if (!CameraModeInstances.IsValidIndex(CamEntry.InstanceIndex))
+		{
+			continue;
+		}
+
+		EntryUpdate.ModeInstance = &CameraModeInstances[CamEntry.InstanceIndex];
+		if ((StackIdx == 0) && bSkipNextInterpolation)
+		{
+			EntryUpdate.ModeInstance->CameraMode->SkipNextInterpolation();
+		}
+
+		if (EntryUpdate.ModeInstance->CameraMode->SupportsParallelUpdate())
+		{
+			EntryUpdate.ModeInstance->BeginCameraUpdate(EntryUpdate.DeltaTime, EntryUpdate.VT);
+			EntryUpdate.bParallel = true;
+			ParallelEntries.Add(StackIdx);
+		}
+	}
+
+	ParallelFor(ParallelEntries.Num(), [&EntryUpdates, &ParallelEntries](int32 Index)
+	{
+		FStackEntryUpdate& EntryUpdate = EntryUpdates[ParallelEntries[Index]];
+		EntryUpdate.ModeInstance->ComputeCamera(EntryUpdate.DeltaTime, EntryUpdate.VT);
+	});
+
+	// game thread again: controller and world changes, in stack order like the serial update
+	for (int32 StackIdx = 0; StackIdx < CameraBlendStack.Num(); ++StackIdx)
+	{
+		FActiveSPCamera& CamEntry = CameraBlendStack[StackIdx];
+		FStackEntryUpdate& EntryUpdate = EntryUpdates[StackIdx];
+		if (EntryUpdate.bHoldPOV)
+		{
+			continue;
+		}
+
+		if (EntryUpdate.bParallel)
+		{
+			EntryUpdate.ModeInstance->FinishCameraUpdate(EntryUpdate.DeltaTime, EntryUpdate.VT);
+		}
+		else if (EntryUpdate.ModeInstance)
+		{
+			EntryUpdate.ModeInstance->UpdateCamera(EntryUpdate.DeltaTime, EntryUpdate.VT);
+		}
+
+		// the incoming view is kept for the blend to start from, the others aren't needed past here
+		if (StackIdx == 0)
+		{
+			CamEntry.LastPOV = EntryUpdate.VT.POV;
+		}
+		else
+		{
+			CamEntry.LastPOV = MoveTemp(EntryUpdate.VT.POV);
+		}
+	}
+
+	if (EntryUpdates[0].bHoldPOV)
+	{
+		OutVT.POV = CameraBlendStack[0].LastPOV;
+	}
+	else
+	{
+		OutVT.POV = MoveTemp(EntryUpdates[0].VT.POV);
+	}
+
+	bSkipNextInterpolation = false;
+}
+
+bool ASPPlayerCameraManager::ShouldHoldOutgoingPOV(int32 StackIdx, float DeltaTime)
+{
+	FActiveSPCamera& CamEntry = CameraBlendStack[StackIdx];
+	if ((StackIdx >= 1) && (CamEntry.BlendWeight < SPCameraOutgoingUpdateWeight) && (CamEntry.HeldFrames + 1 < SPCameraOutgoingUpdateInterval))
+	{
+		++CamEntry.HeldFrames;
+		CamEntry.HeldDeltaTime += DeltaTime;
+		return true;
+	}
+
+	return false;
+}
+
+float ASPPlayerCameraManager::ConsumeCameraDeltaTime(int32 StackIdx, float DeltaTime)
+{
+	FActiveSPCamera& CamEntry = CameraBlendStack[StackIdx];
+	const float CameraDeltaTime = DeltaTime + CamEntry.HeldDeltaTime;
+	CamEntry.HeldFrames = 0;
+	CamEntry.HeldDeltaTime = 0.f;
+	return CameraDeltaTime;
+}
+
 APlayerController* ASPPlayerCameraManager::GetOwningPC() const
 {
 	return Cast<APlayerController>(PCOwner);
@@ -387,7 +580,7 @@ void ASPPlayerCameraManager::UpdateViewTarget(struct FTViewTarget& OutVT, float
 		}
 
 		// Normalize weights, evaluate and blend!
-		UpdateCameraInStack(0, DeltaTime, OutVT);
+		UpdateCameraStack(DeltaTime, OutVT);
 
 		if (TotalWeight == 0.0f)
 		{
@@ -398,63 +591,19 @@ void ASPPlayerCameraManager::UpdateViewTarget(struct FTViewTarget& OutVT, float
 			CameraBlendStack[0].BlendWeight /= TotalWeight;
 		}
 
-		FMinimalViewInfo BlendedPOV = OutVT.POV;
-		BlendedPOV.ApplyBlendWeight(CameraBlendStack[0].BlendWeight);
-
-
-		float SkippedFStopWeight = 0.f;
-		float SkippedFocalDistWeight = 0.f;
-
-		// handle depth of field post processing settings
-		{
-			BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFstop |= OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFstop;
-			const float FStop = OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFstop ? OutVT.POV.PostProcessSettings.DepthOfFieldFstop : 22.f;
-			BlendedPOV.PostProcessSettings.DepthOfFieldFstop = FStop * CameraBlendStack[0].BlendWeight;
-
-			if (OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
-			{
-				BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance = true;
-				BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance = OutVT.POV.PostProcessSettings.DepthOfFieldFocalDistance * CameraBlendStack[0].BlendWeight;
-			}
-			else
-			{
-				SkippedFocalDistWeight += CameraBlendStack[0].BlendWeight;
-				BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance = 0.f;
-			}
-		}
-
-
 		for (int32 StackIdx = 1; StackIdx < CameraBlendStack.Num(); ++StackIdx)
 		{
-			FActiveSPCamera& CamEntry = CameraBlendStack[StackIdx];
-
-			UpdateCameraInStack(StackIdx, DeltaTime, OutVT);
-
-			CamEntry.BlendWeight /= TotalWeight;
-
-			BlendedPOV.AddWeightedViewInfo(OutVT.POV, CamEntry.BlendWeight);
-
-			BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFstop |= OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFstop;
-			const float FStop = OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFstop ? OutVT.POV.PostProcessSettings.DepthOfFieldFstop : 8.f;
-			BlendedPOV.PostProcessSettings.DepthOfFieldFstop += FStop * CamEntry.BlendWeight;
-
-			if (OutVT.POV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
-			{
-				BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance = true;
-				BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance += OutVT.POV.PostProcessSettings.DepthOfFieldFocalDistance * CamEntry.BlendWeight;
-			}
-			else
-			{
-				SkippedFocalDistWeight += CamEntry.BlendWeight;
-			}
+			CameraBlendStack[StackIdx].BlendWeight /= TotalWeight;
 		}
 
-		if (BlendedPOV.PostProcessSettings.bOverride_DepthOfFieldFocalDistance)
+		// OutVT.POV holds the incoming mode's view, see UpdateCameraStack. Post process settings are only touched where some mode
+		// in the stack overrides them
+		TArray<FSPCameraViewBlendEntry, TInlineAllocator<8>> BlendEntries;
+		for (FActiveSPCamera& CamEntry : CameraBlendStack)
 		{
-			BlendedPOV.PostProcessSettings.DepthOfFieldFocalDistance /= (1.f - SkippedFocalDistWeight);
+			BlendEntries.Add({ &CamEntry.LastPOV, CamEntry.Camera ? &CamEntry.Camera->GetPostProcessBlendMask() : nullptr, CamEntry.BlendWeight });
 		}
-
-		OutVT.POV = BlendedPOV;
+		FSPCameraViewBlend::Blend(BlendEntries, OutVT.POV);
 
 		// do custom blending of the rotators, because the method above always blends through 0 
 		// here we roll up the camera stack bottom up -- last 2 together, then that result into the one above that, and so on
@@ -480,43 +629,31 @@ void ASPPlayerCameraManager::UpdateViewTarget(struct FTViewTarget& OutVT, float
 	// Apply camera modifiers at the end (view shakes for example)
 	ApplyCameraModifiers(DeltaTime, OutVT.POV);
 
+	// batched ambient shakes once for the whole stack, each as strong as its mode's share of the view
+	for (const FActiveSPCamera& CamEntry : CameraBlendStack)
+	{
+		if (CamEntry.Camera)
+		{
+			CamEntry.Camera->SetAmbientShakeWeight(CamEntry.BlendWeight);
+		}
+	}
+	CameraShakeBatch.Apply(DeltaTime, OutVT.POV);
+
 	// Synchronize the actor with the view target results
 	SetActorLocationAndRotation(OutVT.POV.Location, OutVT.POV.Rotation, false);
 
-	// keep camera out of player
-	// NOTE: this assumes one single player character
+	// keep camera out of characters
 	if (PCOwner)
 	{
-		ACharacter* const PlayerChar = UGameplayStatics::GetPlayerCharacter(this, 0);
 		if (CamActor)
 		{
-			// assume whoever is controlling the character knows what they are doing
-			PCOwner->HiddenActors.Remove(PlayerChar);
+			// assume whoever is controlling the camera knows what they are doing
+			OcclusionFade.Reset(PCOwner);
 		}
 		else
 		{
-			const UCapsuleComponent* const Capsule = PlayerChar ? PlayerChar->GetCapsuleComponent() : nullptr;
-			if (Capsule)
-			{
-				// assumes upright capsule
-				const FVector CapsuleCenter = Capsule->GetComponentLocation();
-				const FVector Offset = FVector(0.f, 0.f, Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere());
-				const FVector BottomCapsulePoint = CapsuleCenter - Offset;
-				const FVector TopCapsulePoint = CapsuleCenter + Offset;
-				const float DistToSegment = FMath::PointDistToSegment(OutVT.POV.Location, BottomCapsulePoint, TopCapsulePoint);
-
-				const float HideCharacterDistPadding = 15.f;
-				if (DistToSegment < (Capsule->GetScaledCapsuleRadius() + HideCharacterDistPadding))
-				{
-					PCOwner->HiddenActors.AddUnique(PlayerChar);
-				}
-				else
-				{
-					PCOwner->HiddenActors.Remove(PlayerChar);
-				}
-			}
+			OcclusionFade.Update(PCOwner, OutVT.POV.Location, DeltaTime);
 		}
-
 	}
 
 	UpdateCameraLensEffects(OutVT);
@@ -531,35 +668,49 @@ void ASPPlayerCameraManager::UpdateViewTarget(struct FTViewTarget& OutVT, float
 
 void ASPPlayerCameraManager::CleanUpOutdatedCameraModeInstances()
 {
-	for (int32 RemoveCheckIndex = CameraModeInstances.Num() - 1; RemoveCheckIndex >= 0; RemoveCheckIndex--)
+	for (int32 InstanceIdx = 0; InstanceIdx < CameraModeInstances.Num(); ++InstanceIdx)
 	{
-		if (CameraModeInstances[RemoveCheckIndex].ViewTarget == nullptr)
+		const FSPCameraModeInstance& Inst = CameraModeInstances[InstanceIdx];
+		if (Inst.bPooled || IsValid(Inst.ViewTarget) || !Inst.CameraMode)
 		{
-			CameraModeInstances.RemoveAt(RemoveCheckIndex);
+			continue;
 		}
-	}
-}
 
-// assumes valid inputs
-int32 ASPPlayerCameraManager::FindOrCreateCameraModeInstance(TSubclassOf<USPCameraMode> CameraModeClass, AActor* InViewTarget)
-{
-	for (int Idx = 0; Idx < CameraModeInstances.Num(); ++Idx)
-	{
-		const FSPCameraModeInstance& Inst = CameraModeInstances[Idx];
-		if ((Inst.CameraModeClass == CameraModeClass) && (Inst.ViewTarget == InViewTarget) && (Inst.CameraMode))
+		// outgoing cameras keep blending until the stack lets go of them
+		const bool bInBlendStack = CameraBlendStack.ContainsByPredicate([InstanceIdx](const FActiveSPCamera& CamEntry) { return CamEntry.InstanceIndex == InstanceIdx; });
+		if (!bInBlendStack)
 		{
-			return Idx;
+			ReleaseCameraModeInstance(InstanceIdx);
 		}
 	}
+}
+
+void ASPPlayerCameraManager::ReleaseCameraModeInstance(int32 InstanceIdx)
+{
+	FSPCameraModeInstance& Inst = CameraModeInstances[InstanceIdx];
+	CameraModeInstanceLookup.Remove(MakeTuple(TObjectKey<UClass>(Inst.CameraModeClass.Get()), Inst.ViewTargetKey));
+
+	Inst.ViewTarget = nullptr;
+	Inst.ViewTargetKey = TObjectKey<AActor>();
+	Inst.bPooled = true;
+
+	// come back out of the pool looking like a new instance
+	Inst.CameraMode->StopAmbientCameraShake(true);
+	Inst.CameraMode->ResetToDefaultSettings();
+	Inst.CameraMode->BlockingActors.Reset();
+	Inst.CameraMode->SkipNextInterpolation();
 
-	// no camera mode found, so we create one
+	PooledCameraModeInstances.FindOrAdd(Inst.CameraModeClass.Get()).Add(InstanceIdx);
+}
+
+int32 ASPPlayerCameraManager::CreateCameraModeInstance(TSubclassOf<USPCameraMode> CameraModeClass)
+{
 	USPCameraMode* const NewCameraMode = NewObject<USPCameraMode>(this, CameraModeClass);
 
 	NewCameraMode->PlayerCamera = this;
 
 	FSPCameraModeInstance NewInstance;
 	NewInstance.CameraModeClass = CameraModeClass;
-	NewInstance.ViewTarget = InViewTarget;
 	NewInstance.CameraMode = NewCameraMode;
 
 	UCineCameraComponent* NewCineComp;
@@ -573,9 +724,76 @@ int32 ASPPlayerCameraManager::FindOrCreateCameraModeInstance(TSubclassOf<USPCame
 	}
 	NewInstance.CineCameraComponent = NewCineComp;
 
-	int32 NewIdx = CameraModeInstances.Emplace(NewInstance);
+	++NumCameraModeInstancesCreated;
 
-	return NewIdx;
+	return CameraModeInstances.Emplace(NewInstance);
+}
+
+// assumes valid inputs
+int32 ASPPlayerCameraManager::FindOrCreateCameraModeInstance(TSubclassOf<USPCameraMode> CameraModeClass, AActor* InViewTarget)
+{
+	const TPair<TObjectKey<UClass>, TObjectKey<AActor>> InstanceKey(CameraModeClass.Get(), InViewTarget);
+	if (const int32* const FoundIdx = CameraModeInstanceLookup.Find(InstanceKey))
+	{
+		const FSPCameraModeInstance& Inst = CameraModeInstances[*FoundIdx];
+		if ((Inst.ViewTarget == InViewTarget) && (Inst.CameraMode))
+		{
+			return *FoundIdx;
+		}
+		CameraModeInstanceLookup.Remove(InstanceKey);
+	}
+
+	// a miss means the view target changed, a good time to take back instances whose view targets are gone
+	CleanUpOutdatedCameraModeInstances();
+
+	// reuse a pooled instance of this class, and only create one if there is none
+	int32 InstanceIdx = INDEX_NONE;
+	TArray<int32>* const Pool = PooledCameraModeInstances.Find(CameraModeClass.Get());
+	if (Pool && (Pool->Num() > 0))
+	{
+		InstanceIdx = Pool->Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		InstanceIdx = CreateCameraModeInstance(CameraModeClass);
+	}
+
+	FSPCameraModeInstance& Inst = CameraModeInstances[InstanceIdx];
+	Inst.ViewTarget = InViewTarget;
+	Inst.ViewTargetKey = InViewTarget;
+	Inst.bPooled = false;
+	CameraModeInstanceLookup.Add(InstanceKey, InstanceIdx);
+
+	return InstanceIdx;
+}
+
+void ASPPlayerCameraManager::PrewarmCameraModes(const TArray<TSubclassOf<USPCameraMode>>& CameraModeClasses, int32 InstancesPerClass)
+{
+	for (const TSubclassOf<USPCameraMode>& CameraModeClass : CameraModeClasses)
+	{
+		if (!CameraModeClass)
+		{
+			continue;
+		}
+
+		TArray<int32>& Pool = PooledCameraModeInstances.FindOrAdd(CameraModeClass.Get());
+		while (Pool.Num() < InstancesPerClass)
+		{
+			const int32 InstanceIdx = CreateCameraModeInstance(CameraModeClass);
+			CameraModeInstances[InstanceIdx].bPooled = true;
+			Pool.Add(InstanceIdx);
+		}
+	}
+}
+
+int32 ASPPlayerCameraManager::GetNumPooledCameraModeInstances() const
+{
+	int32 NumPooled = 0;
+	for (const TPair<TObjectKey<UClass>, TArray<int32>>& Pool : PooledCameraModeInstances)
+	{
+		NumPooled += Pool.Value.Num();
+	}
+	return NumPooled;
 }
 
 int32 ASPPlayerCameraManager::GetBestCameraMode(AActor* Target)
@@ -677,6 +895,21 @@ void FSPCameraModeInstance::UpdateCamera(float DeltaTime, FTViewTarget& OutVT)
 	CameraMode->UpdateCamera(ViewTarget, (CameraMode->bUseCineCam ? CineCameraComponent : nullptr), DeltaTime, OutVT);
 }
 
+void FSPCameraModeInstance::BeginCameraUpdate(float DeltaTime, FTViewTarget& OutVT)
+{
+	CameraMode->BeginCameraUpdate(ViewTarget, DeltaTime, OutVT);
+}
+
+void FSPCameraModeInstance::ComputeCamera(float DeltaTime, FTViewTarget& OutVT)
+{
+	CameraMode->ComputeCamera(ViewTarget, DeltaTime, OutVT);
+}
+
+void FSPCameraModeInstance::FinishCameraUpdate(float DeltaTime, FTViewTarget& OutVT)
+{
+	CameraMode->FinishCameraUpdate(ViewTarget, (CameraMode->bUseCineCam ? CineCameraComponent : nullptr), DeltaTime, OutVT);
+}
+
 
 void ASPPlayerCameraManager::SkipBlends()
 {
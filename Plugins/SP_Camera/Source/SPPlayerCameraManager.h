@@ -4,7 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Camera/PlayerCameraManager.h"
+#include "SPCameraCollisionSnapshot.h"
 #include "SPCameraMode.h"
+#include "SPCameraOcclusionFade.h"
+#include "SPCameraShakeBatch.h"
+#include "UObject/ObjectKey.h"
 
 #include "SPPlayerCameraManager.generated.h"
 
@@ -60,6 +64,12 @@ public:
 
 	/** If true, view info will be locked during camera transitions involving this camera */
 	bool bLockOutgoingPOV = false;
+
+	/** Frames this outgoing camera held LastPOV instead of updating, see SP.Camera.OutgoingUpdateInterval */
+	int32 HeldFrames = 0;
+
+	/** Time that passed while this camera held LastPOV, handed to its next update */
+	float HeldDeltaTime = 0.f;
 };
 
 /** Instances of camera modes that can be used/reused to support active cameras */
@@ -86,8 +96,19 @@ public:
 	UPROPERTY(BlueprintReadOnly, EditInstanceOnly)
 	UCineCameraComponent* CineCameraComponent = nullptr;
 
+	/** View target the instance is registered under in the manager's lookup, still valid once the view target itself is gone */
+	TObjectKey<AActor> ViewTargetKey;
+
+	/** True while the instance sits in the manager's pool waiting for a new view target */
+	bool bPooled = false;
+
 	/** Triggers an update on the underlying camera mode associated with the instance */
 	void UpdateCamera(float DeltaTime, FTViewTarget& OutVT);
+
+	/** Two phase update of the underlying camera mode, see USPCameraMode::SupportsParallelUpdate */
+	void BeginCameraUpdate(float DeltaTime, FTViewTarget& OutVT);
+	void ComputeCamera(float DeltaTime, FTViewTarget& OutVT);
+	void FinishCameraUpdate(float DeltaTime, FTViewTarget& OutVT);
 };
 
 
@@ -102,6 +123,10 @@ class ASPPlayerCameraManager : public APlayerCameraManager
 public:
 	ASPPlayerCameraManager(const FObjectInitializer& ObjectInitializer);
 
+	//~ Begin AActor Interface
+	virtual void BeginPlay() override;
+	//~ End AActor Interface
+
 	//~ Begin APlayerCameraManager Interface
 	virtual void UpdateViewTarget(struct FTViewTarget& OutVT, float DeltaTime) override;
 	virtual void DisplayDebug(class UCanvas* Canvas, const FDebugDisplayInfo& DebugDisplay, float& YL, float& YPos) override;
@@ -114,6 +139,57 @@ public:
 	/** Will create if it doesn't find one.  Returns index into CameraModeInstances. */
 	int32 GetBestCameraMode(AActor* ViewTarget);
 
+	/** Creates pooled camera mode instances ahead of time, so the first switch to one of these modes doesn't allocate mid-frame */
+	UFUNCTION(BlueprintCallable, Category = Camera)
+	void PrewarmCameraModes(const TArray<TSubclassOf<USPCameraMode>>& CameraModeClasses, int32 InstancesPerClass = 1);
+
+	/** Camera modes to pre-warm one instance of when play begins */
+	UPROPERTY(EditAnywhere, Category = Camera)
+	TArray<TSubclassOf<USPCameraMode>> PrewarmedCameraModeClasses;
+
+	const TArray<FSPCameraModeInstance>& GetCameraModeInstances() const
+	{
+		return CameraModeInstances;
+	}
+
+	/** Number of camera mode instances created since the manager spawned, pooled ones included */
+	int32 GetNumCameraModeInstancesCreated() const
+	{
+		return NumCameraModeInstancesCreated;
+	}
+
+	/** Number of instances in the pool, waiting for a view target */
+	int32 GetNumPooledCameraModeInstances() const;
+
+	/** Number of camera modes currently blending, the active one included */
+	int32 GetNumCamerasInBlendStack() const
+	{
+		return CameraBlendStack.Num();
+	}
+
+	/** Camera modes currently blending, the active one first */
+	const TArray<FActiveSPCamera>& GetCameraBlendStack() const
+	{
+		return CameraBlendStack;
+	}
+
+	/** Collision around the view target for camera modes to sweep against this frame, null when SP.Camera.CollisionSnapshot is off */
+	const FSPCameraCollisionSnapshot* GetCollisionSnapshot() const
+	{
+		return CollisionSnapshot.IsCaptured() ? &CollisionSnapshot : nullptr;
+	}
+
+	/** Ambient shakes of the camera modes in the blend stack, applied after the camera modifiers */
+	FSPCameraShakeBatch& GetCameraShakeBatch()
+	{
+		return CameraShakeBatch;
+	}
+
+	const FSPCameraShakeBatch& GetCameraShakeBatch() const
+	{
+		return CameraShakeBatch;
+	}
+
 	/** Returns the view info that the camera on the top of our camera blend stack is transitioning to */
 	FMinimalViewInfo GetTransitionGoalPOV() const
 	{
@@ -132,6 +208,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void ResetViewPitchLimits();
 
+	/** Fades out characters the camera gets too close to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
+	FSPCameraOcclusionFade OcclusionFade;
+
 	/** Pelvis Z height, in component space. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float BasePelvisRelativeZ;
@@ -214,6 +294,18 @@ protected:
 	/** Update individual camera modes that correspond with the index passed in */
 	void UpdateCameraInStack(int32 StackIdx, float DeltaTime, FTViewTarget& OutVT);
 
+	/** Updates every camera mode in the blend stack, leaving each entry's result in its LastPOV and the incoming one's in OutVT.POV. Computes them in parallel when SP.Camera.ParallelUpdate is set. */
+	void UpdateCameraStack(float DeltaTime, FTViewTarget& OutVT);
+
+	/** True if the outgoing camera at StackIdx should hold its last POV this frame rather than update, see SP.Camera.OutgoingUpdateInterval */
+	bool ShouldHoldOutgoingPOV(int32 StackIdx, float DeltaTime);
+
+	/** Delta time for the camera at StackIdx's next update, including any frames it held its POV for */
+	float ConsumeCameraDeltaTime(int32 StackIdx, float DeltaTime);
+
+	/** Recaptures the collision snapshot around ViewTarget every SP.Camera.CollisionSnapshotInterval frames, or sooner if it has moved away from it */
+	void RefreshCollisionSnapshot(AActor* ViewTarget);
+
 	/** Returns transition time determined by the camera modes we are transitioning between */
 	float GetModeTransitionTime(USPCameraMode* ToMode) const;
 
@@ -232,12 +324,33 @@ private:
 	/** Determines the best camera mode for a potential view target */
 	TSubclassOf<USPCameraMode> DetermineBestCameraClass(AActor const* ViewTarget) const;
 
-	/** Attempts to find existing camera mode instance to set the new view target, and creates a new camera mode instance if no existing candidates are found */
+	/** Attempts to find existing camera mode instance to set the new view target, reusing a pooled instance or creating a new one if no existing candidates are found */
 	int32 FindOrCreateCameraModeInstance(TSubclassOf<USPCameraMode> CameraModeClass, AActor* InViewTarget);
 
-	/** Removes any existing camera mode instances that don't currently have a view target set */
+	/** Creates a camera mode instance and its cine cam component, without a view target. Returns index into CameraModeInstances. */
+	int32 CreateCameraModeInstance(TSubclassOf<USPCameraMode> CameraModeClass);
+
+	/** Returns instances whose view target is gone and that are no longer blending to the pool */
 	void CleanUpOutdatedCameraModeInstances();
 
+	/** Resets an instance to its class defaults and puts it in the pool */
+	void ReleaseCameraModeInstance(int32 InstanceIdx);
+
+	/** CameraModeInstances index by camera mode class and view target */
+	TMap<TPair<TObjectKey<UClass>, TObjectKey<AActor>>, int32> CameraModeInstanceLookup;
+
+	/** CameraModeInstances indices of pooled instances, by camera mode class */
+	TMap<TObjectKey<UClass>, TArray<int32>> PooledCameraModeInstances;
+
+	int32 NumCameraModeInstancesCreated = 0;
+
+	/** Shared by every camera mode in the blend stack, see GetCollisionSnapshot */
+	FSPCameraCollisionSnapshot CollisionSnapshot;
+	int32 FramesSinceCollisionSnapshot = 0;
+
+	/** Shared by every camera mode in the blend stack, see GetCameraShakeBatch */
+	FSPCameraShakeBatch CameraShakeBatch;
+
 	/** The destination POV of an active transition */
 	FMinimalViewInfo TransitionGoalPOV;
 
@@ -36,9 +36,12 @@ public class SP_Camera : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"PhysicsCore",
+				"Chaos",
 				"Slate",
 				"SlateCore",
 				"CinematicCamera",
+				"EngineCameras",
 				"EnhancedInput",
 				"SP_Interpolators",
 				// ... add private dependencies that you statically link with here ...	
@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HoverDroneAltitudeSubsystem.h"
+#include "HoverDronePawnBase.h"
+#include "Components/PrimitiveComponent.h"
+#include "CollisionQueryParams.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HoverDroneAltitudeSubsystem)
+
+namespace HoverDroneAltitudeCache
+{
+	static bool GEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("HoverDrone.AltitudeCache"),
+		GEnabled,
+		TEXT("Measure drone altitude from a lazily sampled height field instead of tracing every query. Traces still cover cache misses."),
+		ECVF_Default);
+
+	/** Same reach as the altitude trace in UHoverDroneMovementComponent::MeasureAltitude */
+	constexpr float AltitudeTraceLength = 100000.f;
+
+	/** Samples are traced through the whole playable height so one sample serves any drone altitude above it */
+	constexpr float SampleTraceTopZ = 1000000.f;
+	constexpr float SampleTraceBottomZ = -1000000.f;
+
+	/** Drones in the way of a sample get traced through, this many at most */
+	constexpr int32 MaxIgnoredDrones = 4;
+
+	static bool IsMovingCollision(const UPrimitiveComponent* Component)
+	{
+		return Component
+			&& Component->Mobility == EComponentMobility::Movable
+			&& Component->IsCollisionEnabled()
+			&& Component->GetCollisionResponseToChannel(ECC_WorldStatic) == ECR_Block;
+	}
+}
+
+bool UHoverDroneAltitudeSubsystem::IsCacheEnabled()
+{
+	return HoverDroneAltitudeCache::GEnabled;
+}
+
+void UHoverDroneAltitudeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	HeightField = MakeUnique<FHoverDroneHeightField>([this](const FVector2D& Position, float& OutGroundZ)
+	{
+		return SampleGround(Position, OutGroundZ);
+	});
+
+	OnLevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::OnLevelRemovedFromWorld);
+	OnLevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::OnLevelAddedToWorld);
+	OnActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::OnActorSpawned));
+}
+
+void UHoverDroneAltitudeSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelRemovedFromWorld.Remove(OnLevelRemovedFromWorldHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(OnLevelAddedToWorldHandle);
+	GetWorld()->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
+
+	OnLevelRemovedFromWorldHandle = FDelegateHandle();
+	OnLevelAddedToWorldHandle = FDelegateHandle();
+	OnActorSpawnedHandle = FDelegateHandle();
+
+	TrackedPrimitives.Empty();
+	HeightField.Reset();
+
+	Super::Deinitialize();
+}
+
+void UHoverDroneAltitudeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		TrackMovingCollision(*It);
+	}
+}
+
+bool UHoverDroneAltitudeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UHoverDroneAltitudeSubsystem::GetCachedAltitude(const FVector& Location, float& OutAltitude)
+{
+	float GroundZ = 0.f;
+	if (!HeightField.IsValid() || !HeightField->GetGroundHeight(Location, GroundZ))
+	{
+		return false;
+	}
+
+	const float Altitude = float(Location.Z) - GroundZ;
+	OutAltitude = Altitude <= HoverDroneAltitudeCache::AltitudeTraceLength ? Altitude : 0.f;
+	return true;
+}
+
+void UHoverDroneAltitudeSubsystem::InvalidateAll()
+{
+	if (HeightField.IsValid())
+	{
+		HeightField->InvalidateAll();
+	}
+}
+
+EHoverDroneGroundSample UHoverDroneAltitudeSubsystem::SampleGround(const FVector2D& Position, float& OutGroundZ) const
+{
+	using namespace HoverDroneAltitudeCache;
+
+	// drones flying over a sample shouldn't end up in the ground, they would be under every sample near them
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(HoverDrone_SampleAltitudeCache), true);
+	for (int32 Attempt = 0; Attempt <= MaxIgnoredDrones; ++Attempt)
+	{
+		FHitResult Hit;
+		const FVector TraceStart(Position.X, Position.Y, SampleTraceTopZ);
+		const FVector TraceEnd(Position.X, Position.Y, SampleTraceBottomZ);
+		if (!GetWorld()->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, ECC_WorldStatic, TraceParams))
+		{
+			return EHoverDroneGroundSample::NoGround;
+		}
+
+		AActor* const HitActor = Hit.GetActor();
+		if (Cast<AHoverDronePawnBase>(HitActor) != nullptr)
+		{
+			TraceParams.AddIgnoredActor(HitActor);
+			continue;
+		}
+
+		// other pawns and untracked movers would go stale without anyone telling the cache
+		const UPrimitiveComponent* const HitComponent = Hit.GetComponent();
+		if (Cast<APawn>(HitActor) != nullptr || (HitComponent && HitComponent->Mobility == EComponentMobility::Movable && !IsTracked(HitComponent)))
+		{
+			return EHoverDroneGroundSample::Uncacheable;
+		}
+
+		OutGroundZ = float(Hit.ImpactPoint.Z);
+		return EHoverDroneGroundSample::Ground;
+	}
+
+	return EHoverDroneGroundSample::Uncacheable;
+}
+
+bool UHoverDroneAltitudeSubsystem::IsTracked(const UPrimitiveComponent* Component) const
+{
+	return TrackedPrimitives.ContainsByPredicate([Component](const FTrackedPrimitive& Tracked) { return Tracked.Component == Component; });
+}
+
+void UHoverDroneAltitudeSubsystem::TrackMovingCollision(AActor* Actor)
+{
+	// pawns aren't tracked, they move every frame and samples never keep them
+	if (!IsValid(Actor) || Actor->IsA<APawn>())
+	{
+		return;
+	}
+
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this](UPrimitiveComponent* Component)
+	{
+		if (HoverDroneAltitudeCache::IsMovingCollision(Component) && !IsTracked(Component))
+		{
+			TrackedPrimitives.Add({ Component, Component->Bounds.GetBox() });
+			if (HeightField.IsValid())
+			{
+				HeightField->Invalidate(Component->Bounds.GetBox());
+			}
+		}
+	});
+}
+
+void UHoverDroneAltitudeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// samples taken before the cache was switched off aren't being kept up to date
+	const bool bCacheEnabled = IsCacheEnabled();
+	if (bCacheEnabled != bWasCacheEnabled)
+	{
+		InvalidateAll();
+		bWasCacheEnabled = bCacheEnabled;
+	}
+
+	if (!HeightField.IsValid())
+	{
+		return;
+	}
+
+	for (int32 Index = TrackedPrimitives.Num() - 1; Index >= 0; --Index)
+	{
+		FTrackedPrimitive& Tracked = TrackedPrimitives[Index];
+		const UPrimitiveComponent* const Component = Tracked.Component.Get();
+		if (Component == nullptr || !HoverDroneAltitudeCache::IsMovingCollision(Component))
+		{
+			HeightField->Invalidate(Tracked.Bounds);
+			TrackedPrimitives.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const FBox Bounds = Component->Bounds.GetBox();
+		if (!Bounds.Equals(Tracked.Bounds, 0.1))
+		{
+			HeightField->Invalidate(Tracked.Bounds);
+			HeightField->Invalidate(Bounds);
+			Tracked.Bounds = Bounds;
+		}
+	}
+}
+
+TStatId UHoverDroneAltitudeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHoverDroneAltitudeSubsystem, STATGROUP_Tickables);
+}
+
+void UHoverDroneAltitudeSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (GetWorld() != World)
+	{
+		return;
+	}
+
+	// a streamed out level takes its ground with it, anything under it needs sampling again
+	InvalidateAll();
+}
+
+void UHoverDroneAltitudeSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (GetWorld() != World)
+	{
+		return;
+	}
+
+	InvalidateAll();
+	for (AActor* Actor : Level->Actors)
+	{
+		TrackMovingCollision(Actor);
+	}
+}
+
+void UHoverDroneAltitudeSubsystem::OnActorSpawned(AActor* Actor)
+{
+	TrackMovingCollision(Actor);
+}
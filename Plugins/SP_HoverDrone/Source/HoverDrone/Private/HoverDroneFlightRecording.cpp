@@ -0,0 +1,221 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HoverDroneFlightRecording.h"
+#include "HoverDronePawnBase.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace HoverDroneFlightRecording
+{
+	constexpr uint32 FileMagic = 0x48444652; // HDFR
+	constexpr uint32 FileVersion = 1;
+
+	/** Size of a frame without any input on disk, rejects frame counts a corrupt file couldn't possibly hold */
+	constexpr int64 MinBytesPerFrame = 29;
+
+	enum EFrameFlags : uint8
+	{
+		MoveInput = 1 << 0,
+		RotationInput = 1 << 1,
+		DirectRotationInput = 1 << 2,
+		VelocityImpulse = 1 << 3,
+		RotVelocityImpulse = 1 << 4,
+		FOVChanged = 1 << 5,
+		SpeedIndexChanged = 1 << 6,
+		Turbo = 1 << 7
+	};
+
+	static void SerializeStart(FArchive& Ar, FHoverDroneFlightStartState& Start)
+	{
+		Ar << Start.Location;
+		Ar << Start.Rotation;
+		Ar << Start.Velocity;
+		Ar << Start.RotVelocity;
+		Ar << Start.DirectRotationInputGoalRotation;
+		Ar << Start.LinearVelocity_NewModel;
+		Ar << Start.YawVelocity_NewModel;
+		Ar << Start.PitchVelocity_NewModel;
+		Ar << Start.DesiredHoverHeight;
+		Ar << Start.FOV;
+		Ar << Start.MovementRateMultiplier;
+		Ar << Start.LookRateMultiplier;
+		Ar << Start.DroneSpeedScalar;
+		Ar << Start.SpeedIndex;
+		Ar << Start.bMaintainHoverHeight;
+		Ar << Start.bTurbo;
+		Ar << Start.bUseNewFlightModel;
+	}
+}
+
+double FHoverDroneFlightRecording::GetDuration() const
+{
+	double Duration = 0.0;
+	for (const FHoverDroneFlightFrame& Frame : Frames)
+	{
+		Duration += Frame.DeltaTime;
+	}
+	return Duration;
+}
+
+void FHoverDroneFlightRecording::GetTransformAtTime(double Time, FVector& OutLocation, FRotator& OutRotation) const
+{
+	FHoverDroneFlightCursor Cursor;
+	GetTransformAtTime(Time, OutLocation, OutRotation, Cursor);
+}
+
+void FHoverDroneFlightRecording::GetTransformAtTime(double Time, FVector& OutLocation, FRotator& OutRotation, FHoverDroneFlightCursor& Cursor) const
+{
+	if (Time < Cursor.FrameStartTime || Cursor.FrameIndex > Frames.Num())
+	{
+		Cursor = FHoverDroneFlightCursor();
+	}
+
+	// frames without any time are stepped over like the ones that already ended
+	while (Cursor.FrameIndex < Frames.Num() && Time >= Cursor.FrameStartTime + Frames[Cursor.FrameIndex].DeltaTime)
+	{
+		Cursor.FrameStartTime += Frames[Cursor.FrameIndex].DeltaTime;
+		++Cursor.FrameIndex;
+	}
+
+	const FVector FromLocation = Cursor.FrameIndex > 0 ? GetFrameLocation(Cursor.FrameIndex - 1) : Start.Location;
+	const FRotator FromRotation = Cursor.FrameIndex > 0 ? GetFrameRotation(Cursor.FrameIndex - 1) : Start.Rotation;
+	if (Cursor.FrameIndex >= Frames.Num())
+	{
+		OutLocation = FromLocation;
+		OutRotation = FromRotation;
+		return;
+	}
+
+	// the short way around, a frame crossing +-180 degrees doesn't spin the other way for its duration
+	const float Alpha = float((Time - Cursor.FrameStartTime) / Frames[Cursor.FrameIndex].DeltaTime);
+	OutLocation = FMath::Lerp(FromLocation, GetFrameLocation(Cursor.FrameIndex), Alpha);
+	OutRotation = FromRotation + (GetFrameRotation(Cursor.FrameIndex) - FromRotation).GetNormalized() * Alpha;
+}
+
+bool FHoverDroneFlightRecording::Serialize(FArchive& Ar)
+{
+	using namespace HoverDroneFlightRecording;
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != FileMagic || Version != FileVersion)
+	{
+		return false;
+	}
+
+	SerializeStart(Ar, Start);
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0 || (Ar.TotalSize() > 0 && NumFrames > Ar.TotalSize() / MinBytesPerFrame))
+		{
+			Ar.SetError();
+			return false;
+		}
+		Frames.SetNum(NumFrames);
+	}
+
+	// state that rarely changes is only written when it differs from the frame before
+	float PreviousFOV = Start.FOV;
+	int32 PreviousSpeedIndex = Start.SpeedIndex;
+	for (FHoverDroneFlightFrame& Frame : Frames)
+	{
+		uint8 Flags = 0;
+		if (Ar.IsSaving())
+		{
+			Flags |= Frame.MoveInput.IsZero() ? 0 : MoveInput;
+			Flags |= Frame.RotationInput.IsZero() ? 0 : RotationInput;
+			Flags |= Frame.DirectRotationInput.IsZero() ? 0 : DirectRotationInput;
+			Flags |= Frame.VelocityImpulse.IsZero() ? 0 : VelocityImpulse;
+			Flags |= Frame.RotVelocityImpulse.IsZero() ? 0 : RotVelocityImpulse;
+			Flags |= Frame.FOV != PreviousFOV ? FOVChanged : 0;
+			Flags |= Frame.SpeedIndex != PreviousSpeedIndex ? SpeedIndexChanged : 0;
+			Flags |= Frame.bTurbo ? Turbo : 0;
+		}
+
+		Ar << Flags;
+		Ar << Frame.DeltaTime;
+
+		if (Flags & MoveInput)
+		{
+			Ar << Frame.MoveInput;
+		}
+		if (Flags & RotationInput)
+		{
+			Ar << Frame.RotationInput;
+		}
+		if (Flags & DirectRotationInput)
+		{
+			Ar << Frame.DirectRotationInput;
+		}
+		if (Flags & VelocityImpulse)
+		{
+			Ar << Frame.VelocityImpulse;
+		}
+		if (Flags & RotVelocityImpulse)
+		{
+			Ar << Frame.RotVelocityImpulse;
+		}
+
+		Frame.FOV = PreviousFOV;
+		if (Flags & FOVChanged)
+		{
+			Ar << Frame.FOV;
+		}
+		Frame.SpeedIndex = PreviousSpeedIndex;
+		if (Flags & SpeedIndexChanged)
+		{
+			Ar << Frame.SpeedIndex;
+		}
+		Frame.bTurbo = (Flags & Turbo) != 0;
+
+		Ar << Frame.Location;
+		Ar << Frame.Rotation;
+
+		PreviousFOV = Frame.FOV;
+		PreviousSpeedIndex = Frame.SpeedIndex;
+	}
+
+	return !Ar.IsError();
+}
+
+bool FHoverDroneFlightRecording::SaveToFile(const FString& Filename)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogHoverDrone, Warning, TEXT("Couldn't open %s to save the flight recording"), *Filename);
+		return false;
+	}
+
+	return Serialize(*Writer) && Writer->Close();
+}
+
+bool FHoverDroneFlightRecording::LoadFromFile(const FString& Filename)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogHoverDrone, Warning, TEXT("Couldn't open flight recording %s"), *Filename);
+		return false;
+	}
+
+	if (!Serialize(*Reader))
+	{
+		UE_LOG(LogHoverDrone, Warning, TEXT("%s isn't a flight recording this version can read"), *Filename);
+		Frames.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+FString FHoverDroneFlightRecording::GetSavedPath(const FString& Name)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HoverDrone"), Name + GetFileExtension());
+}
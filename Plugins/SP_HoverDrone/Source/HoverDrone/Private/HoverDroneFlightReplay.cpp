@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HoverDroneFlightReplay.h"
+#include "HoverDroneFlightRecording.h"
+#include "HoverDroneMovementComponent.h"
+#include "HoverDronePawnBase.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace HoverDroneFlightReplay
+{
+	/**
+	 * The rate and speed multipliers are cvars, the recorded values win for the duration of the replay. Both are set at the cvar's
+	 * current priority, so the override doesn't lock out game settings or the console afterwards
+	 */
+	class FScopedFloatCVarOverride
+	{
+	public:
+		FScopedFloatCVarOverride(const TCHAR* Name, float Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar != nullptr)
+			{
+				PreviousValue = CVar->GetFloat();
+				SetBy = static_cast<EConsoleVariableFlags>(CVar->GetFlags() & ECVF_SetByMask);
+				CVar->Set(Value, SetBy);
+			}
+		}
+
+		~FScopedFloatCVarOverride()
+		{
+			if (CVar != nullptr)
+			{
+				CVar->Set(PreviousValue, SetBy);
+			}
+		}
+
+	private:
+		IConsoleVariable* CVar = nullptr;
+		float PreviousValue = 0.f;
+		EConsoleVariableFlags SetBy = ECVF_SetByConstructor;
+	};
+
+	/** Feeds one frame's input. InputScale scales the per frame direct rotation deltas when replaying at a different step */
+	static void ApplyFrameInput(UHoverDroneMovementComponent& MovementComponent, const FHoverDroneFlightFrame& Frame, float InputScale, bool bApplyImpulses)
+	{
+		MovementComponent.SetCurrentFOV(Frame.FOV);
+		MovementComponent.SetDroneSpeedIndex(Frame.SpeedIndex);
+		MovementComponent.SetTurbo(Frame.bTurbo);
+
+		MovementComponent.AddInputVector(FVector(Frame.MoveInput), true);
+		MovementComponent.AddRotationInput(FRotator(Frame.RotationInput));
+		MovementComponent.AddDirectRotationInput(FRotator(Frame.DirectRotationInput) * InputScale);
+
+		if (bApplyImpulses)
+		{
+			MovementComponent.AddVelocity(FVector(Frame.VelocityImpulse));
+			MovementComponent.AddRotationalVelocity(FRotator(Frame.RotVelocityImpulse));
+		}
+	}
+
+	static UHoverDroneMovementComponent* FindPlayerMovementComponent(UWorld* World)
+	{
+		APlayerController* const PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn* const Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		return Pawn ? Cast<UHoverDroneMovementComponent>(Pawn->GetMovementComponent()) : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdRecordStart(
+		TEXT("HoverDrone.Record.Start"),
+		TEXT("Starts recording the player's drone flight."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UHoverDroneMovementComponent* const MovementComponent = FindPlayerMovementComponent(World))
+			{
+				MovementComponent->StartRecording();
+				UE_LOG(LogHoverDrone, Display, TEXT("Flight recording started"));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdRecordStop(
+		TEXT("HoverDrone.Record.Stop"),
+		TEXT("Stops recording and saves it to Saved/HoverDrone/<Name>.hdflight. Usage: HoverDrone.Record.Stop [Name], the name defaults to the map name."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UHoverDroneMovementComponent* const MovementComponent = FindPlayerMovementComponent(World);
+			const TSharedPtr<FHoverDroneFlightRecording> Recording = MovementComponent ? MovementComponent->StopRecording() : nullptr;
+			if (!Recording.IsValid())
+			{
+				UE_LOG(LogHoverDrone, Warning, TEXT("No flight recording in progress"));
+				return;
+			}
+
+			const FString Filename = FHoverDroneFlightRecording::GetSavedPath(Args.Num() > 0 ? Args[0] : World->GetMapName());
+			if (Recording->SaveToFile(Filename))
+			{
+				UE_LOG(LogHoverDrone, Display, TEXT("Saved %d frames (%.1f s) to %s"), Recording->Frames.Num(), Recording->GetDuration(), *Filename);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdReplay(
+		TEXT("HoverDrone.Replay"),
+		TEXT("Replays a saved flight through the player's drone and logs divergence and tick cost. Usage: HoverDrone.Replay <Name> [FixedDeltaTime], recorded timing without a delta time."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UHoverDroneMovementComponent* const MovementComponent = FindPlayerMovementComponent(World);
+			if (MovementComponent == nullptr || Args.Num() < 1)
+			{
+				return;
+			}
+
+			FHoverDroneFlightRecording Recording;
+			if (!Recording.LoadFromFile(FHoverDroneFlightRecording::GetSavedPath(Args[0])))
+			{
+				return;
+			}
+
+			FHoverDroneReplaySettings Settings;
+			if (Args.Num() > 1)
+			{
+				Settings.bUseRecordedTiming = false;
+				LexFromString(Settings.FixedDeltaTime, *Args[1]);
+			}
+
+			const FHoverDroneReplayReport Report = UEHoverDrone::ReplayFlight(*MovementComponent, Recording, Settings);
+			UE_LOG(LogHoverDrone, Display, TEXT("Replay of %s: %s"), *Args[0], *Report.ToString());
+		}));
+}
+
+FString FHoverDroneReplayReport::ToString() const
+{
+	return FString::Printf(TEXT("%d frames, location error max %.3f cm final %.3f cm, rotation error max %.3f deg, %s, tick avg %.1f us max %.1f us"),
+		NumFrames,
+		MaxLocationError,
+		FinalLocationError,
+		MaxRotationError,
+		HasDiverged() ? *FString::Printf(TEXT("diverged at frame %d"), FirstDivergentFrame) : TEXT("no divergence"),
+		AvgTickMicroseconds,
+		MaxTickMicroseconds);
+}
+
+FHoverDroneReplayReport UEHoverDrone::ReplayFlight(UHoverDroneMovementComponent& MovementComponent, const FHoverDroneFlightRecording& Recording, const FHoverDroneReplaySettings& Settings)
+{
+	using namespace HoverDroneFlightReplay;
+
+	FHoverDroneReplayReport Report;
+	if (!MovementComponent.GetPawnOwner() || !MovementComponent.UpdatedComponent || Recording.Frames.IsEmpty())
+	{
+		return Report;
+	}
+
+	FScopedFloatCVarOverride MovementRateOverride(TEXT("HoverDrone.MovementRateMultiplier"), Recording.Start.MovementRateMultiplier);
+	FScopedFloatCVarOverride LookRateOverride(TEXT("HoverDrone.LookRateMultiplier"), Recording.Start.LookRateMultiplier);
+	FScopedFloatCVarOverride SpeedScalarOverride(TEXT("HoverDrone.DroneSpeedScalar"), Recording.Start.DroneSpeedScalar);
+
+	const bool bWasTickEnabled = MovementComponent.IsComponentTickEnabled();
+	MovementComponent.SetComponentTickEnabled(false);
+	MovementComponent.RestoreFlightState(Recording.Start);
+
+	double TotalTickSeconds = 0.0;
+	auto TickAndCompare = [&](float DeltaTime, const FVector& ExpectedLocation, const FRotator& ExpectedRotation)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		MovementComponent.TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+		const double TickSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+		TotalTickSeconds += TickSeconds;
+		Report.MaxTickMicroseconds = FMath::Max(Report.MaxTickMicroseconds, TickSeconds * 1.0e6);
+
+		const double LocationError = FVector::Dist(MovementComponent.UpdatedComponent->GetComponentLocation(), ExpectedLocation);
+		const float RotationError = FMath::RadiansToDegrees(float(MovementComponent.UpdatedComponent->GetComponentQuat().AngularDistance(ExpectedRotation.Quaternion())));
+		Report.MaxLocationError = FMath::Max(Report.MaxLocationError, LocationError);
+		Report.FinalLocationError = LocationError;
+		Report.MaxRotationError = FMath::Max(Report.MaxRotationError, RotationError);
+		if (Report.FirstDivergentFrame == INDEX_NONE && (LocationError > Settings.LocationTolerance || RotationError > Settings.RotationTolerance))
+		{
+			Report.FirstDivergentFrame = Report.NumFrames;
+		}
+
+		++Report.NumFrames;
+	};
+
+	if (Settings.bUseRecordedTiming)
+	{
+		for (int32 FrameIndex = 0; FrameIndex < Recording.Frames.Num(); ++FrameIndex)
+		{
+			const FHoverDroneFlightFrame& Frame = Recording.Frames[FrameIndex];
+			ApplyFrameInput(MovementComponent, Frame, 1.f, true);
+			TickAndCompare(Frame.DeltaTime, Recording.GetFrameLocation(FrameIndex), Recording.GetFrameRotation(FrameIndex));
+		}
+	}
+	else
+	{
+		// step at a fixed rate, holding the input of whichever recorded frame covers the current time
+		const float FixedDeltaTime = FMath::Max(Settings.FixedDeltaTime, KINDA_SMALL_NUMBER);
+		const double Duration = Recording.GetDuration();
+
+		double Time = 0.0;
+		double FrameEndTime = Recording.Frames[0].DeltaTime;
+		int32 FrameIndex = 0;
+		int32 LastImpulseFrameIndex = INDEX_NONE;
+		FHoverDroneFlightCursor Cursor;
+		while (Time < Duration - KINDA_SMALL_NUMBER)
+		{
+			while (Time >= FrameEndTime && FrameIndex < Recording.Frames.Num() - 1)
+			{
+				++FrameIndex;
+				FrameEndTime += Recording.Frames[FrameIndex].DeltaTime;
+			}
+
+			const FHoverDroneFlightFrame& Frame = Recording.Frames[FrameIndex];
+			const float DeltaTime = float(FMath::Min(double(FixedDeltaTime), Duration - Time));
+			const float InputScale = Frame.DeltaTime > 0.f ? DeltaTime / Frame.DeltaTime : 0.f;
+			ApplyFrameInput(MovementComponent, Frame, InputScale, FrameIndex != LastImpulseFrameIndex);
+			LastImpulseFrameIndex = FrameIndex;
+
+			Time += DeltaTime;
+
+			FVector ExpectedLocation;
+			FRotator ExpectedRotation;
+			Recording.GetTransformAtTime(Time, ExpectedLocation, ExpectedRotation, Cursor);
+			TickAndCompare(DeltaTime, ExpectedLocation, ExpectedRotation);
+		}
+	}
+
+	MovementComponent.SetComponentTickEnabled(bWasTickEnabled);
+
+	Report.AvgTickMicroseconds = Report.NumFrames > 0 ? TotalTickSeconds * 1.0e6 / Report.NumFrames : 0.0;
+	return Report;
+}
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HoverDroneHeightField.h"
+
+namespace HoverDroneHeightField
+{
+	static int32 FloorDivide(int32 Value, int32 Divisor)
+	{
+		return Value >= 0 ? Value / Divisor : (Value - Divisor + 1) / Divisor;
+	}
+}
+
+FHoverDroneHeightField::FTile::FTile()
+{
+	FMemory::Memzero(Heights);
+	for (ESampleState& State : States)
+	{
+		State = ESampleState::Unsampled;
+	}
+}
+
+FHoverDroneHeightField::FHoverDroneHeightField(FSampler InSampler, const FHoverDroneHeightFieldSettings& InSettings)
+	: Sampler(MoveTemp(InSampler))
+	, Settings(InSettings)
+{
+	Settings.CellSize = FMath::Max(Settings.CellSize, 1.f);
+	Settings.MaxTiles = FMath::Max(Settings.MaxTiles, 4);
+}
+
+bool FHoverDroneHeightField::GetGroundHeight(const FVector& Location, float& OutGroundZ)
+{
+	++QueryCounter;
+
+	const double GridX = Location.X / Settings.CellSize;
+	const double GridY = Location.Y / Settings.CellSize;
+	const FIntPoint Cell(FMath::FloorToInt32(GridX), FMath::FloorToInt32(GridY));
+
+	float Corners[4];
+	if (!GetSample(Cell, Corners[0])
+		|| !GetSample(Cell + FIntPoint(1, 0), Corners[1])
+		|| !GetSample(Cell + FIntPoint(0, 1), Corners[2])
+		|| !GetSample(Cell + FIntPoint(1, 1), Corners[3]))
+	{
+		return false;
+	}
+
+	// interpolating across a ledge would put the ground halfway up a wall
+	const float MinZ = FMath::Min(FMath::Min(Corners[0], Corners[1]), FMath::Min(Corners[2], Corners[3]));
+	const float MaxZ = FMath::Max(FMath::Max(Corners[0], Corners[1]), FMath::Max(Corners[2], Corners[3]));
+	if (MaxZ - MinZ > Settings.MaxCornerHeightDelta)
+	{
+		return false;
+	}
+
+	const float AlphaX = float(GridX - Cell.X);
+	const float AlphaY = float(GridY - Cell.Y);
+	const float GroundZ = FMath::Lerp(FMath::Lerp(Corners[0], Corners[1], AlphaX), FMath::Lerp(Corners[2], Corners[3], AlphaX), AlphaY);
+
+	// samples are taken from above, anything underneath them is out of sight of the cache
+	if (Location.Z < GroundZ)
+	{
+		return false;
+	}
+
+	OutGroundZ = GroundZ;
+	return true;
+}
+
+bool FHoverDroneHeightField::GetSample(const FIntPoint& GridPoint, float& OutGroundZ)
+{
+	const FIntPoint TileCoord(HoverDroneHeightField::FloorDivide(GridPoint.X, TileSize), HoverDroneHeightField::FloorDivide(GridPoint.Y, TileSize));
+	FTile& Tile = FindOrAddTile(TileCoord);
+	Tile.LastUsed = QueryCounter;
+
+	const int32 Index = (GridPoint.Y - TileCoord.Y * TileSize) * TileSize + (GridPoint.X - TileCoord.X * TileSize);
+	ESampleState& State = Tile.States[Index];
+	if (State == ESampleState::Unsampled)
+	{
+		float GroundZ = 0.f;
+		const EHoverDroneGroundSample Sample = Sampler(FVector2D(GridPoint) * Settings.CellSize, GroundZ);
+		++NumSamplesTaken;
+
+		if (Sample == EHoverDroneGroundSample::Uncacheable)
+		{
+			return false;
+		}
+
+		State = Sample == EHoverDroneGroundSample::Ground ? ESampleState::Ground : ESampleState::NoGround;
+		Tile.Heights[Index] = GroundZ;
+	}
+
+	OutGroundZ = Tile.Heights[Index];
+	return State == ESampleState::Ground;
+}
+
+FHoverDroneHeightField::FTile& FHoverDroneHeightField::FindOrAddTile(const FIntPoint& TileCoord)
+{
+	if (TUniquePtr<FTile>* Existing = Tiles.Find(TileCoord))
+	{
+		return **Existing;
+	}
+
+	if (Tiles.Num() >= Settings.MaxTiles)
+	{
+		EvictLeastRecentlyUsed();
+	}
+	return *Tiles.Add(TileCoord, MakeUnique<FTile>());
+}
+
+void FHoverDroneHeightField::EvictLeastRecentlyUsed()
+{
+	// drop the oldest quarter at once so a drone flying in a straight line doesn't evict on every new tile
+	TArray<TPair<uint64, FIntPoint>> ByAge;
+	ByAge.Reserve(Tiles.Num());
+	for (const TPair<FIntPoint, TUniquePtr<FTile>>& Pair : Tiles)
+	{
+		ByAge.Emplace(Pair.Value->LastUsed, Pair.Key);
+	}
+	ByAge.Sort([](const TPair<uint64, FIntPoint>& A, const TPair<uint64, FIntPoint>& B) { return A.Key < B.Key; });
+
+	// tiles touched by the current query stay, the cell being sampled may straddle them
+	const int32 NumToEvict = FMath::Max(Tiles.Num() / 4, 1);
+	for (int32 Index = 0; Index < NumToEvict && ByAge[Index].Key != QueryCounter; ++Index)
+	{
+		Tiles.Remove(ByAge[Index].Value);
+	}
+}
+
+void FHoverDroneHeightField::Invalidate(const FBox& Bounds)
+{
+	if (!Bounds.IsValid || Tiles.IsEmpty())
+	{
+		return;
+	}
+
+	// any cell touching the bounds interpolates from a changed sample, so widen to the surrounding grid points
+	const FIntPoint MinPoint(FMath::FloorToInt32(Bounds.Min.X / Settings.CellSize), FMath::FloorToInt32(Bounds.Min.Y / Settings.CellSize));
+	const FIntPoint MaxPoint(FMath::CeilToInt32(Bounds.Max.X / Settings.CellSize), FMath::CeilToInt32(Bounds.Max.Y / Settings.CellSize));
+
+	for (TPair<FIntPoint, TUniquePtr<FTile>>& Pair : Tiles)
+	{
+		const FIntPoint TileMin = Pair.Key * TileSize;
+		const int32 MinX = FMath::Max(MinPoint.X - TileMin.X, 0);
+		const int32 MinY = FMath::Max(MinPoint.Y - TileMin.Y, 0);
+		const int32 MaxX = FMath::Min(MaxPoint.X - TileMin.X, TileSize - 1);
+		const int32 MaxY = FMath::Min(MaxPoint.Y - TileMin.Y, TileSize - 1);
+
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				Pair.Value->States[Y * TileSize + X] = ESampleState::Unsampled;
+			}
+		}
+	}
+}
+
+void FHoverDroneHeightField::InvalidateAll()
+{
+	Tiles.Reset();
+}
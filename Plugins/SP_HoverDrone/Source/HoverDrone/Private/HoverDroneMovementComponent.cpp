@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "HoverDroneMovementComponent.h"
+#include "HoverDroneAltitudeSubsystem.h"
 #include "HoverDroneSpeedLimitBox.h"
 #include "HoverDronePawn.h"
 #include "HoverDroneUtils.h"
@@ -640,6 +641,8 @@ void UHoverDroneMovementComponent::TickComponent(float DeltaTime, enum ELevelTic
 		return;
 	}
 
+	const float RawDeltaTime = DeltaTime;
+
 	// subclasses don't account for dilation, so do this adjustment before calling the super
 	if (bIgnoreTimeDilation)
 	{
@@ -649,6 +652,23 @@ void UHoverDroneMovementComponent::TickComponent(float DeltaTime, enum ELevelTic
 	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
 	const FRotator OldRotation = UpdatedComponent->GetComponentRotation();
 
+	// record the input before anything below adds to it or consumes it
+	int32 RecordedFrameIndex = INDEX_NONE;
+	if (ActiveRecording.IsValid())
+	{
+		FHoverDroneFlightFrame& Frame = ActiveRecording->Frames.AddDefaulted_GetRef();
+		Frame.DeltaTime = RawDeltaTime;
+		Frame.MoveInput = FVector3f(GetPendingInputVector());
+		Frame.RotationInput = FRotator3f(RotationInput);
+		Frame.DirectRotationInput = FRotator3f(DirectRotationInput);
+		Frame.VelocityImpulse = FVector3f(PendingVelocityToAdd);
+		Frame.RotVelocityImpulse = FRotator3f(PendingRotVelocityToAdd);
+		Frame.FOV = CurrentFOV;
+		Frame.SpeedIndex = DroneSpeedParamIndex;
+		Frame.bTurbo = bTurbo;
+		RecordedFrameIndex = ActiveRecording->Frames.Num() - 1;
+	}
+
 	// do any work to maintain a minimum height above the ground. this can potentially add inputs, so do this before inputs are applied
 	UpdateAutoHover();
 
@@ -794,6 +814,88 @@ void UHoverDroneMovementComponent::TickComponent(float DeltaTime, enum ELevelTic
 	CurrentAltitude = MeasureAltitude(PawnOwner->GetActorLocation());
 
 	bResetInterpolation = false;
+
+	if (RecordedFrameIndex != INDEX_NONE)
+	{
+		FHoverDroneFlightFrame& Frame = ActiveRecording->Frames[RecordedFrameIndex];
+		Frame.Location = FVector3f(UpdatedComponent->GetComponentLocation() - ActiveRecording->Start.Location);
+		Frame.Rotation = FRotator3f(UpdatedComponent->GetComponentRotation());
+	}
+}
+
+void UHoverDroneMovementComponent::StartRecording()
+{
+	ActiveRecording = MakeShared<FHoverDroneFlightRecording>();
+	ActiveRecording->Start = CaptureFlightState();
+}
+
+TSharedPtr<FHoverDroneFlightRecording> UHoverDroneMovementComponent::StopRecording()
+{
+	TSharedPtr<FHoverDroneFlightRecording> Recording = MoveTemp(ActiveRecording);
+	ActiveRecording.Reset();
+	return Recording;
+}
+
+FHoverDroneFlightStartState UHoverDroneMovementComponent::CaptureFlightState() const
+{
+	FHoverDroneFlightStartState State;
+	if (UpdatedComponent)
+	{
+		State.Location = UpdatedComponent->GetComponentLocation();
+		State.Rotation = UpdatedComponent->GetComponentRotation();
+	}
+	State.Velocity = Velocity;
+	State.RotVelocity = RotVelocity;
+	State.DirectRotationInputGoalRotation = DirectRotationInputGoalRotation;
+	State.LinearVelocity_NewModel = LinearVelInterpolator_IIR.GetCurrentValue();
+	State.YawVelocity_NewModel = YawVelInterpolator_IIR.GetCurrentValue();
+	State.PitchVelocity_NewModel = PitchVelInterpolator_IIR.GetCurrentValue();
+	State.DesiredHoverHeight = DesiredHoverHeight;
+	State.FOV = CurrentFOV;
+	State.MovementRateMultiplier = HoverDroneMovementRate::GetMultiplier();
+	State.LookRateMultiplier = HoverDroneMovementRate::GetLookMultiplier();
+	State.DroneSpeedScalar = DroneSpeedScalar;
+	State.SpeedIndex = DroneSpeedParamIndex;
+	State.bMaintainHoverHeight = bMaintainHoverHeight;
+	State.bTurbo = bTurbo;
+	State.bUseNewFlightModel = bUseNewDroneFlightModel;
+	return State;
+}
+
+void UHoverDroneMovementComponent::RestoreFlightState(const FHoverDroneFlightStartState& State)
+{
+	if (!PawnOwner || !UpdatedComponent)
+	{
+		return;
+	}
+
+	UpdatedComponent->SetWorldLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+	Velocity = State.Velocity;
+	RotVelocity = State.RotVelocity;
+	DirectRotationInputGoalRotation = State.DirectRotationInputGoalRotation;
+	DesiredHoverHeight = State.DesiredHoverHeight;
+	CurrentFOV = State.FOV;
+	DroneSpeedParamIndex = FMath::Clamp(State.SpeedIndex, 0, DroneSpeedParameters.Num() - 1);
+	bMaintainHoverHeight = State.bMaintainHoverHeight;
+	bTurbo = State.bTurbo;
+	bUseNewDroneFlightModel = State.bUseNewFlightModel;
+
+	// the new model interpolators snap on their first eval, so this only matches a recording that started after the drone had already flown
+	if (bUseNewDroneFlightModel)
+	{
+		LinearVelInterpolator_IIR.SetInitialValue(State.LinearVelocity_NewModel);
+		YawVelInterpolator_IIR.SetInitialValue(State.YawVelocity_NewModel);
+		PitchVelInterpolator_IIR.SetInitialValue(State.PitchVelocity_NewModel);
+	}
+
+	ConsumeInputVector();
+	RotationInput = FRotator::ZeroRotator;
+	DirectRotationInput = FRotator::ZeroRotator;
+	PendingVelocityToAdd = FVector::ZeroVector;
+	PendingRotVelocityToAdd = FRotator::ZeroRotator;
+
+	CurrentAltitude = MeasureAltitude(PawnOwner->GetActorLocation());
 }
 
 void UHoverDroneMovementComponent::OnRegister()
@@ -921,6 +1023,16 @@ void UHoverDroneMovementComponent::UpdatedMaxAllowedSpeed(int32 NewMaxAllowedSpe
 //#include "DrawDebugHelpers.h"
 float UHoverDroneMovementComponent::MeasureAltitude(FVector Location) const
 {
+	if (UHoverDroneAltitudeSubsystem::IsCacheEnabled())
+	{
+		UHoverDroneAltitudeSubsystem* const AltitudeSubsystem = GetWorld()->GetSubsystem<UHoverDroneAltitudeSubsystem>();
+		float CachedAltitude = 0.f;
+		if (AltitudeSubsystem && AltitudeSubsystem->GetCachedAltitude(Location, CachedAltitude))
+		{
+			return CachedAltitude;
+		}
+	}
+
 	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(Reverb_HoverDrone_MeasureAltitude), true, PawnOwner);
 	FHitResult Hit;
 
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "HoverDroneUtils.h"
+#include "HoverDroneAltitudeSubsystem.h"
 #include "Engine/GameInstance.h"
 #include "HoverDroneSpeedLimitBox.h"
 #include "HoverDroneVolumeManager.h"
@@ -15,6 +16,16 @@ namespace UEHoverDrone
 	{
 		if (Actor)
 		{
+			if (UHoverDroneAltitudeSubsystem::IsCacheEnabled())
+			{
+				UHoverDroneAltitudeSubsystem* const AltitudeSubsystem = Actor->GetWorld()->GetSubsystem<UHoverDroneAltitudeSubsystem>();
+				float CachedAltitude = 0.f;
+				if (AltitudeSubsystem && AltitudeSubsystem->GetCachedAltitude(Actor->GetActorLocation() + Offset, CachedAltitude))
+				{
+					return CachedAltitude;
+				}
+			}
+
 			FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(Reverb_HoverDrone_MeasureAltitude), true, Actor);
 			FHitResult Hit;
 
@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HoverDroneTestWorld.h"
+#include "HoverDroneAltitudeSubsystem.h"
+#include "HoverDroneHeightField.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+// Checks the drone altitude cache against analytic terrain and against the downward trace it replaces
+
+namespace HoverDroneAltitudeCacheTest
+{
+	/** What UHoverDroneMovementComponent::MeasureAltitude does without the cache */
+	static float TraceAltitude(UWorld* World, const FVector& Location)
+	{
+		FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(HoverDroneAltitudeCacheTest), true);
+		FHitResult Hit;
+		if (World->LineTraceSingleByChannel(Hit, Location, Location - FVector::UpVector * 100000.f, ECC_WorldStatic, TraceParams))
+		{
+			return (Hit.ImpactPoint - Location).Size();
+		}
+		return 0.f;
+	}
+
+	static AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* Cube, const FTransform& Transform, EComponentMobility::Type Mobility)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		// static components won't take a mesh once registered
+		AStaticMeshActor* const Box = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParameters);
+		Box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Box->GetStaticMeshComponent()->SetStaticMesh(Cube);
+		Box->GetStaticMeshComponent()->SetMobility(Mobility);
+		return Box;
+	}
+
+	/** A floor with its top at Z 0 over 100 m, and a tilted slab on top of it */
+	static bool SpawnTerrain(FAutomationTestBase& Test, UWorld* World)
+	{
+		UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if (!Test.TestNotNull(TEXT("Engine cube mesh"), Cube))
+		{
+			return false;
+		}
+
+		SpawnBox(World, Cube, FTransform(FRotator::ZeroRotator, FVector(0.0, 0.0, -50.0), FVector(100.0, 100.0, 1.0)), EComponentMobility::Static);
+		SpawnBox(World, Cube, FTransform(FRotator(10.0, 0.0, 0.0), FVector(-1000.0, 1000.0, 150.0), FVector(30.0, 30.0, 1.0)), EComponentMobility::Static);
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverDroneAltitudeCacheTest, "HoverDrone.AltitudeCache",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FHoverDroneAltitudeCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace HoverDroneAltitudeCacheTest;
+
+	// analytic rolling terrain, bilinear over 1 m cells should be well under a centimetre off
+	{
+		float TerrainOffset = 0.f;
+		auto RollingTerrain = [&TerrainOffset](const FVector2D& Position)
+		{
+			return TerrainOffset + 300.f * FMath::Sin(float(Position.X) / 1000.f) * FMath::Cos(float(Position.Y) / 1300.f);
+		};
+
+		FHoverDroneHeightField HeightField([&RollingTerrain](const FVector2D& Position, float& OutGroundZ)
+		{
+			OutGroundZ = RollingTerrain(Position);
+			return EHoverDroneGroundSample::Ground;
+		});
+
+		FRandomStream Random(1234);
+		TArray<FVector> Queries;
+		for (int32 Index = 0; Index < 20000; ++Index)
+		{
+			Queries.Emplace(Random.FRandRange(-5000.f, 5000.f), Random.FRandRange(-5000.f, 5000.f), 1000.f);
+		}
+
+		float MaxError = 0.f;
+		int32 NumAnswered = 0;
+		for (const FVector& Query : Queries)
+		{
+			float GroundZ = 0.f;
+			if (HeightField.GetGroundHeight(Query, GroundZ))
+			{
+				++NumAnswered;
+				MaxError = FMath::Max(MaxError, FMath::Abs(GroundZ - RollingTerrain(FVector2D(Query))));
+			}
+		}
+		AddInfo(FString::Printf(TEXT("Rolling terrain: %d queries, %lld samples, %d tiles, max error %.3f cm"), Queries.Num(), HeightField.GetNumSamplesTaken(), HeightField.GetNumTiles(), MaxError));
+		TestEqual(TEXT("Smooth terrain is always answered"), NumAnswered, Queries.Num());
+		TestTrue(TEXT("Under a centimetre off"), MaxError < 1.f);
+
+		const int64 SamplesAfterFirstPass = HeightField.GetNumSamplesTaken();
+		float GroundZ = 0.f;
+		for (const FVector& Query : Queries)
+		{
+			HeightField.GetGroundHeight(Query, GroundZ);
+		}
+		TestEqual(TEXT("Visited ground isn't sampled again"), HeightField.GetNumSamplesTaken(), SamplesAfterFirstPass);
+
+		TestFalse(TEXT("Points under the ground aren't answered"), HeightField.GetGroundHeight(FVector(0.0, 0.0, -1000.0), GroundZ));
+
+		// only the invalidated region picks up the change
+		HeightField.GetGroundHeight(FVector(3000.0, 3000.0, 1000.0), GroundZ);
+		TerrainOffset = 100.f;
+		HeightField.Invalidate(FBox(FVector(-200.0, -200.0, -1000.0), FVector(200.0, 200.0, 1000.0)));
+		TestTrue(TEXT("Invalidated region answers"), HeightField.GetGroundHeight(FVector(0.0, 0.0, 1000.0), GroundZ));
+		TestTrue(TEXT("Invalidated region is sampled again"), FMath::IsNearlyEqual(GroundZ, RollingTerrain(FVector2D::ZeroVector), 1.f));
+		TestTrue(TEXT("Elsewhere keeps its samples"), HeightField.GetGroundHeight(FVector(3000.0, 3000.0, 1000.0), GroundZ)
+			&& FMath::IsNearlyEqual(GroundZ, RollingTerrain(FVector2D(3000.0, 3000.0)) - TerrainOffset, 1.f));
+	}
+
+	// ledges, holes and uncacheable ground go back to the trace
+	{
+		int32 NumSamples = 0;
+		FHoverDroneHeightFieldSettings Settings;
+		Settings.MaxTiles = 8;
+		FHoverDroneHeightField HeightField([&NumSamples](const FVector2D& Position, float& OutGroundZ)
+		{
+			++NumSamples;
+			OutGroundZ = Position.X < 0.0 ? 0.f : 500.f;
+			if (Position.Y > 10000.0)
+			{
+				return EHoverDroneGroundSample::NoGround;
+			}
+			return Position.Y < -10000.0 ? EHoverDroneGroundSample::Uncacheable : EHoverDroneGroundSample::Ground;
+		}, Settings);
+
+		float GroundZ = 0.f;
+		TestFalse(TEXT("Cells across a ledge aren't interpolated"), HeightField.GetGroundHeight(FVector(-50.0, 50.0, 1000.0), GroundZ));
+		TestTrue(TEXT("Either side of the ledge is"), HeightField.GetGroundHeight(FVector(-550.0, 50.0, 1000.0), GroundZ) && GroundZ == 0.f);
+		TestTrue(TEXT("On top of the ledge too"), HeightField.GetGroundHeight(FVector(550.0, 50.0, 1000.0), GroundZ) && GroundZ == 500.f);
+		TestFalse(TEXT("No ground isn't answered"), HeightField.GetGroundHeight(FVector(-550.0, 10550.0, 1000.0), GroundZ));
+
+		TestFalse(TEXT("Uncacheable ground isn't answered"), HeightField.GetGroundHeight(FVector(-550.0, -10550.0, 1000.0), GroundZ));
+		const int32 SamplesBefore = NumSamples;
+		HeightField.GetGroundHeight(FVector(-550.0, -10550.0, 1000.0), GroundZ);
+		TestTrue(TEXT("Uncacheable ground isn't kept"), NumSamples > SamplesBefore);
+
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			HeightField.GetGroundHeight(FVector(-100000.0 + Index * 2000.0, 0.0, 1000.0), GroundZ);
+		}
+		TestTrue(TEXT("Old tiles are evicted"), HeightField.GetNumTiles() <= Settings.MaxTiles);
+	}
+
+	// real collision, against the trace
+	const FHoverDroneScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	UHoverDroneAltitudeSubsystem* AltitudeSubsystem = World->GetSubsystem<UHoverDroneAltitudeSubsystem>();
+	if (!TestNotNull(TEXT("Altitude subsystem"), AltitudeSubsystem) || !SpawnTerrain(*this, World))
+	{
+		return false;
+	}
+
+	FRandomStream Random(5678);
+	int32 NumQueries = 0;
+	int32 NumAnswered = 0;
+	int32 NumClose = 0;
+	float MaxError = 0.f;
+	for (; NumQueries < 5000; ++NumQueries)
+	{
+		const FVector Location(Random.FRandRange(-4000.f, 4000.f), Random.FRandRange(-4000.f, 4000.f), Random.FRandRange(800.f, 3000.f));
+		float CachedAltitude = 0.f;
+		if (AltitudeSubsystem->GetCachedAltitude(Location, CachedAltitude))
+		{
+			const float Error = FMath::Abs(CachedAltitude - TraceAltitude(World, Location));
+			MaxError = FMath::Max(MaxError, Error);
+			NumClose += Error < 5.f ? 1 : 0;
+			++NumAnswered;
+		}
+	}
+	AddInfo(FString::Printf(TEXT("Traced terrain: %d of %d queries answered, %d within 5 cm, max error %.2f cm"), NumAnswered, NumQueries, NumClose, MaxError));
+	TestTrue(TEXT("Most queries are answered from the cache"), NumAnswered > NumQueries * 9 / 10);
+	TestTrue(TEXT("Almost all match the trace"), NumClose >= NumAnswered * 98 / 100);
+	TestTrue(TEXT("Nothing further off than a ledge the cache would have refused"), MaxError <= AltitudeSubsystem->GetHeightField().GetSettings().MaxCornerHeightDelta);
+
+	// moving collision invalidates what was under it and where it went
+	UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	AStaticMeshActor* const Mover = SpawnBox(World, Cube, FTransform(FRotator::ZeroRotator, FVector(2000.0, -2000.0, 200.0), FVector(4.0)), EComponentMobility::Movable);
+	AltitudeSubsystem->TrackMovingCollision(Mover);
+
+	const FVector OverMover(2050.0, -1950.0, 1000.0);
+	float Altitude = 0.f;
+	TestTrue(TEXT("Answered over the mover"), AltitudeSubsystem->GetCachedAltitude(OverMover, Altitude));
+	TestTrue(TEXT("Mover is the ground"), FMath::IsNearlyEqual(Altitude, 600.f, 1.f));
+
+	Mover->SetActorLocation(FVector(2000.0, 2000.0, 200.0), false, nullptr, ETeleportType::TeleportPhysics);
+	AltitudeSubsystem->Tick(0.f);
+	TestTrue(TEXT("Answered where the mover was"), AltitudeSubsystem->GetCachedAltitude(OverMover, Altitude));
+	TestTrue(TEXT("Floor again after the mover left"), FMath::IsNearlyEqual(Altitude, TraceAltitude(World, OverMover), 1.f) && FMath::IsNearlyEqual(Altitude, 1000.f, 1.f));
+	TestTrue(TEXT("Answered where the mover went"), AltitudeSubsystem->GetCachedAltitude(FVector(2050.0, 2050.0, 1000.0), Altitude));
+	TestTrue(TEXT("Mover is the ground where it went"), FMath::IsNearlyEqual(Altitude, 600.f, 1.f));
+
+	AltitudeSubsystem->InvalidateAll();
+	TestEqual(TEXT("Level streaming drops every tile"), AltitudeSubsystem->GetHeightField().GetNumTiles(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverDroneAltitudeCacheBenchmark, "HoverDrone.AltitudeCacheBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FHoverDroneAltitudeCacheBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace HoverDroneAltitudeCacheTest;
+
+	constexpr int32 NumQueries = 100000;
+
+	const FHoverDroneScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	UHoverDroneAltitudeSubsystem* AltitudeSubsystem = World->GetSubsystem<UHoverDroneAltitudeSubsystem>();
+	if (!TestNotNull(TEXT("Altitude subsystem"), AltitudeSubsystem) || !SpawnTerrain(*this, World))
+	{
+		return false;
+	}
+
+	// a drone circling over the terrain, the way the hover height prediction queries it
+	TArray<FVector> Queries;
+	Queries.Reserve(NumQueries);
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		const float Angle = Index * 0.0005f;
+		Queries.Emplace(3000.f * FMath::Cos(Angle), 3000.f * FMath::Sin(Angle), 1500.f + 200.f * FMath::Sin(Angle * 7.f));
+	}
+
+	double StartTime = FPlatformTime::Seconds();
+	double TracedSum = 0.0;
+	for (const FVector& Query : Queries)
+	{
+		TracedSum += TraceAltitude(World, Query);
+	}
+	const double TraceMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	double CachedSum = 0.0;
+	int32 NumMisses = 0;
+	for (const FVector& Query : Queries)
+	{
+		float Altitude = 0.f;
+		if (!AltitudeSubsystem->GetCachedAltitude(Query, Altitude))
+		{
+			Altitude = TraceAltitude(World, Query);
+			++NumMisses;
+		}
+		CachedSum += Altitude;
+	}
+	const double CacheMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const FHoverDroneHeightField& HeightField = AltitudeSubsystem->GetHeightField();
+	AddInfo(FString::Printf(TEXT("%d queries: trace %.3f ms, cache %.3f ms (%d misses, %lld samples, %d tiles)"),
+		NumQueries, TraceMilliseconds, CacheMilliseconds, NumMisses, HeightField.GetNumSamplesTaken(), HeightField.GetNumTiles()));
+
+	TestTrue(TEXT("Cache is faster than tracing every query"), CacheMilliseconds < TraceMilliseconds);
+	TestTrue(TEXT("Far fewer traces"), HeightField.GetNumSamplesTaken() + NumMisses < NumQueries / 4);
+	TestTrue(TEXT("Same average altitude as the trace"), FMath::IsNearlyEqual(CachedSum / NumQueries, TracedSum / NumQueries, 1.0));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HoverDroneTestWorld.h"
+#include "HoverDroneFlightRecording.h"
+#include "HoverDroneFlightReplay.h"
+#include "HoverDroneMovementComponent.h"
+#include "HoverDronePawn.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Records a scripted drone flight in an empty world, round trips it through the file format and replays it
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHoverDroneFlightReplayTest, "HoverDrone.FlightReplay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FHoverDroneFlightReplayTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumFrames = 240;
+
+	const FHoverDroneScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AHoverDronePawn* Drone = World->SpawnActor<AHoverDronePawn>(AHoverDronePawn::StaticClass(), FTransform(FVector(0.0, 0.0, 1000.0)), SpawnParameters);
+	APlayerController* PlayerController = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), FTransform::Identity, SpawnParameters);
+	UHoverDroneMovementComponent* Movement = Drone ? Cast<UHoverDroneMovementComponent>(Drone->GetMovementComponent()) : nullptr;
+	if (!TestNotNull(TEXT("Drone movement component"), Movement) || !TestNotNull(TEXT("Player controller"), PlayerController))
+	{
+		return false;
+	}
+
+	// the movement only applies input for a local controller
+	PlayerController->Possess(Drone);
+	Movement->SetComponentTickEnabled(false);
+
+	// scripted input with uneven frame times, like a real session
+	Movement->StartRecording();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const float DeltaTime = (Frame % 3 == 0) ? 1.f / 30.f : 1.f / 60.f;
+		const float Phase = Frame * 0.05f;
+		Movement->AddInputVector(FVector(FMath::Cos(Phase), FMath::Sin(Phase), Frame < NumFrames / 2 ? 0.2f : -0.2f), true);
+		Movement->AddRotationInput(FRotator(0.f, Frame < NumFrames / 2 ? 0.5f : -0.5f, 0.f));
+		if (Frame % 40 == 20)
+		{
+			Movement->AddDirectRotationInput(FRotator(1.f, 3.f, 0.f));
+		}
+		if (Frame == 100)
+		{
+			Movement->AddVelocity(FVector(0.0, 0.0, 500.0));
+			Movement->SetTurbo(true);
+		}
+		Movement->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+	}
+	const FVector RecordedEndLocation = Drone->GetActorLocation();
+
+	TSharedPtr<FHoverDroneFlightRecording> Recording = Movement->StopRecording();
+	if (!TestTrue(TEXT("Recording captured"), Recording.IsValid()))
+	{
+		return false;
+	}
+	TestFalse(TEXT("Stopped"), Movement->IsRecording());
+	TestEqual(TEXT("One frame per tick"), Recording->Frames.Num(), NumFrames);
+	TestTrue(TEXT("The drone moved"), FVector::Dist(RecordedEndLocation, Recording->Start.Location) > 100.0);
+
+	// file format round trip
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("Saved"), Recording->Serialize(Writer));
+	AddInfo(FString::Printf(TEXT("%d frames in %d bytes"), NumFrames, Bytes.Num()));
+	TestTrue(TEXT("Compact, under 80 bytes per frame with input on every frame"), Bytes.Num() < NumFrames * 80);
+
+	FHoverDroneFlightRecording Loaded;
+	FMemoryReader Reader(Bytes);
+	TestTrue(TEXT("Loaded"), Loaded.Serialize(Reader));
+	TestEqual(TEXT("Same frame count"), Loaded.Frames.Num(), NumFrames);
+	if (Loaded.Frames.Num() == NumFrames)
+	{
+		TestTrue(TEXT("Turbo survives"), Loaded.Frames[150].bTurbo && !Loaded.Frames[50].bTurbo);
+		TestEqual(TEXT("Impulse survives"), Loaded.Frames[100].VelocityImpulse, FVector3f(0.f, 0.f, 500.f));
+		TestEqual(TEXT("Direct rotation survives"), Loaded.Frames[60].DirectRotationInput, FRotator3f(1.f, 3.f, 0.f));
+		TestTrue(TEXT("Transform survives"), Loaded.GetFrameLocation(NumFrames - 1).Equals(RecordedEndLocation, 0.1));
+	}
+
+	// playing forward with a cursor lands where searching from the first frame does
+	FHoverDroneFlightCursor Cursor;
+	bool bCursorMatches = true;
+	for (double Time = 0.0; Time < Loaded.GetDuration() + 0.1; Time += 1.0 / 90.0)
+	{
+		FVector SearchedLocation, CursorLocation;
+		FRotator SearchedRotation, CursorRotation;
+		Loaded.GetTransformAtTime(Time, SearchedLocation, SearchedRotation);
+		Loaded.GetTransformAtTime(Time, CursorLocation, CursorRotation, Cursor);
+		bCursorMatches &= SearchedLocation.Equals(CursorLocation) && SearchedRotation.Equals(CursorRotation);
+	}
+	TestTrue(TEXT("Cursor playback matches searching from the start"), bCursorMatches);
+
+	// turning through +-180 degrees goes the short way, not back around through 0
+	FHoverDroneFlightRecording Turn;
+	Turn.Start.Rotation = FRotator(0.f, 170.f, 0.f);
+	Turn.Frames.AddDefaulted_GetRef().DeltaTime = 1.f;
+	Turn.Frames[0].Rotation = FRotator3f(0.f, -170.f, 0.f);
+	FVector TurnLocation;
+	FRotator TurnRotation;
+	Turn.GetTransformAtTime(0.5, TurnLocation, TurnRotation);
+	TestTrue(TEXT("Halfway through a turn across 180 degrees faces 180"), FMath::IsNearlyEqual(FRotator::NormalizeAxis(TurnRotation.Yaw + 180.0), 0.0, 0.01));
+
+	TArray<uint8> NotARecording = Bytes;
+	NotARecording[0] ^= 0xFF;
+	FMemoryReader NotARecordingReader(NotARecording);
+	FHoverDroneFlightRecording Rejected;
+	TestFalse(TEXT("Other files are rejected"), Rejected.Serialize(NotARecordingReader));
+
+	// same timing replays the same flight
+	const FHoverDroneReplayReport Report = UEHoverDrone::ReplayFlight(*Movement, Loaded);
+	AddInfo(FString::Printf(TEXT("Recorded timing: %s"), *Report.ToString()));
+	TestEqual(TEXT("Every frame replayed"), Report.NumFrames, NumFrames);
+	TestFalse(TEXT("Replay doesn't diverge"), Report.HasDiverged());
+	TestTrue(TEXT("Ends where the recording ended"), Drone->GetActorLocation().Equals(RecordedEndLocation, 1.0));
+	TestFalse(TEXT("Component tick left off"), Movement->IsComponentTickEnabled());
+
+	// a fixed step covers the same duration, divergence is reported rather than expected to be zero
+	FHoverDroneReplaySettings FixedSettings;
+	FixedSettings.bUseRecordedTiming = false;
+	FixedSettings.FixedDeltaTime = 1.f / 120.f;
+	const FHoverDroneReplayReport FixedReport = UEHoverDrone::ReplayFlight(*Movement, Loaded, FixedSettings);
+	AddInfo(FString::Printf(TEXT("Fixed 1/120 s: %s"), *FixedReport.ToString()));
+	TestTrue(TEXT("Fixed step covers the recorded duration"), FMath::Abs(FixedReport.NumFrames - FMath::RoundToInt32(Loaded.GetDuration() * 120.0)) <= 1);
+
+	// replays leave the multiplier cvars at their priority, the hotkeys still get to change them
+	if (IConsoleVariable* MovementRateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoverDrone.MovementRateMultiplier")))
+	{
+		const float PreviousRate = MovementRateCVar->GetFloat();
+		MovementRateCVar->Set(PreviousRate * 2.f, ECVF_SetByGameSetting);
+		TestEqual(TEXT("Game settings still set the movement rate after a replay"), MovementRateCVar->GetFloat(), PreviousRate * 2.f);
+		MovementRateCVar->Set(PreviousRate, ECVF_SetByGameSetting);
+	}
+
+	return true;
+}
+
+#endif
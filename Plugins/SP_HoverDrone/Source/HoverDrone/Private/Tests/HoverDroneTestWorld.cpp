@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HoverDroneTestWorld.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+FHoverDroneScopedTestWorld::FHoverDroneScopedTestWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+}
+
+FHoverDroneScopedTestWorld::~FHoverDroneScopedTestWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+#endif
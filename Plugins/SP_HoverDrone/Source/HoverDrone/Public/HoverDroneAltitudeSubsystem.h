@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "HoverDroneHeightField.h"
+#include "HoverDroneAltitudeSubsystem.generated.h"
+
+/**
+ * Answers drone altitude queries from a cached height field instead of a physics trace per query.
+ * Enabled with HoverDrone.AltitudeCache. Streaming levels in or out drops the whole cache, movable
+ * collision only drops the samples under where it was and where it is now.
+ */
+UCLASS()
+class HOVERDRONE_API UHoverDroneAltitudeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static bool IsCacheEnabled();
+
+	/**
+	 * Altitude above the ground as the downward trace in UHoverDroneMovementComponent::MeasureAltitude would
+	 * measure it, 0 with nothing in trace range. False on a cache miss, the caller should trace instead.
+	 */
+	bool GetCachedAltitude(const FVector& Location, float& OutAltitude);
+
+	/** Starts watching an actor's movable collision, for actors that became movable after they spawned */
+	void TrackMovingCollision(AActor* Actor);
+
+	void InvalidateAll();
+
+	FHoverDroneHeightField& GetHeightField() { return *HeightField; }
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+private:
+
+	EHoverDroneGroundSample SampleGround(const FVector2D& Position, float& OutGroundZ) const;
+	bool IsTracked(const class UPrimitiveComponent* Component) const;
+
+	void OnLevelRemovedFromWorld(class ULevel* Level, class UWorld* World);
+	void OnLevelAddedToWorld(class ULevel* Level, class UWorld* World);
+	void OnActorSpawned(AActor* Actor);
+
+	struct FTrackedPrimitive
+	{
+		TWeakObjectPtr<class UPrimitiveComponent> Component;
+		FBox Bounds;
+	};
+
+	TArray<FTrackedPrimitive> TrackedPrimitives;
+	TUniquePtr<FHoverDroneHeightField> HeightField;
+	bool bWasCacheEnabled = false;
+
+	FDelegateHandle OnLevelRemovedFromWorldHandle;
+	FDelegateHandle OnLevelAddedToWorldHandle;
+	FDelegateHandle OnActorSpawnedHandle;
+};
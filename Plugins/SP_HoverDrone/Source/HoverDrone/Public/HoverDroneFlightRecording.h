@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Movement component state at the start of a recording, everything a replay needs to start from the same place */
+struct FHoverDroneFlightStartState
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector Velocity = FVector::ZeroVector;
+	FRotator RotVelocity = FRotator::ZeroRotator;
+	FRotator DirectRotationInputGoalRotation = FRotator::ZeroRotator;
+	FVector LinearVelocity_NewModel = FVector::ZeroVector;
+	float YawVelocity_NewModel = 0.f;
+	float PitchVelocity_NewModel = 0.f;
+	float DesiredHoverHeight = 0.f;
+	float FOV = 90.f;
+	float MovementRateMultiplier = 1.f;
+	float LookRateMultiplier = 1.f;
+	float DroneSpeedScalar = 1.f;
+	int32 SpeedIndex = 0;
+	bool bMaintainHoverHeight = false;
+	bool bTurbo = false;
+	bool bUseNewFlightModel = false;
+};
+
+/** One movement tick: the input that went in and the transform that came out */
+struct FHoverDroneFlightFrame
+{
+	/** Raw delta time passed to the movement tick */
+	float DeltaTime = 0.f;
+
+	FVector3f MoveInput = FVector3f::ZeroVector;
+	FRotator3f RotationInput = FRotator3f::ZeroRotator;
+	FRotator3f DirectRotationInput = FRotator3f::ZeroRotator;
+	FVector3f VelocityImpulse = FVector3f::ZeroVector;
+	FRotator3f RotVelocityImpulse = FRotator3f::ZeroRotator;
+	float FOV = 90.f;
+	int32 SpeedIndex = 0;
+	bool bTurbo = false;
+
+	/** Resulting transform, location relative to the start location */
+	FVector3f Location = FVector3f::ZeroVector;
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+};
+
+/** Where the last GetTransformAtTime lookup landed, so playback moving forward continues from there instead of from the first frame */
+struct FHoverDroneFlightCursor
+{
+	int32 FrameIndex = 0;
+	double FrameStartTime = 0.0;
+};
+
+/**
+ * A captured drone flight. Saved as a small binary file where each frame only stores the inputs that are set
+ * and the state that changed since the previous frame, so a quiet frame is under 30 bytes.
+ */
+class HOVERDRONE_API FHoverDroneFlightRecording
+{
+public:
+	FHoverDroneFlightStartState Start;
+	TArray<FHoverDroneFlightFrame> Frames;
+
+	/** Sum of all frame delta times */
+	double GetDuration() const;
+
+	FVector GetFrameLocation(int32 FrameIndex) const { return Start.Location + FVector(Frames[FrameIndex].Location); }
+	FRotator GetFrameRotation(int32 FrameIndex) const { return FRotator(Frames[FrameIndex].Rotation); }
+
+	/** Transform at a time since the start of the recording, interpolated between frames. Searches from the first frame */
+	void GetTransformAtTime(double Time, FVector& OutLocation, FRotator& OutRotation) const;
+
+	/** Same, searching from Cursor and leaving it on the frame Time falls in. A time before the cursor's frame searches from the first frame again */
+	void GetTransformAtTime(double Time, FVector& OutLocation, FRotator& OutRotation, FHoverDroneFlightCursor& Cursor) const;
+
+	/** Returns false if the archive doesn't hold a recording this version can read */
+	bool Serialize(FArchive& Ar);
+
+	bool SaveToFile(const FString& Filename);
+	bool LoadFromFile(const FString& Filename);
+
+	static const TCHAR* GetFileExtension() { return TEXT(".hdflight"); }
+
+	/** Saved/HoverDrone/<Name>.hdflight, where the record and replay console commands look for recordings */
+	static FString GetSavedPath(const FString& Name);
+};
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FHoverDroneFlightRecording;
+class UHoverDroneMovementComponent;
+
+struct FHoverDroneReplaySettings
+{
+	/** Replays every frame with its recorded delta time. Otherwise steps at FixedDeltaTime over the same duration */
+	bool bUseRecordedTiming = true;
+	float FixedDeltaTime = 1.f / 60.f;
+
+	/** Location error in cm above which the replay counts as diverged */
+	float LocationTolerance = 1.f;
+
+	/** Rotation error in degrees above which the replay counts as diverged */
+	float RotationTolerance = 0.5f;
+};
+
+struct HOVERDRONE_API FHoverDroneReplayReport
+{
+	int32 NumFrames = 0;
+	double MaxLocationError = 0.0;
+	double FinalLocationError = 0.0;
+	float MaxRotationError = 0.f;
+
+	/** First replayed frame that went past a tolerance, INDEX_NONE if none did */
+	int32 FirstDivergentFrame = INDEX_NONE;
+
+	/** CPU cost of the movement tick */
+	double AvgTickMicroseconds = 0.0;
+	double MaxTickMicroseconds = 0.0;
+
+	bool HasDiverged() const { return FirstDivergentFrame != INDEX_NONE; }
+	FString ToString() const;
+};
+
+namespace UEHoverDrone
+{
+	/**
+	 * Feeds a recording back through the movement component, ticking it directly rather than through the
+	 * world, so it runs as fast as the simulation allows and works headless. The component's own tick is
+	 * off while replaying and the drone ends up where the replay left it.
+	 */
+	HOVERDRONE_API FHoverDroneReplayReport ReplayFlight(UHoverDroneMovementComponent& MovementComponent, const FHoverDroneFlightRecording& Recording, const FHoverDroneReplaySettings& Settings = FHoverDroneReplaySettings());
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EHoverDroneGroundSample : uint8
+{
+	/** Ground found, safe to cache */
+	Ground,
+	/** Nothing below this point */
+	NoGround,
+	/** Hit something that may move away on its own (a pawn), don't keep it */
+	Uncacheable
+};
+
+struct FHoverDroneHeightFieldSettings
+{
+	/** Distance between ground samples */
+	float CellSize = 100.f;
+
+	/** Least recently used tiles get dropped above this many */
+	int32 MaxTiles = 1024;
+
+	/** Cells whose corners differ by more than this are treated as ledges and not interpolated */
+	float MaxCornerHeightDelta = 100.f;
+};
+
+/**
+ * Sparse grid of ground heights, sampled lazily in tiles around the points that get queried and read back with
+ * bilinear interpolation. Doesn't know about the world itself, the sampler does the actual tracing.
+ */
+class HOVERDRONE_API FHoverDroneHeightField
+{
+public:
+	/** Finds the ground height at a grid position */
+	using FSampler = TFunction<EHoverDroneGroundSample(const FVector2D& Position, float& OutGroundZ)>;
+
+	static constexpr int32 TileSize = 16;
+
+	explicit FHoverDroneHeightField(FSampler InSampler, const FHoverDroneHeightFieldSettings& InSettings = FHoverDroneHeightFieldSettings());
+
+	/**
+	 * Ground height under a location. Returns false when the cache can't answer: no ground or uncacheable ground
+	 * at a cell corner, a ledge inside the cell, or the location is below the cached ground (overhangs, caves).
+	 */
+	bool GetGroundHeight(const FVector& Location, float& OutGroundZ);
+
+	/** Drops every sample inside the bounds, seen from above */
+	void Invalidate(const FBox& Bounds);
+	void InvalidateAll();
+
+	int32 GetNumTiles() const { return Tiles.Num(); }
+	int64 GetNumSamplesTaken() const { return NumSamplesTaken; }
+	const FHoverDroneHeightFieldSettings& GetSettings() const { return Settings; }
+
+private:
+	enum class ESampleState : uint8
+	{
+		Unsampled,
+		Ground,
+		NoGround
+	};
+
+	struct FTile
+	{
+		float Heights[TileSize * TileSize];
+		ESampleState States[TileSize * TileSize];
+		uint64 LastUsed = 0;
+
+		FTile();
+	};
+
+	/** Looks up or samples one grid point, false if it has no cacheable ground */
+	bool GetSample(const FIntPoint& GridPoint, float& OutGroundZ);
+	FTile& FindOrAddTile(const FIntPoint& TileCoord);
+	void EvictLeastRecentlyUsed();
+
+	FSampler Sampler;
+	FHoverDroneHeightFieldSettings Settings;
+	TMap<FIntPoint, TUniquePtr<FTile>> Tiles;
+	uint64 QueryCounter = 0;
+	int64 NumSamplesTaken = 0;
+};
@@ -4,6 +4,7 @@
 
 #include "GameFramework/FloatingPawnMovement.h"
 #include "GameFramework/SpectatorPawnMovement.h"
+#include "HoverDroneFlightRecording.h"
 #include "HoverDroneTypes.h"
 #include "SPInterpolators.h"
 #include "HoverDroneMovementComponent.generated.h"
@@ -79,6 +80,19 @@ public:
 	/** Snaps any interpolations to the goal position, useful on cuts. */
 	void ResetInterpolation() { bResetInterpolation = true; };			
 
+	/** Flight recording, captures the input and resulting transform of every movement tick until stopped. */
+	void StartRecording();
+	TSharedPtr<FHoverDroneFlightRecording> StopRecording();
+	bool IsRecording() const { return ActiveRecording.IsValid(); }
+
+	/** Everything a replay needs to start from the current state. */
+	FHoverDroneFlightStartState CaptureFlightState() const;
+
+	/** Puts the drone back into a captured state and drops any pending input, used before replaying a recording. */
+	void RestoreFlightState(const FHoverDroneFlightStartState& State);
+
+	float GetCurrentFOV() const { return CurrentFOV; }
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = HoverDroneMovement)
 	int32 MaxAllowedSpeedIndex;
 
@@ -295,6 +309,9 @@ private:
 
 	void UpdatedMaxAllowedSpeed(int32 NewMaxAllowedSpeed);
 
+	/** Recording in progress, if any */
+	TSharedPtr<FHoverDroneFlightRecording> ActiveRecording;
+
 protected:
 	FVector PendingVelocityToAdd = FVector::ZeroVector;
 	FRotator PendingRotVelocityToAdd = FRotator::ZeroRotator;
@@ -19,6 +19,7 @@
 #include "StreamlineDLSSG.h"
 #include "StreamlineLatewarp.h"
 #include "StreamlineDeepDVC.h"
+#include "StreamlineFrameSettings.h"
 
 #include "StreamlineRHI.h"
 #include "sl_helpers.h"
@@ -56,6 +57,23 @@ Streamline::EStreamlineFeatureSupport TranslateStreamlineResult(sl::Result Resul
 	}
 }
  
+// The support queries each go through slIsFeatureSupported and some also query the feature state. Streamline doesn't promise those are safe to
+// call from several threads at once and the queries share the DLSS-G state they fill in, so they run one after another on the game thread.
+// Their results are cached and read every frame without synchronization, so this runs before anything else uses them.
+static void QueryStreamlineFeatureSupport()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Reflex support queries the DLSS-G state, so it comes after DLSS-G
+	QueryStreamlineDLSSGSupport();
+	QueryStreamlineReflexSupport();
+	QueryStreamlineDeepDVCSupport();
+	QueryStreamlineLatewarpSupport();
+	IsStreamlineLatewarpSupported();
+
+	UE_LOG(LogStreamline, Log, TEXT("Querying Streamline feature support took %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
 void FStreamlineCoreModule::StartupModule()
 {
 	auto CVarInitializePlugin = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.InitializePlugin"));
@@ -70,6 +88,10 @@ void FStreamlineCoreModule::StartupModule()
 
 	if (GetPlatformStreamlineSupport() == EStreamlineSupport::Supported)
 	{
+		// the support queries already read the frame settings, before the first view family does the capture
+		CaptureStreamlineFrameSettings();
+		QueryStreamlineFeatureSupport();
+
 		// set the view family extension that's gonna call into SL in the postprocessing pass
 		bool bShouldCreateViewExtension = IsStreamlineDLSSGSupported() || IsStreamlineLatewarpSupported() || IsStreamlineDeepDVCSupported();
 		if (FParse::Param(FCommandLine::Get(), TEXT("slviewextension")))
@@ -91,14 +113,11 @@ void FStreamlineCoreModule::StartupModule()
 		
 		RegisterStreamlineReflexHooks();
 
-		if (ForceTagStreamlineBuffers() || IsStreamlineDLSSGSupported())
+		// DLSS-G and Latewarp share the present hook that tags the backbuffer and UI color, so those only get tagged once
+		if (ForceTagStreamlineBuffers() || IsStreamlineDLSSGSupported() || IsStreamlineLatewarpSupported())
 		{
 			RegisterStreamlineDLSSGHooks(GetStreamlineRHI());
 		}
-		if (ForceTagStreamlineBuffers() || IsStreamlineLatewarpSupported())
-		{
-			RegisterStreamlineLatewarpHooks(GetStreamlineRHI());
-		}
 
 		LogStreamlineFeatureSupport(sl::kFeatureImGUI, *GetStreamlineRHI()->GetAdapterInfo());
 	}
@@ -142,12 +161,7 @@ void FStreamlineCoreModule::ShutdownModule()
 
 	if (GetPlatformStreamlineSupport() == EStreamlineSupport::Supported)
 	{
-		if (IsStreamlineLatewarpSupported())
-		{
-			UnregisterStreamlineLatewarpHooks();
-		}
-
-		if (IsStreamlineDLSSGSupported())
+		if (IsStreamlineDLSSGSupported() || IsStreamlineLatewarpSupported())
 		{
 			UnregisterStreamlineDLSSGHooks();
 		}
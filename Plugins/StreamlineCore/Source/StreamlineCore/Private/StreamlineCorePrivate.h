@@ -21,11 +21,13 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogStreamline, Verbose, All);
 DECLARE_GPU_STAT_NAMED_EXTERN(Streamline, TEXT("Streamline"));
+DECLARE_STATS_GROUP(TEXT("Streamline"), STATGROUP_Streamline, STATCAT_Advanced);
 
 
 bool ShouldTagStreamlineBuffers();
 bool ForceTagStreamlineBuffers();
 bool NeedStreamlineViewIdOverride();
+int32 GetViewIndexToTag();
 
 namespace sl
 {
@@ -74,28 +76,43 @@ inline void DebugLayerCompatibilityRHISetup(const FDebugLayerCompatibilityShader
 		DebugLayerCompatibilityRHISetup(PassParameters, Texture);
 	}
 }
-#endif 
+#endif
 
-BEGIN_SHADER_PARAMETER_STRUCT(FSLSetStateShaderParameters, )
-END_SHADER_PARAMETER_STRUCT()
-
-template<typename StateOnRenderThreadLambda, typename RHIThreadLambda >
-void AddStreamlineStateRenderPass(const TCHAR* FeatureName, FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect, StateOnRenderThreadLambda&& StateOnRenderThread, RHIThreadLambda&& OnRHIThread)
+// Remembers the options last pushed per Streamline viewport so sl{Feature}SetOptions only gets called when something changed.
+// Honors r.Streamline.FilterRedundantSetOptionsCalls, same as the Reflex options
+template<typename OptionsType>
+class TStreamlineViewportOptionsCache
 {
-	FSLSetStateShaderParameters* PassParameters = GraphBuilder.AllocParameters<FSLSetStateShaderParameters>();
-
-	GraphBuilder.AddPass(
-		RDG_EVENT_NAME("Streamline %s State ViewID = % u", FeatureName, ViewID),
-		PassParameters,
-		ERDGPassFlags::Compute | ERDGPassFlags::Raster | ERDGPassFlags::SkipRenderPass | ERDGPassFlags::NeverCull,
-		[PassParameters, ViewID, SecondaryViewRect, &OnRHIThread, &StateOnRenderThread](FRHICommandListImmediate& RHICmdList) mutable
+public:
+	template<typename EquivalentLambda, typename SetOptionsLambda>
+	bool SetOptionsIfChanged(uint32 ViewID, const OptionsType& Options, EquivalentLambda&& AreOptionsEquivalent, SetOptionsLambda&& SetOptions)
+	{
+		const OptionsType* LastOptions = LastPushedOptions.Find(ViewID);
+		if (LastOptions && StreamlineFilterRedundantSetOptionsCalls() && AreOptionsEquivalent(*LastOptions, Options))
 		{
-			auto Options = StateOnRenderThread(ViewID, SecondaryViewRect);
-
-			RHICmdList.EnqueueLambda(
-				[ViewID, SecondaryViewRect, Options, &OnRHIThread](FRHICommandListImmediate& Cmd) mutable
-				{
-					OnRHIThread(Cmd, ViewID, SecondaryViewRect, Options);
-				});
-			});
-}
\ No newline at end of file
+			return false;
+		}
+
+		SetOptions(ViewID, Options);
+		LastPushedOptions.Add(ViewID, Options);
+		return true;
+	}
+
+	void Forget(uint32 ViewID)
+	{
+		LastPushedOptions.Remove(ViewID);
+	}
+
+	void Reset()
+	{
+		LastPushedOptions.Reset();
+	}
+
+	int32 Num() const
+	{
+		return LastPushedOptions.Num();
+	}
+
+private:
+	TMap<uint32, OptionsType> LastPushedOptions;
+};
@@ -17,6 +17,8 @@
 #include "StreamlineAPI.h"
 #include "StreamlineRHI.h"
 #include "StreamlineViewExtension.h"
+#include "StreamlineTagCollector.h"
+#include "StreamlineFrameSettings.h"
 #include "sl_helpers.h"
 #include "sl_dlss_g.h"
 #include "UIHintExtractionPass.h"
@@ -260,20 +262,19 @@ static void DLSSGOnBackBufferReadyToPresent(SWindow& InWindow, const FTextureRHI
 		}
 	}
 
-	const static auto CVarStreamlineViewIndexToTag = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.ViewIndexToTag"));
-	if (CVarStreamlineViewIndexToTag )
+	// same view selection as in the view extension, which only tagged that one view
+	const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+	const int32 ViewIndexToTag = GetViewIndexToTag();
+	if (ViewIndexToTag != -1)
 	{
-		if (const int32 ViewIndexToTag = CVarStreamlineViewIndexToTag->GetInt() != -1)
+		for (int32 ViewIndex = 0; ViewIndex < ViewsInThisBackBuffer.Num(); ++ViewIndex)
 		{
-			for (int32 ViewIndex = 0; ViewIndex < ViewsInThisBackBuffer.Num(); ++ViewIndex)
+			if (ViewIndex == ViewIndexToTag)
 			{
-				if (ViewIndex == ViewIndexToTag)
-				{
-					const FTrackedView ViewToTrack = ViewsInThisBackBuffer[ViewIndex];
-					ViewsInThisBackBuffer.Empty();
-					ViewsInThisBackBuffer.Add(ViewToTrack);
-					break;
-				}
+				const FTrackedView ViewToTrack = ViewsInThisBackBuffer[ViewIndex];
+				ViewsInThisBackBuffer.Empty();
+				ViewsInThisBackBuffer.Add(ViewToTrack);
+				break;
 			}
 		}
 	}
@@ -302,15 +303,14 @@ static void DLSSGOnBackBufferReadyToPresent(SWindow& InWindow, const FTextureRHI
 		return;
 	}
 
-	const bool bTagUIColorAlpha = ForceTagStreamlineBuffers() ||(GIsEditor ? CVarStreamlineEditorTagUIColorAlpha.GetValueOnRenderThread() : CVarStreamlineTagUIColorAlpha.GetValueOnRenderThread());
-	const bool bTagBackbuffer = ForceTagStreamlineBuffers() || (CVarStreamlineTagBackbuffer.GetValueOnRenderThread());
+	const bool bTagUIColorAlpha = ForceTagStreamlineBuffers() || FrameSettings.bTagUIColorAlpha;
+	const bool bTagBackbuffer = ForceTagStreamlineBuffers() || FrameSettings.bTagBackbuffer;
 	
-	// TODO maybe add a helper function to add the RDG pass to tag a resource and use that everywhere
 	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
 	FRDGBuilder GraphBuilder(RHICmdList);
 
-	FSLUIHintTagShaderParameters* PassParameters = GraphBuilder.AllocParameters<FSLUIHintTagShaderParameters>();
 	FStreamlineRHI* RHIExtensions = FStreamlineCoreModule::GetStreamlineRHI();
+	FStreamlineTagCollector TagCollector(RHIExtensions);
 	
 	FIntPoint BackBufferDimension = { int32(InBackBuffer->GetTexture2D()->GetSizeX()), int32(InBackBuffer->GetTexture2D()->GetSizeY()) };
 	
@@ -341,33 +341,43 @@ static void DLSSGOnBackBufferReadyToPresent(SWindow& InWindow, const FTextureRHI
 	}
 #endif
 	
+	FRDGTextureRef BackBuffer = nullptr;
 	if (bTagBackbuffer)
 	{
-		PassParameters->BackBuffer = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(InBackBuffer, TEXT("InBackBuffer")));
+		BackBuffer = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(InBackBuffer, TEXT("InBackBuffer")));
 	}
 		
+	FRDGTextureRef UIHintTexture = nullptr;
 	if (bTagUIColorAlpha)
 	{
-		const float AlphaThreshold = CVarStreamlineTagUIColorAlphaThreshold.GetValueOnRenderThread();
-		FRDGTextureRef UIHintTexture = AddStreamlineUIHintExtractionPass(GraphBuilder, AlphaThreshold, InBackBuffer);
-		PassParameters->UIColorAndAlpha = UIHintTexture;
+		const float AlphaThreshold = FrameSettings.UIColorAlphaThreshold;
+		UIHintTexture = AddStreamlineUIHintExtractionPass(GraphBuilder, AlphaThreshold, InBackBuffer);
 	}
 
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-	if (RHIExtensions->NeedExtraPassesForDebugLayerCompatibility())
+	const bool bHasViewIdOverride = NeedStreamlineViewIdOverride();
+	for (const FTrackedView& View : ViewsInThisBackBuffer)
 	{
-		AddDebugLayerCompatibilitySetupPasses(GraphBuilder, &PassParameters->DebugLayerCompatibility);
+		const uint32 ViewID = bHasViewIdOverride ? 0 : View.ViewKey;
+		TagCollector.AddTag(ViewID, BackBuffer, ERHIAccess::CopySrc, View.UnscaledViewRect, EStreamlineResource::Backbuffer);
+		TagCollector.AddTag(ViewID, UIHintTexture, ERHIAccess::CopySrc, View.UnscaledViewRect, EStreamlineResource::UIColorAndAlpha);
 	}
-#endif
 
-	AddStreamlineUIHintTagPass(GraphBuilder, bTagBackbuffer, bTagUIColorAlpha, BackBufferDimension, PassParameters, 0, RHIExtensions, ViewsInThisBackBuffer, WindowClientAreaRect, NeedStreamlineViewIdOverride());
+	TagCollector.AddPass(GraphBuilder, *FString::Printf(TEXT("Present NumViews=%u WindowClient%dx%d [%d,%d -> %d,%d] Texture=%s"),
+		ViewsInThisBackBuffer.Num(),
+		WindowClientAreaRect.Width(), WindowClientAreaRect.Height(),
+		WindowClientAreaRect.Min.X, WindowClientAreaRect.Min.Y,
+		WindowClientAreaRect.Max.X, WindowClientAreaRect.Max.Y,
+		*BackBufferDimension.ToString()));
+
+	GraphBuilder.Execute();
 }
 
 void RegisterStreamlineDLSSGHooks(FStreamlineRHI* InStreamlineRHI)
 {
 	UE_LOG(LogStreamline, Log, TEXT("%s Enter"), ANSI_TO_TCHAR(__FUNCTION__));
 
-	check(ShouldTagStreamlineBuffers() || IsStreamlineDLSSGSupported());
+	// Latewarp shares this present hook to tag the backbuffer & UI, so the resources are only tagged once per frame
+	check(ShouldTagStreamlineBuffers() || IsStreamlineDLSSGSupported() || IsStreamlineLatewarpSupported());
 
 	{
 		check(FSlateApplication::IsInitialized());
@@ -634,9 +644,9 @@ STREAMLINECORE_API void GetStreamlineDLSSGFrameTiming(float& FrameRateInHertz, i
 	FramesPresented = GLastDLSSGFramesPresented;
 }
 
-void AddStreamlineDLSSGStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect)
+void AddStreamlineDLSSGState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect)
 {
-	AddStreamlineStateRenderPass (TEXT("DLSS-G"), GraphBuilder, ViewID, SecondaryViewRect,
+	TagCollector.AddState(TEXT("DLSS-G"), ViewID, SecondaryViewRect,
 		// this lambda computes the SL options struct based on cvars and other state
 		[] (uint32 ViewID, const FIntRect & SecondaryViewRect) ->sl::DLSSGOptions
 		{
@@ -656,17 +666,18 @@ void AddStreamlineDLSSGStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID,
 
 			SLConstants.mode = (bIsForeground && bIsLargeEnough) ? SLDLSSGModeFromCvar() : sl::DLSSGMode::eOff;
 
-			if (CVarStreamlineFullScreenMenuDetection.GetValueOnRenderThread() != 0)
+			const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+			if (FrameSettings.bDLSSGFullScreenMenuDetection)
 			{
 				EnumAddFlags(SLConstants.flags, sl::DLSSGFlags::eEnableFullscreenMenuDetection);
 			}
 
-			if (CVarStreamlineDLSSGDynamicResolutionMode.GetValueOnRenderThread() != 0)
+			if (FrameSettings.bDLSSGDynamicResolutionMode)
 			{
 				EnumAddFlags(SLConstants.flags, sl::DLSSGFlags::eDynamicResolutionEnabled);
 			}
 
-			if (CVarStreamlineDLSSGRetainResourcesWhenOff.GetValueOnRenderThread() != 0)
+			if (FrameSettings.bDLSSGRetainResourcesWhenOff)
 			{
 				EnumAddFlags(SLConstants.flags, sl::DLSSGFlags::eRetainResourcesWhenOff);
 			}
@@ -683,6 +694,16 @@ void AddStreamlineDLSSGStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID,
 		);
 }
 
+void ReadStreamlineDLSSGFrameSettings(FStreamlineFrameSettings& Settings)
+{
+	Settings.bTagUIColorAlpha = GIsEditor ? CVarStreamlineEditorTagUIColorAlpha.GetValueOnGameThread() : CVarStreamlineTagUIColorAlpha.GetValueOnGameThread();
+	Settings.bTagBackbuffer = CVarStreamlineTagBackbuffer.GetValueOnGameThread();
+	Settings.UIColorAlphaThreshold = CVarStreamlineTagUIColorAlphaThreshold.GetValueOnGameThread();
+	Settings.bDLSSGFullScreenMenuDetection = CVarStreamlineFullScreenMenuDetection.GetValueOnGameThread();
+	Settings.bDLSSGDynamicResolutionMode = CVarStreamlineDLSSGDynamicResolutionMode.GetValueOnGameThread() != 0;
+	Settings.bDLSSGRetainResourcesWhenOff = CVarStreamlineDLSSGRetainResourcesWhenOff.GetValueOnGameThread();
+}
+
 void BeginRenderViewFamilyDLSSG(FSceneViewFamily& InViewFamily)
 {
 	if(IsDLSSGActive() && CVarStreamlineDLSSGAdjustMotionBlurTimeScale.GetValueOnAnyThread() && InViewFamily.Views.Num())
@@ -9,8 +9,11 @@
 * its affiliates is strictly prohibited.
 */
 #include "StreamlineDeepDVC.h"
+#include "StreamlineDeepDVCPrivate.h"
 #include "StreamlineCore.h"
 #include "StreamlineCorePrivate.h"
+#include "StreamlineTagCollector.h"
+#include "StreamlineFrameSettings.h"
 #include "StreamlineAPI.h"
 #include "StreamlineRHI.h"
 #include "sl_helpers.h"
@@ -56,6 +59,13 @@ static Streamline::EStreamlineFeatureSupport GStreamlineDeepDVCSupport = Streaml
 namespace
 {
 	float GLastDeepDVCVRAMEstimate = 0;
+
+	// the game thread copy is only there for the getters, the render thread copy is what gets used
+	TMap<int32, FStreamlineDeepDVCViewParameters> GDeepDVCViewParameters;
+	TMap<int32, FStreamlineDeepDVCViewParameters> GDeepDVCViewParameters_RenderThread;
+
+	TStreamlineViewportOptionsCache<sl::DeepDVCOptions> GDeepDVCOptionsCache;
+	FStreamlineDeepDVCSetOptionsFunction GDeepDVCSetOptionsFunction;
 }
 
 STREAMLINECORE_API Streamline::EStreamlineFeatureSupport QueryStreamlineDeepDVCSupport()
@@ -114,7 +124,7 @@ bool IsStreamlineDeepDVCSupported()
 
 static sl::DeepDVCMode SLDeepDVCModeFromCvar()
 {
-	int32 DeepDVCMode = CVarStreamlineDeepDVCEnable.GetValueOnAnyThread();
+	int32 DeepDVCMode = GetStreamlineFrameSettings().DeepDVCMode;
 	switch (DeepDVCMode)
 	{
 	case 0:
@@ -141,8 +151,147 @@ bool IsDeepDVCActive()
 
 
 
+STREAMLINECORE_API void SetStreamlineDeepDVCViewParameters(int32 ViewIndex, const FStreamlineDeepDVCViewParameters& Parameters)
+{
+	check(IsInGameThread());
+	check(ViewIndex >= 0);
+
+	FStreamlineDeepDVCViewParameters ClampedParameters;
+	ClampedParameters.Intensity = FMath::Clamp(Parameters.Intensity, 0.0f, 1.0f);
+	ClampedParameters.SaturationBoost = FMath::Clamp(Parameters.SaturationBoost, 0.0f, 1.0f);
+
+	const FStreamlineDeepDVCViewParameters* ExistingParameters = GDeepDVCViewParameters.Find(ViewIndex);
+	if (ExistingParameters && ExistingParameters->Intensity == ClampedParameters.Intensity && ExistingParameters->SaturationBoost == ClampedParameters.SaturationBoost)
+	{
+		return;
+	}
+
+	GDeepDVCViewParameters.Add(ViewIndex, ClampedParameters);
+
+	ENQUEUE_RENDER_COMMAND(SetStreamlineDeepDVCViewParameters)(
+		[ViewIndex, ClampedParameters](FRHICommandListImmediate& RHICmdList)
+		{
+			GDeepDVCViewParameters_RenderThread.Add(ViewIndex, ClampedParameters);
+		});
+}
+
+STREAMLINECORE_API void ClearStreamlineDeepDVCViewParameters(int32 ViewIndex)
+{
+	check(IsInGameThread());
+
+	if (ViewIndex == INDEX_NONE)
+	{
+		GDeepDVCViewParameters.Reset();
+	}
+	else if (!GDeepDVCViewParameters.Remove(ViewIndex))
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(ClearStreamlineDeepDVCViewParameters)(
+		[ViewIndex](FRHICommandListImmediate& RHICmdList)
+		{
+			if (ViewIndex == INDEX_NONE)
+			{
+				GDeepDVCViewParameters_RenderThread.Reset();
+			}
+			else
+			{
+				GDeepDVCViewParameters_RenderThread.Remove(ViewIndex);
+			}
+		});
+}
+
+STREAMLINECORE_API bool GetStreamlineDeepDVCViewParameters(int32 ViewIndex, FStreamlineDeepDVCViewParameters& OutParameters)
+{
+	check(IsInGameThread());
+
+	if (const FStreamlineDeepDVCViewParameters* Parameters = GDeepDVCViewParameters.Find(ViewIndex))
+	{
+		OutParameters = *Parameters;
+		return true;
+	}
+
+	const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+	OutParameters.Intensity = FrameSettings.DeepDVCIntensity;
+	OutParameters.SaturationBoost = FrameSettings.DeepDVCSaturationBoost;
+	return false;
+}
+
+FStreamlineDeepDVCViewParameters GetStreamlineDeepDVCViewParameters_RenderThread(int32 ViewIndex)
+{
+	check(IsInRenderingThread());
+
+	if (const FStreamlineDeepDVCViewParameters* Parameters = GDeepDVCViewParameters_RenderThread.Find(ViewIndex))
+	{
+		return *Parameters;
+	}
+
+	const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+	FStreamlineDeepDVCViewParameters Parameters;
+	Parameters.Intensity = FrameSettings.DeepDVCIntensity;
+	Parameters.SaturationBoost = FrameSettings.DeepDVCSaturationBoost;
+	return Parameters;
+}
+
+void ReadStreamlineDeepDVCFrameSettings(FStreamlineFrameSettings& Settings)
+{
+	Settings.DeepDVCMode = CVarStreamlineDeepDVCEnable.GetValueOnGameThread();
+	Settings.DeepDVCIntensity = CVarStreamlineDeepDVCIntensity.GetValueOnGameThread();
+	Settings.DeepDVCSaturationBoost = CVarStreamlineDeepDVCSaturationBoost.GetValueOnGameThread();
+}
+
+sl::DeepDVCOptions MakeStreamlineDeepDVCOptions(const FStreamlineDeepDVCViewParameters& Parameters)
+{
+	sl::DeepDVCOptions SLConstants;
+
+	// a view with 0 intensity doesn't get evaluated, so tell SL to turn it off too
+	SLConstants.mode = ShouldEvaluateStreamlineDeepDVC(Parameters) ? SLDeepDVCModeFromCvar() : sl::DeepDVCMode::eOff;
+	SLConstants.intensity = Parameters.Intensity;
+	SLConstants.saturationBoost = Parameters.SaturationBoost;
+
+	return SLConstants;
+}
+
+bool AreDeepDVCOptionsEquivalent(const sl::DeepDVCOptions& LHS, const sl::DeepDVCOptions& RHS)
+{
+	return LHS.mode == RHS.mode
+		&& LHS.intensity == RHS.intensity
+		&& LHS.saturationBoost == RHS.saturationBoost;
+}
+
 DECLARE_STATS_GROUP(TEXT("DeepDVC"), STATGROUP_DeepDVC, STATCAT_Advanced);
 DECLARE_FLOAT_COUNTER_STAT(TEXT("DeepDVC: VRAM Estimate (MiB)"), STAT_DeepDVCVRAMEstimate, STATGROUP_DeepDVC);
+DECLARE_DWORD_COUNTER_STAT(TEXT("DeepDVC: SetOptions calls"), STAT_DeepDVCSetOptionsCalls, STATGROUP_DeepDVC);
+
+bool SetStreamlineDeepDVCOptionsIfChanged(uint32 ViewID, const sl::DeepDVCOptions& Options)
+{
+	return GDeepDVCOptionsCache.SetOptionsIfChanged(ViewID, Options, &AreDeepDVCOptionsEquivalent,
+		[](uint32 ViewID, const sl::DeepDVCOptions& Options)
+		{
+			INC_DWORD_STAT(STAT_DeepDVCSetOptionsCalls);
+
+			if (GDeepDVCSetOptionsFunction)
+			{
+				GDeepDVCSetOptionsFunction(ViewID, Options);
+			}
+			else
+			{
+				CALL_SL_FEATURE_FN(sl::kFeatureDeepDVC, slDeepDVCSetOptions, sl::ViewportHandle(ViewID), Options);
+			}
+		});
+}
+
+void ForgetStreamlineDeepDVCOptions(uint32 ViewID)
+{
+	GDeepDVCOptionsCache.Forget(ViewID);
+}
+
+void SetStreamlineDeepDVCSetOptionsFunction(FStreamlineDeepDVCSetOptionsFunction InSetOptions)
+{
+	GDeepDVCSetOptionsFunction = MoveTemp(InSetOptions);
+	GDeepDVCOptionsCache.Reset();
+}
 
 void GetDeepDVCStatusFromStreamline()
 {
@@ -150,11 +299,7 @@ void GetDeepDVCStatusFromStreamline()
 
 	if (IsStreamlineDeepDVCSupported())
 	{
-		// INSERT AWKWARD MUPPET FACE HERE
-
-    	//	static const auto CVarStreamlineViewIdOverride = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.ViewIdOverride"));
-		//checkf(CVarStreamlineViewIdOverride && CVarStreamlineViewIdOverride->GetInt() != 0, TEXT("r.Streamline.ViewIdOverride must be set to 1 since DeepDVC only supports a single viewport."));
-
+		// the VRAM estimate is per viewport, the first one is representative enough for the min width/height and stats
 		sl::ViewportHandle Viewport(0);
 
 		sl::DeepDVCState State;
@@ -183,28 +328,22 @@ SHADER_PARAMETER_STRUCT_INCLUDE(FDebugLayerCompatibilityShaderParameters, DebugL
 END_SHADER_PARAMETER_STRUCT()
 }
 
-void AddStreamlineDeepDVCStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect)
+void AddStreamlineDeepDVCState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect, const FStreamlineDeepDVCViewParameters& Parameters)
 {
-	AddStreamlineStateRenderPass(TEXT("DeepDVC"), GraphBuilder, ViewID, SecondaryViewRect,
-		// this lambda computes the SL options struct based on cvars and other state
-		[](uint32 ViewID, const FIntRect& SecondaryViewRect) ->sl::DeepDVCOptions
+	TagCollector.AddState(TEXT("DeepDVC"), ViewID, SecondaryViewRect,
+		// this lambda computes the SL options struct based on cvars and the per view parameters
+		[Parameters](uint32 ViewID, const FIntRect& SecondaryViewRect) ->sl::DeepDVCOptions
 		{
 			// the callsite is expcted to not call this, so we don't need to if bail out here
 			check(IsStreamlineDeepDVCSupported());
 			check(IsInRenderingThread());
 
-			sl::DeepDVCOptions SLConstants;
-
-			SLConstants.mode = SLDeepDVCModeFromCvar();
-			SLConstants.intensity = CVarStreamlineDeepDVCIntensity.GetValueOnRenderThread();
-			SLConstants.saturationBoost = CVarStreamlineDeepDVCSaturationBoost.GetValueOnRenderThread();
-
-			return SLConstants;
+			return MakeStreamlineDeepDVCOptions(Parameters);
 		},
-		// this lambda is only here since templating the function pointer and functin name and such below is inconvenient
+		// the options are the same most frames, so only push them to SL when they changed for this viewport
 		[](FRHICommandListImmediate& RHICmdList, uint32 ViewID, const FIntRect& SecondaryViewRect, const sl::DeepDVCOptions& Options)
 		{
-			CALL_SL_FEATURE_FN(sl::kFeatureDeepDVC, slDeepDVCSetOptions, sl::ViewportHandle(ViewID), Options);
+			SetStreamlineDeepDVCOptionsIfChanged(ViewID, Options);
 		}
 	);
 
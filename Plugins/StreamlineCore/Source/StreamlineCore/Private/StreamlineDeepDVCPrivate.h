@@ -0,0 +1,26 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StreamlineDeepDVC.h"
+#include "sl_deepdvc.h"
+
+sl::DeepDVCOptions MakeStreamlineDeepDVCOptions(const FStreamlineDeepDVCViewParameters& Parameters);
+bool AreDeepDVCOptionsEquivalent(const sl::DeepDVCOptions& LHS, const sl::DeepDVCOptions& RHS);
+
+// the options only get pushed to SL when they differ from what was last pushed for that viewport. RHI thread
+bool SetStreamlineDeepDVCOptionsIfChanged(uint32 ViewID, const sl::DeepDVCOptions& Options);
+void ForgetStreamlineDeepDVCOptions(uint32 ViewID);
+
+// defaults to slDeepDVCSetOptions, replaceable so the change detection can be tested without a Streamline runtime
+using FStreamlineDeepDVCSetOptionsFunction = TFunction<void(uint32 ViewID, const sl::DeepDVCOptions& Options)>;
+void SetStreamlineDeepDVCSetOptionsFunction(FStreamlineDeepDVCSetOptionsFunction InSetOptions);
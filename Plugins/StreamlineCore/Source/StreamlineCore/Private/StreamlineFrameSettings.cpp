@@ -0,0 +1,118 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+
+#include "StreamlineFrameSettings.h"
+#include "StreamlineCorePrivate.h"
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+
+DECLARE_CYCLE_STAT(TEXT("Capture frame settings"), STAT_StreamlineCaptureFrameSettings, STATGROUP_Streamline);
+
+// one copy per pipe, each only written on its own thread. New values travel down the pipes with the frame that captured them
+static FStreamlineFrameSettings GStreamlineFrameSettings;
+static FStreamlineFrameSettings GStreamlineFrameSettings_RenderThread;
+static FStreamlineFrameSettings GStreamlineFrameSettings_RHIThread;
+
+// set by the console variable sink, which the engine calls on the game thread once per frame after any cvar changed
+static bool bStreamlineFrameSettingsDirty = true;
+
+static void OnStreamlineConsoleVariablesChanged()
+{
+	bStreamlineFrameSettingsDirty = true;
+}
+
+static FAutoConsoleVariableSink CVarStreamlineFrameSettingsSink(FConsoleCommandDelegate::CreateStatic(&OnStreamlineConsoleVariablesChanged));
+
+bool FStreamlineFrameSettings::HasSameValues(const FStreamlineFrameSettings& Other) const
+{
+	return ViewIndexToTag == Other.ViewIndexToTag
+		&& ViewIdOverride == Other.ViewIdOverride
+		&& bTagSceneColorWithoutHUD == Other.bTagSceneColorWithoutHUD
+		&& bTagCustomDepth == Other.bTagCustomDepth
+		&& bTagVelocities == Other.bTagVelocities
+		&& bDilateMotionVectors == Other.bDilateMotionVectors
+		&& bClearSceneColorAlpha == Other.bClearSceneColorAlpha
+		&& MotionVectorScale == Other.MotionVectorScale
+		&& CustomCameraNearPlane == Other.CustomCameraNearPlane
+		&& CustomCameraFarPlane == Other.CustomCameraFarPlane
+		&& bTagUIColorAlpha == Other.bTagUIColorAlpha
+		&& bTagBackbuffer == Other.bTagBackbuffer
+		&& UIColorAlphaThreshold == Other.UIColorAlphaThreshold
+		&& bDLSSGFullScreenMenuDetection == Other.bDLSSGFullScreenMenuDetection
+		&& bDLSSGDynamicResolutionMode == Other.bDLSSGDynamicResolutionMode
+		&& bDLSSGRetainResourcesWhenOff == Other.bDLSSGRetainResourcesWhenOff
+		&& DeepDVCMode == Other.DeepDVCMode
+		&& DeepDVCIntensity == Other.DeepDVCIntensity
+		&& DeepDVCSaturationBoost == Other.DeepDVCSaturationBoost;
+}
+
+bool CaptureStreamlineFrameSettings()
+{
+	check(IsInGameThread());
+
+	if (!bStreamlineFrameSettingsDirty)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_StreamlineCaptureFrameSettings);
+	bStreamlineFrameSettingsDirty = false;
+
+	FStreamlineFrameSettings NewSettings;
+	ReadStreamlineViewExtensionFrameSettings(NewSettings);
+	ReadStreamlineDLSSGFrameSettings(NewSettings);
+	ReadStreamlineDeepDVCFrameSettings(NewSettings);
+
+	// the sink fires for any cvar, so most of the time nothing we care about changed
+	if (NewSettings.HasSameValues(GStreamlineFrameSettings))
+	{
+		return false;
+	}
+
+	GStreamlineFrameSettings = NewSettings;
+
+	// the render thread picks the new values up with the frame that captured them, the RHI thread once it gets to that frame's commands
+	ENQUEUE_RENDER_COMMAND(UpdateStreamlineFrameSettings)(
+		[NewSettings](FRHICommandListImmediate& RHICmdList)
+		{
+			GStreamlineFrameSettings_RenderThread = NewSettings;
+			RHICmdList.EnqueueLambda([NewSettings](FRHICommandListImmediate&)
+			{
+				GStreamlineFrameSettings_RHIThread = NewSettings;
+			});
+		});
+
+	return true;
+}
+
+void InvalidateStreamlineFrameSettings()
+{
+	bStreamlineFrameSettingsDirty = true;
+}
+
+const FStreamlineFrameSettings& GetStreamlineFrameSettings()
+{
+	if (IsInGameThread())
+	{
+		return GStreamlineFrameSettings;
+	}
+	else if (IsInRHIThread())
+	{
+		return GStreamlineFrameSettings_RHIThread;
+	}
+
+	// the render thread and its tasks. Without a separate RHI thread the RHI commands run here too, with the RHI copy being written right away
+	check(IsInParallelRenderingThread());
+	return GStreamlineFrameSettings_RenderThread;
+}
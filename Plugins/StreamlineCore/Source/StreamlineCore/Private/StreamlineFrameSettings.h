@@ -0,0 +1,63 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+	Snapshot of the r.Streamline.* cvars that the per view and present paths read.
+	It gets captured once per frame on the game thread (BeginRenderViewFamily) and is handed down to the render and RHI threads
+	with that frame's commands, so all views of a frame see the same values and no thread reads a copy another thread writes.
+	The cvars are only read again after a console variable sink reported a change.
+*/
+struct FStreamlineFrameSettings
+{
+	// view extension
+	int32 ViewIndexToTag = -1;
+	int32 ViewIdOverride = -1;
+	bool bTagSceneColorWithoutHUD = true;
+	bool bTagCustomDepth = false;
+	bool bTagVelocities = true;
+	bool bDilateMotionVectors = false;
+	bool bClearSceneColorAlpha = true;
+	float MotionVectorScale = 1.0f;
+	float CustomCameraNearPlane = 0.01f;
+	float CustomCameraFarPlane = 75000.0f;
+
+	// DLSS-G & present
+	bool bTagUIColorAlpha = true;
+	bool bTagBackbuffer = true;
+	float UIColorAlphaThreshold = 0.0f;
+	bool bDLSSGFullScreenMenuDetection = false;
+	bool bDLSSGDynamicResolutionMode = false;
+	bool bDLSSGRetainResourcesWhenOff = false;
+
+	// DeepDVC
+	int32 DeepDVCMode = 0;
+	float DeepDVCIntensity = 0.5f;
+	float DeepDVCSaturationBoost = 0.5f;
+
+	bool HasSameValues(const FStreamlineFrameSettings& Other) const;
+};
+
+// game thread, cheap unless a cvar changed since the last capture. Returns whether any captured value changed
+bool CaptureStreamlineFrameSettings();
+
+// forces the next capture to read the cvars again
+void InvalidateStreamlineFrameSettings();
+
+// the copy of the calling thread: game, render (and its tasks) or RHI thread. Doesn't capture, the game thread copy is the last captured one
+const FStreamlineFrameSettings& GetStreamlineFrameSettings();
+
+// those live next to the cvars they read
+void ReadStreamlineViewExtensionFrameSettings(FStreamlineFrameSettings& Settings);
+void ReadStreamlineDLSSGFrameSettings(FStreamlineFrameSettings& Settings);
+void ReadStreamlineDeepDVCFrameSettings(FStreamlineFrameSettings& Settings);
@@ -10,12 +10,15 @@
 */
 
 #include "StreamlineLatewarp.h"
+#include "StreamlineLatewarpPrivate.h"
 #include "StreamlineCore.h"
 #include "StreamlineCorePrivate.h"
 #include "StreamlineShaders.h"
 #include "StreamlineViewExtension.h"
+#include "StreamlineTagCollector.h"
 #include "StreamlineAPI.h"
 #include "StreamlineRHI.h"
+#include "StreamlineReflex.h"
 
 #include "UIHintExtractionPass.h"
 #include "CoreMinimal.h"
@@ -26,146 +29,66 @@
 #include "PostProcess/PostProcessMaterial.h"
 
 
+#include <atomic>
+
 #include "sl_helpers.h"
 #if WITH_LATEWARP
 #include "sl_latewarp.h"
 #endif
 
-static int32 NumLatewarpInstances = 0;
-static FDelegateHandle LatewarpOnBackBufferReadyToPresentHandle;
-
 static TAutoConsoleVariable<int32> CVarLatewarpEnable(
 	TEXT("r.Streamline.Latewarp.Enable"), 0,
-	TEXT("Enable/disable Latewarp (default = 1)\n"),
+	TEXT("Latewarp mode (default = 0)\n")
+	TEXT("0: off\n")
+	TEXT("1: always on\n")
+	TEXT("2: auto mode (on only when the render latency is above r.Streamline.Latewarp.Auto.RenderLatencyThresholdMs)\n"),
 	ECVF_Default);
 
-DEFINE_LOG_CATEGORY_STATIC(LogStreamlineLatewarp, Log, All);
-
-DECLARE_GPU_STAT(Latewarp);
+static TAutoConsoleVariable<float> CVarLatewarpAutoRenderLatencyThreshold(
+	TEXT("r.Streamline.Latewarp.Auto.RenderLatencyThresholdMs"), 33.3f,
+	TEXT("Render latency in ms above which the Latewarp auto mode turns Latewarp on (default = 33.3)\n")
+	TEXT("The render latency is measured with PC Latency markers, see t.Streamline.Reflex.EnableLatencyMarkers\n"),
+	ECVF_Default);
 
+static TAutoConsoleVariable<float> CVarLatewarpAutoHysteresis(
+	TEXT("r.Streamline.Latewarp.Auto.HysteresisMs"), 3.0f,
+	TEXT("Once on, the Latewarp auto mode only turns Latewarp off again when the render latency drops this many ms below the threshold (default = 3.0)\n"),
+	ECVF_Default);
 
-static FIntRect LatewarpGetViewportRect(SWindow& InWindow)
-{
-	// During app shutdown, the window might not have a viewport anymore, so using SWindow::GetViewportSize() that handles that transparently.
-	FIntRect ViewportRect = FIntRect(FIntPoint::ZeroValue,InWindow.GetViewportSize().IntPoint());
-	
-	if (TSharedPtr<ISlateViewport> Viewport = InWindow.GetViewport())
-	{
-		if (TSharedPtr<SWidget> Widget = Viewport->GetWidget().Pin())
-		{
-			FGeometry Geom = Widget->GetPaintSpaceGeometry();
+static TAutoConsoleVariable<bool> CVarLatewarpOnlyInForeground(
+	TEXT("r.Streamline.Latewarp.OnlyInForeground"), false,
+	TEXT("Turn Latewarp off when the application is not in the foreground (default = false)\n"),
+	ECVF_RenderThreadSafe);
 
-			FIntPoint Min = { int32(Geom.GetAbsolutePosition().X),int32(Geom.GetAbsolutePosition().Y) };
-			FIntPoint Max = { int32((Geom.GetAbsolutePosition() + Geom.GetAbsoluteSize()).X),
-								int32((Geom.GetAbsolutePosition() + Geom.GetAbsoluteSize()).Y) };
+static TAutoConsoleVariable<int32> CVarLatewarpMinWidthOrHeight(
+	TEXT("r.Streamline.Latewarp.MinWidthOrHeight"), 0,
+	TEXT("Turn Latewarp off for views smaller than this in either dimension, e.g. small split screen or picture in picture views (default = 0)\n"),
+	ECVF_RenderThreadSafe);
 
-			ViewportRect = FIntRect(Min.X, Min.Y, Max.X, Max.Y);
-		}
-	}
+DEFINE_LOG_CATEGORY_STATIC(LogStreamlineLatewarp, Log, All);
 
-	return ViewportRect;
-}
-#if	((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 1))
-static void LatewarpOnBackBufferReadyToPresent(SWindow& InWindow, const FTextureRHIRef& InBackBuffer)
-#else
-static void LatewarpOnBackBufferReadyToPresent(SWindow& InWindow, const FTexture2DRHIRef& InBackBuffer)
-#endif
-{
-	check(IsInRenderingThread());
+DECLARE_GPU_STAT(Latewarp);
 
-	const bool bIsGameWindow = InWindow.GetType() == EWindowType::GameWindow;
-#if WITH_EDITOR
-	const bool bIsPIEWindow = GIsEditor && (InWindow.GetTitle().ToString().Contains(TEXT("Preview [NetMode:")));
-#else
-	const bool bIsPIEWindow = false;
-#endif
-	if (!(bIsGameWindow || bIsPIEWindow))
-	{
-		return;
-	}
+DECLARE_STATS_GROUP(TEXT("Latewarp"), STATGROUP_Latewarp, STATCAT_Advanced);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Latewarp: Auto mode render latency (ms)"), STAT_LatewarpAutoRenderLatency, STATGROUP_Latewarp);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Latewarp: Auto mode active"), STAT_LatewarpAutoActive, STATGROUP_Latewarp);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Latewarp: Auto mode transitions"), STAT_LatewarpAutoTransitions, STATGROUP_Latewarp);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Latewarp: SetOptions calls"), STAT_LatewarpSetOptionsCalls, STATGROUP_Latewarp);
 
-	// TODO maybe add a helper function to add the RDG pass to tag a resource and use that everywhere
-	FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
-	FRDGBuilder GraphBuilder(RHICmdList);
+namespace
+{
+	FStreamlineLatewarpAutoGate GLatewarpAutoGate;
+	FStreamlineLatewarpLatencySource GLatewarpLatencySource;
 
-	FSLUIHintTagShaderParameters* PassParameters = GraphBuilder.AllocParameters<FSLUIHintTagShaderParameters>();
-	
-	const float AlphaThreshold= 0.0f;
-	FRDGTextureRef UIHintTexture = AddStreamlineUIHintExtractionPass(GraphBuilder, AlphaThreshold, InBackBuffer);
-	PassParameters->UIColorAndAlpha = UIHintTexture;
-	PassParameters->BackBuffer = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(InBackBuffer, TEXT("InBackBuffer")));
-#if	((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 1))
-	FIntPoint BackBufferDimension = { int32(InBackBuffer->GetDesc().Extent.X), int32(InBackBuffer->GetDesc().Extent.Y) };
-#else
-	FIntPoint BackBufferDimension = { int32(InBackBuffer->GetTexture2D()->GetSizeX()), int32(InBackBuffer->GetTexture2D()->GetSizeY()) };
-#endif
-	
-	FStreamlineRHI* RHIExtensions = FStreamlineCoreModule::GetStreamlineRHI();
-	TArray<FTrackedView>& TrackedViews = FStreamlineViewExtension::GetTrackedViews();
-	TArray<FTrackedView> ViewsInThisBackBuffer;
-	int32 ViewRectIndex = 0;
-#if	((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 1))
-	FRHITextureReference* RealOrBufferedBackBuffer = InBackBuffer->GetTextureReference();
-#else
-	FRHITexture2D* RealOrBufferedBackBuffer = InBackBuffer->GetTexture2D();
-#endif
-	while (ViewRectIndex < TrackedViews.Num())
-	{
+	// written on the game thread, read on the render thread
+	std::atomic<bool> GLatewarpAutoModeActive{ false };
 
-#if	((ENGINE_MAJOR_VERSION == 5) && (ENGINE_MINOR_VERSION >= 1))
-		if (TrackedViews[ViewRectIndex].Texture->GetTextureReference() == RealOrBufferedBackBuffer)
-#else
-		if (TrackedViews[ViewRectIndex].Texture->GetTexture2D() == RealOrBufferedBackBuffer)
+#if WITH_LATEWARP
+	TStreamlineViewportOptionsCache<sl::LatewarpOptions> GLatewarpOptionsCache;
 #endif
-		{
-			ViewsInThisBackBuffer.Add(TrackedViews[ViewRectIndex]);
-			TrackedViews.RemoveAtSwap(ViewRectIndex);
-		}
-		else
-		{
-			++ViewRectIndex;
-		}
-	}
-	const FIntRect WindowClientAreaRect = LatewarpGetViewportRect(InWindow);
-	AddStreamlineUIHintTagPass(GraphBuilder, true, true, BackBufferDimension, PassParameters, 0, RHIExtensions, ViewsInThisBackBuffer, WindowClientAreaRect, true);
 }
 
-void RegisterStreamlineLatewarpHooks(FStreamlineRHI* InStreamlineRHI)
-{
-#if WITH_LATEWARP
-	UE_LOG(LogStreamline, Log, TEXT("%s Enter"), ANSI_TO_TCHAR(__FUNCTION__));
-
-	check(ShouldTagStreamlineBuffers() || IsStreamlineLatewarpSupported());
-
-	{
-		check(FSlateApplication::IsInitialized());
-		FSlateRenderer* SlateRenderer = FSlateApplication::Get().GetRenderer();
-
-		LatewarpOnBackBufferReadyToPresentHandle = SlateRenderer->OnBackBufferReadyToPresent().AddStatic(&LatewarpOnBackBufferReadyToPresent);
-
-		// ShutdownModule is too late for this
-		FSlateApplication::Get().OnPreShutdown().AddLambda(
-		[]()
-		{
-			UE_LOG(LogStreamline, Log, TEXT("Unregistering of OnBackBufferReadyToPresent callback during FSlateApplication::OnPreShutdown"));
-			FSlateRenderer* SlateRenderer = FSlateApplication::Get().GetRenderer();
-			check(SlateRenderer);
-
-			SlateRenderer->OnBackBufferReadyToPresent().Remove(LatewarpOnBackBufferReadyToPresentHandle);
-		}
-		);
 
-		
-	}
-	UE_LOG(LogStreamline, Log, TEXT("%s Leave"), ANSI_TO_TCHAR(__FUNCTION__));
-#else
-	return;
-#endif
-}
-void UnregisterStreamlineLatewarpHooks()
-{
-	// see  FSlateApplication::OnPreShutdown lambda in RegisterStreamlineDLSSGHooks
-}
 static bool IsStreamlineLatewarpSupportedInternal()
 {
 	static bool bStreamlineLatewarpSupportedInitialized = false;
@@ -268,19 +191,118 @@ bool IsLatewarpActive()
 	{
 		return false;
 	}
-	else
+
+	switch (CVarLatewarpEnable.GetValueOnAnyThread())
 	{
-		return CVarLatewarpEnable.GetValueOnAnyThread() != 0;
+	case 0:
+		return false;
+	case 1:
+		return true;
+	case 2:
+		return GLatewarpAutoModeActive.load(std::memory_order_relaxed);
+	default:
+		return false;
 	}
 #else
 	return false;
 #endif
 }
 
-void AddStreamlineLatewarpStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect)
+bool IsLatewarpAutoModeEnabled()
 {
 #if WITH_LATEWARP
-	AddStreamlineStateRenderPass(TEXT("Latewarp"), GraphBuilder, ViewID, SecondaryViewRect,
+	return IsStreamlineLatewarpSupportedInternal() && CVarLatewarpEnable.GetValueOnAnyThread() == 2;
+#else
+	return false;
+#endif
+}
+
+void SetStreamlineLatewarpLatencySource(FStreamlineLatewarpLatencySource InLatencySource)
+{
+	GLatewarpLatencySource = MoveTemp(InLatencySource);
+	GLatewarpAutoGate.Reset();
+}
+
+static float GetLatewarpRenderLatencyMs()
+{
+	if (GLatewarpLatencySource)
+	{
+		return GLatewarpLatencySource();
+	}
+
+	if (!IsStreamlineReflexSupported())
+	{
+		return 0.0f;
+	}
+
+	// this is "OS render queue start to GPU render end", so it includes the frames queued up in front of the GPU
+	FStreamlineLatencyMarkers* LatencyMarkers = GetStreamlineReflexLatencyMarkerModule();
+	return (LatencyMarkers && LatencyMarkers->GetAvailable()) ? LatencyMarkers->GetRenderLatencyInMs() : 0.0f;
+}
+
+bool UpdateStreamlineLatewarpAutoMode()
+{
+	check(IsInGameThread());
+
+	const float RenderLatencyMs = GetLatewarpRenderLatencyMs();
+	const float ThresholdMs = CVarLatewarpAutoRenderLatencyThreshold.GetValueOnGameThread();
+	const bool bWasActive = GLatewarpAutoGate.IsActive();
+	const bool bActive = GLatewarpAutoGate.Update(RenderLatencyMs, ThresholdMs, CVarLatewarpAutoHysteresis.GetValueOnGameThread());
+
+	UE_CLOG(bActive != bWasActive, LogStreamlineLatewarp, Log, TEXT("Latewarp auto mode turned %s at %.2f ms render latency (threshold %.2f ms)"),
+		bActive ? TEXT("on") : TEXT("off"), RenderLatencyMs, ThresholdMs);
+
+	SET_FLOAT_STAT(STAT_LatewarpAutoRenderLatency, RenderLatencyMs);
+	SET_DWORD_STAT(STAT_LatewarpAutoActive, bActive ? 1 : 0);
+	SET_DWORD_STAT(STAT_LatewarpAutoTransitions, GLatewarpAutoGate.GetNumTransitions());
+
+	GLatewarpAutoModeActive.store(bActive, std::memory_order_relaxed);
+	return bActive;
+}
+
+void ResetStreamlineLatewarpAutoMode()
+{
+	check(IsInGameThread());
+
+	GLatewarpAutoGate.Reset();
+	GLatewarpAutoModeActive.store(false, std::memory_order_relaxed);
+}
+
+void BeginRenderViewFamilyLatewarp(FSceneViewFamily& InViewFamily)
+{
+	if (!IsLatewarpAutoModeEnabled())
+	{
+		ResetStreamlineLatewarpAutoMode();
+		return;
+	}
+
+	// multiple view families can render in one frame, but the latency only needs to be sampled once
+	static uint64 LastUpdatedFrameCounter = 0;
+	if (LastUpdatedFrameCounter != GFrameCounter)
+	{
+		LastUpdatedFrameCounter = GFrameCounter;
+		UpdateStreamlineLatewarpAutoMode();
+	}
+}
+
+#if WITH_LATEWARP
+static bool AreLatewarpOptionsEquivalent(const sl::LatewarpOptions& LHS, const sl::LatewarpOptions& RHS)
+{
+	return LHS.latewarpActive == RHS.latewarpActive;
+}
+#endif
+
+void ForgetStreamlineLatewarpOptions(uint32 ViewID)
+{
+#if WITH_LATEWARP
+	GLatewarpOptionsCache.Forget(ViewID);
+#endif
+}
+
+void AddStreamlineLatewarpState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect)
+{
+#if WITH_LATEWARP
+	TagCollector.AddState(TEXT("Latewarp"), ViewID, SecondaryViewRect,
 		// this lambda computes the SL options struct based on cvars and other state
 		[](uint32 ViewID, const FIntRect& SecondaryViewRect) ->sl::LatewarpOptions
 		{
@@ -288,32 +310,32 @@ void AddStreamlineLatewarpStateRenderPass(FRDGBuilder& GraphBuilder, uint32 View
 			check(IsStreamlineLatewarpSupported());
 			check(IsInRenderingThread());
 			
-			sl:: LatewarpOptions{};
-			
 			sl::LatewarpOptions SLConstants;
 
 			// TODO: implement when we have an SDK RC that has that implemented
 			//SLConstants.onErrorCallback = DLSSGAPIErrorCallBack;
-			
 
 #if (ENGINE_MAJOR_VERSION == 4)
 			const bool bIsForeground = FApp::HasVRFocus() || FApp::IsBenchmarking() || FPlatformApplicationMisc::IsThisApplicationForeground();
 #else
 			const bool bIsForeground = FApp::HasFocus();
 #endif
-			const bool bIsLargeEnough = true; // FMath::Min(SecondaryViewRect.Width(), SecondaryViewRect.Height()) >= GDLSSGMinWidthOrHeight;
+			const bool bForegroundOK = bIsForeground || !CVarLatewarpOnlyInForeground.GetValueOnRenderThread();
+			const bool bIsLargeEnough = FMath::Min(SecondaryViewRect.Width(), SecondaryViewRect.Height()) >= CVarLatewarpMinWidthOrHeight.GetValueOnRenderThread();
 
+			SLConstants.latewarpActive = (bForegroundOK && bIsLargeEnough) ? IsLatewarpActive() : false;
 
-			// TODO hook up to cvar 
-			// 
-			SLConstants.latewarpActive = (true ||  bIsForeground && bIsLargeEnough) ? IsLatewarpActive() : false;
-		
 			return SLConstants;
 		},
-		// this lambda is only here since templating the function pointer and functin name and such below is inconvenient
+		// the options are the same most frames, so only push them to SL when they changed for this viewport
 		[](FRHICommandListImmediate& RHICmdList, uint32 ViewID, const FIntRect& SecondaryViewRect, const sl::LatewarpOptions& Options)
 		{
-			CALL_SL_FEATURE_FN(sl::kFeatureLatewarp, slLatewarpSetOptions, sl::ViewportHandle(ViewID), Options);
+			GLatewarpOptionsCache.SetOptionsIfChanged(ViewID, Options, &AreLatewarpOptionsEquivalent,
+				[](uint32 ViewID, const sl::LatewarpOptions& Options)
+				{
+					INC_DWORD_STAT(STAT_LatewarpSetOptionsCalls);
+					CALL_SL_FEATURE_FN(sl::kFeatureLatewarp, slLatewarpSetOptions, sl::ViewportHandle(ViewID), Options);
+				});
 		}
 	);
 #else
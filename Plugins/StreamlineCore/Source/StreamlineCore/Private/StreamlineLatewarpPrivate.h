@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+	Decides whether Latewarp should be on in auto mode (r.Streamline.Latewarp.Enable=2).
+	It turns on once the measured render latency goes above the threshold and only turns off again once the latency
+	drops below the threshold minus the hysteresis, so it doesn't flip every frame when hovering around the threshold.
+	A latency of 0 means no latency report is available (e.g. PC Latency markers are off), which keeps Latewarp off.
+*/
+class FStreamlineLatewarpAutoGate
+{
+public:
+	bool Update(float RenderLatencyMs, float ThresholdMs, float HysteresisMs)
+	{
+		const bool bWasActive = bActive;
+
+		if (RenderLatencyMs <= 0.0f)
+		{
+			bActive = false;
+		}
+		else if (bActive)
+		{
+			bActive = RenderLatencyMs >= ThresholdMs - FMath::Max(0.0f, HysteresisMs);
+		}
+		else
+		{
+			bActive = RenderLatencyMs > ThresholdMs;
+		}
+
+		if (bActive != bWasActive)
+		{
+			++NumTransitions;
+		}
+
+		return bActive;
+	}
+
+	bool IsActive() const
+	{
+		return bActive;
+	}
+
+	uint32 GetNumTransitions() const
+	{
+		return NumTransitions;
+	}
+
+	void Reset()
+	{
+		bActive = false;
+	}
+
+private:
+	bool bActive = false;
+	uint32 NumTransitions = 0;
+};
+
+// defaults to the Reflex PC Latency render latency, replaceable so the auto mode can be tested without a Streamline runtime
+using FStreamlineLatewarpLatencySource = TFunction<float()>;
+void SetStreamlineLatewarpLatencySource(FStreamlineLatewarpLatencySource InLatencySource);
+
+// game thread, samples the render latency once per frame and updates the auto mode. Returns whether auto mode wants Latewarp on
+bool UpdateStreamlineLatewarpAutoMode();
+
+// game thread, turns the auto mode off until the next update
+void ResetStreamlineLatewarpAutoMode();
+
+bool IsLatewarpAutoModeEnabled();
+
+// RHI thread, drops the options remembered for a released Streamline viewport
+void ForgetStreamlineLatewarpOptions(uint32 ViewID);
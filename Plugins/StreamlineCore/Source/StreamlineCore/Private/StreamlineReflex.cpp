@@ -203,7 +203,8 @@ void FStreamlineMaxTickRateHandler::SetEnabled(bool bInEnabled)
 // TODO base on eventual FStreamlineRHI queries
 bool DoActiveStreamlineFeaturesRequireReflex()
 {
-	return IsDLSSGActive() || IsLatewarpActive();
+	// the Latewarp auto mode needs the latency reports to decide whether to turn on
+	return IsDLSSGActive() || IsLatewarpActive() || IsLatewarpAutoModeEnabled();
 }
 
 bool FStreamlineMaxTickRateHandler::GetEnabled()
@@ -0,0 +1,211 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+
+#include "StreamlineTagCollector.h"
+#include "StreamlineCore.h"
+#include "StreamlineCorePrivate.h"
+#include "StreamlineRHI.h"
+
+#include "CoreMinimal.h"
+#include "RenderGraphBuilder.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Streamline: Tag passes submitted"), STAT_StreamlineTagPasses, STATGROUP_Streamline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Streamline: Passes saved by coalescing"), STAT_StreamlineCoalescedPasses, STATGROUP_Streamline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Streamline: Duplicate tags removed"), STAT_StreamlineCoalescedTags, STATGROUP_Streamline);
+
+FStreamlineTagCollector::FStreamlineTagCollector(FStreamlineRHI* InStreamlineRHI)
+	: StreamlineRHI(InStreamlineRHI)
+{
+	check(StreamlineRHI);
+}
+
+void FStreamlineTagCollector::SetConstants(const FRHIStreamlineArguments& InArguments)
+{
+	Constants = InArguments;
+}
+
+void FStreamlineTagCollector::AddTag(uint32 ViewID, FRDGTextureRef Texture, ERHIAccess Access, const FIntRect& ViewRect, EStreamlineResource Tag)
+{
+	FTagRequest Request;
+	Request.ViewID = ViewID;
+	Request.Tag = Tag;
+	Request.Texture = Texture;
+	Request.Access = Access;
+	Request.ViewRect = ViewRect;
+	AddTagRequest(Request);
+}
+
+void FStreamlineTagCollector::AddTag(uint32 ViewID, FRDGTextureRef Texture, ERHIAccess Access, EStreamlineResource Tag)
+{
+	FTagRequest Request;
+	Request.ViewID = ViewID;
+	Request.Tag = Tag;
+	Request.Texture = Texture;
+	Request.Access = Access;
+	Request.bUseFullExtent = true;
+	AddTagRequest(Request);
+}
+
+void FStreamlineTagCollector::AddTagRequest(const FTagRequest& InRequest)
+{
+	FTagRequest* ExistingRequest = TagRequests.FindByPredicate([&InRequest](const FTagRequest& Request)
+	{
+		return Request.ViewID == InRequest.ViewID && Request.Tag == InRequest.Tag;
+	});
+
+	if (!ExistingRequest)
+	{
+		TagRequests.Add(InRequest);
+		return;
+	}
+
+	++NumCoalescedTags;
+
+	// a feature asking to untag must not drop a resource another feature still needs
+	if (InRequest.Texture || !ExistingRequest->Texture)
+	{
+		*ExistingRequest = InRequest;
+	}
+}
+
+bool FStreamlineTagCollector::AddPass(FRDGBuilder& GraphBuilder, const TCHAR* CallSite)
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	FSLTagCollectorShaderParameters* PassParameters = GraphBuilder.AllocParameters<FSLTagCollectorShaderParameters>();
+
+	// multiple tags can refer to the same texture, but RDG needs each texture to be declared only once per pass
+	for (FTagRequest& Request : TagRequests)
+	{
+		if (!Request.Texture)
+		{
+			Request.AccessIndex = INDEX_NONE;
+			continue;
+		}
+
+		Request.AccessIndex = PassParameters->Textures.IndexOfByPredicate([&Request](const FRDGTextureAccess& TextureAccess)
+		{
+			return TextureAccess.GetTexture() == Request.Texture;
+		});
+
+		if (Request.AccessIndex == INDEX_NONE)
+		{
+			Request.AccessIndex = PassParameters->Textures.Emplace(Request.Texture, Request.Access);
+		}
+		else if (PassParameters->Textures[Request.AccessIndex].GetAccess() != Request.Access)
+		{
+			const ERHIAccess CombinedAccess = PassParameters->Textures[Request.AccessIndex].GetAccess() | Request.Access;
+			checkf(IsReadOnlyAccess(CombinedAccess), TEXT("Streamline resource %s is tagged with conflicting access %u"), Request.Texture->Name, uint32(CombinedAccess));
+			PassParameters->Textures[Request.AccessIndex] = FRDGTextureAccess(Request.Texture, CombinedAccess);
+		}
+	}
+
+#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
+	if (StreamlineRHI->NeedExtraPassesForDebugLayerCompatibility())
+	{
+		AddDebugLayerCompatibilitySetupPasses(GraphBuilder, &PassParameters->DebugLayerCompatibility);
+	}
+#endif
+
+	// without the collector the constants and tags would have been one pass, and every feature state another one
+	const int32 NumTagRequests = TagRequests.Num();
+	const int32 NumFeatureStates = FeatureStates.Num();
+	const int32 NumSeparatePasses = ((Constants.IsSet() || NumTagRequests) ? 1 : 0) + NumFeatureStates;
+	const int32 NumCoalescedPasses = FMath::Max(0, NumSeparatePasses - 1);
+
+	INC_DWORD_STAT(STAT_StreamlineTagPasses);
+	INC_DWORD_STAT_BY(STAT_StreamlineCoalescedPasses, NumCoalescedPasses);
+	INC_DWORD_STAT_BY(STAT_StreamlineCoalescedTags, NumCoalescedTags);
+
+	GraphBuilder.AddPass(
+		RDG_EVENT_NAME("Streamline Tags %s {Tags=%d Options=%d} Coalesced {Passes=%d Tags=%d}",
+			CallSite, NumTagRequests, NumFeatureStates, NumCoalescedPasses, NumCoalescedTags),
+		PassParameters,
+		ERDGPassFlags::Raster | ERDGPassFlags::Compute | ERDGPassFlags::Copy
+		| ERDGPassFlags::NeverCull | ERDGPassFlags::NeverMerge | ERDGPassFlags::SkipRenderPass,
+		[LocalStreamlineRHI = StreamlineRHI, PassParameters, LocalConstants = MoveTemp(Constants), LocalTagRequests = MoveTemp(TagRequests), LocalFeatureStates = MoveTemp(FeatureStates)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			// first the constants
+			if (LocalConstants.IsSet())
+			{
+				RHICmdList.EnqueueLambda(
+				[LocalStreamlineRHI, StreamlineArguments = LocalConstants.GetValue()](FRHICommandListImmediate& Cmd) mutable
+				{
+					LocalStreamlineRHI->SetStreamlineData(Cmd, StreamlineArguments);
+				});
+			}
+
+			// then tagging the resources, batched per view
+			TArray<uint32, TInlineAllocator<4>> ViewIDs;
+			for (const FTagRequest& Request : LocalTagRequests)
+			{
+				ViewIDs.AddUnique(Request.ViewID);
+			}
+
+			const uint64 LocalGFrameCounter = GFrameCounterRenderThread;
+
+			for (const uint32 ViewID : ViewIDs)
+			{
+				TArray<FRHIStreamlineResource, TInlineAllocator<8>> TexturesToTagOrUntag;
+
+				for (const FTagRequest& Request : LocalTagRequests)
+				{
+					if (Request.ViewID != ViewID)
+					{
+						continue;
+					}
+
+					if (Request.AccessIndex == INDEX_NONE)
+					{
+						TexturesToTagOrUntag.Add(FRHIStreamlineResource::NullResource(Request.Tag));
+						continue;
+					}
+
+					const FRDGTextureAccess& TextureAccess = PassParameters->Textures[Request.AccessIndex];
+					TextureAccess->MarkResourceAsUsed();
+
+					TexturesToTagOrUntag.Add(Request.bUseFullExtent
+						? FRHIStreamlineResource::FromRDGTextureAccess(TextureAccess, Request.Tag)
+						: FRHIStreamlineResource::FromRDGTextureAccess(TextureAccess, Request.ViewRect, Request.Tag));
+				}
+
+#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
+				if (LocalStreamlineRHI->NeedExtraPassesForDebugLayerCompatibility())
+				{
+					DebugLayerCompatibilityRHISetup(PassParameters->DebugLayerCompatibility, TexturesToTagOrUntag);
+				}
+#endif
+
+				RHICmdList.EnqueueLambda(
+				[LocalStreamlineRHI, ViewID, TexturesToTagOrUntag, LocalGFrameCounter](FRHICommandListImmediate& Cmd) mutable
+				{
+					sl::FrameToken* FrameToken = FStreamlineCoreModule::GetStreamlineRHI()->GetFrameToken(LocalGFrameCounter);
+					LocalStreamlineRHI->TagTextures(Cmd, ViewID, *FrameToken, TexturesToTagOrUntag);
+				});
+			}
+
+			// and finally the feature options
+			for (TPair<const TCHAR*, TFunction<void(FRHICommandListImmediate&)>>& FeatureState : LocalFeatureStates)
+			{
+				FeatureState.Value(RHICmdList);
+			}
+		});
+
+	Constants.Reset();
+	TagRequests.Reset();
+	FeatureStates.Reset();
+	NumCoalescedTags = 0;
+
+	return true;
+}
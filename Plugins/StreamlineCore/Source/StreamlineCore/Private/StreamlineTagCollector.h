@@ -0,0 +1,100 @@
+/*
+* Copyright (c) 2022 - 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphBuilder.h"
+#include "StreamlineRHI.h"
+#include "StreamlineCorePrivate.h"
+
+BEGIN_SHADER_PARAMETER_STRUCT(FSLTagCollectorShaderParameters, )
+RDG_TEXTURE_ACCESS_ARRAY(Textures)
+
+#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
+SHADER_PARAMETER_STRUCT_INCLUDE(FDebugLayerCompatibilityShaderParameters, DebugLayerCompatibility)
+#endif
+END_SHADER_PARAMETER_STRUCT()
+
+/*
+	Collects the Streamline common constants, resource tags and feature options (DLSS-G, Latewarp, DeepDVC, ...)
+	and submits all of them in a single RDG pass instead of each feature adding its own pass.
+
+	Tags are keyed by view id and resource type. If multiple features request the same resource for the same view,
+	only one tag is submitted. A real texture always wins over a null (untag) request.
+
+	Submission order inside the pass matches what SL expects: constants, then tags (one TagTextures call per view), then feature options.
+*/
+class FStreamlineTagCollector
+{
+public:
+	explicit FStreamlineTagCollector(FStreamlineRHI* InStreamlineRHI);
+
+	void SetConstants(const FRHIStreamlineArguments& InArguments);
+
+	// Tags the resource with the given view rect. Passing a null texture untags the resource.
+	void AddTag(uint32 ViewID, FRDGTextureRef Texture, ERHIAccess Access, const FIntRect& ViewRect, EStreamlineResource Tag);
+
+	// Tags the resource using the full texture extent as view rect.
+	void AddTag(uint32 ViewID, FRDGTextureRef Texture, ERHIAccess Access, EStreamlineResource Tag);
+
+	template<typename StateOnRenderThreadLambda, typename RHIThreadLambda>
+	void AddState(const TCHAR* FeatureName, uint32 ViewID, const FIntRect& SecondaryViewRect, StateOnRenderThreadLambda&& StateOnRenderThread, RHIThreadLambda&& OnRHIThread)
+	{
+		FeatureStates.Emplace(FeatureName,
+			[ViewID, SecondaryViewRect, StateOnRenderThread = Forward<StateOnRenderThreadLambda>(StateOnRenderThread), OnRHIThread = Forward<RHIThreadLambda>(OnRHIThread)](FRHICommandListImmediate& RHICmdList)
+			{
+				auto Options = StateOnRenderThread(ViewID, SecondaryViewRect);
+
+				RHICmdList.EnqueueLambda(
+					[ViewID, SecondaryViewRect, Options, OnRHIThread](FRHICommandListImmediate& Cmd) mutable
+					{
+						OnRHIThread(Cmd, ViewID, SecondaryViewRect, Options);
+					});
+			});
+	}
+
+	bool IsEmpty() const
+	{
+		return !Constants.IsSet() && TagRequests.IsEmpty() && FeatureStates.IsEmpty();
+	}
+
+	int32 NumTags() const
+	{
+		return TagRequests.Num();
+	}
+
+	// Adds one RDG pass that submits everything collected so far and resets the collector. Returns false if there was nothing to submit.
+	bool AddPass(FRDGBuilder& GraphBuilder, const TCHAR* CallSite);
+
+private:
+	struct FTagRequest
+	{
+		uint32 ViewID = 0;
+		EStreamlineResource Tag = EStreamlineResource::Depth;
+		FRDGTextureRef Texture = nullptr;
+		ERHIAccess Access = ERHIAccess::Unknown;
+		FIntRect ViewRect;
+		bool bUseFullExtent = false;
+
+		// index into FSLTagCollectorShaderParameters::Textures, INDEX_NONE for untagging
+		int32 AccessIndex = INDEX_NONE;
+	};
+
+	void AddTagRequest(const FTagRequest& InRequest);
+
+	FStreamlineRHI* StreamlineRHI = nullptr;
+
+	TOptional<FRHIStreamlineArguments> Constants;
+	TArray<FTagRequest, TInlineAllocator<8>> TagRequests;
+	TArray<TPair<const TCHAR*, TFunction<void(FRHICommandListImmediate&)>>, TInlineAllocator<4>> FeatureStates;
+
+	int32 NumCoalescedTags = 0;
+};
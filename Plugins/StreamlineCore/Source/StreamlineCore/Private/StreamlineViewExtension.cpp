@@ -15,6 +15,10 @@
 #include "StreamlineDLSSG.h"
 #include "StreamlineLatewarp.h"
 #include "StreamlineDeepDVC.h"
+#include "StreamlineDeepDVCPrivate.h"
+#include "StreamlineLatewarpPrivate.h"
+#include "StreamlineTagCollector.h"
+#include "StreamlineFrameSettings.h"
 #include "StreamlineRHI.h"
 #include "StreamlineAPI.h"
 
@@ -135,6 +139,7 @@ static constexpr bool bLogStreamlineLogTrackedViews = false;
 
 
 DEFINE_GPU_STAT(Streamline);
+DECLARE_CYCLE_STAT(TEXT("Per view setup (render thread)"), STAT_StreamlinePostProcessPassAtEnd, STATGROUP_Streamline);
 DECLARE_GPU_STAT(StreamlineDeepDVC);
 
 FDelegateHandle FStreamlineViewExtension::OnPreResizeWindowBackBufferHandle;
@@ -147,11 +152,11 @@ bool DoActiveStreamlineFeaturesSupportMultiView()
 	return !IsLatewarpActive();
 }
 
-int GetViewIndexToTag()
+int32 GetViewIndexToTag()
 {
 	if (DoActiveStreamlineFeaturesSupportMultiView())
 	{
-		return CVarStreamlineViewIndexToTag->GetInt();
+		return GetStreamlineFrameSettings().ViewIndexToTag;
 	}
 	else
 	{
@@ -162,16 +167,31 @@ int GetViewIndexToTag()
 
 bool NeedStreamlineViewIdOverride()
 {
-	if (CVarStreamlineViewIdOverride->GetInt() == -1)
+	const int32 ViewIdOverride = GetStreamlineFrameSettings().ViewIdOverride;
+	if (ViewIdOverride == -1)
 	{
 		return GetViewIndexToTag() != -1;
 	}
 	else
 	{
-		return CVarStreamlineViewIdOverride->GetInt() == 1;
+		return ViewIdOverride == 1;
 	}
 }
 
+void ReadStreamlineViewExtensionFrameSettings(FStreamlineFrameSettings& Settings)
+{
+	Settings.ViewIndexToTag = CVarStreamlineViewIndexToTag.GetValueOnGameThread();
+	Settings.ViewIdOverride = CVarStreamlineViewIdOverride.GetValueOnGameThread();
+	Settings.bTagSceneColorWithoutHUD = GIsEditor ? CVarStreamlineTagEditorSceneColorWithoutHUD.GetValueOnGameThread() : CVarStreamlineTagSceneColorWithoutHUD.GetValueOnGameThread();
+	Settings.bTagCustomDepth = CVarStreamlineTagCustomDepth.GetValueOnGameThread();
+	Settings.bTagVelocities = CVarStreamlineTagVelocities.GetValueOnGameThread();
+	Settings.bDilateMotionVectors = CVarStreamlineDilateMotionVectors.GetValueOnGameThread() != 0;
+	Settings.bClearSceneColorAlpha = CVarStreamlineClearColorAlpha.GetValueOnGameThread();
+	Settings.MotionVectorScale = CVarStreamlineMotionVectorScale.GetValueOnGameThread();
+	Settings.CustomCameraNearPlane = CVarStreamlineCustomCameraNearPlane.GetValueOnGameThread();
+	Settings.CustomCameraFarPlane = CVarStreamlineCustomCameraFarPlane.GetValueOnGameThread();
+}
+
 FStreamlineViewExtension::FStreamlineViewExtension(const FAutoRegister& AutoRegister, FStreamlineRHI* InStreamlineRHIExtensions)
 	: FSceneViewExtensionBase(AutoRegister)
 	, StreamlineRHIExtensions(InStreamlineRHIExtensions)
@@ -258,7 +278,9 @@ void FStreamlineViewExtension::SetupViewPoint(APlayerController* Player, FMinima
 
 void FStreamlineViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
 {
+	CaptureStreamlineFrameSettings();
 	BeginRenderViewFamilyDLSSG(InViewFamily);
+	BeginRenderViewFamilyLatewarp(InViewFamily);
 }
 
 
@@ -543,6 +565,8 @@ void FStreamlineViewExtension::PreRenderViewFamily_RenderThread(FGraphBuilderOrC
 		{
 			UE_CLOG(DebugViewTracking(), LogStreamline, Log, TEXT("%s %s freeing resources for View Id %u"), ANSI_TO_TCHAR(__FUNCTION__), *CurrentThreadName(), StaleView);
 			StreamlineRHIExtensions->ReleaseStreamlineResourcesForAllFeatures(StaleView);
+			ForgetStreamlineDeepDVCOptions(StaleView);
+			ForgetStreamlineLatewarpOptions(StaleView);
 		});
 	}
 }
@@ -560,77 +584,6 @@ void FStreamlineViewExtension::PostRenderViewFamily_RenderThread(FGraphBuilderOr
 
 }
 
-void AddStreamlineUIHintTagPass(
-	FRDGBuilder& GraphBuilder,
-	bool bTagBackbuffer,
-	bool bTagUIColorAlpha,
-	const FIntPoint &BackBufferDimension,
-	FSLUIHintTagShaderParameters* PassParameters,
-	uint32 ViewId,
-	FStreamlineRHI* RHIExtensions,
-	TArray<FTrackedView>& ViewsInThisBackBuffer,
-	const FIntRect &WindowClientAreaRect,
-	bool HasViewIdOverride
-)
-{
-
-
-	GraphBuilder.AddPass(
-		RDG_EVENT_NAME("Streamline Tag {Backbuffer=%u UIColorAndAlpha=%u} NumViews=%u  WindowClient%dx%d [%d,%d -> %d,%d] Texture=%s",
-			bTagBackbuffer, bTagUIColorAlpha,
-			ViewsInThisBackBuffer.Num(),
-			WindowClientAreaRect.Width(), WindowClientAreaRect.Height(),
-			WindowClientAreaRect.Min.X, WindowClientAreaRect.Min.Y,
-			WindowClientAreaRect.Max.X, WindowClientAreaRect.Max.Y
-			,  *BackBufferDimension.ToString()),
-		PassParameters,
-		ERDGPassFlags::Raster | ERDGPassFlags::Compute | ERDGPassFlags::Copy
-		| ERDGPassFlags::NeverCull | ERDGPassFlags::NeverMerge | ERDGPassFlags::SkipRenderPass,
-		[RHIExtensions, bTagBackbuffer, bTagUIColorAlpha, PassParameters, WindowClientAreaRect, ViewsInThisBackBuffer, HasViewIdOverride](FRHICommandListImmediate& RHICmdList) mutable
-		{
-			for (const FTrackedView& View : ViewsInThisBackBuffer)
-			{
-				TArray<FRHIStreamlineResource, TInlineAllocator<2>> TexturesToTagOrUntag;
-				
-				check(!!PassParameters->BackBuffer == bTagBackbuffer);
-				TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->BackBuffer, View.UnscaledViewRect, EStreamlineResource::Backbuffer));
-				if (bTagBackbuffer)
-				{
-					check(PassParameters->BackBuffer);
-					PassParameters->BackBuffer->MarkResourceAsUsed();
-				}
-
-				check(!!PassParameters->UIColorAndAlpha == bTagUIColorAlpha);
-				TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->UIColorAndAlpha, View.UnscaledViewRect, EStreamlineResource::UIColorAndAlpha));
-				if (bTagUIColorAlpha)
-				{
-					check(PassParameters->UIColorAndAlpha);
-					PassParameters->UIColorAndAlpha->MarkResourceAsUsed();
-				}
-
-				const uint32 ViewID = HasViewIdOverride ? 0 : View.ViewKey;
-				const uint64 LocalGFrameCounter = GFrameCounterRenderThread;
-
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-				if (RHIExtensions->NeedExtraPassesForDebugLayerCompatibility())
-				{
-					DebugLayerCompatibilityRHISetup(PassParameters->DebugLayerCompatibility, TexturesToTagOrUntag);
-				}
-#endif
-				RHICmdList.EnqueueLambda(
-					[RHIExtensions, TexturesToTagOrUntag, ViewID, LocalGFrameCounter](FRHICommandListImmediate& Cmd) mutable
-				{
-						sl::FrameToken* FrameToken = FStreamlineCoreModule::GetStreamlineRHI()->GetFrameToken(LocalGFrameCounter);
-						RHIExtensions->TagTextures(Cmd, ViewID, *FrameToken, TexturesToTagOrUntag);
-				});
-			}
-	});
-
-	
-	GraphBuilder.Execute();
-}
-
-
 void FStreamlineViewExtension::SubscribeToPostProcessingPass(
 	EPostProcessingPass Pass
 #if !UE_VERSION_OLDER_THAN(5,5,0)	
@@ -683,26 +636,20 @@ To avoid those extra transitions we are using the RDG/RHI to put the resources i
 
 
 */
-BEGIN_SHADER_PARAMETER_STRUCT(FSLShaderParameters, )
-RDG_TEXTURE_ACCESS(Depth, ERHIAccess::CopySrc | ERHIAccess::DSVRead | ERHIAccess::SRVMask)
-RDG_TEXTURE_ACCESS(Velocity, ERHIAccess::CopySrc)
-RDG_TEXTURE_ACCESS(NoWarpMask, ERHIAccess::CopySrc)
-RDG_TEXTURE_ACCESS(SceneColorWithoutHUD, ERHIAccess::CopySrc)
-
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-SHADER_PARAMETER_STRUCT_INCLUDE(FDebugLayerCompatibilityShaderParameters, DebugLayerCompatibility)
-#endif
-END_SHADER_PARAMETER_STRUCT()
+static constexpr ERHIAccess StreamlineDepthAccess = ERHIAccess::CopySrc | ERHIAccess::DSVRead | ERHIAccess::SRVMask;
+static constexpr ERHIAccess StreamlineInputAccess = ERHIAccess::CopySrc;
 
 FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& InOutInputs)
 {
 	check(IsInRenderingThread());
 	check(View.bIsViewInfo);
+	SCOPE_CYCLE_COUNTER(STAT_StreamlinePostProcessPassAtEnd);
 
 	AddTrackedView(View);
 
-	const int ViewIndexToTag = GetViewIndexToTag();
-	const bool bTagAllViews = -1 == GetViewIndexToTag();
+	const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+	const int32 ViewIndexToTag = GetViewIndexToTag();
+	const bool bTagAllViews = -1 == ViewIndexToTag;
 	check(!bTagAllViews || bTagAllViews && DoActiveStreamlineFeaturesSupportMultiView());
 	const bool bTagThisView = bTagAllViews || (ViewIndexToTag == GetViewIndex(&View));
 
@@ -758,6 +705,9 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 		ViewRect.Max.X, ViewRect.Max.Y);
 	RDG_GPU_STAT_SCOPE(GraphBuilder, Streamline);
 
+	// constants, tags and feature options of all Streamline features get submitted together in one pass
+	FStreamlineTagCollector TagCollector(StreamlineRHIExtensions);
+
 	if (ShouldTagStreamlineBuffers())
 	{
 		const uint64 FrameNumber = GFrameNumberRenderThread;
@@ -811,10 +761,6 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 		FRDGTextureRef AlternateMotionVector = nullptr;
 #endif
 
-		FStreamlineRHI* LocalStreamlineRHIExtensions = this->StreamlineRHIExtensions;
-
-		FSLShaderParameters* PassParameters = GraphBuilder.AllocParameters<FSLShaderParameters>();
-
 		// Those are consumed directly by SL 
 		// FRDGTextureRef SLDepth = SceneDepth; 
 
@@ -823,7 +769,7 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 		FRDGTextureRef SLVelocity = nullptr;
 		FRDGTextureRef SLSceneColorWithoutHUD = nullptr;
 
-		const bool bTagSceneColorWithoutHUD = GIsEditor ? CVarStreamlineTagEditorSceneColorWithoutHUD.GetValueOnRenderThread() : CVarStreamlineTagSceneColorWithoutHUD.GetValueOnRenderThread();
+		const bool bTagSceneColorWithoutHUD = FrameSettings.bTagSceneColorWithoutHUD;
 		if (bTagSceneColorWithoutHUD)
 		{
 			FRDGTextureDesc Desc = SceneColor.Texture->Desc;
@@ -832,11 +778,9 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 			EnumRemoveFlags(Desc.Flags, TexCreate_ResolveTargetable);
 			SLSceneColorWithoutHUD = GraphBuilder.CreateTexture(Desc, TEXT("Streamline.SceneColorWithoutHUD"));
 			AddDrawTexturePass(GraphBuilder, ViewInfo, SceneColor.Texture, SLSceneColorWithoutHUD, FIntPoint::ZeroValue, FIntPoint::ZeroValue, FIntPoint::ZeroValue);
-
-			PassParameters->SceneColorWithoutHUD = SLSceneColorWithoutHUD;
 		}
 
-		const bool bTagCustomDepth = CVarStreamlineTagCustomDepth.GetValueOnRenderThread();
+		const bool bTagCustomDepth = FrameSettings.bTagCustomDepth;
 		if (bTagCustomDepth)
 		{
 			NV_RDG_EVENT_SCOPE(GraphBuilder,Streamline, "Streamline CustomDepth %dx%d [%d,%d -> %d,%d]",
@@ -877,21 +821,16 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 #endif
 				AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(SLCustomDepth), kClearValue);
 			}
-
-			PassParameters->NoWarpMask = SLCustomDepth;
 		}
 
-		const bool bTagMotionVectors = CVarStreamlineTagVelocities.GetValueOnRenderThread() != 0;
-		const bool bDilateMotionVectors = CVarStreamlineDilateMotionVectors.GetValueOnRenderThread() != 0;
+		const bool bTagMotionVectors = FrameSettings.bTagVelocities;
+		const bool bDilateMotionVectors = FrameSettings.bDilateMotionVectors;
 		
 		if (bTagMotionVectors)
 		{
 			SLVelocity = AddStreamlineVelocityCombinePass(GraphBuilder, ViewInfo, SceneDepth, SceneVelocity, AlternateMotionVector, bDilateMotionVectors);
-			PassParameters->Velocity = SLVelocity;
 		}
 
-		PassParameters->Depth = SceneDepth;
-
 
 		FRHIStreamlineArguments StreamlineArguments = {};
 		FMemory::Memzero(StreamlineArguments);
@@ -906,11 +845,11 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 
 		StreamlineArguments.JitterOffset = { float(ViewInfo.TemporalJitterPixels.X), float(ViewInfo.TemporalJitterPixels.Y) }; // LWC_TODO: Precision loss
 
-		StreamlineArguments.CameraNear = CVarStreamlineCustomCameraNearPlane.GetValueOnRenderThread();
-		StreamlineArguments.CameraFar = CVarStreamlineCustomCameraFarPlane.GetValueOnRenderThread();
+		StreamlineArguments.CameraNear = FrameSettings.CustomCameraNearPlane;
+		StreamlineArguments.CameraFar = FrameSettings.CustomCameraFarPlane;
 		StreamlineArguments.CameraFOV = ViewInfo.FOV;
 		StreamlineArguments.CameraAspectRatio = float(ViewInfo.ViewRect.Width()) / float(ViewInfo.ViewRect.Height());
-		const float MotionVectorScale = CVarStreamlineMotionVectorScale.GetValueOnRenderThread();
+		const float MotionVectorScale = FrameSettings.MotionVectorScale;
 		if (bDilateMotionVectors)
 		{
 			StreamlineArguments.MotionVectorScale = { MotionVectorScale / ViewInfo.GetSecondaryViewRectSize().X, MotionVectorScale / ViewInfo.GetSecondaryViewRectSize().Y };
@@ -946,95 +885,47 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 		StreamlineArguments.CameraViewToClip = ViewUniformShaderParameters.ViewToClip;
 
 		StreamlineArguments.CameraPinholeOffset = FRHIStreamlineArguments::FVector2f::ZeroVector;
-		
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-		if (LocalStreamlineRHIExtensions->NeedExtraPassesForDebugLayerCompatibility())
-		{
-			AddDebugLayerCompatibilitySetupPasses(GraphBuilder, &PassParameters->DebugLayerCompatibility);
-		}
-#endif
-
-		GraphBuilder.AddPass(
-		RDG_EVENT_NAME("Streamline Common %dx%d FrameId=%u ViewID=%u", ViewRect.Width(), ViewRect.Height(), StreamlineArguments.FrameId, StreamlineArguments.ViewId),
-			PassParameters,
-			ERDGPassFlags::Raster | ERDGPassFlags::Compute | ERDGPassFlags::Copy
-			| ERDGPassFlags::NeverCull | ERDGPassFlags::NeverMerge | ERDGPassFlags::SkipRenderPass,
-			[LocalStreamlineRHIExtensions, PassParameters, StreamlineArguments, ViewRect, SecondaryViewRect, SceneColor, 
-			bTagMotionVectors, bTagCustomDepth, bTagSceneColorWithoutHUD](FRHICommandListImmediate& RHICmdList) mutable
-		{
 
-			// first the constants
-			RHICmdList.EnqueueLambda(
-			[LocalStreamlineRHIExtensions, StreamlineArguments](FRHICommandListImmediate& Cmd) mutable
-			{
-				LocalStreamlineRHIExtensions->SetStreamlineData(Cmd, StreamlineArguments);
-			});
-
-			TArray<FRHIStreamlineResource, TInlineAllocator<4>> TexturesToTagOrUntag;
-			check(PassParameters->Depth);
-			PassParameters->Depth->MarkResourceAsUsed();
-			TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->Depth, ViewRect, EStreamlineResource::Depth));
+		// first the constants
+		TagCollector.SetConstants(StreamlineArguments);
 
-			// motion vectors are in the top left corner after the Velocity Combine pass
-			check(!!PassParameters->Velocity == bTagMotionVectors);
-			TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->Velocity, EStreamlineResource::MotionVectors));
-			if (bTagMotionVectors)
-			{
-				check(PassParameters->Velocity)
-				PassParameters->Velocity->MarkResourceAsUsed();
-			}
+		// then tagging the resources
+		TagCollector.AddTag(ViewID, SceneDepth, StreamlineDepthAccess, ViewRect, EStreamlineResource::Depth);
 
-			// custom depth are in the same rect as the depth buffer
-			check(!!PassParameters->NoWarpMask == bTagCustomDepth);
-			TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->NoWarpMask, ViewRect, EStreamlineResource::NoWarpMask));
-			if (bTagCustomDepth)
-			{
-				check(PassParameters->NoWarpMask)
-				PassParameters->NoWarpMask->MarkResourceAsUsed();
-			}
+		// motion vectors are in the top left corner after the Velocity Combine pass
+		TagCollector.AddTag(ViewID, SLVelocity, StreamlineInputAccess, EStreamlineResource::MotionVectors);
 
-			check(!!PassParameters->SceneColorWithoutHUD == bTagSceneColorWithoutHUD);
-			TexturesToTagOrUntag.Add(FRHIStreamlineResource::FromRDGTextureAccess(PassParameters->SceneColorWithoutHUD, SceneColor.ViewRect, EStreamlineResource::HUDLessColor));
-			if (bTagSceneColorWithoutHUD)
-			{
-				check(PassParameters->SceneColorWithoutHUD);
-				PassParameters->SceneColorWithoutHUD->MarkResourceAsUsed();
-			}
-
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-			if (LocalStreamlineRHIExtensions->NeedExtraPassesForDebugLayerCompatibility())
-			{
-				DebugLayerCompatibilityRHISetup(PassParameters->DebugLayerCompatibility, TexturesToTagOrUntag);
-			}
-#endif
-			// then tagging the resources
-			const uint32 ViewId = StreamlineArguments.ViewId;
-			const uint64 LocalGFrameCounter = GFrameCounterRenderThread;
-
-			RHICmdList.EnqueueLambda(
-			[LocalStreamlineRHIExtensions, ViewId, TexturesToTagOrUntag, LocalGFrameCounter](FRHICommandListImmediate& Cmd) mutable
-			{
-				sl::FrameToken* FrameToken = FStreamlineCoreModule::GetStreamlineRHI()->GetFrameToken(LocalGFrameCounter);
-				LocalStreamlineRHIExtensions->TagTextures(Cmd, ViewId, *FrameToken, TexturesToTagOrUntag);
-			});
-		});
+		// custom depth are in the same rect as the depth buffer
+		TagCollector.AddTag(ViewID, SLCustomDepth, StreamlineInputAccess, ViewRect, EStreamlineResource::NoWarpMask);
 
+		TagCollector.AddTag(ViewID, SLSceneColorWithoutHUD, StreamlineInputAccess, SceneColor.ViewRect, EStreamlineResource::HUDLessColor);
 	}
 
 	// this is always executed if DLSS-G is supported so we can turn DLSS-G off at the SL side (after we skipped the work above)
 	if (IsStreamlineDLSSGSupported())
 	{
-		AddStreamlineDLSSGStateRenderPass(GraphBuilder, ViewID, SecondaryViewRect);
+		AddStreamlineDLSSGState(TagCollector, ViewID, SecondaryViewRect);
 	}
 
 	// this is always executed if Latewarp is supported so we can turn it off at the SL side (after we skipped the work above)
 	if (IsStreamlineLatewarpSupported())
 	{
-		AddStreamlineLatewarpStateRenderPass(GraphBuilder, ViewID, SecondaryViewRect);
+		AddStreamlineLatewarpState(TagCollector, ViewID, SecondaryViewRect);
 	}
 
-	// DeepDVC render pass
-	if(IsDeepDVCActive())
+	const bool bIsDeepDVCActive = IsDeepDVCActive();
+	const FStreamlineDeepDVCViewParameters DeepDVCParameters = GetStreamlineDeepDVCViewParameters_RenderThread(GetViewIndex(&View));
+	if (bIsDeepDVCActive)
+	{
+		// we wont need to run this always since (unlike FG) we skip the whole evaluate pass
+		// views with 0 intensity still get their state set so SL turns DeepDVC off for that viewport
+		AddStreamlineDeepDVCState(TagCollector, ViewID, SecondaryViewRect, DeepDVCParameters);
+	}
+
+	TagCollector.AddPass(GraphBuilder, *FString::Printf(TEXT("FrameId=%llu ViewID=%u %dx%d"), FrameID, ViewID, ViewRect.Width(), ViewRect.Height()));
+
+	// DeepDVC render pass, including the copies
+	if (bIsDeepDVCActive && ShouldEvaluateStreamlineDeepDVC(DeepDVCParameters))
 	{
 		NV_RDG_EVENT_SCOPE(GraphBuilder, StreamlineDeepDVC, "Streamline DeepDVC %dx%d [%d,%d -> %d,%d]",
 			SceneColor.ViewRect.Width(), SceneColor.ViewRect.Height(),
@@ -1042,9 +933,6 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 			SceneColor.ViewRect.Max.X, SceneColor.ViewRect.Max.Y
 		);
 		RDG_GPU_STAT_SCOPE(GraphBuilder, StreamlineDeepDVC);
-		// we wont need to run this always since (unlike FG) we skip the whole evaluate pass
-
-		AddStreamlineDeepDVCStateRenderPass(GraphBuilder, ViewID, SecondaryViewRect);
 		
 		FRDGTextureRef SLSceneColorWithoutHUD = SceneColor.Texture;
 
@@ -1086,7 +974,7 @@ FScreenPassTexture FStreamlineViewExtension::PostProcessPassAtEnd_RenderThread(F
 
 
 #if ENGINE_SUPPORTS_CLEARQUADALPHA
-	if (ShouldTagStreamlineBuffers() &&  CVarStreamlineClearColorAlpha.GetValueOnRenderThread())
+	if (ShouldTagStreamlineBuffers() && FrameSettings.bClearSceneColorAlpha)
 	{
 		auto* PassParameters = GraphBuilder.AllocParameters<FRenderTargetParameters>();
 		PassParameters->RenderTargets[0] = FRenderTargetBinding(SceneColor.Texture, ERenderTargetLoadAction::ENoAction);
@@ -42,30 +42,6 @@ struct FTrackedView
 	uint32_t ViewKey = 0;
 };
 
-BEGIN_SHADER_PARAMETER_STRUCT(FSLUIHintTagShaderParameters, )
-RDG_TEXTURE_ACCESS(BackBuffer, ERHIAccess::CopySrc)
-RDG_TEXTURE_ACCESS(UIColorAndAlpha, ERHIAccess::CopySrc)
-
-#if !ENGINE_PROVIDES_UE_5_6_ID3D12DYNAMICRHI_METHODS
-SHADER_PARAMETER_STRUCT_INCLUDE(FDebugLayerCompatibilityShaderParameters, DebugLayerCompatibility)
-#endif
-END_SHADER_PARAMETER_STRUCT()
-
-
-
-extern void AddStreamlineUIHintTagPass(
-	FRDGBuilder& GraphBuilder,
-	bool bTagBackbuffer,
-	bool bTagUIColorAlpha,
-	const FIntPoint &BackBufferDimension,
-	FSLUIHintTagShaderParameters* PassParameters,
-	uint32 ViewId,
-	FStreamlineRHI* RHIExtensions,
-	TArray<FTrackedView>& ViewsInThisBackBuffer,
-	const FIntRect &WindowClientAreaRect,
-	bool HasViewIdOverride
-);
-
 class FStreamlineViewExtension final : public FSceneViewExtensionBase
 {
 public:
@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// plugin includes
+#include "StreamlineDeepDVC.h"
+#include "StreamlineDeepDVCPrivate.h"
+#include "StreamlineRHI.h"
+
+// engine includes
+#include "Misc/AutomationTest.h"
+
+// The SL backend is replaced with a recorder, so this runs without a Streamline runtime or NVIDIA GPU
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlineDeepDVCViewOptionsTest, "Nvidia.Streamline.DeepDVC.ViewOptions",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FStreamlineDeepDVCViewOptionsTest::RunTest(const FString& Parameters)
+{
+	TArray<TPair<uint32, sl::DeepDVCOptions>> SetOptionsCalls;
+	SetStreamlineDeepDVCSetOptionsFunction([&SetOptionsCalls](uint32 ViewID, const sl::DeepDVCOptions& Options)
+	{
+		SetOptionsCalls.Emplace(ViewID, Options);
+	});
+	ON_SCOPE_EXIT
+	{
+		SetStreamlineDeepDVCSetOptionsFunction(nullptr);
+	};
+
+	FStreamlineDeepDVCViewParameters PlayerOne;
+	PlayerOne.Intensity = 0.25f;
+	PlayerOne.SaturationBoost = 0.5f;
+
+	FStreamlineDeepDVCViewParameters PlayerTwo;
+	PlayerTwo.Intensity = 0.75f;
+	PlayerTwo.SaturationBoost = 0.1f;
+
+	const uint32 PlayerOneViewID = 1;
+	const uint32 PlayerTwoViewID = 2;
+
+	// the first options for each viewport always get pushed
+	TestTrue(TEXT("First options for view 1 are pushed"), SetStreamlineDeepDVCOptionsIfChanged(PlayerOneViewID, MakeStreamlineDeepDVCOptions(PlayerOne)));
+	TestTrue(TEXT("First options for view 2 are pushed"), SetStreamlineDeepDVCOptionsIfChanged(PlayerTwoViewID, MakeStreamlineDeepDVCOptions(PlayerTwo)));
+	TestEqual(TEXT("One SetOptions call per view"), SetOptionsCalls.Num(), 2);
+
+	if (SetOptionsCalls.Num() == 2)
+	{
+		TestEqual(TEXT("View 1 gets its own intensity"), SetOptionsCalls[0].Key, PlayerOneViewID);
+		TestEqual(TEXT("View 1 intensity"), SetOptionsCalls[0].Value.intensity, PlayerOne.Intensity);
+		TestEqual(TEXT("View 2 gets its own intensity"), SetOptionsCalls[1].Key, PlayerTwoViewID);
+		TestEqual(TEXT("View 2 saturation boost"), SetOptionsCalls[1].Value.saturationBoost, PlayerTwo.SaturationBoost);
+	}
+
+	// unchanged options are filtered, unless that got turned off with r.Streamline.FilterRedundantSetOptionsCalls or -slnofilter
+	SetOptionsCalls.Reset();
+	SetStreamlineDeepDVCOptionsIfChanged(PlayerOneViewID, MakeStreamlineDeepDVCOptions(PlayerOne));
+	SetStreamlineDeepDVCOptionsIfChanged(PlayerTwoViewID, MakeStreamlineDeepDVCOptions(PlayerTwo));
+	TestEqual(TEXT("Unchanged options are only pushed without filtering"), SetOptionsCalls.Num(), StreamlineFilterRedundantSetOptionsCalls() ? 0 : 2);
+
+	// changing one view doesn't push the other one
+	SetOptionsCalls.Reset();
+	PlayerOne.SaturationBoost = 1.0f;
+	TestTrue(TEXT("Changed options are pushed"), SetStreamlineDeepDVCOptionsIfChanged(PlayerOneViewID, MakeStreamlineDeepDVCOptions(PlayerOne)));
+	SetStreamlineDeepDVCOptionsIfChanged(PlayerTwoViewID, MakeStreamlineDeepDVCOptions(PlayerTwo));
+	TestEqual(TEXT("Only the changed view is pushed"), SetOptionsCalls.Num(), StreamlineFilterRedundantSetOptionsCalls() ? 1 : 2);
+
+	// 0 intensity turns DeepDVC off for that view and skips evaluation
+	SetOptionsCalls.Reset();
+	PlayerTwo.Intensity = 0.0f;
+	TestFalse(TEXT("0 intensity is not evaluated"), ShouldEvaluateStreamlineDeepDVC(PlayerTwo));
+	TestTrue(TEXT("Other views are still evaluated"), ShouldEvaluateStreamlineDeepDVC(PlayerOne));
+	SetStreamlineDeepDVCOptionsIfChanged(PlayerTwoViewID, MakeStreamlineDeepDVCOptions(PlayerTwo));
+	if (TestEqual(TEXT("Turning a view off is pushed"), SetOptionsCalls.Num(), 1))
+	{
+		TestTrue(TEXT("0 intensity sets the mode to off"), SetOptionsCalls[0].Value.mode == sl::DeepDVCMode::eOff);
+	}
+
+	// a released viewport gets its options pushed again when it comes back
+	SetOptionsCalls.Reset();
+	ForgetStreamlineDeepDVCOptions(PlayerOneViewID);
+	TestTrue(TEXT("Forgotten view is pushed again"), SetStreamlineDeepDVCOptionsIfChanged(PlayerOneViewID, MakeStreamlineDeepDVCOptions(PlayerOne)));
+	TestEqual(TEXT("Forgotten view is pushed once"), SetOptionsCalls.Num(), 1);
+
+	return true;
+}
+
+#endif
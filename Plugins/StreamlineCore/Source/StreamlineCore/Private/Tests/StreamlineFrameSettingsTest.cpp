@@ -0,0 +1,162 @@
+/*
+* Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// plugin includes
+#include "StreamlineFrameSettings.h"
+
+// engine includes
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "RenderingThread.h"
+
+// This only touches the cvar snapshot, so it runs without a Streamline runtime or NVIDIA GPU
+
+namespace StreamlineFrameSettingsTest
+{
+	static float GetRenderThreadMotionVectorScale()
+	{
+		float MotionVectorScale = 0.0f;
+		ENQUEUE_RENDER_COMMAND(ReadStreamlineFrameSettings)(
+			[&MotionVectorScale](FRHICommandListImmediate& RHICmdList)
+			{
+				MotionVectorScale = GetStreamlineFrameSettings().MotionVectorScale;
+			});
+		FlushRenderingCommands();
+		return MotionVectorScale;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlineFrameSettingsTest, "Nvidia.Streamline.FrameSettings",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FStreamlineFrameSettingsTest::RunTest(const FString& Parameters)
+{
+	using namespace StreamlineFrameSettingsTest;
+
+	IConsoleVariable* CVarMotionVectorScale = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.MotionVectorScale"));
+	if (!TestNotNull(TEXT("Motion vector scale cvar"), CVarMotionVectorScale))
+	{
+		return false;
+	}
+
+	// set and restored at the priority it already has, so the test doesn't pin it to SetByCode
+	const EConsoleVariableFlags OriginalPriority = static_cast<EConsoleVariableFlags>(CVarMotionVectorScale->GetFlags() & ECVF_SetByMask);
+	const float OriginalMotionVectorScale = CVarMotionVectorScale->GetFloat();
+	ON_SCOPE_EXIT
+	{
+		CVarMotionVectorScale->Set(OriginalMotionVectorScale, OriginalPriority);
+		InvalidateStreamlineFrameSettings();
+		CaptureStreamlineFrameSettings();
+		FlushRenderingCommands();
+	};
+
+	InvalidateStreamlineFrameSettings();
+	CaptureStreamlineFrameSettings();
+
+	// the console variable sink only runs once per frame, so the test marks the snapshot dirty itself
+	InvalidateStreamlineFrameSettings();
+	TestFalse(TEXT("Unchanged cvars are no change"), CaptureStreamlineFrameSettings());
+
+	CVarMotionVectorScale->Set(OriginalMotionVectorScale + 1.0f, OriginalPriority);
+	TestFalse(TEXT("Changes are picked up only after an invalidation"), CaptureStreamlineFrameSettings());
+	TestEqual(TEXT("Reading the snapshot doesn't capture"), GetStreamlineFrameSettings().MotionVectorScale, OriginalMotionVectorScale);
+
+	InvalidateStreamlineFrameSettings();
+	TestTrue(TEXT("A changed cvar is a change"), CaptureStreamlineFrameSettings());
+	TestEqual(TEXT("Game thread snapshot holds the new value"), GetStreamlineFrameSettings().MotionVectorScale, OriginalMotionVectorScale + 1.0f);
+	TestEqual(TEXT("Render thread snapshot holds the new value"), GetRenderThreadMotionVectorScale(), OriginalMotionVectorScale + 1.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlineFrameSettingsBenchmark, "Nvidia.Streamline.FrameSettingsBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FStreamlineFrameSettingsBenchmark::RunTest(const FString& Parameters)
+{
+	// the cvars the per view setup and the present callback read, as they read them before the snapshot
+	const TCHAR* const PerViewCVarNames[] =
+	{
+		TEXT("r.Streamline.ViewIndexToTag"), TEXT("r.Streamline.ViewIdOverride"), TEXT("r.Streamline.TagSceneColorWithoutHUD"),
+		TEXT("r.Streamline.TagCustomDepth"), TEXT("r.Streamline.TagVelocities"), TEXT("r.Streamline.DilateMotionVectors"),
+		TEXT("r.Streamline.ClearSceneColorAlpha"), TEXT("r.Streamline.MotionVectorScale"), TEXT("r.Streamline.CustomCameraNearPlane"),
+		TEXT("r.Streamline.CustomCameraFarPlane"), TEXT("r.Streamline.DeepDVC.Enable"), TEXT("r.Streamline.DeepDVC.Intensity"),
+		TEXT("r.Streamline.DeepDVC.SaturationBoost"),
+	};
+
+	TArray<IConsoleVariable*> PerViewCVars;
+	for (const TCHAR* CVarName : PerViewCVarNames)
+	{
+		if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(CVarName))
+		{
+			PerViewCVars.Add(CVar);
+		}
+		else
+		{
+			AddWarning(FString::Printf(TEXT("%s not found, left out of the comparison"), CVarName));
+		}
+	}
+
+	constexpr int32 NumFrames = 10000;
+	constexpr int32 NumViews = 4;
+
+	// before: every view reads every cvar, and so does the present callback for the view index
+	double StartTime = FPlatformTime::Seconds();
+	double CVarSum = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (int32 View = 0; View < NumViews; ++View)
+		{
+			for (IConsoleVariable* CVar : PerViewCVars)
+			{
+				CVarSum += CVar->GetFloat();
+			}
+		}
+		CVarSum += PerViewCVars.Num() ? PerViewCVars[0]->GetInt() : 0;
+	}
+	const double CVarMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumFrames;
+
+	// after: one capture per frame, views and the present callback read the snapshot
+	StartTime = FPlatformTime::Seconds();
+	double SnapshotSum = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		CaptureStreamlineFrameSettings();
+		for (int32 View = 0; View < NumViews + 1; ++View)
+		{
+			const FStreamlineFrameSettings& FrameSettings = GetStreamlineFrameSettings();
+			SnapshotSum += FrameSettings.ViewIndexToTag + FrameSettings.ViewIdOverride + FrameSettings.MotionVectorScale + FrameSettings.CustomCameraNearPlane
+				+ FrameSettings.CustomCameraFarPlane + FrameSettings.DeepDVCIntensity + FrameSettings.DeepDVCSaturationBoost;
+		}
+	}
+	const double SnapshotMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumFrames;
+
+	// a frame that follows a cvar change reads them all once more
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		InvalidateStreamlineFrameSettings();
+		CaptureStreamlineFrameSettings();
+	}
+	const double RecaptureMicroseconds = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumFrames;
+
+	AddInfo(FString::Printf(TEXT("Per frame settings with %d views: %.3f us reading cvars, %.3f us with the snapshot, %.3f us to recapture after a cvar change (sums %.1f, %.1f)"),
+		NumViews, CVarMicroseconds, SnapshotMicroseconds, RecaptureMicroseconds, CVarSum, SnapshotSum));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+* Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+*
+* NVIDIA CORPORATION, its affiliates and licensors retain all intellectual
+* property and proprietary rights in and to this material, related
+* documentation and any modifications thereto. Any use, reproduction,
+* disclosure or distribution of this material and related documentation
+* without an express license agreement from NVIDIA CORPORATION or
+* its affiliates is strictly prohibited.
+*/
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// plugin includes
+#include "StreamlineLatewarpPrivate.h"
+
+// engine includes
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+// The latency source is replaced with a stub, so this runs without a Streamline runtime or NVIDIA GPU
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStreamlineLatewarpAutoModeTest, "Nvidia.Streamline.Latewarp.AutoMode",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FStreamlineLatewarpAutoModeTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* CVarThreshold = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.Latewarp.Auto.RenderLatencyThresholdMs"));
+	IConsoleVariable* CVarHysteresis = IConsoleManager::Get().FindConsoleVariable(TEXT("r.Streamline.Latewarp.Auto.HysteresisMs"));
+	if (!TestNotNull(TEXT("Threshold cvar"), CVarThreshold) || !TestNotNull(TEXT("Hysteresis cvar"), CVarHysteresis))
+	{
+		return false;
+	}
+
+	// set at the priority they already have, so the test doesn't lock out ini or console changes once it's done
+	const float OriginalThreshold = CVarThreshold->GetFloat();
+	const float OriginalHysteresis = CVarHysteresis->GetFloat();
+	const EConsoleVariableFlags ThresholdPriority = static_cast<EConsoleVariableFlags>(CVarThreshold->GetFlags() & ECVF_SetByMask);
+	const EConsoleVariableFlags HysteresisPriority = static_cast<EConsoleVariableFlags>(CVarHysteresis->GetFlags() & ECVF_SetByMask);
+	CVarThreshold->Set(30.0f, ThresholdPriority);
+	CVarHysteresis->Set(5.0f, HysteresisPriority);
+
+	float StubLatencyMs = 0.0f;
+	SetStreamlineLatewarpLatencySource([&StubLatencyMs]() { return StubLatencyMs; });
+	ON_SCOPE_EXIT
+	{
+		SetStreamlineLatewarpLatencySource(nullptr);
+		ResetStreamlineLatewarpAutoMode();
+		CVarThreshold->Set(OriginalThreshold, ThresholdPriority);
+		CVarHysteresis->Set(OriginalHysteresis, HysteresisPriority);
+	};
+
+	// without a latency report there is nothing to base the decision on
+	TestFalse(TEXT("No latency report keeps Latewarp off"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 20.0f;
+	TestFalse(TEXT("Below the threshold"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 30.0f;
+	TestFalse(TEXT("At the threshold"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 31.0f;
+	TestTrue(TEXT("Above the threshold turns on"), UpdateStreamlineLatewarpAutoMode());
+
+	// hovering around the threshold must not flip it every frame
+	StubLatencyMs = 27.0f;
+	TestTrue(TEXT("Within the hysteresis stays on"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 24.0f;
+	TestFalse(TEXT("Below the hysteresis turns off"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 27.0f;
+	TestFalse(TEXT("Within the hysteresis stays off"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 40.0f;
+	TestTrue(TEXT("Turns on again"), UpdateStreamlineLatewarpAutoMode());
+
+	StubLatencyMs = 0.0f;
+	TestFalse(TEXT("Losing the latency report turns off"), UpdateStreamlineLatewarpAutoMode());
+
+	// the gate on its own counts transitions for the stats
+	FStreamlineLatewarpAutoGate Gate;
+	const float Samples[] = { 10.0f, 35.0f, 29.0f, 35.0f, 20.0f, 20.0f };
+	for (const float Sample : Samples)
+	{
+		Gate.Update(Sample, 30.0f, 5.0f);
+	}
+	TestEqual(TEXT("Transitions"), Gate.GetNumTransitions(), 2u);
+	TestFalse(TEXT("Ends off"), Gate.IsActive());
+
+	return true;
+}
+
+#endif
@@ -31,6 +31,7 @@ class FRHICommandListImmediate;
 struct FRHIStreamlineArguments;
 class FSceneViewFamily;
 class FRDGBuilder;
-void AddStreamlineDLSSGStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect);
+class FStreamlineTagCollector;
+void AddStreamlineDLSSGState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect);
 void BeginRenderViewFamilyDLSSG(FSceneViewFamily& InViewFamily);
 void GetDLSSGStatusFromStreamline(bool bQueryOncePerAppLifetimeValues = false);
\ No newline at end of file
@@ -20,13 +20,37 @@ bool IsDeepDVCActive();
 extern STREAMLINECORE_API Streamline::EStreamlineFeatureSupport QueryStreamlineDeepDVCSupport();
 extern STREAMLINECORE_API bool IsStreamlineDeepDVCSupported();
 
+// Per view DeepDVC parameters. Views are identified by their index in the view family, same as r.Streamline.ViewIndexToTag (e.g. the split screen player).
+// Views without parameters set use r.Streamline.DeepDVC.Intensity and r.Streamline.DeepDVC.SaturationBoost
+// An intensity of 0 turns DeepDVC off for that view and skips its evaluate pass
+struct FStreamlineDeepDVCViewParameters
+{
+	float Intensity = 0.5f;
+	float SaturationBoost = 0.5f;
+};
+
+// game thread
+extern STREAMLINECORE_API void SetStreamlineDeepDVCViewParameters(int32 ViewIndex, const FStreamlineDeepDVCViewParameters& Parameters);
+// game thread, INDEX_NONE clears the parameters of all views
+extern STREAMLINECORE_API void ClearStreamlineDeepDVCViewParameters(int32 ViewIndex);
+// game thread, returns false if the view uses the cvars
+extern STREAMLINECORE_API bool GetStreamlineDeepDVCViewParameters(int32 ViewIndex, FStreamlineDeepDVCViewParameters& OutParameters);
+
+// render thread, falls back to the cvars
+FStreamlineDeepDVCViewParameters GetStreamlineDeepDVCViewParameters_RenderThread(int32 ViewIndex);
+
+inline bool ShouldEvaluateStreamlineDeepDVC(const FStreamlineDeepDVCViewParameters& Parameters)
+{
+	return Parameters.Intensity > 0.0f;
+}
 
 
 class FRHICommandListImmediate;
 struct FRHIStreamlineArguments;
 class FSceneViewFamily;
 class FRDGBuilder;
-void AddStreamlineDeepDVCStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect);
+class FStreamlineTagCollector;
+void AddStreamlineDeepDVCState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect, const FStreamlineDeepDVCViewParameters& Parameters);
 void AddStreamlineDeepDVCEvaluateRenderPass(FStreamlineRHI* StreamlineRHIExtensions, FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect, FRDGTextureRef SLSceneColorWithoutHUD);
 void BeginRenderViewFamilyDeepDVC(FSceneViewFamily& InViewFamily);
 void GetDeepDVCStatusFromStreamline();
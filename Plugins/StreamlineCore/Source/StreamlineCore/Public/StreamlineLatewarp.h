@@ -22,9 +22,9 @@ class FRHICommandListImmediate;
 struct FRHIStreamlineArguments;
 class FSceneViewFamily;
 class FRDGBuilder;
+class FStreamlineTagCollector;
 
 extern STREAMLINECORE_API Streamline::EStreamlineFeatureSupport QueryStreamlineLatewarpSupport();
 extern STREAMLINECORE_API bool IsStreamlineLatewarpSupported();
-void RegisterStreamlineLatewarpHooks(FStreamlineRHI* InStreamlineRHI);
-void UnregisterStreamlineLatewarpHooks();
-void AddStreamlineLatewarpStateRenderPass(FRDGBuilder& GraphBuilder, uint32 ViewID, const FIntRect& SecondaryViewRect);
+void BeginRenderViewFamilyLatewarp(FSceneViewFamily& InViewFamily);
+void AddStreamlineLatewarpState(FStreamlineTagCollector& TagCollector, uint32 ViewID, const FIntRect& SecondaryViewRect);
@@ -610,7 +610,8 @@ void FStreamlineD3D12RHIModule::StartupModule()
 		if ((GDynamicRHI != nullptr) && (RHIGetInterfaceType() == ERHIInterfaceType::D3D12))
 		{
 			FStreamlineRHIModule& StreamlineRHIModule = FModuleManager::LoadModuleChecked<FStreamlineRHIModule>(TEXT("StreamlineRHI"));
-			if (AreStreamlineFunctionsLoaded())
+			// InitializeStreamline waits for the interposer if it's still loading, after preparing everything that doesn't need it
+			if (AreStreamlineFunctionsLoadedOrLoading())
 			{
 				StreamlineRHIModule.InitializeStreamline();
 				if (IsStreamlineSupported())
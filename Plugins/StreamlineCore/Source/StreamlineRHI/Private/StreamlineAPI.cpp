@@ -16,11 +16,15 @@
 #include "HAL/IConsoleManager.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/ThreadManager.h"
+#include "Misc/ScopeLock.h"
+#include "Async/Async.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #include "sl.h"
 #include "sl_helpers.h"
 
+#include <atomic>
+
 #define LOCTEXT_NAMESPACE "FStreamlineRHIModule"
 
 #ifndef LOG_SL_FUNCTIONS
@@ -159,6 +163,12 @@ namespace
 	PFun_slSetD3DDevice* Ptr_setD3DDevice = nullptr;
 
 	bool bIsStreamlineFunctionPointersLoaded = false;
+
+	// set on the game thread while the interposer gets verified and loaded on a worker thread, see LoadStreamlineFunctionPointersAsync.
+	// Any thread can ask whether the functions are loaded, the first one to get the lock joins the worker and clears it
+	std::atomic<bool> bIsStreamlineFunctionPointersLoadPending{ false };
+	FCriticalSection StreamlineFunctionPointersLoadSection;
+	TFuture<bool> StreamlineFunctionPointersLoadFuture;
 }
 
 FString CurrentThreadName()
@@ -208,11 +218,36 @@ FString CurrentThreadName()
 #endif
  }
 
-STREAMLINERHI_API bool AreStreamlineFunctionsLoaded()
+static bool WaitForStreamlineFunctionPointers()
 {
+	if (bIsStreamlineFunctionPointersLoadPending)
+	{
+		// threads arriving while another one waits block on the lock, then see the flag cleared
+		FScopeLock Lock(&StreamlineFunctionPointersLoadSection);
+		if (bIsStreamlineFunctionPointersLoadPending)
+		{
+			const double WaitStartTime = FPlatformTime::Seconds();
+			StreamlineFunctionPointersLoadFuture.Wait();
+			bIsStreamlineFunctionPointersLoadPending = false;
+
+			UE_LOG(LogStreamlineRHI, Log, TEXT("Waited %.2f ms for the Streamline interposer to be verified and loaded on %s"), (FPlatformTime::Seconds() - WaitStartTime) * 1000.0, *CurrentThreadName());
+		}
+	}
+
 	return bIsStreamlineFunctionPointersLoaded;
 }
 
+STREAMLINERHI_API bool AreStreamlineFunctionsLoaded()
+{
+	// the first call after LoadStreamlineFunctionPointersAsync joins the worker
+	return WaitForStreamlineFunctionPointers();
+}
+
+STREAMLINERHI_API bool AreStreamlineFunctionsLoadedOrLoading()
+{
+	return bIsStreamlineFunctionPointersLoadPending || bIsStreamlineFunctionPointersLoaded;
+}
+
 
 sl::Result SLinit(const sl::Preferences& pref, uint64_t sdkVersion)
 {
@@ -669,78 +704,78 @@ bool LoadStreamlineFunctionPointers(const FString& InterposerBinaryPath)
 				return false;
 			}
 
-			Ptr_init = (PFun_slInit*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slInit")));
+			Ptr_init = (PFun_slInit*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slInit")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slInit = %p"), Ptr_init);
 			check(Ptr_init);
 
-			Ptr_shutdown = (PFun_slShutdown*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slShutdown")));
+			Ptr_shutdown = (PFun_slShutdown*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slShutdown")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slShutdown = %p"), Ptr_shutdown);
 			check(Ptr_shutdown);
 
-			Ptr_isFeatureSupported = (PFun_slIsFeatureSupported*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slIsFeatureSupported")));
+			Ptr_isFeatureSupported = (PFun_slIsFeatureSupported*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slIsFeatureSupported")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slIsFeatureSupported = %p"), Ptr_isFeatureSupported);
 			check(Ptr_isFeatureSupported);
 
-			Ptr_isFeatureLoaded = (PFun_slIsFeatureLoaded*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slIsFeatureLoaded")));
+			Ptr_isFeatureLoaded = (PFun_slIsFeatureLoaded*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slIsFeatureLoaded")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slIsFeatureLoaded = %p"), Ptr_isFeatureLoaded);
 			check(Ptr_isFeatureLoaded);
 
-			Ptr_setFeatureLoaded = (PFun_slSetFeatureLoaded*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetFeatureLoaded")));
+			Ptr_setFeatureLoaded = (PFun_slSetFeatureLoaded*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetFeatureLoaded")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slSetFeatureLoaded = %p"), Ptr_setFeatureLoaded);
 			check(Ptr_setFeatureLoaded);
 
-			Ptr_evaluateFeature = (PFun_slEvaluateFeature*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slEvaluateFeature")));
+			Ptr_evaluateFeature = (PFun_slEvaluateFeature*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slEvaluateFeature")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slEvaluateFeature = %p"), Ptr_evaluateFeature);
 			check(Ptr_evaluateFeature);
 
-			Ptr_allocateResources = (PFun_slAllocateResources*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slAllocateResources")));
+			Ptr_allocateResources = (PFun_slAllocateResources*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slAllocateResources")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slAllocateResources = %p"), Ptr_allocateResources);
 			check(Ptr_allocateResources);
 
-			Ptr_freeResources = (PFun_slFreeResources*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slFreeResources")));
+			Ptr_freeResources = (PFun_slFreeResources*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slFreeResources")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slFreeResources = %p"), Ptr_freeResources);
 			check(Ptr_freeResources);
 
 			// we are selectively disabling those warnings since we want the ability to use the deprecated API since the new one is risky
 			SL_DISABLE_DEPRECATED_WARNINGS
-			Ptr_setTag = (PFun_slSetTag*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetTag")));
+			Ptr_setTag = (PFun_slSetTag*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetTag")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slSetTag = %p"), Ptr_setTag);
 			check(Ptr_setTag);
 			SL_RESTORE_DEPRECATED_WARNINGS
 			
-			Ptr_setTagForFrame = (PFun_slSetTagForFrame*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetTagForFrame")));
+			Ptr_setTagForFrame = (PFun_slSetTagForFrame*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetTagForFrame")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slSetTagForFrame = %p"), Ptr_setTagForFrame);
 			check(Ptr_setTagForFrame);
 
-			Ptr_getFeatureRequirements = (PFun_slGetFeatureRequirements*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureRequirements")));
+			Ptr_getFeatureRequirements = (PFun_slGetFeatureRequirements*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureRequirements")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slGetFeatureRequirements = %p"), Ptr_getFeatureRequirements);
 			check(Ptr_getFeatureRequirements);
 
-			Ptr_getFeatureVersion = (PFun_slGetFeatureVersion*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureVersion")));
+			Ptr_getFeatureVersion = (PFun_slGetFeatureVersion*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureVersion")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slGetFeatureVersion = %p"), Ptr_getFeatureVersion);
 			check(Ptr_getFeatureVersion);
 
-			Ptr_upgradeInterface = (PFun_slUpgradeInterface*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slUpgradeInterface")));
+			Ptr_upgradeInterface = (PFun_slUpgradeInterface*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slUpgradeInterface")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slUpgradeInterface = %p"), Ptr_upgradeInterface);
 			check(Ptr_upgradeInterface);
 
-			Ptr_setConstants = (PFun_slSetConstants*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetConstants")));
+			Ptr_setConstants = (PFun_slSetConstants*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetConstants")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slSetConstants = %p"), Ptr_setConstants);
 			check(Ptr_setConstants);
 
-			Ptr_getNativeInterface = (PFun_slGetNativeInterface*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetNativeInterface")));
+			Ptr_getNativeInterface = (PFun_slGetNativeInterface*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetNativeInterface")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slGetNativeInterface = %p"), Ptr_getNativeInterface);
 			check(Ptr_getNativeInterface);
 
-			Ptr_getFeatureFunction = (PFun_slGetFeatureFunction*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureFunction")));
+			Ptr_getFeatureFunction = (PFun_slGetFeatureFunction*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetFeatureFunction")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slGetFeatureFunction = %p"), Ptr_getFeatureFunction);
 			check(Ptr_getFeatureFunction);
 
-			Ptr_getNewFrameToken = (PFun_slGetNewFrameToken*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetNewFrameToken")));
+			Ptr_getNewFrameToken = (PFun_slGetNewFrameToken*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slGetNewFrameToken")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slGetNewFrameToken = %p"), Ptr_getNewFrameToken);
 			check(Ptr_getNewFrameToken);
 
-			Ptr_setD3DDevice = (PFun_slSetD3DDevice*)(FWindowsPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetD3DDevice")));
+			Ptr_setD3DDevice = (PFun_slSetD3DDevice*)(FPlatformProcess::GetDllExport(SLInterPoserDLL, TEXT("slSetD3DDevice")));
 			UE_LOG(LogStreamlineRHI, Log, TEXT("slSetD3DDevice = %p"), Ptr_setD3DDevice);
 			check(Ptr_setD3DDevice);
 
@@ -751,5 +786,24 @@ bool LoadStreamlineFunctionPointers(const FString& InterposerBinaryPath)
 	return bIsStreamlineFunctionPointersLoaded;
 }
 
+void LoadStreamlineFunctionPointersAsync(const FString& InterposerBinaryPath)
+{
+	check(IsInGameThread());
+	check(!bIsStreamlineFunctionPointersLoadPending);
+
+	if (bIsStreamlineFunctionPointersLoaded)
+	{
+		return;
+	}
+
+	// verifying the signature can take a while (certificate revocation checks), so do that and the DLL loading on a worker while the
+	// D3D RHI module loads. Everything that needs the function pointers goes through AreStreamlineFunctionsLoaded, which waits
+	bIsStreamlineFunctionPointersLoadPending = true;
+	StreamlineFunctionPointersLoadFuture = Async(EAsyncExecution::Thread, [InterposerBinaryPath]()
+	{
+		return LoadStreamlineFunctionPointers(InterposerBinaryPath);
+	});
+}
+
 #undef LOCTEXT_NAMESPACE
 
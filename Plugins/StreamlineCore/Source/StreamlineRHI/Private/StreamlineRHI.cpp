@@ -1159,6 +1159,12 @@ void FStreamlineRHIModule::InitializeStreamline()
 
 	FStreamlineRHI::FeaturesRequestedAtSLInitTime = Features;
 
+	// all of the above didn't need the interposer yet, so this is where we wait for it if it's still loading
+	if (!AreStreamlineFunctionsLoaded())
+	{
+		UE_LOG(LogStreamlineRHI, Error, TEXT("Failed to load the Streamline interposer, skipping Streamline init"));
+		return;
+	}
 
 	sl::Result Result = SLinit(Preferences);
 	if (Result == sl::Result::eOk)
@@ -1259,7 +1265,16 @@ void FStreamlineRHIModule::StartupModule()
 		);
 
 		const FString StreamlineInterposerBinaryPath = FPaths::Combine(*StreamlineBinaryDirectory, STREAMLINE_INTERPOSER_BINARY_NAME);
-		LoadStreamlineFunctionPointers(StreamlineInterposerBinaryPath);
+		// opt-in, the RHI below still gets created right away so its swap chain provider is registered before any viewport exists.
+		// The worker only overlaps loading the D3D RHI module and InitializeStreamline's setup, which waits for it before slInit
+		if (FParse::Param(FCommandLine::Get(), TEXT("slasyncload")))
+		{
+			LoadStreamlineFunctionPointersAsync(StreamlineInterposerBinaryPath);
+		}
+		else
+		{
+			LoadStreamlineFunctionPointers(StreamlineInterposerBinaryPath);
+		}
 	}
 	else
 	{
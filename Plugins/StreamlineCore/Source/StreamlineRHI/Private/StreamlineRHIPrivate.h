@@ -17,6 +17,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogStreamlineRHI, Log, All);
 bool slVerifyEmbeddedSignature(const FString& PathToBinary);
 
 bool LoadStreamlineFunctionPointers(const FString& InterposerBinaryPath);
+void LoadStreamlineFunctionPointersAsync(const FString& InterposerBinaryPath);
 void SetStreamlineAPILoggingEnabled(bool bEnabled);
 
 
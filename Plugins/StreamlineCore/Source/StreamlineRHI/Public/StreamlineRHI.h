@@ -345,6 +345,8 @@ STREAMLINERHI_API FStreamlineRHI* GetPlatformStreamlineRHI();
 STREAMLINERHI_API EStreamlineSupport GetPlatformStreamlineSupport();
 STREAMLINERHI_API bool IsStreamlineSupported();
 STREAMLINERHI_API bool AreStreamlineFunctionsLoaded();
+// true while the interposer is still being loaded asynchronously, without waiting for it
+STREAMLINERHI_API bool AreStreamlineFunctionsLoadedOrLoading();
 
 STREAMLINERHI_API sl::FeatureRequirementFlags PlatformGetAllImplementedStreamlineRHIs();
 
@@ -289,6 +289,52 @@ STREAMLINEDEEPDVCBLUEPRINT_API float UStreamlineLibraryDeepDVC::GetDeepDVCSatura
 	return  0.0f;
 }
 
+STREAMLINEDEEPDVCBLUEPRINT_API void UStreamlineLibraryDeepDVC::SetDeepDVCViewParameters(int32 ViewIndex, float Intensity, float SaturationBoost)
+{
+	TRY_INIT_STREAMLINE_DEEPDVC_LIBRARY_AND_RETURN(void());
+
+#if WITH_STREAMLINE
+	if (ViewIndex < 0)
+	{
+		UE_LOG(LogStreamlineDeepDVCBlueprint, Error, TEXT("%s called with invalid ViewIndex %d"), ANSI_TO_TCHAR(__FUNCTION__), ViewIndex);
+		return;
+	}
+
+	// Quantize the same way as the console variables so a slider can snap to 0, which turns off DeepDVC for that view
+	FStreamlineDeepDVCViewParameters Parameters;
+	Parameters.Intensity = FMath::RoundToFloat(Intensity * 100.0f) / 100.0f;
+	Parameters.SaturationBoost = FMath::RoundToFloat(SaturationBoost * 100.0f) / 100.0f;
+	SetStreamlineDeepDVCViewParameters(ViewIndex, Parameters);
+#endif
+}
+
+STREAMLINEDEEPDVCBLUEPRINT_API void UStreamlineLibraryDeepDVC::ClearDeepDVCViewParameters(int32 ViewIndex)
+{
+	TRY_INIT_STREAMLINE_DEEPDVC_LIBRARY_AND_RETURN(void());
+
+#if WITH_STREAMLINE
+	ClearStreamlineDeepDVCViewParameters(ViewIndex < 0 ? INDEX_NONE : ViewIndex);
+#endif
+}
+
+STREAMLINEDEEPDVCBLUEPRINT_API bool UStreamlineLibraryDeepDVC::GetDeepDVCViewParameters(int32 ViewIndex, float& Intensity, float& SaturationBoost)
+{
+	Intensity = 0.0f;
+	SaturationBoost = 0.0f;
+
+	TRY_INIT_STREAMLINE_DEEPDVC_LIBRARY_AND_RETURN(false);
+
+#if WITH_STREAMLINE
+	FStreamlineDeepDVCViewParameters Parameters;
+	const bool bHasOverride = GetStreamlineDeepDVCViewParameters(ViewIndex, Parameters);
+	Intensity = Parameters.Intensity;
+	SaturationBoost = Parameters.SaturationBoost;
+	return bHasOverride;
+#else
+	return false;
+#endif
+}
+
 #if WITH_STREAMLINE
 
 // Delayed initialization, which allows this module to be available early so blueprints can be loaded before DLSS is available in PostEngineInit
@@ -93,6 +93,18 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Streamline|DeepDVC", meta = (DisplayName = "Get DeepDVC Saturation Boost"))
 	static UE_API float GetDeepDVCSaturationBoost();
 
+	/* Overrides the DeepDVC intensity and saturation boost for a single view, e.g. a split screen player. ViewIndex is the index of the view in its view family. An intensity of 0 turns DeepDVC off for that view only */
+	UFUNCTION(BlueprintCallable, Category = "Streamline|DeepDVC", meta = (DisplayName = "Set DeepDVC View Parameters"))
+	static UE_API void SetDeepDVCViewParameters(int32 ViewIndex, float Intensity, float SaturationBoost);
+
+	/* Makes the view use the console variables again. A ViewIndex of -1 clears the overrides of all views */
+	UFUNCTION(BlueprintCallable, Category = "Streamline|DeepDVC", meta = (DisplayName = "Clear DeepDVC View Parameters"))
+	static UE_API void ClearDeepDVCViewParameters(int32 ViewIndex);
+
+	/* Reads the DeepDVC parameters used for a view. Returns false if the view has no override and uses the console variables */
+	UFUNCTION(BlueprintPure, Category = "Streamline|DeepDVC", meta = (DisplayName = "Get DeepDVC View Parameters"))
+	static UE_API bool GetDeepDVCViewParameters(int32 ViewIndex, float& Intensity, float& SaturationBoost);
+
 
 
 
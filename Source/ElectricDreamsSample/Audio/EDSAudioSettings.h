@@ -7,6 +7,18 @@
 
 #include "EDSAudioSettings.generated.h"
 
+/** A control bus mix that can be switched to at runtime by name */
+USTRUCT()
+struct FEDSNamedControlBusMix
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = MixSettings)
+	FName Name;
+
+	UPROPERTY(EditAnywhere, Category = MixSettings, meta = (AllowedClasses = "/Script/AudioModulation.SoundControlBusMix"))
+	FSoftObjectPath Mix;
+};
 
 /**
  *
@@ -24,4 +36,12 @@ public:
 	/** The Live Control Bus Mix */
 	UPROPERTY(config, EditAnywhere, Category = MixSettings, meta = (AllowedClasses = "/Script/AudioModulation.SoundControlBusMix"))
 	FSoftObjectPath LiveControlBusMix;
+
+	/** Mixes that can be switched between at runtime with ElectricDreams.Audio.ActivateMix, only one of them is active at a time */
+	UPROPERTY(config, EditAnywhere, Category = MixSettings)
+	TArray<FEDSNamedControlBusMix> NamedControlBusMixes;
+
+	/** Named mix activated when a world begins play, None for no named mix */
+	UPROPERTY(config, EditAnywhere, Category = MixSettings)
+	FName InitialNamedControlBusMix;
 };
\ No newline at end of file
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSMixLibrarySubsystem.h"
+#include "EDSAudioSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "SoundControlBusMix.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSMixLibrarySubsystem)
+
+void UEDSMixLibrarySubsystem::Deinitialize()
+{
+	if (LoadHandle.IsValid())
+	{
+		LoadHandle->ReleaseHandle();
+		LoadHandle.Reset();
+	}
+	PendingCallbacks.Reset();
+
+	Super::Deinitialize();
+}
+
+void UEDSMixLibrarySubsystem::RequestMixes(const UEDSAudioSettings& Settings, FSimpleDelegate OnLoaded)
+{
+	if (bMixesResolved)
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	PendingCallbacks.Add(MoveTemp(OnLoaded));
+	if (bMixesRequested)
+	{
+		return;
+	}
+	bMixesRequested = true;
+
+	DefaultMixPath = Settings.DefaultControlBusMix;
+	LiveMixPath = Settings.LiveControlBusMix;
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	PathsToLoad.Add(DefaultMixPath);
+	PathsToLoad.Add(LiveMixPath);
+	for (const FEDSNamedControlBusMix& NamedMix : Settings.NamedControlBusMixes)
+	{
+		NamedMixPaths.Emplace(NamedMix.Name, NamedMix.Mix);
+		PathsToLoad.Add(NamedMix.Mix);
+	}
+	PathsToLoad.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+
+	if (PathsToLoad.IsEmpty())
+	{
+		ResolveLoadedMixes();
+		return;
+	}
+
+	LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		PathsToLoad,
+		FStreamableDelegate::CreateUObject(this, &UEDSMixLibrarySubsystem::ResolveLoadedMixes),
+		FStreamableManager::AsyncLoadHighPriority,
+		true
+	);
+
+	if (!LoadHandle.IsValid())
+	{
+		// nothing could be requested, resolve whatever is in memory
+		ResolveLoadedMixes();
+	}
+}
+
+void UEDSMixLibrarySubsystem::WaitForMixes()
+{
+	if (LoadHandle.IsValid() && !bMixesResolved)
+	{
+		LoadHandle->WaitUntilComplete();
+		ResolveLoadedMixes();
+	}
+}
+
+USoundControlBusMix* UEDSMixLibrarySubsystem::GetNamedMix(FName Name) const
+{
+	const TObjectPtr<USoundControlBusMix>* Mix = NamedMixes.Find(Name);
+	return Mix ? Mix->Get() : nullptr;
+}
+
+void UEDSMixLibrarySubsystem::GetNamedMixNames(TArray<FName>& OutNames) const
+{
+	NamedMixes.GenerateKeyArray(OutNames);
+}
+
+void UEDSMixLibrarySubsystem::ResolveLoadedMixes()
+{
+	if (bMixesResolved)
+	{
+		return;
+	}
+	bMixesResolved = true;
+
+	DefaultMix = Cast<USoundControlBusMix>(DefaultMixPath.ResolveObject());
+	ensureMsgf(DefaultMix || DefaultMixPath.IsNull(), TEXT("Default Control Bus Mix %s from EDS Audio Settings failed to load."), *DefaultMixPath.ToString());
+
+	LiveMix = Cast<USoundControlBusMix>(LiveMixPath.ResolveObject());
+	ensureMsgf(LiveMix || LiveMixPath.IsNull(), TEXT("Live Control Bus Mix %s from EDS Audio Settings failed to load."), *LiveMixPath.ToString());
+
+	for (const TPair<FName, FSoftObjectPath>& NamedMixPath : NamedMixPaths)
+	{
+		if (USoundControlBusMix* Mix = Cast<USoundControlBusMix>(NamedMixPath.Value.ResolveObject()))
+		{
+			NamedMixes.Add(NamedMixPath.Key, Mix);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Named Control Bus Mix %s (%s) from EDS Audio Settings failed to load."), *NamedMixPath.Key.ToString(), *NamedMixPath.Value.ToString());
+		}
+	}
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/EngineSubsystem.h"
+
+#include "EDSMixLibrarySubsystem.generated.h"
+
+class UEDSAudioSettings;
+class USoundControlBusMix;
+struct FStreamableHandle;
+
+/**
+ * Loads the control bus mixes of the EDS Audio Settings asynchronously and keeps them resident for the
+ * lifetime of the engine, so worlds don't block on audio assets and map travel doesn't reload them.
+ */
+UCLASS()
+class ELECTRICDREAMSSAMPLE_API UEDSMixLibrarySubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// USubsystem implementation Begin
+	virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	/**
+	 * Starts loading the mixes of the given settings if that didn't happen yet. OnLoaded runs once they are
+	 * resident, right away if they already are.
+	 */
+	void RequestMixes(const UEDSAudioSettings& Settings, FSimpleDelegate OnLoaded);
+
+	/** Blocks until a pending load has finished */
+	void WaitForMixes();
+
+	bool HasLoadedMixes() const { return bMixesResolved; }
+
+	USoundControlBusMix* GetDefaultMix() const { return DefaultMix; }
+	USoundControlBusMix* GetLiveMix() const { return LiveMix; }
+	USoundControlBusMix* GetNamedMix(FName Name) const;
+	void GetNamedMixNames(TArray<FName>& OutNames) const;
+
+private:
+	void ResolveLoadedMixes();
+
+	UPROPERTY(Transient)
+	TObjectPtr<USoundControlBusMix> DefaultMix = nullptr;
+
+	UPROPERTY(Transient)
+	TObjectPtr<USoundControlBusMix> LiveMix = nullptr;
+
+	UPROPERTY(Transient)
+	TMap<FName, TObjectPtr<USoundControlBusMix>> NamedMixes;
+
+	FSoftObjectPath DefaultMixPath;
+	FSoftObjectPath LiveMixPath;
+	TArray<TPair<FName, FSoftObjectPath>> NamedMixPaths;
+
+	TSharedPtr<FStreamableHandle> LoadHandle;
+	TArray<FSimpleDelegate> PendingCallbacks;
+	bool bMixesRequested = false;
+	bool bMixesResolved = false;
+};
@@ -2,17 +2,38 @@
 
 #include "EDSMixManagerSubsystem.h"
 #include "EDSAudioSettings.h"
+#include "EDSMixLibrarySubsystem.h"
+#include "Engine/Engine.h"
 #include "Engine/World.h"
 #include "UObject/Object.h"
 #include "SoundControlBus.h"
 #include "SoundControlBusMix.h"
 #include "AudioModulationStatics.h"
+#include "HAL/IConsoleManager.h"
 
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EDSMixManagerSubsystem)
 
 class FSubsystemCollectionBase;
 
+static FAutoConsoleCommandWithWorldAndArgs CmdActivateNamedMix(
+	TEXT("ElectricDreams.Audio.ActivateMix"),
+	TEXT("Switches to a named control bus mix of the EDS Audio Settings. No argument deactivates the current named mix"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UEDSMixManagerSubsystem* MixManager = World ? World->GetSubsystem<UEDSMixManagerSubsystem>() : nullptr;
+		if (MixManager == nullptr)
+		{
+			return;
+		}
+
+		const FName MixName = Args.IsEmpty() ? NAME_None : FName(*Args[0]);
+		if (!MixManager->ActivateNamedMix(MixName))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Named Control Bus Mix %s is not in the EDS Audio Settings."), *MixName.ToString());
+		}
+	}));
+
 void UEDSMixManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -43,30 +64,15 @@ void UEDSMixManagerSubsystem::PostInitialize()
 {
 	Super::PostInitialize();
 
+	ActiveNamedMixName = NAME_None;
 	if (const UEDSAudioSettings* EDSAudioSettings = GetDefault<UEDSAudioSettings>())
 	{
-		if (UObject* ObjPath = EDSAudioSettings->DefaultControlBusMix.TryLoad())
-		{
-			if (USoundControlBusMix* SoundControlBusMix = Cast<USoundControlBusMix>(ObjPath))
-			{
-				DefaultBaseMix = SoundControlBusMix;
-			}
-			else
-			{
-				ensureMsgf(SoundControlBusMix, TEXT("Default Control Bus Mix reference missing from EDS Audio Settings."));
-			}
-		}
+		ActiveNamedMixName = EDSAudioSettings->InitialNamedControlBusMix;
 
-		if (UObject* ObjPath = EDSAudioSettings->LiveControlBusMix.TryLoad())
+		// The library keeps the mixes resident, so only the first world pays for the load and nothing blocks on it
+		if (UEDSMixLibrarySubsystem* MixLibrary = GEngine ? GEngine->GetEngineSubsystem<UEDSMixLibrarySubsystem>() : nullptr)
 		{
-			if (USoundControlBusMix* SoundControlBusMix = Cast<USoundControlBusMix>(ObjPath))
-			{
-				LiveMix = SoundControlBusMix;
-			}
-			else
-			{
-				ensureMsgf(SoundControlBusMix, TEXT("Live Control Bus Mix reference missing from EDS Audio Settings."));
-			}
+			MixLibrary->RequestMixes(*EDSAudioSettings, FSimpleDelegate::CreateUObject(this, &UEDSMixManagerSubsystem::OnMixesLoaded));
 		}
 	}
 }
@@ -75,18 +81,103 @@ void UEDSMixManagerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
 	Super::OnWorldBeginPlay(InWorld);
 
-	if (const UWorld* World = InWorld.GetWorld())
+	bWorldBegunPlay = true;
+	TryActivateMixes();
+}
+
+bool UEDSMixManagerSubsystem::ActivateNamedMix(FName MixName)
+{
+	USoundControlBusMix* NewMix = nullptr;
+	if (!MixName.IsNone())
+	{
+		const UEDSMixLibrarySubsystem* MixLibrary = GEngine ? GEngine->GetEngineSubsystem<UEDSMixLibrarySubsystem>() : nullptr;
+		if (MixLibrary == nullptr || !MixLibrary->HasLoadedMixes())
+		{
+			// Picked up by TryActivateMixes once the library has loaded
+			ActiveNamedMixName = MixName;
+			return true;
+		}
+
+		NewMix = MixLibrary->GetNamedMix(MixName);
+		if (NewMix == nullptr)
+		{
+			return false;
+		}
+	}
+
+	ActiveNamedMixName = MixName;
+	if (!bMixesActivated || NewMix == ActiveNamedMix)
 	{
-		// Activate the default base mix
-		if (DefaultBaseMix)
+		return true;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		if (ActiveNamedMix)
 		{
-			UAudioModulationStatics::ActivateBusMix(World, DefaultBaseMix);
+			UAudioModulationStatics::DeactivateBusMix(World, ActiveNamedMix);
 		}
 
-		// Activate the live mix
-		if (LiveMix)
+		if (NewMix)
+		{
+			UAudioModulationStatics::ActivateBusMix(World, NewMix);
+		}
+	}
+	ActiveNamedMix = NewMix;
+
+	return true;
+}
+
+void UEDSMixManagerSubsystem::OnMixesLoaded()
+{
+	if (const UEDSMixLibrarySubsystem* MixLibrary = GEngine ? GEngine->GetEngineSubsystem<UEDSMixLibrarySubsystem>() : nullptr)
+	{
+		DefaultBaseMix = MixLibrary->GetDefaultMix();
+		LiveMix = MixLibrary->GetLiveMix();
+	}
+
+	bMixesLoaded = true;
+	TryActivateMixes();
+}
+
+void UEDSMixManagerSubsystem::TryActivateMixes()
+{
+	if (!bMixesLoaded || !bWorldBegunPlay || bMixesActivated)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+	bMixesActivated = true;
+
+	// Activate the default base mix
+	if (DefaultBaseMix)
+	{
+		UAudioModulationStatics::ActivateBusMix(World, DefaultBaseMix);
+	}
+
+	// Activate the live mix
+	if (LiveMix)
+	{
+		UAudioModulationStatics::ActivateBusMix(World, LiveMix);
+	}
+
+	// Activate the named mix requested so far
+	if (const UEDSMixLibrarySubsystem* MixLibrary = GEngine->GetEngineSubsystem<UEDSMixLibrarySubsystem>())
+	{
+		ActiveNamedMix = MixLibrary->GetNamedMix(ActiveNamedMixName);
+		if (ActiveNamedMix)
+		{
+			UAudioModulationStatics::ActivateBusMix(World, ActiveNamedMix);
+		}
+		else if (!ActiveNamedMixName.IsNone())
 		{
-			UAudioModulationStatics::ActivateBusMix(World, LiveMix);
+			UE_LOG(LogTemp, Warning, TEXT("Named Control Bus Mix %s is not in the EDS Audio Settings."), *ActiveNamedMixName.ToString());
+			ActiveNamedMixName = NAME_None;
 		}
 	}
 }
@@ -32,10 +32,21 @@ public:
 	/** Called when world is ready to start gameplay before the game mode transitions to the correct state and call BeginPlay on all actors */
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
+	/** Switches to one of the named mixes of the EDS Audio Settings, None deactivates the current one. Returns false for unknown names */
+	bool ActivateNamedMix(FName MixName);
+
+	FName GetActiveNamedMix() const { return ActiveNamedMixName; }
+
 protected:
 	// Called when determining whether to create this Subsystem
 	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
 
+	// Called by the mix library once the mixes are resident
+	void OnMixesLoaded();
+
+	// Activates the mixes once they are loaded and the world has begun play
+	void TryActivateMixes();
+
 	// Default Sound Control Bus Mix retrieved from the EDS Audio Settings
 	UPROPERTY(Transient)
 	TObjectPtr<USoundControlBusMix> DefaultBaseMix = nullptr;
@@ -44,4 +55,14 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<USoundControlBusMix> LiveMix = nullptr;
 
+	// Currently active named mix
+	UPROPERTY(Transient)
+	TObjectPtr<USoundControlBusMix> ActiveNamedMix = nullptr;
+
+	FName ActiveNamedMixName;
+
+	bool bMixesLoaded = false;
+	bool bWorldBegunPlay = false;
+	bool bMixesActivated = false;
+
 };
\ No newline at end of file
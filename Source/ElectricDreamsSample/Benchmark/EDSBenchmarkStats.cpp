@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSBenchmarkStats.h"
+
+namespace EDSBenchmarkStats
+{
+	static FString EscapeJson(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+	}
+}
+
+FEDSBenchmarkSegmentSummary EDSBenchmarkStats::Summarize(const FString& MapName, const FString& PresetName, TConstArrayView<FEDSBenchmarkFrameSample> Samples, float HitchThresholdMs)
+{
+	FEDSBenchmarkSegmentSummary Summary;
+	Summary.MapName = MapName;
+	Summary.PresetName = PresetName;
+	Summary.NumFrames = Samples.Num();
+	if (Samples.IsEmpty())
+	{
+		return Summary;
+	}
+
+	TArray<float> FrameMs;
+	FrameMs.Reserve(Samples.Num());
+
+	double TotalFrameMs = 0.0;
+	double TotalGameThreadMs = 0.0;
+	double TotalRenderThreadMs = 0.0;
+	double TotalRHIThreadMs = 0.0;
+	double TotalGPUMs = 0.0;
+	for (const FEDSBenchmarkFrameSample& Sample : Samples)
+	{
+		FrameMs.Add(Sample.FrameMs);
+		TotalFrameMs += Sample.FrameMs;
+		TotalGameThreadMs += Sample.GameThreadMs;
+		TotalRenderThreadMs += Sample.RenderThreadMs;
+		TotalRHIThreadMs += Sample.RHIThreadMs;
+		TotalGPUMs += Sample.GPUMs;
+		Summary.NumHitches += Sample.FrameMs > HitchThresholdMs ? 1 : 0;
+	}
+	FrameMs.Sort();
+
+	const double NumFrames = double(Samples.Num());
+	Summary.AvgFrameMs = float(TotalFrameMs / NumFrames);
+	Summary.MedianFrameMs = GetPercentile(FrameMs, 50.0f);
+	Summary.P95FrameMs = GetPercentile(FrameMs, 95.0f);
+	Summary.P99FrameMs = GetPercentile(FrameMs, 99.0f);
+	Summary.MaxFrameMs = FrameMs.Last();
+	Summary.AvgGameThreadMs = float(TotalGameThreadMs / NumFrames);
+	Summary.AvgRenderThreadMs = float(TotalRenderThreadMs / NumFrames);
+	Summary.AvgRHIThreadMs = float(TotalRHIThreadMs / NumFrames);
+	Summary.AvgGPUMs = float(TotalGPUMs / NumFrames);
+	return Summary;
+}
+
+float EDSBenchmarkStats::GetPercentile(TConstArrayView<float> SortedValues, float Percentile)
+{
+	if (SortedValues.IsEmpty())
+	{
+		return 0.0f;
+	}
+
+	const int32 Rank = FMath::CeilToInt32(FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0f * SortedValues.Num());
+	return SortedValues[FMath::Clamp(Rank - 1, 0, SortedValues.Num() - 1)];
+}
+
+FString EDSBenchmarkStats::ToCsv(TConstArrayView<FEDSBenchmarkSegmentSummary> Summaries)
+{
+	FString Csv = TEXT("Map,Preset,Frames,AvgFrameMs,MedianFrameMs,P95FrameMs,P99FrameMs,MaxFrameMs,AvgGameThreadMs,AvgRenderThreadMs,AvgRHIThreadMs,AvgGPUMs,Hitches\n");
+	for (const FEDSBenchmarkSegmentSummary& Summary : Summaries)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d\n"),
+			*Summary.MapName,
+			*Summary.PresetName,
+			Summary.NumFrames,
+			Summary.AvgFrameMs,
+			Summary.MedianFrameMs,
+			Summary.P95FrameMs,
+			Summary.P99FrameMs,
+			Summary.MaxFrameMs,
+			Summary.AvgGameThreadMs,
+			Summary.AvgRenderThreadMs,
+			Summary.AvgRHIThreadMs,
+			Summary.AvgGPUMs,
+			Summary.NumHitches);
+	}
+	return Csv;
+}
+
+FString EDSBenchmarkStats::ToJson(TConstArrayView<FEDSBenchmarkSegmentSummary> Summaries, const TMap<FString, FString>& Metadata)
+{
+	TArray<FString> MetadataKeys;
+	Metadata.GenerateKeyArray(MetadataKeys);
+	MetadataKeys.Sort();
+
+	FString Json = TEXT("{\n");
+	for (const FString& Key : MetadataKeys)
+	{
+		Json += FString::Printf(TEXT("\t\"%s\": \"%s\",\n"), *EscapeJson(Key), *EscapeJson(Metadata[Key]));
+	}
+
+	Json += TEXT("\t\"segments\": [");
+	for (int32 SummaryIndex = 0; SummaryIndex < Summaries.Num(); ++SummaryIndex)
+	{
+		const FEDSBenchmarkSegmentSummary& Summary = Summaries[SummaryIndex];
+		Json += FString::Printf(
+			TEXT("%s\n\t\t{ \"map\": \"%s\", \"preset\": \"%s\", \"frames\": %d, \"avgFrameMs\": %.3f, \"medianFrameMs\": %.3f, \"p95FrameMs\": %.3f, \"p99FrameMs\": %.3f, \"maxFrameMs\": %.3f, ")
+			TEXT("\"avgGameThreadMs\": %.3f, \"avgRenderThreadMs\": %.3f, \"avgRHIThreadMs\": %.3f, \"avgGPUMs\": %.3f, \"hitches\": %d }"),
+			SummaryIndex > 0 ? TEXT(",") : TEXT(""),
+			*EscapeJson(Summary.MapName),
+			*EscapeJson(Summary.PresetName),
+			Summary.NumFrames,
+			Summary.AvgFrameMs,
+			Summary.MedianFrameMs,
+			Summary.P95FrameMs,
+			Summary.P99FrameMs,
+			Summary.MaxFrameMs,
+			Summary.AvgGameThreadMs,
+			Summary.AvgRenderThreadMs,
+			Summary.AvgRHIThreadMs,
+			Summary.AvgGPUMs,
+			Summary.NumHitches);
+	}
+	Json += Summaries.IsEmpty() ? TEXT("]\n}\n") : TEXT("\n\t]\n}\n");
+
+	return Json;
+}
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Timings of one captured frame, in milliseconds */
+struct FEDSBenchmarkFrameSample
+{
+	float FrameMs = 0.0f;
+	float GameThreadMs = 0.0f;
+	float RenderThreadMs = 0.0f;
+	float RHIThreadMs = 0.0f;
+	float GPUMs = 0.0f;
+};
+
+/** Summary of the frames captured for one map and lighting preset */
+struct FEDSBenchmarkSegmentSummary
+{
+	FString MapName;
+	FString PresetName;
+	int32 NumFrames = 0;
+	float AvgFrameMs = 0.0f;
+	float MedianFrameMs = 0.0f;
+	float P95FrameMs = 0.0f;
+	float P99FrameMs = 0.0f;
+	float MaxFrameMs = 0.0f;
+	float AvgGameThreadMs = 0.0f;
+	float AvgRenderThreadMs = 0.0f;
+	float AvgRHIThreadMs = 0.0f;
+	float AvgGPUMs = 0.0f;
+	int32 NumHitches = 0;
+};
+
+/**
+ * Turns captured frames into summaries and writes them out. Summaries are printed with a fixed precision and
+ * in capture order, so two runs of the same build only differ where the timings do.
+ */
+namespace EDSBenchmarkStats
+{
+	ELECTRICDREAMSSAMPLE_API FEDSBenchmarkSegmentSummary Summarize(const FString& MapName, const FString& PresetName, TConstArrayView<FEDSBenchmarkFrameSample> Samples, float HitchThresholdMs);
+
+	/** Nearest rank percentile of already sorted values, Percentile in [0, 100] */
+	ELECTRICDREAMSSAMPLE_API float GetPercentile(TConstArrayView<float> SortedValues, float Percentile);
+
+	ELECTRICDREAMSSAMPLE_API FString ToCsv(TConstArrayView<FEDSBenchmarkSegmentSummary> Summaries);
+
+	/** Metadata ends up as string fields next to the segments, sorted by key */
+	ELECTRICDREAMSSAMPLE_API FString ToJson(TConstArrayView<FEDSBenchmarkSegmentSummary> Summaries, const TMap<FString, FString>& Metadata);
+}
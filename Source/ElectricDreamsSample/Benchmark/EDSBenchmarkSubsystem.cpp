@@ -0,0 +1,388 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSBenchmarkSubsystem.h"
+#include "ElectricDreamsHotkeySubsystem.h"
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HoverDroneFlightRecording.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSBenchmarkSubsystem)
+
+static TAutoConsoleVariable<float> CVarBenchmarkHitchMs(
+	TEXT("ElectricDreams.Benchmark.HitchMs"),
+	50.0f,
+	TEXT("Frames slower than this many milliseconds count as hitches in the benchmark summary (default = 50)"),
+	ECVF_Default);
+
+namespace EDSBenchmark
+{
+	const FName PathActorTag = TEXT("EDSBenchmarkPath");
+	constexpr float FixedDeltaSeconds = 1.0f / 30.0f;
+	constexpr double LoadTimeoutSeconds = 120.0;
+	constexpr float OrbitRadius = 2000.0f;
+	constexpr float OrbitHeight = 500.0f;
+}
+
+bool UEDSBenchmarkSubsystem::IsBenchmarkRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("EDSBenchmark"));
+}
+
+bool UEDSBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return IsBenchmarkRequested() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UEDSBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TArray<FString> Errors;
+	if (!DemoTable.Build(*GetDefault<UEDSDemoSettings>(), Errors))
+	{
+		for (const FString& Error : Errors)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("EDSDemoSettings: %s"), *Error);
+		}
+	}
+
+	for (int32 LevelIndex = 0; LevelIndex < DemoTable.Levels.Num(); ++LevelIndex)
+	{
+		const int32 PresetCount = FMath::Max(DemoTable.GetPresetIndicesForLevel(LevelIndex).Num(), 1);
+		for (int32 PresetSlot = 0; PresetSlot < PresetCount; ++PresetSlot)
+		{
+			Segments.Add({ LevelIndex, PresetSlot });
+		}
+	}
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (!FParse::Value(CommandLine, TEXT("EDSBenchmarkOutput="), OutputDirectory))
+	{
+		OutputDirectory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("EDSBenchmark"));
+	}
+	FParse::Value(CommandLine, TEXT("EDSBenchmarkWarmupFrames="), WarmupFrames);
+	FParse::Value(CommandLine, TEXT("EDSBenchmarkFrames="), CaptureFrames);
+	WarmupFrames = FMath::Max(WarmupFrames, 0);
+	CaptureFrames = FMath::Max(CaptureFrames, 1);
+
+	// same simulated time every frame, so the path and everything animated along it repeats exactly
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(EDSBenchmark::FixedDeltaSeconds);
+
+	// background loads would show up as noise in whichever segment they land in
+	if (IConsoleVariable* PreloadCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ElectricDreams.Levels.Preload")))
+	{
+		PreloadCVar->Set(false, ECVF_SetByCommandline);
+	}
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UEDSBenchmarkSubsystem::OnPostLoadMap);
+
+	State = Segments.IsEmpty() ? EState::Done : EState::Travel;
+	UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: %d segments, %d warmup and %d captured frames each, writing to %s"), Segments.Num(), WarmupFrames, CaptureFrames, *OutputDirectory);
+}
+
+void UEDSBenchmarkSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	FApp::SetUseFixedTimeStep(false);
+
+	Super::Deinitialize();
+}
+
+TStatId UEDSBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEDSBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UEDSBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	UWorld* World = GetGameInstance() != nullptr ? GetGameInstance()->GetWorld() : nullptr;
+
+	switch (State)
+	{
+	case EState::Travel:
+		if (World != nullptr)
+		{
+			const FString& PackageName = DemoTable.Levels[Segments[SegmentIndex].LevelIndex].PackageName;
+			UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: loading %s"), *PackageName);
+
+			State = EState::Loading;
+			LoadStartSeconds = NowSeconds;
+			UGameplayStatics::OpenLevel(World, FName(*PackageName));
+		}
+		break;
+
+	case EState::Loading:
+		if (NowSeconds - LoadStartSeconds > EDSBenchmark::LoadTimeoutSeconds)
+		{
+			UE_LOG(LogTemp, Error, TEXT("EDSBenchmark: %s didn't load, skipping it"), *GetSegmentMapName(Segments[SegmentIndex]));
+			SkipLevel();
+		}
+		break;
+
+	case EState::Warmup:
+	case EState::Capture:
+		if (World != nullptr)
+		{
+			if (State == EState::Capture)
+			{
+				Samples.Add(SampleFrame(NowSeconds));
+			}
+
+			FlyPath(*World);
+			++SegmentFrame;
+
+			if (State == EState::Warmup && SegmentFrame >= WarmupFrames)
+			{
+				State = EState::Capture;
+			}
+			else if (State == EState::Capture && Samples.Num() >= CaptureFrames)
+			{
+				FinishSegment();
+			}
+		}
+		break;
+
+	case EState::Done:
+		break;
+	}
+
+	LastFrameSeconds = NowSeconds;
+
+	if (State == EState::Done && !Segments.IsEmpty())
+	{
+		WriteResults();
+		Segments.Reset();
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UEDSBenchmarkSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (State != EState::Loading || LoadedWorld == nullptr)
+	{
+		return;
+	}
+
+	// the first map loaded at startup isn't necessarily the one we asked for
+	if (LoadedWorld->GetOutermost()->GetName() != DemoTable.Levels[Segments[SegmentIndex].LevelIndex].PackageName)
+	{
+		return;
+	}
+
+	BeginSegment(*LoadedWorld);
+}
+
+void UEDSBenchmarkSubsystem::BeginSegment(UWorld& World)
+{
+	const FSegment& Segment = Segments[SegmentIndex];
+	UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: segment %d/%d, %s %s"), SegmentIndex + 1, Segments.Num(), *GetSegmentMapName(Segment), *GetSegmentPresetName(Segment));
+
+	if (UElectricDreamsHotkeySubsystem* Hotkeys = World.GetSubsystem<UElectricDreamsHotkeySubsystem>())
+	{
+		if (Hotkeys->GetNumLightingPresets() > 0)
+		{
+			Hotkeys->SetLightingPresetSlot(Segment.PresetSlot);
+		}
+	}
+
+	PathRecording = MakeShared<FHoverDroneFlightRecording>();
+	const FString RecordingPath = FHoverDroneFlightRecording::GetSavedPath(GetSegmentMapName(Segment));
+	if (!FPaths::FileExists(RecordingPath) || !PathRecording->LoadFromFile(RecordingPath) || PathRecording->Frames.IsEmpty())
+	{
+		PathRecording.Reset();
+	}
+	PathRecordingDuration = PathRecording.IsValid() ? PathRecording->GetDuration() : 0.0;
+	PathRecordingCursor = FHoverDroneFlightCursor();
+
+	PathSpline.Reset();
+	for (TActorIterator<AActor> It(&World); !PathRecording.IsValid() && It; ++It)
+	{
+		if (It->ActorHasTag(EDSBenchmark::PathActorTag))
+		{
+			PathSpline = It->FindComponentByClass<USplineComponent>();
+			if (PathSpline.IsValid())
+			{
+				break;
+			}
+		}
+	}
+
+	OrbitCenter = FVector::ZeroVector;
+	if (APlayerController* PlayerController = World.GetFirstPlayerController())
+	{
+		if (const APawn* Pawn = PlayerController->GetPawn())
+		{
+			OrbitCenter = Pawn->GetActorLocation();
+		}
+	}
+
+	if (PathRecording.IsValid())
+	{
+		UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: flying the recording %s"), *RecordingPath);
+	}
+	else if (!PathSpline.IsValid())
+	{
+		UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: no flight recording and no actor tagged %s with a spline, orbiting the player start"), *EDSBenchmark::PathActorTag.ToString());
+	}
+
+	// frames are timed from here, so without warmup frames the first sample doesn't include the map load
+	LastFrameSeconds = FPlatformTime::Seconds();
+
+	Samples.Reset(CaptureFrames);
+	SegmentFrame = 0;
+	State = WarmupFrames > 0 ? EState::Warmup : EState::Capture;
+}
+
+void UEDSBenchmarkSubsystem::FinishSegment()
+{
+	const FSegment& Segment = Segments[SegmentIndex];
+	const FEDSBenchmarkSegmentSummary& Summary = Summaries.Add_GetRef(
+		EDSBenchmarkStats::Summarize(GetSegmentMapName(Segment), GetSegmentPresetName(Segment), Samples, CVarBenchmarkHitchMs.GetValueOnGameThread()));
+
+	UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: %s %s avg %.2f ms, p95 %.2f ms, %d hitches"), *Summary.MapName, *Summary.PresetName, Summary.AvgFrameMs, Summary.P95FrameMs, Summary.NumHitches);
+
+	++SegmentIndex;
+	if (!Segments.IsValidIndex(SegmentIndex))
+	{
+		State = EState::Done;
+	}
+	else if (Segments[SegmentIndex].LevelIndex != Segment.LevelIndex)
+	{
+		State = EState::Travel;
+	}
+	else if (UWorld* World = GetGameInstance()->GetWorld())
+	{
+		// next preset on the same map, no reload needed
+		BeginSegment(*World);
+	}
+}
+
+void UEDSBenchmarkSubsystem::SkipLevel()
+{
+	const int32 LevelIndex = Segments[SegmentIndex].LevelIndex;
+	while (Segments.IsValidIndex(SegmentIndex) && Segments[SegmentIndex].LevelIndex == LevelIndex)
+	{
+		++SegmentIndex;
+	}
+
+	State = Segments.IsValidIndex(SegmentIndex) ? EState::Travel : EState::Done;
+}
+
+void UEDSBenchmarkSubsystem::FlyPath(UWorld& World)
+{
+	APlayerController* PlayerController = World.GetFirstPlayerController();
+	APawn* Pawn = PlayerController != nullptr ? PlayerController->GetPawn() : nullptr;
+	if (Pawn == nullptr)
+	{
+		return;
+	}
+
+	// warmup and capture together cover the path once
+	const float Alpha = float(SegmentFrame) / float(FMath::Max(WarmupFrames + CaptureFrames - 1, 1));
+
+	FVector Location;
+	FRotator Rotation;
+	if (!GetPathTransform(Alpha, Location, Rotation))
+	{
+		return;
+	}
+
+	Pawn->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	PlayerController->SetControlRotation(Rotation);
+
+	if (UPawnMovementComponent* Movement = Pawn->GetMovementComponent())
+	{
+		Movement->StopMovementImmediately();
+	}
+}
+
+bool UEDSBenchmarkSubsystem::GetPathTransform(float Alpha, FVector& OutLocation, FRotator& OutRotation) const
+{
+	if (PathRecording.IsValid())
+	{
+		PathRecording->GetTransformAtTime(Alpha * PathRecordingDuration, OutLocation, OutRotation, PathRecordingCursor);
+		return true;
+	}
+
+	if (const USplineComponent* Spline = PathSpline.Get())
+	{
+		const float Distance = Alpha * Spline->GetSplineLength();
+		OutLocation = Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+		OutRotation = Spline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+		return true;
+	}
+
+	// one lap around the start, looking at it
+	const float Angle = Alpha * UE_TWO_PI;
+	OutLocation = OrbitCenter + FVector(FMath::Cos(Angle) * EDSBenchmark::OrbitRadius, FMath::Sin(Angle) * EDSBenchmark::OrbitRadius, EDSBenchmark::OrbitHeight);
+	OutRotation = (OrbitCenter - OutLocation).Rotation();
+	return true;
+}
+
+FEDSBenchmarkFrameSample UEDSBenchmarkSubsystem::SampleFrame(double NowSeconds) const
+{
+	// the fixed time step hides the real frame time from DeltaTime, measure it instead
+	FEDSBenchmarkFrameSample Sample;
+	Sample.FrameMs = float((NowSeconds - LastFrameSeconds) * 1000.0);
+	Sample.GameThreadMs = float(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	Sample.RenderThreadMs = float(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+	Sample.RHIThreadMs = float(FPlatformTime::ToMilliseconds(GRHIThreadTime));
+	Sample.GPUMs = FApp::CanEverRender() ? float(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles())) : 0.0f;
+	return Sample;
+}
+
+void UEDSBenchmarkSubsystem::WriteResults()
+{
+	TMap<FString, FString> Metadata;
+	Metadata.Add(TEXT("build"), FApp::GetBuildVersion());
+	Metadata.Add(TEXT("configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Metadata.Add(TEXT("rendering"), FApp::CanEverRender() ? TEXT("true") : TEXT("false"));
+	Metadata.Add(TEXT("fixedDeltaSeconds"), FString::Printf(TEXT("%.6f"), EDSBenchmark::FixedDeltaSeconds));
+	Metadata.Add(TEXT("warmupFrames"), FString::FromInt(WarmupFrames));
+	Metadata.Add(TEXT("captureFrames"), FString::FromInt(CaptureFrames));
+	Metadata.Add(TEXT("hitchMs"), FString::Printf(TEXT("%.1f"), CVarBenchmarkHitchMs.GetValueOnGameThread()));
+
+	const FString CsvPath = FPaths::Combine(OutputDirectory, TEXT("EDSBenchmark.csv"));
+	const FString JsonPath = FPaths::Combine(OutputDirectory, TEXT("EDSBenchmark.json"));
+	const bool bWroteCsv = FFileHelper::SaveStringToFile(EDSBenchmarkStats::ToCsv(Summaries), *CsvPath);
+	const bool bWroteJson = FFileHelper::SaveStringToFile(EDSBenchmarkStats::ToJson(Summaries, Metadata), *JsonPath);
+
+	if (bWroteCsv && bWroteJson)
+	{
+		UE_LOG(LogTemp, Display, TEXT("EDSBenchmark: wrote %d segments to %s"), Summaries.Num(), *OutputDirectory);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("EDSBenchmark: couldn't write the results to %s"), *OutputDirectory);
+	}
+}
+
+FString UEDSBenchmarkSubsystem::GetSegmentMapName(const FSegment& Segment) const
+{
+	return FPackageName::GetShortName(DemoTable.Levels[Segment.LevelIndex].PackageName);
+}
+
+FString UEDSBenchmarkSubsystem::GetSegmentPresetName(const FSegment& Segment) const
+{
+	const TArray<int32>& PresetIndices = DemoTable.GetPresetIndicesForLevel(Segment.LevelIndex);
+	return PresetIndices.IsValidIndex(Segment.PresetSlot) ? DemoTable.Presets[PresetIndices[Segment.PresetSlot]].Name.ToString() : TEXT("Default");
+}
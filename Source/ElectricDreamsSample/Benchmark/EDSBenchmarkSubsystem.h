@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "EDSDemoSettings.h"
+#include "EDSBenchmarkStats.h"
+#include "HoverDroneFlightRecording.h"
+
+#include "EDSBenchmarkSubsystem.generated.h"
+
+class USplineComponent;
+
+/**
+ * Unattended performance flythrough, only created when the game runs with -EDSBenchmark. Visits every map of
+ * the level rotation with each of its lighting presets, flies the player pawn along the map's benchmark path
+ * and records frame and thread times. Writes EDSBenchmark.csv and EDSBenchmark.json and quits when done.
+ *
+ * The game runs on a fixed time step, so every run flies the exact same path frame by frame, and works with
+ * -nullrhi for CPU only runs. Options:
+ *   -EDSBenchmarkOutput=<dir>       defaults to Saved/Profiling/EDSBenchmark
+ *   -EDSBenchmarkWarmupFrames=<n>   frames flown before capturing, default 120
+ *   -EDSBenchmarkFrames=<n>         frames captured per map and preset, default 600
+ *
+ * The path is a drone flight recorded for the map (HoverDrone.Record.Stop saves Saved/HoverDrone/<Map>.hdflight),
+ * else the spline of an actor tagged EDSBenchmarkPath, else an orbit around the player start.
+ */
+UCLASS()
+class ELECTRICDREAMSSAMPLE_API UEDSBenchmarkSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// USubsystem implementation Begin
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	// FTickableGameObject implementation Begin
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	// FTickableGameObject implementation End
+
+	static bool IsBenchmarkRequested();
+
+private:
+	enum class EState : uint8
+	{
+		Travel,
+		Loading,
+		Warmup,
+		Capture,
+		Done
+	};
+
+	/** One map and lighting preset to capture */
+	struct FSegment
+	{
+		int32 LevelIndex = INDEX_NONE;
+		int32 PresetSlot = 0;
+	};
+
+	void OnPostLoadMap(UWorld* LoadedWorld);
+	void BeginSegment(UWorld& World);
+	void FinishSegment();
+	void SkipLevel();
+	void FlyPath(UWorld& World);
+	bool GetPathTransform(float Alpha, FVector& OutLocation, FRotator& OutRotation) const;
+	FEDSBenchmarkFrameSample SampleFrame(double NowSeconds) const;
+	void WriteResults();
+	FString GetSegmentMapName(const FSegment& Segment) const;
+	FString GetSegmentPresetName(const FSegment& Segment) const;
+
+	FEDSDemoRuntimeTable DemoTable;
+	TArray<FSegment> Segments;
+	int32 SegmentIndex = 0;
+	EState State = EState::Travel;
+
+	FString OutputDirectory;
+	int32 WarmupFrames = 120;
+	int32 CaptureFrames = 600;
+	int32 SegmentFrame = 0;
+	double LastFrameSeconds = 0.0;
+	double LoadStartSeconds = 0.0;
+
+	TSharedPtr<FHoverDroneFlightRecording> PathRecording;
+	double PathRecordingDuration = 0.0;
+	mutable FHoverDroneFlightCursor PathRecordingCursor;
+	TWeakObjectPtr<USplineComponent> PathSpline;
+	FVector OrbitCenter = FVector::ZeroVector;
+
+	TArray<FEDSBenchmarkFrameSample> Samples;
+	TArray<FEDSBenchmarkSegmentSummary> Summaries;
+	FDelegateHandle PostLoadMapHandle;
+};
@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSDemoSettings.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSDemoSettings)
+
+namespace EDSDemoSettings
+{
+	static FEDSLightingPreset MakePreset(const TCHAR* Name, float SunPitch, float SunIntensity, const FLinearColor& SunColor, float SkyIntensity, float FogDensity, const FLinearColor& FogColor)
+	{
+		FEDSLightingPreset Preset;
+		Preset.Name = Name;
+		Preset.SunPitch = SunPitch;
+		Preset.SunIntensity = SunIntensity;
+		Preset.SunColor = SunColor;
+		Preset.SkyIntensity = SkyIntensity;
+		Preset.FogDensity = FogDensity;
+		Preset.FogColor = FogColor;
+		return Preset;
+	}
+
+	static FEDSHotkeyBinding MakeBinding(EEDSHotkeyAction Action, const FKey& Key)
+	{
+		FEDSHotkeyBinding Binding;
+		Binding.Action = Action;
+		Binding.Key = Key;
+		return Binding;
+	}
+
+	static FEDSLevelRotationEntry MakeLevel(const TCHAR* PackageName)
+	{
+		FEDSLevelRotationEntry Entry;
+		Entry.Map = FSoftObjectPath(FString::Printf(TEXT("%s.%s"), PackageName, *FPackageName::GetShortName(PackageName)));
+		return Entry;
+	}
+}
+
+UEDSDemoSettings::UEDSDemoSettings()
+{
+	LightingPresets = {
+		EDSDemoSettings::MakePreset(TEXT("Dawn"), -12.0f, 22000.0f, FLinearColor(1.00f, 0.77f, 0.56f), 0.65f, 0.0100f, FLinearColor(0.72f, 0.55f, 0.46f)),
+		EDSDemoSettings::MakePreset(TEXT("Midday"), -58.0f, 95000.0f, FLinearColor(1.00f, 0.97f, 0.92f), 1.10f, 0.0025f, FLinearColor(0.63f, 0.74f, 0.92f)),
+		EDSDemoSettings::MakePreset(TEXT("Dusk"), -2.0f, 12000.0f, FLinearColor(1.00f, 0.58f, 0.36f), 0.40f, 0.0120f, FLinearColor(0.44f, 0.31f, 0.40f)),
+		EDSDemoSettings::MakePreset(TEXT("Night"), 8.0f, 0.35f, FLinearColor(0.36f, 0.48f, 0.78f), 0.18f, 0.0180f, FLinearColor(0.05f, 0.08f, 0.18f))
+	};
+	DefaultLightingPreset = TEXT("Midday");
+
+	LevelRotation = {
+		EDSDemoSettings::MakeLevel(TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Boat_Cinematic_Map")),
+		EDSDemoSettings::MakeLevel(TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Map")),
+		EDSDemoSettings::MakeLevel(TEXT("/Game/TropicalIslandPack/Maps/Sublevel/TropicalIslandMap_Environment")),
+		EDSDemoSettings::MakeLevel(TEXT("/Game/Levels/ElectricDreams_Env")),
+		EDSDemoSettings::MakeLevel(TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Map_Overcast"))
+	};
+
+	HotkeyBindings = {
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleHelp, EKeys::F1),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleHelp, EKeys::Gamepad_LeftThumbstick),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::IncreaseMovementRate, EKeys::Equals),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::IncreaseMovementRate, EKeys::Gamepad_DPad_Right),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::DecreaseMovementRate, EKeys::Hyphen),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::DecreaseMovementRate, EKeys::Gamepad_DPad_Left),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::NextLevel, EKeys::PageDown),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::NextLevel, EKeys::Gamepad_RightShoulder),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::NextLevel, EKeys::Gamepad_FaceButton_Bottom),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::PreviousLevel, EKeys::PageUp),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::PreviousLevel, EKeys::Gamepad_LeftShoulder),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::PreviousLevel, EKeys::Gamepad_FaceButton_Left),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::NextLightingPreset, EKeys::F7),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::NextLightingPreset, EKeys::Gamepad_DPad_Up),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::PreviousLightingPreset, EKeys::F6),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::PreviousLightingPreset, EKeys::Gamepad_DPad_Down),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleInvertLookY, EKeys::F9),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleInvertLookY, EKeys::Gamepad_RightThumbstick),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleVr, EKeys::F10),
+		EDSDemoSettings::MakeBinding(EEDSHotkeyAction::ToggleVr, EKeys::Gamepad_Special_Right)
+	};
+}
+
+bool UEDSDemoSettings::Validate(TArray<FString>& OutErrors) const
+{
+	const int32 NumErrorsBefore = OutErrors.Num();
+
+	if (LightingPresets.IsEmpty())
+	{
+		OutErrors.Add(TEXT("No lighting presets configured."));
+	}
+
+	TSet<FName> PresetNames;
+	for (int32 PresetIndex = 0; PresetIndex < LightingPresets.Num(); ++PresetIndex)
+	{
+		const FEDSLightingPreset& Preset = LightingPresets[PresetIndex];
+		if (Preset.Name.IsNone())
+		{
+			OutErrors.Add(FString::Printf(TEXT("Lighting preset %d has no name."), PresetIndex));
+		}
+		else if (PresetNames.Contains(Preset.Name))
+		{
+			OutErrors.Add(FString::Printf(TEXT("Lighting preset name %s is used more than once."), *Preset.Name.ToString()));
+		}
+		PresetNames.Add(Preset.Name);
+
+		if (Preset.SunPitch < -90.0f || Preset.SunPitch > 90.0f)
+		{
+			OutErrors.Add(FString::Printf(TEXT("Lighting preset %s has a sun pitch of %f, outside of [-90, 90]."), *Preset.Name.ToString(), Preset.SunPitch));
+		}
+		if (Preset.SunIntensity < 0.0f || Preset.SkyIntensity < 0.0f || Preset.FogDensity < 0.0f)
+		{
+			OutErrors.Add(FString::Printf(TEXT("Lighting preset %s has a negative intensity or fog density."), *Preset.Name.ToString()));
+		}
+	}
+
+	if (!DefaultLightingPreset.IsNone() && !PresetNames.Contains(DefaultLightingPreset))
+	{
+		OutErrors.Add(FString::Printf(TEXT("Default lighting preset %s does not exist."), *DefaultLightingPreset.ToString()));
+	}
+
+	TSet<FName> MapNames;
+	for (int32 LevelIndex = 0; LevelIndex < LevelRotation.Num(); ++LevelIndex)
+	{
+		const FEDSLevelRotationEntry& Entry = LevelRotation[LevelIndex];
+		const FString PackageName = Entry.Map.GetLongPackageName();
+		if (PackageName.IsEmpty() || !FPackageName::IsValidLongPackageName(PackageName))
+		{
+			OutErrors.Add(FString::Printf(TEXT("Level rotation entry %d has an invalid map %s."), LevelIndex, *Entry.Map.ToString()));
+			continue;
+		}
+
+		// maps are matched by short name, same as UWorld::GetMapName
+		const FName ShortName(*FPackageName::GetShortName(PackageName));
+		if (MapNames.Contains(ShortName))
+		{
+			OutErrors.Add(FString::Printf(TEXT("Map %s is in the level rotation more than once."), *ShortName.ToString()));
+		}
+		MapNames.Add(ShortName);
+
+		for (const FName& PresetName : Entry.LightingPresets)
+		{
+			if (!PresetNames.Contains(PresetName))
+			{
+				OutErrors.Add(FString::Printf(TEXT("Map %s uses lighting preset %s which does not exist."), *ShortName.ToString(), *PresetName.ToString()));
+			}
+		}
+
+		if (!Entry.DefaultLightingPreset.IsNone())
+		{
+			if (!PresetNames.Contains(Entry.DefaultLightingPreset))
+			{
+				OutErrors.Add(FString::Printf(TEXT("Map %s defaults to lighting preset %s which does not exist."), *ShortName.ToString(), *Entry.DefaultLightingPreset.ToString()));
+			}
+			else if (!Entry.LightingPresets.IsEmpty() && !Entry.LightingPresets.Contains(Entry.DefaultLightingPreset))
+			{
+				OutErrors.Add(FString::Printf(TEXT("Map %s defaults to lighting preset %s which is not in its preset list."), *ShortName.ToString(), *Entry.DefaultLightingPreset.ToString()));
+			}
+		}
+	}
+
+	for (int32 BindingIndex = 0; BindingIndex < HotkeyBindings.Num(); ++BindingIndex)
+	{
+		const FEDSHotkeyBinding& Binding = HotkeyBindings[BindingIndex];
+		if (!Binding.Key.IsValid() || Binding.Action >= EEDSHotkeyAction::Count)
+		{
+			OutErrors.Add(FString::Printf(TEXT("Hotkey binding %d has an invalid key or action."), BindingIndex));
+		}
+		else if (Binding.ModifierKeys.ContainsByPredicate([](const FKey& ModifierKey) { return !ModifierKey.IsValid(); }))
+		{
+			OutErrors.Add(FString::Printf(TEXT("Hotkey binding %d on %s has an invalid modifier key."), BindingIndex, *Binding.Key.ToString()));
+		}
+	}
+
+	return OutErrors.Num() == NumErrorsBefore;
+}
+
+#if WITH_EDITOR
+EDataValidationResult UEDSDemoSettings::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	TArray<FString> Errors;
+	if (!Validate(Errors))
+	{
+		for (const FString& Error : Errors)
+		{
+			Context.AddError(FText::FromString(Error));
+		}
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
+}
+#endif
+
+bool FEDSDemoRuntimeTable::Build(const UEDSDemoSettings& Settings, TArray<FString>& OutErrors)
+{
+	const bool bIsValid = Settings.Validate(OutErrors);
+
+	Presets.Reset();
+	Levels.Reset();
+	LevelIndexByShortName.Reset();
+	AllPresetIndices.Reset();
+	DefaultPresetSlot = 0;
+
+	TMap<FName, int32> PresetIndexByName;
+	for (const FEDSLightingPreset& Preset : Settings.LightingPresets)
+	{
+		if (Preset.Name.IsNone() || PresetIndexByName.Contains(Preset.Name))
+		{
+			continue;
+		}
+
+		const int32 PresetIndex = Presets.Add(Preset);
+		PresetIndexByName.Add(Preset.Name, PresetIndex);
+		AllPresetIndices.Add(PresetIndex);
+	}
+
+	if (const int32* DefaultPresetIndex = PresetIndexByName.Find(Settings.DefaultLightingPreset))
+	{
+		DefaultPresetSlot = *DefaultPresetIndex;
+	}
+
+	for (const FEDSLevelRotationEntry& Entry : Settings.LevelRotation)
+	{
+		const FString PackageName = Entry.Map.GetLongPackageName();
+		if (PackageName.IsEmpty() || !FPackageName::IsValidLongPackageName(PackageName))
+		{
+			continue;
+		}
+
+		const FName ShortName(*FPackageName::GetShortName(PackageName));
+		if (LevelIndexByShortName.Contains(ShortName))
+		{
+			continue;
+		}
+
+		FLevel Level;
+		Level.PackageName = PackageName;
+		for (const FName& PresetName : Entry.LightingPresets)
+		{
+			if (const int32* PresetIndex = PresetIndexByName.Find(PresetName))
+			{
+				Level.PresetIndices.AddUnique(*PresetIndex);
+			}
+		}
+
+		const TArray<int32>& LevelPresets = Level.PresetIndices.IsEmpty() ? AllPresetIndices : Level.PresetIndices;
+		const int32* DefaultPresetIndex = PresetIndexByName.Find(Entry.DefaultLightingPreset.IsNone() ? Settings.DefaultLightingPreset : Entry.DefaultLightingPreset);
+		Level.DefaultPresetSlot = DefaultPresetIndex ? FMath::Max(0, LevelPresets.IndexOfByKey(*DefaultPresetIndex)) : 0;
+
+		LevelIndexByShortName.Add(ShortName, Levels.Add(MoveTemp(Level)));
+	}
+
+	return bIsValid;
+}
+
+int32 FEDSDemoRuntimeTable::FindLevelIndex(const FString& ShortMapName) const
+{
+	// FName compares case insensitive, same as the old string compare
+	const FName MapName(*ShortMapName, FNAME_Find);
+	if (MapName.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* LevelIndex = LevelIndexByShortName.Find(MapName);
+	return LevelIndex ? *LevelIndex : INDEX_NONE;
+}
+
+const TArray<int32>& FEDSDemoRuntimeTable::GetPresetIndicesForLevel(int32 LevelIndex) const
+{
+	if (Levels.IsValidIndex(LevelIndex) && !Levels[LevelIndex].PresetIndices.IsEmpty())
+	{
+		return Levels[LevelIndex].PresetIndices;
+	}
+
+	return AllPresetIndices;
+}
+
+int32 FEDSDemoRuntimeTable::GetDefaultPresetSlotForLevel(int32 LevelIndex) const
+{
+	if (Levels.IsValidIndex(LevelIndex))
+	{
+		return Levels[LevelIndex].DefaultPresetSlot;
+	}
+
+	return DefaultPresetSlot;
+}
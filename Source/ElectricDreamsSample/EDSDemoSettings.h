@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "InputCoreTypes.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "EDSDemoSettings.generated.h"
+
+/** One lighting preset the demo hotkeys can cycle through */
+USTRUCT()
+struct FEDSLightingPreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Lighting)
+	FName Name;
+
+	/** Pitch of the directional light in degrees, negative is above the horizon */
+	UPROPERTY(EditAnywhere, Category = Lighting, meta = (ClampMin = "-90", ClampMax = "90"))
+	float SunPitch = -45.0f;
+
+	UPROPERTY(EditAnywhere, Category = Lighting, meta = (ClampMin = "0"))
+	float SunIntensity = 10.0f;
+
+	UPROPERTY(EditAnywhere, Category = Lighting)
+	FLinearColor SunColor = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, Category = Lighting, meta = (ClampMin = "0"))
+	float SkyIntensity = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = Lighting, meta = (ClampMin = "0"))
+	float FogDensity = 0.01f;
+
+	UPROPERTY(EditAnywhere, Category = Lighting)
+	FLinearColor FogColor = FLinearColor::White;
+};
+
+/** One map of the demo level rotation */
+USTRUCT()
+struct FEDSLevelRotationEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Levels, meta = (AllowedClasses = "/Script/Engine.World"))
+	FSoftObjectPath Map;
+
+	/** Presets to cycle through on this map, in order. Empty uses all lighting presets */
+	UPROPERTY(EditAnywhere, Category = Levels)
+	TArray<FName> LightingPresets;
+
+	/** Preset applied when this map starts. None uses the project wide default */
+	UPROPERTY(EditAnywhere, Category = Levels)
+	FName DefaultLightingPreset;
+};
+
+/** What a demo hotkey does */
+UENUM()
+enum class EEDSHotkeyAction : uint8
+{
+	ToggleHelp,
+	IncreaseMovementRate,
+	DecreaseMovementRate,
+	NextLevel,
+	PreviousLevel,
+	NextLightingPreset,
+	PreviousLightingPreset,
+	ToggleInvertLookY,
+	ToggleVr,
+	Count UMETA(Hidden)
+};
+
+/** Triggers an action when Key is pressed while all modifier keys are held */
+USTRUCT()
+struct FEDSHotkeyBinding
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Hotkeys)
+	EEDSHotkeyAction Action = EEDSHotkeyAction::ToggleHelp;
+
+	UPROPERTY(EditAnywhere, Category = Hotkeys)
+	FKey Key;
+
+	/** Keys or gamepad buttons that have to be held for the binding to trigger */
+	UPROPERTY(EditAnywhere, Category = Hotkeys)
+	TArray<FKey> ModifierKeys;
+};
+
+/**
+ * Lighting presets, level rotation and hotkey bindings of the demo hotkeys
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "EDSDemoSettings"))
+class ELECTRICDREAMSSAMPLE_API UEDSDemoSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UEDSDemoSettings();
+
+	/** Appends a message for every problem found, returns true when there were none */
+	bool Validate(TArray<FString>& OutErrors) const;
+
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+	UPROPERTY(config, EditAnywhere, Category = Lighting)
+	TArray<FEDSLightingPreset> LightingPresets;
+
+	/** Preset applied when a map starts, unless the map overrides it */
+	UPROPERTY(config, EditAnywhere, Category = Lighting)
+	FName DefaultLightingPreset;
+
+	UPROPERTY(config, EditAnywhere, Category = Levels)
+	TArray<FEDSLevelRotationEntry> LevelRotation;
+
+	UPROPERTY(config, EditAnywhere, Category = Hotkeys)
+	TArray<FEDSHotkeyBinding> HotkeyBindings;
+};
+
+/**
+ * Lookup tables built once from UEDSDemoSettings, so cycling presets and levels doesn't need any string
+ * compares. Invalid entries are skipped, the errors are reported by Build.
+ */
+struct ELECTRICDREAMSSAMPLE_API FEDSDemoRuntimeTable
+{
+	struct FLevel
+	{
+		FString PackageName;
+		TArray<int32> PresetIndices;
+		int32 DefaultPresetSlot = 0;
+	};
+
+	bool Build(const UEDSDemoSettings& Settings, TArray<FString>& OutErrors);
+
+	/** Index into Levels for a map name as returned by UWorld::GetMapName (without the PIE prefix), INDEX_NONE if it's not in the rotation */
+	int32 FindLevelIndex(const FString& ShortMapName) const;
+
+	/** Indices into Presets to cycle through on a level. INDEX_NONE gives all presets */
+	const TArray<int32>& GetPresetIndicesForLevel(int32 LevelIndex) const;
+	int32 GetDefaultPresetSlotForLevel(int32 LevelIndex) const;
+
+	TArray<FEDSLightingPreset> Presets;
+	TArray<FLevel> Levels;
+
+private:
+	TMap<FName, int32> LevelIndexByShortName;
+	TArray<int32> AllPresetIndices;
+	int32 DefaultPresetSlot = 0;
+};
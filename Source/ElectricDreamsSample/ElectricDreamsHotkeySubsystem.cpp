@@ -1,15 +1,18 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ElectricDreamsHotkeySubsystem.h"
+#include "EDSDemoSettings.h"
+#include "Input/EDSHotkeyDispatcher.h"
+#include "Levels/EDSLevelPreloadSubsystem.h"
+#include "Lighting/EDSLightingIndexSubsystem.h"
+#include "VR/EDSVrSubsystem.h"
 
 #include "Components/DirectionalLightComponent.h"
 #include "Components/ExponentialHeightFogComponent.h"
 #include "Components/SkyLightComponent.h"
 #include "Engine/Engine.h"
-#include "EngineUtils.h"
+#include "Engine/GameInstance.h"
 #include "HAL/IConsoleManager.h"
-#include "IHeadMountedDisplay.h"
-#include "IXRTrackingSystem.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
 #include "HAL/PlatformTime.h"
@@ -18,44 +21,68 @@
 #include "Misc/ConfigCacheIni.h"
 #include "Misc/PackageName.h"
 
-namespace ElectricDreamsLighting
-{
-	struct FLightingPreset
-	{
-		const TCHAR* Name;
-		float SunPitch;
-		float SunIntensity;
-		FLinearColor SunColor;
-		float SkyIntensity;
-		float FogDensity;
-		FLinearColor FogColor;
-	};
-
-	static const FLightingPreset Presets[] = {
-		{ TEXT("Dawn"), -12.0f, 22000.0f, FLinearColor(1.00f, 0.77f, 0.56f), 0.65f, 0.0100f, FLinearColor(0.72f, 0.55f, 0.46f) },
-		{ TEXT("Midday"), -58.0f, 95000.0f, FLinearColor(1.00f, 0.97f, 0.92f), 1.10f, 0.0025f, FLinearColor(0.63f, 0.74f, 0.92f) },
-		{ TEXT("Dusk"), -2.0f, 12000.0f, FLinearColor(1.00f, 0.58f, 0.36f), 0.40f, 0.0120f, FLinearColor(0.44f, 0.31f, 0.40f) },
-		{ TEXT("Night"), 8.0f, 0.35f, FLinearColor(0.36f, 0.48f, 0.78f), 0.18f, 0.0180f, FLinearColor(0.05f, 0.08f, 0.18f) }
-	};
-}
+static TAutoConsoleVariable<float> CVarLightingPresetBlendSeconds(
+	TEXT("ElectricDreams.Lighting.PresetBlendSeconds"),
+	2.0f,
+	TEXT("Duration in seconds of the blend between lighting presets. 0 switches instantly (default = 2)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLightingSkyRecaptureIntervalSeconds(
+	TEXT("ElectricDreams.Lighting.SkyRecaptureIntervalSeconds"),
+	0.5f,
+	TEXT("Minimum time in seconds between sky light recaptures while a lighting preset blends (default = 0.5)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarLevelSeamlessTravel(
+	TEXT("ElectricDreams.Levels.SeamlessTravel"),
+	false,
+	TEXT("Cycle levels with seamless travel through the transition map of the Maps & Modes settings instead of a full map load (default = false)"),
+	ECVF_Default);
 
 namespace ElectricDreamsHotkeys
 {
 	constexpr int32 HelpMessageKey = 9123401;
 	constexpr float MinMovementRateMultiplier = 1.0e-3f;
 	constexpr float MaxMovementRateMultiplier = 1.0e3f;
-	constexpr double VrEnableRetryIntervalSeconds = 0.25;
-	constexpr int32 VrEnableRetryAttempts = 24;
-	constexpr int32 DlssgDisabledValue = 0;
-	constexpr int32 DlssSrDisabledValue = 0;
-	constexpr int32 DeepDvcDisabledValue = 0;
-	constexpr int32 HiddenAreaMaskDisabledValue = 0;
-	constexpr int32 OpenXRDepthLayerDisabledValue = 0;
 	const TCHAR* DlssgCVarName = TEXT("r.Streamline.DLSSG.Enable");
 	const TCHAR* DlssSrCVarName = TEXT("r.NGX.DLSS.Enable");
-	const TCHAR* DeepDvcCVarName = TEXT("r.Streamline.DeepDVC.Enable");
-	const TCHAR* HiddenAreaMaskCVarName = TEXT("vr.HiddenAreaMask");
-	const TCHAR* OpenXRDepthLayerCVarName = TEXT("xr.OpenXRAllowDepthLayer");
+	const TCHAR* MovementRateCVarName = TEXT("HoverDrone.MovementRateMultiplier");
+	const TCHAR* InvertLookYCVarName = TEXT("HoverDrone.InvertLookY");
+}
+
+void UElectricDreamsHotkeySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UEDSDemoSettings* DemoSettings = GetDefault<UEDSDemoSettings>();
+
+	TArray<FString> Errors;
+	if (!DemoTable.Build(*DemoSettings, Errors))
+	{
+		for (const FString& Error : Errors)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("EDSDemoSettings: %s"), *Error);
+		}
+	}
+
+	HotkeyDispatcher.Build(DemoSettings->HotkeyBindings);
+	HotkeyHelpText = HotkeyDispatcher.DescribeBindings();
+}
+
+void UElectricDreamsHotkeySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FString CurrentMapName = InWorld.GetMapName();
+	if (!InWorld.StreamingLevelsPrefix.IsEmpty())
+	{
+		CurrentMapName.RemoveFromStart(InWorld.StreamingLevelsPrefix);
+	}
+
+	CurrentLevelIndex = DemoTable.FindLevelIndex(CurrentMapName);
+	LightingPresetSlot = DemoTable.GetDefaultPresetSlotForLevel(CurrentLevelIndex);
+
+	UpdateLevelPreloads();
 }
 
 TStatId UElectricDreamsHotkeySubsystem::GetStatId() const
@@ -81,89 +108,80 @@ void UElectricDreamsHotkeySubsystem::Tick(float DeltaTime)
 	{
 		ApplyLightingPreset(false);
 	}
+	TickLightingPreset(DeltaTime);
 
-	if (!bAutoVrStartupAttempted)
+	// VR outlives the world, only the first world of the game instance gets to start it
+	if (UEDSVrSubsystem* Vr = UGameInstance::GetSubsystem<UEDSVrSubsystem>(World->GetGameInstance()))
 	{
-		bAutoVrStartupAttempted = true;
+		Vr->StartInVrIfRequested();
+	}
 
-		bool bShouldStartInVr = false;
-		if (GConfig != nullptr &&
-			GConfig->GetBool(TEXT("/Script/EngineSettings.GeneralProjectSettings"), TEXT("bStartInVR"), bShouldStartInVr, GGameIni) &&
-			bShouldStartInVr)
+	TArray<FKey, TInlineAllocator<8>> JustPressedKeys;
+	FEDSHotkeyDispatcher::GatherJustPressedKeys(*PlayerController, JustPressedKeys);
+	if (!JustPressedKeys.IsEmpty())
+	{
+		const uint32 ActionMask = HotkeyDispatcher.Dispatch(JustPressedKeys, [PlayerController](const FKey& Key) { return PlayerController->IsInputKeyDown(Key); });
+		for (uint8 Action = 0; Action < uint8(EEDSHotkeyAction::Count); ++Action)
 		{
-			const FVrRuntimeState CurrentVrState = QueryVrRuntimeState();
-			if (!IsVrFullyActive(CurrentVrState))
+			if (ActionMask & FEDSHotkeyDispatcher::GetActionBit(EEDSHotkeyAction(Action)))
 			{
-				StartVrEnableRetry();
+				ExecuteHotkeyAction(EEDSHotkeyAction(Action), PlayerController);
 			}
 		}
 	}
 
-	TickVrEnableRetry();
-	SyncVrRuntimeCvars();
+	ApplyVerticalReposition(PlayerController, DeltaTime);
 
-	if (PlayerController->WasInputKeyJustPressed(EKeys::F1) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_LeftThumbstick))
+	if (bShowHelpOverlay)
 	{
-		ToggleHelpOverlay();
+		DrawHelpOverlay();
 	}
+}
 
-	if (PlayerController->WasInputKeyJustPressed(EKeys::Equals) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_DPad_Right))
+void UElectricDreamsHotkeySubsystem::ExecuteHotkeyAction(EEDSHotkeyAction Action, APlayerController* PlayerController)
+{
+	switch (Action)
 	{
+	case EEDSHotkeyAction::ToggleHelp:
+		ToggleHelpOverlay();
+		break;
+	case EEDSHotkeyAction::IncreaseMovementRate:
 		AdjustMovementRateMultiplier(1.0f);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::Hyphen) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_DPad_Left))
-	{
+		break;
+	case EEDSHotkeyAction::DecreaseMovementRate:
 		AdjustMovementRateMultiplier(-1.0f);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::PageDown) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_RightShoulder) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_FaceButton_Bottom))
-	{
+		break;
+	case EEDSHotkeyAction::NextLevel:
 		CycleLevel(true);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::PageUp) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_LeftShoulder) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_FaceButton_Left))
-	{
+		break;
+	case EEDSHotkeyAction::PreviousLevel:
 		CycleLevel(false);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::F7) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_DPad_Up))
-	{
+		break;
+	case EEDSHotkeyAction::NextLightingPreset:
 		CycleLightingPreset(true);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::F6) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_DPad_Down))
-	{
+		break;
+	case EEDSHotkeyAction::PreviousLightingPreset:
 		CycleLightingPreset(false);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::F9) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_RightThumbstick))
-	{
+		break;
+	case EEDSHotkeyAction::ToggleInvertLookY:
 		ToggleYAxisInversion(PlayerController);
-	}
-
-	if (PlayerController->WasInputKeyJustPressed(EKeys::F10) ||
-		PlayerController->WasInputKeyJustPressed(EKeys::Gamepad_Special_Right))
-	{
+		break;
+	case EEDSHotkeyAction::ToggleVr:
 		ToggleVrMode();
+		break;
+	default:
+		break;
 	}
+}
 
-	ApplyVerticalReposition(PlayerController, DeltaTime);
-
-	if (bShowHelpOverlay)
+IConsoleVariable* UElectricDreamsHotkeySubsystem::FindCachedConsoleVariable(IConsoleVariable*& CachedCVar, const TCHAR* Name)
+{
+	// plugin cvars may register after us, so keep looking until they show up
+	if (CachedCVar == nullptr)
 	{
-		DrawHelpOverlay();
+		CachedCVar = IConsoleManager::Get().FindConsoleVariable(Name);
 	}
+	return CachedCVar;
 }
 
 void UElectricDreamsHotkeySubsystem::ToggleHelpOverlay()
@@ -203,20 +221,13 @@ void UElectricDreamsHotkeySubsystem::DrawHelpOverlay() const
 	}
 	const FString HelpText = FString::Printf(
 		TEXT("HOTKEYS / CONTROLLER\n")
-		TEXT("F1 / L3: Toggle help overlay\n")
-		TEXT("PageDown / RB / A: Next level\n")
-		TEXT("PageUp / LB / X: Previous level\n")
-		TEXT("F7 / DPad Up: Next lighting preset\n")
-		TEXT("F6 / DPad Down: Previous lighting preset\n")
-		TEXT("F9 / R3: Toggle Y inversion\n")
-		TEXT("= / DPad Right: Increase movement rate (x e)\n")
-		TEXT("- / DPad Left: Decrease movement rate (x 1/e)\n")
+		TEXT("%s")
 		TEXT("Home / RT: Move up\n")
 		TEXT("End / LT: Move down\n")
-		TEXT("F10 / Menu: Toggle VR\n")
 		TEXT("Movement rate multiplier: %.6g\n")
 		TEXT("DLSS Frame Gen in current mode: %s\n")
 		TEXT("DLSS Super Resolution in current mode: %s"),
+		*HotkeyHelpText,
 		MovementRateMultiplier,
 		DlssgValue >= 0 ? (DlssgValue != 0 ? TEXT("ON") : TEXT("OFF")) : TEXT("Unavailable"),
 		DlssSrValue >= 0 ? (DlssSrValue != 0 ? TEXT("ON") : TEXT("OFF")) : TEXT("Unavailable")
@@ -232,7 +243,7 @@ void UElectricDreamsHotkeySubsystem::DrawHelpOverlay() const
 
 float UElectricDreamsHotkeySubsystem::GetMovementRateMultiplier() const
 {
-	if (const IConsoleVariable* MovementRateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoverDrone.MovementRateMultiplier")))
+	if (const IConsoleVariable* MovementRateCVar = FindCachedConsoleVariable(CachedMovementRateCVar, ElectricDreamsHotkeys::MovementRateCVarName))
 	{
 		return FMath::Clamp(
 			MovementRateCVar->GetFloat(),
@@ -246,7 +257,7 @@ float UElectricDreamsHotkeySubsystem::GetMovementRateMultiplier() const
 
 void UElectricDreamsHotkeySubsystem::AdjustMovementRateMultiplier(float LogDelta)
 {
-	if (IConsoleVariable* MovementRateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoverDrone.MovementRateMultiplier")))
+	if (IConsoleVariable* MovementRateCVar = FindCachedConsoleVariable(CachedMovementRateCVar, ElectricDreamsHotkeys::MovementRateCVarName))
 	{
 		const float CurrentMultiplier = FMath::Max(MovementRateCVar->GetFloat(), KINDA_SMALL_NUMBER);
 		const float NewMultiplier = FMath::Clamp(
@@ -293,7 +304,7 @@ void UElectricDreamsHotkeySubsystem::ToggleYAxisInversion(APlayerController* Pla
 
 	TArray<FString> ChangeDetails;
 
-	if (IConsoleVariable* InvertLookYCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoverDrone.InvertLookY")))
+	if (IConsoleVariable* InvertLookYCVar = FindCachedConsoleVariable(CachedInvertLookYCVar, ElectricDreamsHotkeys::InvertLookYCVarName))
 	{
 		const bool bCurrentInverted = InvertLookYCVar->GetInt() != 0;
 		const bool bNewInverted = !bCurrentInverted;
@@ -361,12 +372,29 @@ void UElectricDreamsHotkeySubsystem::ApplyVerticalReposition(APlayerController*
 
 void UElectricDreamsHotkeySubsystem::CycleLightingPreset(bool bForward)
 {
-	constexpr int32 PresetCount = UE_ARRAY_COUNT(ElectricDreamsLighting::Presets);
+	const int32 PresetCount = DemoTable.GetPresetIndicesForLevel(CurrentLevelIndex).Num();
+	if (PresetCount == 0)
+	{
+		return;
+	}
+
 	const int32 Direction = bForward ? 1 : -1;
-	LightingPresetIndex = (LightingPresetIndex + Direction + PresetCount) % PresetCount;
+	LightingPresetSlot = (LightingPresetSlot + Direction + PresetCount) % PresetCount;
 	ApplyLightingPreset(true);
 }
 
+int32 UElectricDreamsHotkeySubsystem::GetNumLightingPresets() const
+{
+	return DemoTable.GetPresetIndicesForLevel(CurrentLevelIndex).Num();
+}
+
+void UElectricDreamsHotkeySubsystem::SetLightingPresetSlot(int32 Slot)
+{
+	LightingPresetSlot = Slot;
+	bLightingPresetApplied = false;
+	ApplyLightingPreset(false);
+}
+
 void UElectricDreamsHotkeySubsystem::ApplyLightingPreset(bool bShowMessage)
 {
 	UWorld* World = GetWorld();
@@ -375,518 +403,267 @@ void UElectricDreamsHotkeySubsystem::ApplyLightingPreset(bool bShowMessage)
 		return;
 	}
 
-	constexpr int32 PresetCount = UE_ARRAY_COUNT(ElectricDreamsLighting::Presets);
-	LightingPresetIndex = FMath::Clamp(LightingPresetIndex, 0, PresetCount - 1);
-	const ElectricDreamsLighting::FLightingPreset& Preset = ElectricDreamsLighting::Presets[LightingPresetIndex];
-
-	int32 DirectionalLightCount = 0;
-	int32 SkyLightCount = 0;
-	int32 FogCount = 0;
-
-	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	const TArray<int32>& PresetIndices = DemoTable.GetPresetIndicesForLevel(CurrentLevelIndex);
+	if (PresetIndices.IsEmpty())
 	{
-		AActor* Actor = *ActorIt;
-
-		TInlineComponentArray<UDirectionalLightComponent*> DirectionalLights(Actor);
-		for (UDirectionalLightComponent* DirectionalLight : DirectionalLights)
-		{
-			if (DirectionalLight == nullptr)
-			{
-				continue;
-			}
-
-			FRotator NewRotation = DirectionalLight->GetComponentRotation();
-			NewRotation.Pitch = Preset.SunPitch;
-			DirectionalLight->SetWorldRotation(NewRotation);
-			DirectionalLight->SetIntensity(Preset.SunIntensity);
-			DirectionalLight->SetLightColor(Preset.SunColor, false);
-			DirectionalLight->MarkRenderStateDirty();
-			++DirectionalLightCount;
-		}
+		return;
+	}
 
-		TInlineComponentArray<USkyLightComponent*> SkyLights(Actor);
-		for (USkyLightComponent* SkyLight : SkyLights)
-		{
-			if (SkyLight == nullptr)
-			{
-				continue;
-			}
+	LightingPresetSlot = FMath::Clamp(LightingPresetSlot, 0, PresetIndices.Num() - 1);
+	const FEDSLightingPreset& Preset = DemoTable.Presets[PresetIndices[LightingPresetSlot]];
 
-			SkyLight->SetIntensity(Preset.SkyIntensity);
-			SkyLight->RecaptureSky();
-			++SkyLightCount;
-		}
+	UEDSLightingIndexSubsystem* LightingIndex = World->GetSubsystem<UEDSLightingIndexSubsystem>();
+	if (LightingIndex == nullptr)
+	{
+		return;
+	}
 
-		TInlineComponentArray<UExponentialHeightFogComponent*> FogComponents(Actor);
-		for (UExponentialHeightFogComponent* FogComponent : FogComponents)
-		{
-			if (FogComponent == nullptr)
-			{
-				continue;
-			}
+	FEDSLightingPresetValues PresetValues;
+	PresetValues.SunPitch = Preset.SunPitch;
+	PresetValues.SunIntensity = Preset.SunIntensity;
+	PresetValues.SunColor = Preset.SunColor;
+	PresetValues.SkyIntensity = Preset.SkyIntensity;
+	PresetValues.FogDensity = Preset.FogDensity;
+	PresetValues.FogColor = Preset.FogColor;
 
-			FogComponent->SetFogDensity(Preset.FogDensity);
-			FogComponent->SetFogInscatteringColor(Preset.FogColor);
-			FogComponent->MarkRenderStateDirty();
-			++FogCount;
-		}
+	// the initial preset snaps, changes afterwards blend from whatever is currently shown
+	if (bLightingPresetApplied)
+	{
+		LightingPresetBlender.BlendTo(PresetValues, CVarLightingPresetBlendSeconds.GetValueOnGameThread());
+	}
+	else
+	{
+		LightingPresetBlender.SnapTo(PresetValues);
 	}
 
+	ApplyLightingValues(LightingPresetBlender.GetCurrentValues());
 	bLightingPresetApplied = true;
 
 	if (bShowMessage && GEngine != nullptr)
 	{
+		TArray<UDirectionalLightComponent*> DirectionalLights;
+		TArray<USkyLightComponent*> SkyLights;
+		TArray<UExponentialHeightFogComponent*> FogComponents;
+		LightingIndex->GetDirectionalLights(DirectionalLights);
+		LightingIndex->GetSkyLights(SkyLights);
+		LightingIndex->GetHeightFogs(FogComponents);
+
 		GEngine->AddOnScreenDebugMessage(
 			-1,
 			4.0f,
 			FColor::Green,
 			FString::Printf(
 				TEXT("Lighting: %s (Directional=%d, Sky=%d, Fog=%d)"),
-				Preset.Name,
-				DirectionalLightCount,
-				SkyLightCount,
-				FogCount
+				*Preset.Name.ToString(),
+				DirectionalLights.Num(),
+				SkyLights.Num(),
+				FogComponents.Num()
 			)
 		);
 	}
 }
 
-void UElectricDreamsHotkeySubsystem::CycleLevel(bool bForward)
+void UElectricDreamsHotkeySubsystem::TickLightingPreset(float DeltaTime)
 {
-	UWorld* World = GetWorld();
-	if (World == nullptr)
+	if (LightingPresetBlender.Tick(DeltaTime))
 	{
-		return;
+		ApplyLightingValues(LightingPresetBlender.GetCurrentValues());
 	}
 
-	static const TArray<FString> LevelRotation = {
-		TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Boat_Cinematic_Map"),
-		TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Map"),
-		TEXT("/Game/TropicalIslandPack/Maps/Sublevel/TropicalIslandMap_Environment"),
-		TEXT("/Game/Levels/ElectricDreams_Env"),
-		TEXT("/Game/TropicalIslandPack/Maps/MainLevel/TropicalIsland_Map_Overcast")
-	};
-
-	FString CurrentMapName = World->GetMapName();
-	if (!World->StreamingLevelsPrefix.IsEmpty())
+	if (!bSkyRecapturePending)
 	{
-		CurrentMapName.RemoveFromStart(World->StreamingLevelsPrefix);
+		return;
 	}
 
-	int32 CurrentIndex = INDEX_NONE;
-	for (int32 Index = 0; Index < LevelRotation.Num(); ++Index)
+	// sky captures are expensive, so during a blend they only happen every so often. The last one catches the final values
+	const double CurrentSeconds = FPlatformTime::Seconds();
+	if (CurrentSeconds - LastSkyRecaptureTimeSeconds < CVarLightingSkyRecaptureIntervalSeconds.GetValueOnGameThread())
 	{
-		const FString ShortName = FPackageName::GetShortName(LevelRotation[Index]);
-		if (ShortName.Equals(CurrentMapName, ESearchCase::IgnoreCase))
-		{
-			CurrentIndex = Index;
-			break;
-		}
+		return;
 	}
 
-	int32 NextIndex = 0;
-	if (CurrentIndex != INDEX_NONE)
+	UWorld* World = GetWorld();
+	UEDSLightingIndexSubsystem* LightingIndex = World != nullptr ? World->GetSubsystem<UEDSLightingIndexSubsystem>() : nullptr;
+	if (LightingIndex == nullptr)
 	{
-		const int32 Direction = bForward ? 1 : -1;
-		NextIndex = (CurrentIndex + Direction + LevelRotation.Num()) % LevelRotation.Num();
+		return;
 	}
 
-	const FString& NextLevel = LevelRotation[NextIndex];
-	if (GEngine != nullptr)
+	TArray<USkyLightComponent*> SkyLights;
+	LightingIndex->GetSkyLights(SkyLights);
+	for (USkyLightComponent* SkyLight : SkyLights)
 	{
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			2.0f,
-			FColor::Green,
-			FString::Printf(TEXT("Loading: %s"), *FPackageName::GetShortName(NextLevel))
-		);
+		// real time captures update on their own
+		if (!SkyLight->IsRealTimeCaptureEnabled())
+		{
+			SkyLight->RecaptureSky();
+		}
 	}
 
-	UGameplayStatics::OpenLevel(World, FName(*NextLevel));
+	bSkyRecapturePending = false;
+	LastSkyRecaptureTimeSeconds = CurrentSeconds;
 }
 
-void UElectricDreamsHotkeySubsystem::ToggleVrMode()
+void UElectricDreamsHotkeySubsystem::ApplyLightingValues(const FEDSLightingPresetValues& Values)
 {
-	if (GEngine == nullptr)
+	UWorld* World = GetWorld();
+	UEDSLightingIndexSubsystem* LightingIndex = World != nullptr ? World->GetSubsystem<UEDSLightingIndexSubsystem>() : nullptr;
+	if (LightingIndex == nullptr)
 	{
 		return;
 	}
 
-	const FVrRuntimeState InitialState = QueryVrRuntimeState();
-	const bool bVrIsActive = IsVrFullyActive(InitialState);
-	if (bVrIsActive)
-	{
-		StopVrEnableRetry();
-
-		FVrRuntimeState NewState;
-		const bool bDisableApplied = TryApplyVrState(false, NewState);
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			bDisableApplied ? FColor::Green : FColor::Yellow,
-			FString::Printf(
-				TEXT("VR Disable Requested | XR=%s | HMDConnected=%d HMDEnabled=%d StereoEnabled=%d"),
-				*NewState.XrSystemName,
-				NewState.bHmdConnected ? 1 : 0,
-				NewState.bHmdEnabled ? 1 : 0,
-				NewState.bStereoEnabled ? 1 : 0
-			)
-		);
-		return;
-	}
+	// the setters below only update the render state when the value differs, so unchanged components cost nothing
+	bool bAnyValueChanged = false;
 
-	if (!InitialState.bHasXrSystem || !InitialState.bHasHmdDevice || !InitialState.bHasStereoDevice)
+	TArray<UDirectionalLightComponent*> DirectionalLights;
+	LightingIndex->GetDirectionalLights(DirectionalLights);
+	for (UDirectionalLightComponent* DirectionalLight : DirectionalLights)
 	{
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			6.0f,
-			FColor::Red,
-			FString::Printf(
-				TEXT("VR unavailable. XR=%s HMD=%d Stereo=%d. Ensure OpenXR is enabled and SteamVR is running."),
-				*InitialState.XrSystemName,
-				InitialState.bHasHmdDevice ? 1 : 0,
-				InitialState.bHasStereoDevice ? 1 : 0
-			)
-		);
-		return;
-	}
-
-	static IConsoleVariable* DlssgCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DlssgCVarName);
-	static IConsoleVariable* DlssSrCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DlssSrCVarName);
-	static IConsoleVariable* DeepDvcCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DeepDvcCVarName);
-	static IConsoleVariable* HiddenAreaMaskCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::HiddenAreaMaskCVarName);
-	static IConsoleVariable* OpenXRDepthLayerCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::OpenXRDepthLayerCVarName);
-	if (!bHasSyncedVrState || !bLastSyncedVrActive)
-	{
-		if (DlssgCVar != nullptr)
-		{
-			CachedNonVrDlssgValue = DlssgCVar->GetInt();
-		}
-		if (DlssSrCVar != nullptr)
-		{
-			CachedNonVrDlssSrValue = DlssSrCVar->GetInt();
-		}
-		if (DeepDvcCVar != nullptr)
+		FRotator NewRotation = DirectionalLight->GetComponentRotation();
+		if (!FMath::IsNearlyEqual(NewRotation.Pitch, double(Values.SunPitch), 1.0e-3))
 		{
-			CachedNonVrDeepDvcValue = DeepDvcCVar->GetInt();
+			NewRotation.Pitch = Values.SunPitch;
+			DirectionalLight->SetWorldRotation(NewRotation);
+			bAnyValueChanged = true;
 		}
-		if (HiddenAreaMaskCVar != nullptr)
+
+		if (DirectionalLight->Intensity != Values.SunIntensity)
 		{
-			CachedNonVrHiddenAreaMaskValue = HiddenAreaMaskCVar->GetInt();
+			DirectionalLight->SetIntensity(Values.SunIntensity);
+			bAnyValueChanged = true;
 		}
-		if (OpenXRDepthLayerCVar != nullptr)
+
+		if (DirectionalLight->LightColor != Values.SunColor.ToFColor(false))
 		{
-			CachedNonVrOpenXRDepthLayerValue = OpenXRDepthLayerCVar->GetInt();
+			DirectionalLight->SetLightColor(Values.SunColor, false);
+			bAnyValueChanged = true;
 		}
 	}
 
-	if (DlssgCVar != nullptr)
-	{
-		DlssgCVar->Set(ElectricDreamsHotkeys::DlssgDisabledValue, ECVF_SetByGameSetting);
-	}
-	if (DlssSrCVar != nullptr)
-	{
-		DlssSrCVar->Set(ElectricDreamsHotkeys::DlssSrDisabledValue, ECVF_SetByGameSetting);
-	}
-	if (DeepDvcCVar != nullptr)
-	{
-		DeepDvcCVar->Set(ElectricDreamsHotkeys::DeepDvcDisabledValue, ECVF_SetByGameSetting);
-	}
-	if (HiddenAreaMaskCVar != nullptr)
+	TArray<USkyLightComponent*> SkyLights;
+	LightingIndex->GetSkyLights(SkyLights);
+	for (USkyLightComponent* SkyLight : SkyLights)
 	{
-		HiddenAreaMaskCVar->Set(ElectricDreamsHotkeys::HiddenAreaMaskDisabledValue, ECVF_SetByGameSetting);
+		if (SkyLight->Intensity != Values.SkyIntensity)
+		{
+			SkyLight->SetIntensity(Values.SkyIntensity);
+			bAnyValueChanged = true;
+		}
 	}
-	if (OpenXRDepthLayerCVar != nullptr)
+
+	TArray<UExponentialHeightFogComponent*> FogComponents;
+	LightingIndex->GetHeightFogs(FogComponents);
+	for (UExponentialHeightFogComponent* FogComponent : FogComponents)
 	{
-		OpenXRDepthLayerCVar->Set(ElectricDreamsHotkeys::OpenXRDepthLayerDisabledValue, ECVF_SetByGameSetting);
+		if (FogComponent->FogDensity != Values.FogDensity)
+		{
+			FogComponent->SetFogDensity(Values.FogDensity);
+			bAnyValueChanged = true;
+		}
+
+		if (FogComponent->FogInscatteringLuminance != Values.FogColor)
+		{
+			FogComponent->SetFogInscatteringColor(Values.FogColor);
+			bAnyValueChanged = true;
+		}
 	}
 
-	if (GEngine != nullptr)
+	if (bAnyValueChanged && SkyLights.Num() > 0)
 	{
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			FColor::Yellow,
-			TEXT("VR preflight: DLSS SR/FG, DeepDVC, hidden area mask and depth layer forced OFF.")
-		);
+		bSkyRecapturePending = true;
 	}
-
-	StartVrEnableRetry();
 }
 
-void UElectricDreamsHotkeySubsystem::TickVrEnableRetry()
+void UElectricDreamsHotkeySubsystem::CycleLevel(bool bForward)
 {
-	if (!bVrEnableRetryActive || GEngine == nullptr)
+	UWorld* World = GetWorld();
+	if (World == nullptr)
 	{
 		return;
 	}
 
-	const double CurrentSeconds = FPlatformTime::Seconds();
-	if (CurrentSeconds < NextVrEnableAttemptTimeSeconds)
+	if (DemoTable.Levels.IsEmpty())
 	{
 		return;
 	}
 
-	FVrRuntimeState StateAfterAttempt;
-	const bool bEnableApplied = TryApplyVrState(true, StateAfterAttempt);
-	const bool bVrActive = bEnableApplied && IsVrFullyActive(StateAfterAttempt);
+	const int32 NextIndex = GetAdjacentLevelIndex(bForward);
+	const FString& NextLevel = DemoTable.Levels[NextIndex].PackageName;
 
-	if (bVrActive)
+	bool bPreloaded = false;
+	if (UEDSLevelPreloadSubsystem* LevelPreloads = UGameInstance::GetSubsystem<UEDSLevelPreloadSubsystem>(World->GetGameInstance()))
 	{
-		StopVrEnableRetry();
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			FColor::Green,
-			FString::Printf(
-				TEXT("VR Enabled | XR=%s | HMDConnected=%d HMDEnabled=%d StereoEnabled=%d"),
-				*StateAfterAttempt.XrSystemName,
-				StateAfterAttempt.bHmdConnected ? 1 : 0,
-				StateAfterAttempt.bHmdEnabled ? 1 : 0,
-				StateAfterAttempt.bStereoEnabled ? 1 : 0
-			)
-		);
-		return;
+		bPreloaded = LevelPreloads->BeginTravel(NextLevel);
 	}
 
-	--RemainingVrEnableAttempts;
-	if (RemainingVrEnableAttempts <= 0)
-	{
-		StopVrEnableRetry();
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			7.0f,
-			FColor::Yellow,
-			FString::Printf(
-				TEXT("VR enable timed out | XR=%s | HMDConnected=%d HMDEnabled=%d StereoEnabled=%d. Keep SteamVR+PSVR2 app running and retry."),
-				*StateAfterAttempt.XrSystemName,
-				StateAfterAttempt.bHmdConnected ? 1 : 0,
-				StateAfterAttempt.bHmdEnabled ? 1 : 0,
-				StateAfterAttempt.bStereoEnabled ? 1 : 0
-			)
-		);
-		return;
-	}
-
-	NextVrEnableAttemptTimeSeconds = CurrentSeconds + ElectricDreamsHotkeys::VrEnableRetryIntervalSeconds;
-}
-
-void UElectricDreamsHotkeySubsystem::StartVrEnableRetry()
-{
-	bVrEnableRetryActive = true;
-	RemainingVrEnableAttempts = ElectricDreamsHotkeys::VrEnableRetryAttempts;
-	NextVrEnableAttemptTimeSeconds = FPlatformTime::Seconds();
-
 	if (GEngine != nullptr)
 	{
 		GEngine->AddOnScreenDebugMessage(
 			-1,
-			5.0f,
-			FColor::Yellow,
-			TEXT("VR enable requested. Attempting to activate OpenXR/SteamVR session...")
+			2.0f,
+			FColor::Green,
+			FString::Printf(TEXT("Loading: %s%s"), *FPackageName::GetShortName(NextLevel), bPreloaded ? TEXT(" (preloaded)") : TEXT(""))
 		);
 	}
-}
-
-void UElectricDreamsHotkeySubsystem::StopVrEnableRetry()
-{
-	bVrEnableRetryActive = false;
-	RemainingVrEnableAttempts = 0;
-	NextVrEnableAttemptTimeSeconds = 0.0;
-}
-
-void UElectricDreamsHotkeySubsystem::SyncVrRuntimeCvars()
-{
-	static IConsoleVariable* DlssgCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DlssgCVarName);
-	static IConsoleVariable* DlssSrCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DlssSrCVarName);
-	static IConsoleVariable* DeepDvcCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::DeepDvcCVarName);
-	static IConsoleVariable* HiddenAreaMaskCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::HiddenAreaMaskCVarName);
-	static IConsoleVariable* OpenXRDepthLayerCVar = IConsoleManager::Get().FindConsoleVariable(ElectricDreamsHotkeys::OpenXRDepthLayerCVarName);
-	if (DlssgCVar == nullptr && DlssSrCVar == nullptr && DeepDvcCVar == nullptr && HiddenAreaMaskCVar == nullptr && OpenXRDepthLayerCVar == nullptr)
-	{
-		return;
-	}
 
-	const FVrRuntimeState VrState = QueryVrRuntimeState();
-	const bool bVrActive = IsVrFullyActive(VrState);
-	const int32 CurrentDlssg = DlssgCVar != nullptr ? DlssgCVar->GetInt() : ElectricDreamsHotkeys::DlssgDisabledValue;
-	const int32 CurrentDlssSr = DlssSrCVar != nullptr ? DlssSrCVar->GetInt() : ElectricDreamsHotkeys::DlssSrDisabledValue;
-	const int32 CurrentDeepDvc = DeepDvcCVar != nullptr ? DeepDvcCVar->GetInt() : ElectricDreamsHotkeys::DeepDvcDisabledValue;
-	const int32 CurrentHiddenAreaMask = HiddenAreaMaskCVar != nullptr ? HiddenAreaMaskCVar->GetInt() : ElectricDreamsHotkeys::HiddenAreaMaskDisabledValue;
-	const int32 CurrentOpenXRDepthLayer = OpenXRDepthLayerCVar != nullptr ? OpenXRDepthLayerCVar->GetInt() : ElectricDreamsHotkeys::OpenXRDepthLayerDisabledValue;
-
-	if (bVrActive)
+	if (CVarLevelSeamlessTravel.GetValueOnGameThread() && World->GetNetMode() != NM_Client)
 	{
-		if (bHasSyncedVrState && !bLastSyncedVrActive)
-		{
-			CachedNonVrDlssgValue = CurrentDlssg;
-			CachedNonVrDlssSrValue = CurrentDlssSr;
-			CachedNonVrDeepDvcValue = CurrentDeepDvc;
-			CachedNonVrHiddenAreaMaskValue = CurrentHiddenAreaMask;
-			CachedNonVrOpenXRDepthLayerValue = CurrentOpenXRDepthLayer;
-		}
-
-		if (DlssgCVar != nullptr && CurrentDlssg != ElectricDreamsHotkeys::DlssgDisabledValue)
-		{
-			DlssgCVar->Set(ElectricDreamsHotkeys::DlssgDisabledValue, ECVF_SetByGameSetting);
-		}
-		if (DlssSrCVar != nullptr && CurrentDlssSr != ElectricDreamsHotkeys::DlssSrDisabledValue)
-		{
-			DlssSrCVar->Set(ElectricDreamsHotkeys::DlssSrDisabledValue, ECVF_SetByGameSetting);
-		}
-		if (DeepDvcCVar != nullptr && CurrentDeepDvc != ElectricDreamsHotkeys::DeepDvcDisabledValue)
-		{
-			DeepDvcCVar->Set(ElectricDreamsHotkeys::DeepDvcDisabledValue, ECVF_SetByGameSetting);
-		}
-		if (HiddenAreaMaskCVar != nullptr && CurrentHiddenAreaMask != ElectricDreamsHotkeys::HiddenAreaMaskDisabledValue)
-		{
-			HiddenAreaMaskCVar->Set(ElectricDreamsHotkeys::HiddenAreaMaskDisabledValue, ECVF_SetByGameSetting);
-		}
-		if (OpenXRDepthLayerCVar != nullptr && CurrentOpenXRDepthLayer != ElectricDreamsHotkeys::OpenXRDepthLayerDisabledValue)
-		{
-			OpenXRDepthLayerCVar->Set(ElectricDreamsHotkeys::OpenXRDepthLayerDisabledValue, ECVF_SetByGameSetting);
-		}
+		World->SeamlessTravel(NextLevel, true);
 	}
 	else
 	{
-		const int32 DesiredNonVrValue = FMath::Clamp(CachedNonVrDlssgValue, 0, 1);
-		if (DlssgCVar != nullptr && CurrentDlssg != DesiredNonVrValue)
-		{
-			DlssgCVar->Set(DesiredNonVrValue, ECVF_SetByGameSetting);
-		}
-
-		const int32 DesiredNonVrDlssSrValue = FMath::Clamp(CachedNonVrDlssSrValue, 0, 1);
-		if (DlssSrCVar != nullptr && CurrentDlssSr != DesiredNonVrDlssSrValue)
-		{
-			DlssSrCVar->Set(DesiredNonVrDlssSrValue, ECVF_SetByGameSetting);
-		}
-
-		const int32 DesiredNonVrDeepDvcValue = FMath::Clamp(CachedNonVrDeepDvcValue, 0, 1);
-		if (DeepDvcCVar != nullptr && CurrentDeepDvc != DesiredNonVrDeepDvcValue)
-		{
-			DeepDvcCVar->Set(DesiredNonVrDeepDvcValue, ECVF_SetByGameSetting);
-		}
-
-		const int32 DesiredNonVrHiddenAreaMaskValue = FMath::Clamp(CachedNonVrHiddenAreaMaskValue, 0, 1);
-		if (HiddenAreaMaskCVar != nullptr && CurrentHiddenAreaMask != DesiredNonVrHiddenAreaMaskValue)
-		{
-			HiddenAreaMaskCVar->Set(DesiredNonVrHiddenAreaMaskValue, ECVF_SetByGameSetting);
-		}
-
-		const int32 DesiredNonVrOpenXRDepthLayerValue = FMath::Clamp(CachedNonVrOpenXRDepthLayerValue, 0, 1);
-		if (OpenXRDepthLayerCVar != nullptr && CurrentOpenXRDepthLayer != DesiredNonVrOpenXRDepthLayerValue)
-		{
-			OpenXRDepthLayerCVar->Set(DesiredNonVrOpenXRDepthLayerValue, ECVF_SetByGameSetting);
-		}
-	}
-
-	const bool bStateChanged = !bHasSyncedVrState || bLastSyncedVrActive != bVrActive;
-	bHasSyncedVrState = true;
-	bLastSyncedVrActive = bVrActive;
-
-	if (bStateChanged && GEngine != nullptr)
-	{
-		const int32 FinalDlssgValue = DlssgCVar != nullptr ? DlssgCVar->GetInt() : -1;
-		const int32 FinalDlssSrValue = DlssSrCVar != nullptr ? DlssSrCVar->GetInt() : -1;
-		const int32 FinalDeepDvcValue = DeepDvcCVar != nullptr ? DeepDvcCVar->GetInt() : -1;
-		const int32 FinalHiddenAreaMaskValue = HiddenAreaMaskCVar != nullptr ? HiddenAreaMaskCVar->GetInt() : -1;
-		const int32 FinalOpenXRDepthLayerValue = OpenXRDepthLayerCVar != nullptr ? OpenXRDepthLayerCVar->GetInt() : -1;
-		const FString VrDlssgState = FString::Printf(
-			TEXT("VR %s | %s=%d | %s=%d | %s=%d | %s=%d | %s=%d"),
-			bVrActive ? TEXT("Active") : TEXT("Inactive"),
-			ElectricDreamsHotkeys::DlssgCVarName,
-			FinalDlssgValue,
-			ElectricDreamsHotkeys::DlssSrCVarName,
-			FinalDlssSrValue,
-			ElectricDreamsHotkeys::DeepDvcCVarName,
-			FinalDeepDvcValue,
-			ElectricDreamsHotkeys::HiddenAreaMaskCVarName,
-			FinalHiddenAreaMaskValue,
-			ElectricDreamsHotkeys::OpenXRDepthLayerCVarName,
-			FinalOpenXRDepthLayerValue
-		);
-		UE_LOG(LogTemp, Display, TEXT("%s"), *VrDlssgState);
-		GEngine->AddOnScreenDebugMessage(
-			-1,
-			5.0f,
-			FColor::Green,
-			VrDlssgState
-		);
+		UGameplayStatics::OpenLevel(World, FName(*NextLevel));
 	}
 }
 
-bool UElectricDreamsHotkeySubsystem::TryApplyVrState(bool bEnableVr, FVrRuntimeState& OutState)
+int32 UElectricDreamsHotkeySubsystem::GetAdjacentLevelIndex(bool bForward) const
 {
-	OutState = QueryVrRuntimeState();
-
-	if (GEngine == nullptr)
-	{
-		return false;
-	}
-
-	IHeadMountedDisplay* HmdDevice = (GEngine->XRSystem.IsValid()) ? GEngine->XRSystem->GetHMDDevice() : nullptr;
-	UWorld* World = GetWorld();
-
-	if (HmdDevice != nullptr)
-	{
-		HmdDevice->EnableHMD(bEnableVr);
-	}
-
-	if (GEngine->StereoRenderingDevice.IsValid())
-	{
-		GEngine->StereoRenderingDevice->EnableStereo(bEnableVr);
-	}
-
-	if (World != nullptr)
+	// maps outside of the rotation start at the first entry
+	const int32 LevelCount = DemoTable.Levels.Num();
+	if (CurrentLevelIndex == INDEX_NONE || LevelCount == 0)
 	{
-		GEngine->Exec(World, *FString::Printf(TEXT("vr.bEnableHMD %s"), bEnableVr ? TEXT("1") : TEXT("0")));
-		GEngine->Exec(World, *FString::Printf(TEXT("vr.bEnableStereo %s"), bEnableVr ? TEXT("1") : TEXT("0")));
+		return 0;
 	}
 
-	OutState = QueryVrRuntimeState();
-	if (bEnableVr)
-	{
-		return IsVrFullyActive(OutState);
-	}
-
-	return !OutState.bHmdEnabled && !OutState.bStereoEnabled;
+	const int32 Direction = bForward ? 1 : -1;
+	return (CurrentLevelIndex + Direction + LevelCount) % LevelCount;
 }
 
-UElectricDreamsHotkeySubsystem::FVrRuntimeState UElectricDreamsHotkeySubsystem::QueryVrRuntimeState() const
+void UElectricDreamsHotkeySubsystem::UpdateLevelPreloads()
 {
-	FVrRuntimeState State;
-	if (GEngine == nullptr)
+	UWorld* World = GetWorld();
+	if (World == nullptr || World->WorldType != EWorldType::Game || DemoTable.Levels.IsEmpty())
 	{
-		return State;
+		// PIE duplicates maps under a different package name, so there's nothing to gain from preloading
+		return;
 	}
 
-	State.bHasXrSystem = GEngine->XRSystem.IsValid();
-	if (State.bHasXrSystem)
+	UEDSLevelPreloadSubsystem* LevelPreloads = UGameInstance::GetSubsystem<UEDSLevelPreloadSubsystem>(World->GetGameInstance());
+	if (LevelPreloads == nullptr)
 	{
-		State.XrSystemName = GEngine->XRSystem->GetSystemName().ToString();
-		if (IHeadMountedDisplay* HmdDevice = GEngine->XRSystem->GetHMDDevice())
-		{
-			State.bHasHmdDevice = true;
-			State.bHmdConnected = HmdDevice->IsHMDConnected();
-			State.bHmdEnabled = HmdDevice->IsHMDEnabled();
-		}
+		return;
 	}
 
-	State.bHasStereoDevice = GEngine->StereoRenderingDevice.IsValid();
-	if (State.bHasStereoDevice)
+	// forward first, that's the way the demo usually cycles
+	TArray<FString> PackageNames;
+	for (const bool bForward : { true, false })
 	{
-		State.bStereoEnabled = GEngine->StereoRenderingDevice->IsStereoEnabled();
+		const int32 LevelIndex = GetAdjacentLevelIndex(bForward);
+		if (LevelIndex != CurrentLevelIndex)
+		{
+			PackageNames.AddUnique(DemoTable.Levels[LevelIndex].PackageName);
+		}
 	}
 
-	return State;
+	LevelPreloads->UpdatePreloads(PackageNames);
 }
 
-bool UElectricDreamsHotkeySubsystem::IsVrFullyActive(const FVrRuntimeState& State) const
+void UElectricDreamsHotkeySubsystem::ToggleVrMode()
 {
-	return State.bHasXrSystem &&
-		State.bHasHmdDevice &&
-		State.bHasStereoDevice &&
-		State.bHmdConnected &&
-		State.bHmdEnabled &&
-		State.bStereoEnabled;
+	UWorld* World = GetWorld();
+	if (UEDSVrSubsystem* Vr = World != nullptr ? UGameInstance::GetSubsystem<UEDSVrSubsystem>(World->GetGameInstance()) : nullptr)
+	{
+		Vr->ToggleVr();
+	}
 }
@@ -4,31 +4,35 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "EDSDemoSettings.h"
+#include "Input/EDSHotkeyDispatcher.h"
+#include "Lighting/EDSLightingPresetBlender.h"
 #include "ElectricDreamsHotkeySubsystem.generated.h"
 
+struct IConsoleVariable;
+
 UCLASS()
 class ELECTRICDREAMSSAMPLE_API UElectricDreamsHotkeySubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual TStatId GetStatId() const override;
 	virtual bool IsTickableInEditor() const override { return false; }
 	virtual bool IsTickableWhenPaused() const override { return true; }
 
-private:
-	struct FVrRuntimeState
-	{
-		bool bHasXrSystem = false;
-		bool bHasHmdDevice = false;
-		bool bHasStereoDevice = false;
-		bool bHmdConnected = false;
-		bool bHmdEnabled = false;
-		bool bStereoEnabled = false;
-		FString XrSystemName = TEXT("None");
-	};
+	/** Number of lighting presets available on the current map */
+	int32 GetNumLightingPresets() const;
 
+	/** Snaps to a lighting preset of the current map without blending or an on-screen message */
+	void SetLightingPresetSlot(int32 Slot);
+
+private:
+	void ExecuteHotkeyAction(EEDSHotkeyAction Action, APlayerController* PlayerController);
+	static IConsoleVariable* FindCachedConsoleVariable(IConsoleVariable*& CachedCVar, const TCHAR* Name);
 	void ApplyVerticalReposition(APlayerController* PlayerController, float DeltaTime);
 	void ToggleHelpOverlay();
 	void DrawHelpOverlay() const;
@@ -36,29 +40,24 @@ private:
 	float GetMovementRateMultiplier() const;
 	void ToggleYAxisInversion(APlayerController* PlayerController);
 	void CycleLevel(bool bForward);
+	int32 GetAdjacentLevelIndex(bool bForward) const;
+	void UpdateLevelPreloads();
 	void CycleLightingPreset(bool bForward);
 	void ApplyLightingPreset(bool bShowMessage);
+	void TickLightingPreset(float DeltaTime);
+	void ApplyLightingValues(const FEDSLightingPresetValues& Values);
 	void ToggleVrMode();
-	void TickVrEnableRetry();
-	void StartVrEnableRetry();
-	void StopVrEnableRetry();
-	void SyncVrRuntimeCvars();
-	bool TryApplyVrState(bool bEnableVr, FVrRuntimeState& OutState);
-	FVrRuntimeState QueryVrRuntimeState() const;
-	bool IsVrFullyActive(const FVrRuntimeState& State) const;
 
-	int32 LightingPresetIndex = 1;
+	FEDSDemoRuntimeTable DemoTable;
+	FEDSHotkeyDispatcher HotkeyDispatcher;
+	FString HotkeyHelpText;
+	mutable IConsoleVariable* CachedMovementRateCVar = nullptr;
+	mutable IConsoleVariable* CachedInvertLookYCVar = nullptr;
+	int32 CurrentLevelIndex = INDEX_NONE;
+	int32 LightingPresetSlot = 0;
 	bool bLightingPresetApplied = false;
+	FEDSLightingPresetBlender LightingPresetBlender;
+	bool bSkyRecapturePending = false;
+	double LastSkyRecaptureTimeSeconds = 0.0;
 	bool bShowHelpOverlay = false;
-	bool bAutoVrStartupAttempted = false;
-	bool bVrEnableRetryActive = false;
-	bool bHasSyncedVrState = false;
-	bool bLastSyncedVrActive = false;
-	int32 CachedNonVrDlssgValue = 1;
-	int32 CachedNonVrDlssSrValue = 1;
-	int32 CachedNonVrDeepDvcValue = 0;
-	int32 CachedNonVrHiddenAreaMaskValue = 0;
-	int32 CachedNonVrOpenXRDepthLayerValue = 1;
-	double NextVrEnableAttemptTimeSeconds = 0.0;
-	int32 RemainingVrEnableAttempts = 0;
 };
@@ -24,8 +24,11 @@ public class ElectricDreamsSample : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"RHI",
+			"RenderCore",
 			"AudioModulation",
-			"HeadMountedDisplay"
+			"HeadMountedDisplay",
+			"HoverDrone",
+			"SP_Interpolators"
 		});
 
 		// Uncomment if you are using Slate UI
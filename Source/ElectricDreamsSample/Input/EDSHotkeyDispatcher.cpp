@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSHotkeyDispatcher.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerInput.h"
+
+void FEDSHotkeyDispatcher::Build(const TArray<FEDSHotkeyBinding>& Bindings)
+{
+	ChordsByKey.Reset();
+	NumBindings = 0;
+
+	for (const FEDSHotkeyBinding& Binding : Bindings)
+	{
+		if (!Binding.Key.IsValid() || Binding.Action >= EEDSHotkeyAction::Count)
+		{
+			continue;
+		}
+
+		FChord& Chord = ChordsByKey.FindOrAdd(Binding.Key).AddDefaulted_GetRef();
+		Chord.Action = Binding.Action;
+		Chord.ModifierKeys = Binding.ModifierKeys;
+		++NumBindings;
+	}
+
+	for (TPair<FKey, TArray<FChord>>& KeyChords : ChordsByKey)
+	{
+		KeyChords.Value.StableSort([](const FChord& A, const FChord& B) { return A.ModifierKeys.Num() > B.ModifierKeys.Num(); });
+	}
+
+	SortedBindings = Bindings;
+	SortedBindings.StableSort([](const FEDSHotkeyBinding& A, const FEDSHotkeyBinding& B) { return A.Action < B.Action; });
+}
+
+uint32 FEDSHotkeyDispatcher::Dispatch(TConstArrayView<FKey> JustPressedKeys, TFunctionRef<bool(const FKey&)> IsKeyDown) const
+{
+	uint32 ActionMask = 0;
+
+	for (const FKey& Key : JustPressedKeys)
+	{
+		const TArray<FChord>* Chords = ChordsByKey.Find(Key);
+		if (Chords == nullptr)
+		{
+			continue;
+		}
+
+		for (const FChord& Chord : *Chords)
+		{
+			const bool bModifiersHeld = !Chord.ModifierKeys.ContainsByPredicate([&IsKeyDown](const FKey& ModifierKey) { return !IsKeyDown(ModifierKey); });
+			if (bModifiersHeld)
+			{
+				ActionMask |= GetActionBit(Chord.Action);
+				break;
+			}
+		}
+	}
+
+	return ActionMask;
+}
+
+void FEDSHotkeyDispatcher::GatherJustPressedKeys(APlayerController& PlayerController, TArray<FKey, TInlineAllocator<8>>& OutKeys)
+{
+	OutKeys.Reset();
+
+	if (UPlayerInput* PlayerInput = PlayerController.PlayerInput)
+	{
+		// same test as UPlayerInput::WasJustPressed, for every key at once
+		for (const TPair<FKey, FKeyState>& KeyState : PlayerInput->GetKeyStateMap())
+		{
+			if (KeyState.Value.EventCounts[IE_Pressed].Num() > 0)
+			{
+				OutKeys.Add(KeyState.Key);
+			}
+		}
+	}
+}
+
+FString FEDSHotkeyDispatcher::DescribeBindings() const
+{
+	const UEnum* ActionEnum = StaticEnum<EEDSHotkeyAction>();
+
+	FString Description;
+	for (int32 BindingIndex = 0; BindingIndex < SortedBindings.Num(); )
+	{
+		const EEDSHotkeyAction Action = SortedBindings[BindingIndex].Action;
+
+		TArray<FString> KeyNames;
+		for (; BindingIndex < SortedBindings.Num() && SortedBindings[BindingIndex].Action == Action; ++BindingIndex)
+		{
+			const FEDSHotkeyBinding& Binding = SortedBindings[BindingIndex];
+			if (!Binding.Key.IsValid())
+			{
+				continue;
+			}
+
+			FString KeyName;
+			for (const FKey& ModifierKey : Binding.ModifierKeys)
+			{
+				KeyName += ModifierKey.GetDisplayName().ToString() + TEXT(" + ");
+			}
+			KeyName += Binding.Key.GetDisplayName().ToString();
+			KeyNames.Add(MoveTemp(KeyName));
+		}
+
+		if (!KeyNames.IsEmpty())
+		{
+			Description += FString::Printf(TEXT("%s: %s\n"), *FString::Join(KeyNames, TEXT(" / ")), *ActionEnum->GetDisplayNameTextByValue(int64(Action)).ToString());
+		}
+	}
+
+	return Description;
+}
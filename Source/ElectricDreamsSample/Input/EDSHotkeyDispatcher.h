@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EDSDemoSettings.h"
+
+class APlayerController;
+
+/**
+ * Maps the pressed keys of a frame to demo hotkey actions. The binding table is indexed by key once, so a
+ * frame only costs a lookup per pressed key instead of a query per binding. When several bindings share a
+ * key, the one with the most modifiers held wins, so chords take precedence over the plain key.
+ */
+class ELECTRICDREAMSSAMPLE_API FEDSHotkeyDispatcher
+{
+public:
+	static_assert(uint8(EEDSHotkeyAction::Count) <= 32, "Hotkey actions need to fit into the action mask");
+
+	void Build(const TArray<FEDSHotkeyBinding>& Bindings);
+
+	/** Returns a mask of the triggered actions, see GetActionBit */
+	uint32 Dispatch(TConstArrayView<FKey> JustPressedKeys, TFunctionRef<bool(const FKey&)> IsKeyDown) const;
+
+	/** Collects the keys that went down this frame in a single pass over the player input key states */
+	static void GatherJustPressedKeys(APlayerController& PlayerController, TArray<FKey, TInlineAllocator<8>>& OutKeys);
+
+	static uint32 GetActionBit(EEDSHotkeyAction Action) { return 1u << uint32(Action); }
+
+	int32 GetNumBindings() const { return NumBindings; }
+
+	/** One line per action listing its keys, for the help overlay */
+	FString DescribeBindings() const;
+
+private:
+	struct FChord
+	{
+		EEDSHotkeyAction Action;
+		TArray<FKey> ModifierKeys;
+	};
+
+	/** Chords per key, most modifiers first */
+	TMap<FKey, TArray<FChord>> ChordsByKey;
+	TArray<FEDSHotkeyBinding> SortedBindings;
+	int32 NumBindings = 0;
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSLevelPreloadSubsystem.h"
+#include "EDSLevelPreloader.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSLevelPreloadSubsystem)
+
+static TAutoConsoleVariable<bool> CVarLevelPreload(
+	TEXT("ElectricDreams.Levels.Preload"),
+	true,
+	TEXT("Preload the next and previous map of the level rotation in the background (default = true)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLevelPreloadBudgetMB(
+	TEXT("ElectricDreams.Levels.PreloadBudgetMB"),
+	2048,
+	TEXT("Memory budget in MB for preloaded maps. No further maps get preloaded once it's used up (default = 2048)"),
+	ECVF_Default);
+
+void UEDSLevelPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Preloader = MakeShared<FEDSLevelPreloader>();
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UEDSLevelPreloadSubsystem::OnPostLoadMap);
+}
+
+void UEDSLevelPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	Preloader.Reset();
+
+	Super::Deinitialize();
+}
+
+void UEDSLevelPreloadSubsystem::UpdatePreloads(const TArray<FString>& PackageNames)
+{
+	if (!Preloader.IsValid())
+	{
+		return;
+	}
+
+	Preloader->SetMemoryBudgetBytes(int64(FMath::Max(0, CVarLevelPreloadBudgetMB.GetValueOnGameThread())) * 1024 * 1024);
+	Preloader->SetPreloadTargets(CVarLevelPreload.GetValueOnGameThread() ? PackageNames : TArray<FString>());
+}
+
+bool UEDSLevelPreloadSubsystem::BeginTravel(const FString& PackageName)
+{
+	TravelPackageName = PackageName;
+	TravelStartSeconds = FPlatformTime::Seconds();
+	bTravelPreloaded = IsPreloaded(PackageName);
+
+	// free everything else before the old map gets collected
+	if (Preloader.IsValid())
+	{
+		Preloader->ReleaseAllExcept(PackageName);
+	}
+
+	return bTravelPreloaded;
+}
+
+bool UEDSLevelPreloadSubsystem::IsPreloaded(const FString& PackageName) const
+{
+	return Preloader.IsValid() && Preloader->IsPreloaded(PackageName);
+}
+
+void UEDSLevelPreloadSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (TravelPackageName.IsEmpty() || LoadedWorld == nullptr || LoadedWorld->GetOutermost()->GetName() != TravelPackageName)
+	{
+		return;
+	}
+
+	LastTravelSeconds = FPlatformTime::Seconds() - TravelStartSeconds;
+	UE_LOG(LogTemp, Log, TEXT("Level switch to %s took %.2f s (%s)"), *TravelPackageName, LastTravelSeconds, bTravelPreloaded ? TEXT("preloaded") : TEXT("not preloaded"));
+
+	TravelPackageName.Reset();
+}
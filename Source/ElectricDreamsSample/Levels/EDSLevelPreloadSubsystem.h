@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+
+#include "EDSLevelPreloadSubsystem.generated.h"
+
+class FEDSLevelPreloader;
+
+/**
+ * Preloads the maps next to the current one in the demo level rotation, and keeps them loaded across map
+ * travel so cycling levels doesn't sit on a black screen while the map streams in. Also reports how long
+ * each level switch took.
+ */
+UCLASS()
+class ELECTRICDREAMSSAMPLE_API UEDSLevelPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// USubsystem implementation Begin
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	/** Preloads these maps, most important first, and releases any other preloaded map */
+	void UpdatePreloads(const TArray<FString>& PackageNames);
+
+	/** Call right before traveling to a map. Returns true if the map is already loaded */
+	bool BeginTravel(const FString& PackageName);
+
+	bool IsPreloaded(const FString& PackageName) const;
+
+	/** Duration of the last level switch started through BeginTravel, negative if there wasn't one yet */
+	double GetLastTravelSeconds() const { return LastTravelSeconds; }
+
+private:
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	TSharedPtr<FEDSLevelPreloader> Preloader;
+	FDelegateHandle PostLoadMapHandle;
+
+	FString TravelPackageName;
+	double TravelStartSeconds = 0.0;
+	bool bTravelPreloaded = false;
+	double LastTravelSeconds = -1.0;
+};
@@ -0,0 +1,244 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSLevelPreloader.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+namespace EDSLevelPreloader
+{
+	static int64 GetPackageDiskBytes(const IAssetRegistry* AssetRegistry, FName PackageName)
+	{
+		if (AssetRegistry != nullptr)
+		{
+			const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(PackageName);
+			if (PackageData.IsSet() && PackageData->DiskSize > 0)
+			{
+				return PackageData->DiskSize;
+			}
+		}
+
+		// not available for packages in IoStore containers
+		FPackagePath PackagePath;
+		if (FPackageName::DoesPackageExist(PackageName.ToString(), &PackagePath))
+		{
+			return FMath::Max<int64>(IFileManager::Get().FileSize(*PackagePath.GetLocalFullPath()), 0);
+		}
+		return 0;
+	}
+}
+
+void FEDSLevelPreloader::SetPreloadTargets(const TArray<FString>& PackageNames)
+{
+	TArray<FEntry> NewEntries;
+	NewEntries.Reserve(PackageNames.Num());
+
+	for (const FString& PackageName : PackageNames)
+	{
+		if (PackageName.IsEmpty() || NewEntries.ContainsByPredicate([&PackageName](const FEntry& Entry) { return Entry.PackageName == PackageName; }))
+		{
+			continue;
+		}
+
+		// keep what's already loaded or failed, everything else starts over
+		const int32 ExistingIndex = Entries.IndexOfByPredicate([&PackageName](const FEntry& Entry) { return Entry.PackageName == PackageName; });
+		if (ExistingIndex != INDEX_NONE)
+		{
+			NewEntries.Add(MoveTemp(Entries[ExistingIndex]));
+		}
+		else
+		{
+			FEntry& Entry = NewEntries.AddDefaulted_GetRef();
+			Entry.PackageName = PackageName;
+		}
+	}
+
+	Entries = MoveTemp(NewEntries);
+	StartNextLoad();
+}
+
+void FEDSLevelPreloader::ReleaseAllExcept(const FString& PackageName)
+{
+	Entries.RemoveAll([&PackageName](const FEntry& Entry) { return Entry.PackageName != PackageName; });
+}
+
+void FEDSLevelPreloader::SetMemoryBudgetBytes(int64 InMemoryBudgetBytes)
+{
+	MemoryBudgetBytes = InMemoryBudgetBytes;
+	StartNextLoad();
+}
+
+bool FEDSLevelPreloader::IsPreloaded(const FString& PackageName) const
+{
+	const FEntry* Entry = Entries.FindByPredicate([&PackageName](const FEntry& Entry) { return Entry.PackageName == PackageName; });
+	return Entry != nullptr && Entry->Package != nullptr;
+}
+
+int32 FEDSLevelPreloader::GetNumPreloaded() const
+{
+	int32 NumPreloaded = 0;
+	for (const FEntry& Entry : Entries)
+	{
+		NumPreloaded += Entry.Package != nullptr ? 1 : 0;
+	}
+	return NumPreloaded;
+}
+
+int64 FEDSLevelPreloader::GetHeldBytes() const
+{
+	int64 HeldBytes = 0;
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.Package != nullptr)
+		{
+			HeldBytes += Entry.EstimatedBytes;
+		}
+	}
+	return HeldBytes;
+}
+
+void FEDSLevelPreloader::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FEntry& Entry : Entries)
+	{
+		Collector.AddReferencedObject(Entry.Package);
+	}
+}
+
+FString FEDSLevelPreloader::GetReferencerName() const
+{
+	return TEXT("FEDSLevelPreloader");
+}
+
+void FEDSLevelPreloader::StartNextLoad()
+{
+	if (IsLoading())
+	{
+		return;
+	}
+
+	// a package too big for what's left waits for a release or a bigger budget, the smaller ones after it can still load
+	FEntry* Entry = Entries.FindByPredicate([this](const FEntry& Entry)
+	{
+		return Entry.Package == nullptr && !Entry.bFailed && FitsMemoryBudget(GetExpectedBytes(Entry.PackageName));
+	});
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	Entry->RequestTimeSeconds = FPlatformTime::Seconds();
+	Entry->UsedPhysicalAtRequest = FPlatformMemory::GetStats().UsedPhysical;
+	InFlightPackageName = Entry->PackageName;
+
+	LoadPackageAsync(InFlightPackageName, FLoadPackageAsyncDelegate::CreateSP(this, &FEDSLevelPreloader::OnPackageLoaded));
+}
+
+int64 FEDSLevelPreloader::GetExpectedBytes(const FString& PackageName) const
+{
+	if (const int64* Measured = MeasuredBytes.Find(PackageName))
+	{
+		return *Measured;
+	}
+
+	// without its own size there's nothing to go on, a budget can't be kept with it
+	const TArray<FDependencyBytes>& Dependencies = GetDependencyBytes(PackageName);
+	if (Dependencies.Num() == 0 || Dependencies[0].DiskBytes <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// dependencies already in memory cost nothing more. The package itself always counts, a released one may be gone by the time it loads
+	int64 ExpectedBytes = Dependencies[0].DiskBytes;
+	for (int32 DependencyIdx = 1; DependencyIdx < Dependencies.Num(); ++DependencyIdx)
+	{
+		if (FindObjectFast<UPackage>(nullptr, Dependencies[DependencyIdx].PackageName) == nullptr)
+		{
+			ExpectedBytes += Dependencies[DependencyIdx].DiskBytes;
+		}
+	}
+	return ExpectedBytes;
+}
+
+const TArray<FEDSLevelPreloader::FDependencyBytes>& FEDSLevelPreloader::GetDependencyBytes(const FString& PackageName) const
+{
+	if (const TArray<FDependencyBytes>* Cached = DependencyBytes.Find(PackageName))
+	{
+		return *Cached;
+	}
+
+	TArray<FDependencyBytes>& Dependencies = DependencyBytes.Add(PackageName);
+	IAssetRegistry* const AssetRegistry = IAssetRegistry::Get();
+
+	TArray<FName> PendingPackages = { FName(*PackageName) };
+	TSet<FName> VisitedPackages;
+	TArray<FName> PackageDependencies;
+	while (PendingPackages.Num() > 0)
+	{
+		const FName DependencyName = PendingPackages.Pop(EAllowShrinking::No);
+
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(DependencyName, &bAlreadyVisited);
+		if (bAlreadyVisited || FPackageName::IsScriptPackage(DependencyName.ToString()))
+		{
+			continue;
+		}
+
+		Dependencies.Add({ DependencyName, EDSLevelPreloader::GetPackageDiskBytes(AssetRegistry, DependencyName) });
+
+		if (AssetRegistry != nullptr)
+		{
+			PackageDependencies.Reset();
+			AssetRegistry->GetDependencies(DependencyName, PackageDependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+			PendingPackages.Append(PackageDependencies);
+		}
+	}
+	return Dependencies;
+}
+
+bool FEDSLevelPreloader::FitsMemoryBudget(int64 ExpectedBytes) const
+{
+	const int64 RemainingBytes = MemoryBudgetBytes - GetHeldBytes();
+	if (RemainingBytes <= 0 || ExpectedBytes == INDEX_NONE || ExpectedBytes > RemainingBytes)
+	{
+		return false;
+	}
+
+	// don't push the machine into paging for a map that may never be visited
+	return FPlatformMemory::GetStats().AvailablePhysical > uint64(RemainingBytes);
+}
+
+void FEDSLevelPreloader::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	InFlightPackageName.Reset();
+
+	const FString PackageNameString = PackageName.ToString();
+	FEntry* Entry = Entries.FindByPredicate([&PackageNameString](const FEntry& Entry) { return Entry.PackageName == PackageNameString; });
+	if (Entry != nullptr)
+	{
+		const double LoadSeconds = FPlatformTime::Seconds() - Entry->RequestTimeSeconds;
+		if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage != nullptr)
+		{
+			// only an estimate, anything else allocated during the load counts as well
+			const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+			Entry->Package = LoadedPackage;
+			Entry->EstimatedBytes = UsedPhysical > Entry->UsedPhysicalAtRequest ? int64(UsedPhysical - Entry->UsedPhysicalAtRequest) : 0;
+			if (Entry->EstimatedBytes > 0)
+			{
+				MeasuredBytes.Add(PackageNameString, Entry->EstimatedBytes);
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("Preloaded %s in %.2f s (~%.1f MB)"), *PackageNameString, LoadSeconds, double(Entry->EstimatedBytes) / (1024.0 * 1024.0));
+		}
+		else
+		{
+			Entry->bFailed = true;
+			UE_LOG(LogTemp, Warning, TEXT("Failed to preload %s after %.2f s"), *PackageNameString, LoadSeconds);
+		}
+	}
+
+	StartNextLoad();
+}
@@ -0,0 +1,83 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "UObject/UObjectGlobals.h"
+
+class UPackage;
+
+/**
+ * Keeps map packages loaded in the background, so traveling to them only has to initialize the world
+ * instead of loading it from disk. Packages load one at a time in the order they were requested, and
+ * only when their expected size fits into what the held packages leave of the memory budget. Packages
+ * of unknown size never do.
+ */
+class ELECTRICDREAMSSAMPLE_API FEDSLevelPreloader : public FGCObject, public TSharedFromThis<FEDSLevelPreloader>
+{
+public:
+	/** Preloads these long package names, most important first, and releases every other package */
+	void SetPreloadTargets(const TArray<FString>& PackageNames);
+
+	/** Releases every package except this one, e.g. right before traveling to it */
+	void ReleaseAllExcept(const FString& PackageName);
+
+	void SetMemoryBudgetBytes(int64 InMemoryBudgetBytes);
+
+	bool IsPreloaded(const FString& PackageName) const;
+	bool IsLoading() const { return !InFlightPackageName.IsEmpty(); }
+	int32 GetNumPreloaded() const;
+
+	/** Rough memory cost of the held packages, measured as the growth of used physical memory while each one loaded */
+	int64 GetHeldBytes() const;
+
+	/**
+	 * What loading a package is expected to cost: what it cost the last time it was preloaded, or else the size on disk of the package
+	 * and the hard dependencies it would pull into memory, which the loaded package rarely comes in under. INDEX_NONE when the package's
+	 * own size isn't known, e.g. for IoStore packages missing from the asset registry.
+	 */
+	int64 GetExpectedBytes(const FString& PackageName) const;
+
+	// FGCObject implementation Begin
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	// FGCObject implementation End
+
+private:
+	struct FEntry
+	{
+		FString PackageName;
+		TObjectPtr<UPackage> Package = nullptr;
+		double RequestTimeSeconds = 0.0;
+		uint64 UsedPhysicalAtRequest = 0;
+		int64 EstimatedBytes = 0;
+		bool bFailed = false;
+	};
+
+	struct FDependencyBytes
+	{
+		FName PackageName;
+		int64 DiskBytes = 0;
+	};
+
+	void StartNextLoad();
+
+	/** The package itself first, then every package it hard references, directly or not, with their sizes on disk. Cached, the walk isn't cheap */
+	const TArray<FDependencyBytes>& GetDependencyBytes(const FString& PackageName) const;
+	bool FitsMemoryBudget(int64 ExpectedBytes) const;
+	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/** Wanted packages, most important first */
+	TArray<FEntry> Entries;
+
+	/** Package currently being loaded, it may have been dropped from Entries since */
+	FString InFlightPackageName;
+
+	/** Memory each package took when it last got preloaded, kept across releases */
+	TMap<FString, int64> MeasuredBytes;
+
+	mutable TMap<FString, TArray<FDependencyBytes>> DependencyBytes;
+
+	int64 MemoryBudgetBytes = 0;
+};
@@ -0,0 +1,253 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSLightingIndexSubsystem.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Components/ExponentialHeightFogComponent.h"
+#include "Components/SkyLightComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSLightingIndexSubsystem)
+
+namespace EDSLightingIndex
+{
+	static bool MatchesFilter(const UActorComponent* Component, const FEDSLightingComponentFilter& Filter)
+	{
+		const AActor* Owner = Component->GetOwner();
+
+		if (Filter.Level != nullptr && (Owner == nullptr || Owner->GetLevel() != Filter.Level))
+		{
+			return false;
+		}
+
+		if (!Filter.Tag.IsNone() && !Component->ComponentHasTag(Filter.Tag) && (Owner == nullptr || !Owner->ActorHasTag(Filter.Tag)))
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename ComponentType>
+	static void Gather(const TArray<TWeakObjectPtr<ComponentType>>& Index, TArray<ComponentType*>& OutComponents, const FEDSLightingComponentFilter& Filter)
+	{
+		OutComponents.Reset();
+		for (const TWeakObjectPtr<ComponentType>& WeakComponent : Index)
+		{
+			ComponentType* Component = WeakComponent.Get();
+			if (Component != nullptr && Component->IsRegistered() && MatchesFilter(Component, Filter))
+			{
+				OutComponents.Add(Component);
+			}
+		}
+	}
+
+	template<typename ComponentType, typename PredicateType>
+	static void RemoveIf(TArray<TWeakObjectPtr<ComponentType>>& Index, PredicateType&& Predicate)
+	{
+		Index.RemoveAllSwap([&Predicate](const TWeakObjectPtr<ComponentType>& WeakComponent)
+		{
+			const ComponentType* Component = WeakComponent.Get();
+			return Component == nullptr || Predicate(Component);
+		});
+	}
+}
+
+void UEDSLightingIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UEDSLightingIndexSubsystem::OnLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UEDSLightingIndexSubsystem::OnLevelRemovedFromWorld);
+
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UEDSLightingIndexSubsystem::OnActorSpawned));
+		ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UEDSLightingIndexSubsystem::OnActorDestroyed));
+	}
+}
+
+void UEDSLightingIndexSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+
+	DirectionalLights.Reset();
+	SkyLights.Reset();
+	HeightFogs.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEDSLightingIndexSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	bool bShouldCreateSubsystem = Super::ShouldCreateSubsystem(Outer);
+
+	if (Outer)
+	{
+		if (UWorld* World = Outer->GetWorld())
+		{
+			bShouldCreateSubsystem = DoesSupportWorldType(World->WorldType) && bShouldCreateSubsystem;
+		}
+	}
+
+	return bShouldCreateSubsystem;
+}
+
+void UEDSLightingIndexSubsystem::OnWorldComponentsUpdated(UWorld& World)
+{
+	Super::OnWorldComponentsUpdated(World);
+
+	// the persistent level's actors were loaded before the spawn handler was there, so lookups before begin play see them too
+	RebuildIndex();
+}
+
+void UEDSLightingIndexSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// persistent level and anything streamed in before begin play
+	RebuildIndex();
+}
+
+bool UEDSLightingIndexSubsystem::DoesSupportWorldType(const EWorldType::Type World) const
+{
+	// Lighting presets are only applied in Game worlds (PIE included)
+	return (World == EWorldType::Game || World == EWorldType::PIE);
+}
+
+void UEDSLightingIndexSubsystem::GetDirectionalLights(TArray<UDirectionalLightComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter) const
+{
+	EDSLightingIndex::Gather(DirectionalLights, OutComponents, Filter);
+}
+
+void UEDSLightingIndexSubsystem::GetSkyLights(TArray<USkyLightComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter) const
+{
+	EDSLightingIndex::Gather(SkyLights, OutComponents, Filter);
+}
+
+void UEDSLightingIndexSubsystem::GetHeightFogs(TArray<UExponentialHeightFogComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter) const
+{
+	EDSLightingIndex::Gather(HeightFogs, OutComponents, Filter);
+}
+
+void UEDSLightingIndexSubsystem::RebuildIndex()
+{
+	DirectionalLights.Reset();
+	SkyLights.Reset();
+	HeightFogs.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		for (ULevel* Level : World->GetLevels())
+		{
+			if (Level != nullptr && Level->bIsVisible)
+			{
+				IndexLevel(Level);
+			}
+		}
+	}
+}
+
+void UEDSLightingIndexSubsystem::IndexActor(AActor* Actor)
+{
+	if (Actor == nullptr || Actor->IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	// one pass over the components instead of one per component type
+	Actor->ForEachComponent(false, [this](UActorComponent* Component)
+	{
+		if (UDirectionalLightComponent* DirectionalLight = Cast<UDirectionalLightComponent>(Component))
+		{
+			DirectionalLights.AddUnique(DirectionalLight);
+		}
+		else if (USkyLightComponent* SkyLight = Cast<USkyLightComponent>(Component))
+		{
+			SkyLights.AddUnique(SkyLight);
+		}
+		else if (UExponentialHeightFogComponent* HeightFog = Cast<UExponentialHeightFogComponent>(Component))
+		{
+			HeightFogs.AddUnique(HeightFog);
+		}
+	});
+}
+
+void UEDSLightingIndexSubsystem::UnindexActor(const AActor* Actor)
+{
+	const auto IsOwnedByActor = [Actor](const UActorComponent* Component) { return Component->GetOwner() == Actor; };
+	EDSLightingIndex::RemoveIf(DirectionalLights, IsOwnedByActor);
+	EDSLightingIndex::RemoveIf(SkyLights, IsOwnedByActor);
+	EDSLightingIndex::RemoveIf(HeightFogs, IsOwnedByActor);
+}
+
+int32 UEDSLightingIndexSubsystem::GetNumIndexedComponents() const
+{
+	return DirectionalLights.Num() + SkyLights.Num() + HeightFogs.Num();
+}
+
+void UEDSLightingIndexSubsystem::IndexLevel(ULevel* Level)
+{
+	for (AActor* Actor : Level->Actors)
+	{
+		IndexActor(Actor);
+	}
+}
+
+void UEDSLightingIndexSubsystem::UnindexLevel(const ULevel* Level)
+{
+	const auto IsInLevel = [Level](const UActorComponent* Component)
+	{
+		const AActor* Owner = Component->GetOwner();
+		return Owner == nullptr || Owner->GetLevel() == Level;
+	};
+	EDSLightingIndex::RemoveIf(DirectionalLights, IsInLevel);
+	EDSLightingIndex::RemoveIf(SkyLights, IsInLevel);
+	EDSLightingIndex::RemoveIf(HeightFogs, IsInLevel);
+}
+
+void UEDSLightingIndexSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (Level != nullptr && World == GetWorld())
+	{
+		IndexLevel(Level);
+	}
+}
+
+void UEDSLightingIndexSubsystem::OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// a null level means all levels got removed
+	if (Level == nullptr)
+	{
+		DirectionalLights.Reset();
+		SkyLights.Reset();
+		HeightFogs.Reset();
+	}
+	else
+	{
+		UnindexLevel(Level);
+	}
+}
+
+void UEDSLightingIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+	IndexActor(Actor);
+}
+
+void UEDSLightingIndexSubsystem::OnActorDestroyed(AActor* Actor)
+{
+	UnindexActor(Actor);
+}
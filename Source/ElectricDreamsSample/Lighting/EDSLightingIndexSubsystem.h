@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "EDSLightingIndexSubsystem.generated.h"
+
+class AActor;
+class ULevel;
+class UDirectionalLightComponent;
+class UExponentialHeightFogComponent;
+class USkyLightComponent;
+
+/** Restricts which indexed lighting components get returned. An empty filter matches everything */
+struct FEDSLightingComponentFilter
+{
+	/** Matches when either the component or its owning actor has this tag */
+	FName Tag = NAME_None;
+
+	/** Matches components whose owning actor lives in this level */
+	const ULevel* Level = nullptr;
+};
+
+/**
+ * Keeps track of the directional lights, sky lights and height fogs of a world, so lighting presets
+ * don't have to walk every actor. Levels get indexed when they are added to the world and dropped when
+ * they are removed, actors spawned or destroyed at runtime are picked up through the world's actor handlers.
+ */
+UCLASS()
+class ELECTRICDREAMSSAMPLE_API UEDSLightingIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// USubsystem implementation Begin
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Called once the world's components got registered, which is when the loaded levels first get indexed */
+	virtual void OnWorldComponentsUpdated(UWorld& World) override;
+
+	/** Called when world is ready to start gameplay before the game mode transitions to the correct state and call BeginPlay on all actors */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	void GetDirectionalLights(TArray<UDirectionalLightComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter = FEDSLightingComponentFilter()) const;
+	void GetSkyLights(TArray<USkyLightComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter = FEDSLightingComponentFilter()) const;
+	void GetHeightFogs(TArray<UExponentialHeightFogComponent*>& OutComponents, const FEDSLightingComponentFilter& Filter = FEDSLightingComponentFilter()) const;
+
+	/** Drops the current index and rebuilds it from all loaded levels */
+	void RebuildIndex();
+
+	/** Adds the lighting components of an actor. Already indexed components are skipped, so this also picks up components added to an actor after it spawned */
+	void IndexActor(AActor* Actor);
+
+	/** Removes all components owned by an actor */
+	void UnindexActor(const AActor* Actor);
+
+	int32 GetNumIndexedComponents() const;
+
+protected:
+	// Called when determining whether to create this Subsystem
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void IndexLevel(ULevel* Level);
+	void UnindexLevel(const ULevel* Level);
+
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	TArray<TWeakObjectPtr<UDirectionalLightComponent>> DirectionalLights;
+	TArray<TWeakObjectPtr<USkyLightComponent>> SkyLights;
+	TArray<TWeakObjectPtr<UExponentialHeightFogComponent>> HeightFogs;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+};
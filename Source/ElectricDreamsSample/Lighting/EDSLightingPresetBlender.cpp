@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSLightingPresetBlender.h"
+
+namespace EDSLightingPresetBlender
+{
+	// a critically damped spring is within ~1% of its target after NaturalFrequency * t = 6.6
+	constexpr float SettleFactor = 6.6f;
+
+	static FVector ToVector(const FLinearColor& Color)
+	{
+		return FVector(Color.R, Color.G, Color.B);
+	}
+
+	static FLinearColor ToColor(const FVector& Vector)
+	{
+		return FLinearColor(
+			FMath::Max(0.0f, float(Vector.X)),
+			FMath::Max(0.0f, float(Vector.Y)),
+			FMath::Max(0.0f, float(Vector.Z))
+		);
+	}
+}
+
+void FEDSLightingPresetBlender::SnapTo(const FEDSLightingPresetValues& Values)
+{
+	TargetValues = Values;
+	CurrentValues = Values;
+	InitSprings(Values);
+	RemainingSeconds = 0.0f;
+	bBlending = false;
+	bHasValues = true;
+}
+
+void FEDSLightingPresetBlender::BlendTo(const FEDSLightingPresetValues& Values, float DurationSeconds)
+{
+	if (!bHasValues || DurationSeconds <= 0.0f)
+	{
+		SnapTo(Values);
+		return;
+	}
+
+	const float NaturalFrequency = EDSLightingPresetBlender::SettleFactor / DurationSeconds;
+	SunPitch.NaturalFrequency = NaturalFrequency;
+	SunIntensity.NaturalFrequency = NaturalFrequency;
+	SunColor.NaturalFrequency = NaturalFrequency;
+	SkyIntensity.NaturalFrequency = NaturalFrequency;
+	FogDensity.NaturalFrequency = NaturalFrequency;
+	FogColor.NaturalFrequency = NaturalFrequency;
+
+	TargetValues = Values;
+	RemainingSeconds = DurationSeconds;
+	bBlending = true;
+}
+
+bool FEDSLightingPresetBlender::Tick(float DeltaTime)
+{
+	if (!bBlending)
+	{
+		return false;
+	}
+
+	RemainingSeconds -= DeltaTime;
+	if (RemainingSeconds <= 0.0f)
+	{
+		// land exactly on the preset instead of creeping towards it
+		SnapTo(TargetValues);
+		return true;
+	}
+
+	CurrentValues.SunPitch = SunPitch.Eval(TargetValues.SunPitch, DeltaTime);
+	CurrentValues.SunIntensity = FMath::Max(0.0f, SunIntensity.Eval(TargetValues.SunIntensity, DeltaTime));
+	CurrentValues.SunColor = EDSLightingPresetBlender::ToColor(SunColor.Eval(EDSLightingPresetBlender::ToVector(TargetValues.SunColor), DeltaTime));
+	CurrentValues.SkyIntensity = FMath::Max(0.0f, SkyIntensity.Eval(TargetValues.SkyIntensity, DeltaTime));
+	CurrentValues.FogDensity = FMath::Max(0.0f, FogDensity.Eval(TargetValues.FogDensity, DeltaTime));
+	CurrentValues.FogColor = EDSLightingPresetBlender::ToColor(FogColor.Eval(EDSLightingPresetBlender::ToVector(TargetValues.FogColor), DeltaTime));
+	return true;
+}
+
+void FEDSLightingPresetBlender::InitSprings(const FEDSLightingPresetValues& Values)
+{
+	SunPitch.Init(Values.SunPitch);
+	SunIntensity.Init(Values.SunIntensity);
+	SunColor.Init(EDSLightingPresetBlender::ToVector(Values.SunColor));
+	SkyIntensity.Init(Values.SkyIntensity);
+	FogDensity.Init(Values.FogDensity);
+	FogColor.Init(EDSLightingPresetBlender::ToVector(Values.FogColor));
+}
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SPInterpolators.h"
+
+/** The values a lighting preset drives on the sun, sky light and height fog */
+struct FEDSLightingPresetValues
+{
+	float SunPitch = 0.0f;
+	float SunIntensity = 0.0f;
+	FLinearColor SunColor = FLinearColor::White;
+	float SkyIntensity = 0.0f;
+	float FogDensity = 0.0f;
+	FLinearColor FogColor = FLinearColor::White;
+};
+
+/**
+ * Blends between lighting presets with critically damped springs, so a preset change eases in over a
+ * configurable duration instead of snapping. Retargeting during a blend continues from the current values.
+ */
+class FEDSLightingPresetBlender
+{
+public:
+	/** Jumps straight to the given values */
+	void SnapTo(const FEDSLightingPresetValues& Values);
+
+	/** Starts blending towards the given values. A duration of 0 snaps */
+	void BlendTo(const FEDSLightingPresetValues& Values, float DurationSeconds);
+
+	/** Advances the blend. Returns false when there was nothing to blend */
+	bool Tick(float DeltaTime);
+
+	bool IsBlending() const { return bBlending; }
+	bool HasValues() const { return bHasValues; }
+	const FEDSLightingPresetValues& GetCurrentValues() const { return CurrentValues; }
+
+private:
+	void InitSprings(const FEDSLightingPresetValues& Values);
+
+	TCritDampSpringInterpolator<float> SunPitch;
+	TCritDampSpringInterpolator<float> SunIntensity;
+	TCritDampSpringInterpolator<FVector> SunColor;
+	TCritDampSpringInterpolator<float> SkyIntensity;
+	TCritDampSpringInterpolator<float> FogDensity;
+	TCritDampSpringInterpolator<FVector> FogColor;
+
+	FEDSLightingPresetValues TargetValues;
+	FEDSLightingPresetValues CurrentValues;
+	float RemainingSeconds = 0.0f;
+	bool bBlending = false;
+	bool bHasValues = false;
+};
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Benchmark/EDSBenchmarkStats.h"
+#include "Misc/AutomationTest.h"
+
+// Summarizes made up frame timings and checks the percentiles, hitch counting and the written summaries
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSBenchmarkStatsTest, "ElectricDreams.Benchmark.Stats",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSBenchmarkStatsTest::RunTest(const FString& Parameters)
+{
+	// 1..100 ms, shuffled so the summary has to sort
+	TArray<FEDSBenchmarkFrameSample> Samples;
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		FEDSBenchmarkFrameSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.FrameMs = float((Index * 37) % 100 + 1);
+		Sample.GameThreadMs = 4.0f;
+		Sample.RenderThreadMs = 6.0f;
+		Sample.RHIThreadMs = 2.0f;
+	}
+
+	const FEDSBenchmarkSegmentSummary Summary = EDSBenchmarkStats::Summarize(TEXT("Map"), TEXT("Dawn"), Samples, 50.0f);
+	TestEqual(TEXT("Frames"), Summary.NumFrames, 100);
+	TestEqual(TEXT("Average"), Summary.AvgFrameMs, 50.5f);
+	TestEqual(TEXT("Median"), Summary.MedianFrameMs, 50.0f);
+	TestEqual(TEXT("95th percentile"), Summary.P95FrameMs, 95.0f);
+	TestEqual(TEXT("99th percentile"), Summary.P99FrameMs, 99.0f);
+	TestEqual(TEXT("Max"), Summary.MaxFrameMs, 100.0f);
+	TestEqual(TEXT("Frames over the threshold are hitches"), Summary.NumHitches, 50);
+	TestEqual(TEXT("Game thread"), Summary.AvgGameThreadMs, 4.0f);
+	TestEqual(TEXT("Render thread"), Summary.AvgRenderThreadMs, 6.0f);
+	TestEqual(TEXT("RHI thread"), Summary.AvgRHIThreadMs, 2.0f);
+
+	const FEDSBenchmarkSegmentSummary Empty = EDSBenchmarkStats::Summarize(TEXT("Map"), TEXT("Night"), {}, 50.0f);
+	TestEqual(TEXT("Empty segment has no frames"), Empty.NumFrames, 0);
+	TestEqual(TEXT("Empty segment has no max"), Empty.MaxFrameMs, 0.0f);
+
+	const float SingleValue = 7.0f;
+	TestEqual(TEXT("Any percentile of one value"), EDSBenchmarkStats::GetPercentile(MakeArrayView(&SingleValue, 1), 99.0f), 7.0f);
+	TestEqual(TEXT("Percentile of nothing"), EDSBenchmarkStats::GetPercentile({}, 50.0f), 0.0f);
+
+	const TArray<FEDSBenchmarkSegmentSummary> Summaries = { Summary, Empty };
+	TArray<FString> CsvLines;
+	EDSBenchmarkStats::ToCsv(Summaries).ParseIntoArrayLines(CsvLines);
+	TestEqual(TEXT("Header and one line per segment"), CsvLines.Num(), 3);
+	if (CsvLines.Num() == 3)
+	{
+		TestEqual(TEXT("CSV line"), CsvLines[1], FString(TEXT("Map,Dawn,100,50.500,50.000,95.000,99.000,100.000,4.000,6.000,2.000,0.000,50")));
+	}
+
+	TMap<FString, FString> Metadata;
+	Metadata.Add(TEXT("warmupFrames"), TEXT("120"));
+	Metadata.Add(TEXT("build"), TEXT("Test \"1\""));
+	const FString Json = EDSBenchmarkStats::ToJson(Summaries, Metadata);
+	TestTrue(TEXT("Metadata sorted by key"), Json.Find(TEXT("\"build\"")) < Json.Find(TEXT("\"warmupFrames\"")));
+	TestTrue(TEXT("Quotes escaped"), Json.Contains(TEXT("\"Test \\\"1\\\"\"")));
+	TestTrue(TEXT("Segments in capture order"), Json.Find(TEXT("\"Dawn\"")) < Json.Find(TEXT("\"Night\"")));
+	TestEqual(TEXT("Same input, same output"), EDSBenchmarkStats::ToJson(Summaries, Metadata), Json);
+
+	return true;
+}
+
+#endif
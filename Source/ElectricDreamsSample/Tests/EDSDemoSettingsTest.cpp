@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EDSDemoSettings.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+// Parses demo settings the way they appear in DefaultGame.ini and checks validation and the runtime table
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSDemoSettingsTest, "ElectricDreams.Settings.DemoConfig",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+namespace EDSDemoSettingsTest
+{
+	template <typename StructType>
+	static bool ImportStruct(FAutomationTestBase& Test, const TCHAR* Text, StructType& OutValue)
+	{
+		const TCHAR* End = StructType::StaticStruct()->ImportText(Text, &OutValue, nullptr, PPF_None, GWarn, StructType::StaticStruct()->GetName());
+		return Test.TestNotNull(FString::Printf(TEXT("Parsed %s"), Text), End);
+	}
+}
+
+bool FEDSDemoSettingsTest::RunTest(const FString& Parameters)
+{
+	const UEDSDemoSettings* DefaultSettings = GetDefault<UEDSDemoSettings>();
+
+	TArray<FString> Errors;
+	TestTrue(TEXT("Project settings are valid"), DefaultSettings->Validate(Errors));
+	for (const FString& Error : Errors)
+	{
+		AddError(Error);
+	}
+
+	UEDSDemoSettings* Settings = NewObject<UEDSDemoSettings>(GetTransientPackage());
+	Settings->LightingPresets.Reset();
+	Settings->LevelRotation.Reset();
+
+	FEDSLightingPreset Preset;
+	EDSDemoSettingsTest::ImportStruct(*this, TEXT("(Name=\"Noon\",SunPitch=-60.0,SunIntensity=90000.0,SunColor=(R=1.0,G=1.0,B=0.9,A=1.0),SkyIntensity=1.0,FogDensity=0.002,FogColor=(R=0.6,G=0.7,B=0.9,A=1.0))"), Preset);
+	TestEqual(TEXT("Preset name"), Preset.Name, FName(TEXT("Noon")));
+	TestEqual(TEXT("Preset sun pitch"), Preset.SunPitch, -60.0f);
+	Settings->LightingPresets.Add(Preset);
+
+	EDSDemoSettingsTest::ImportStruct(*this, TEXT("(Name=\"Storm\",SunPitch=-30.0,SunIntensity=4000.0,SkyIntensity=0.3,FogDensity=0.03)"), Preset);
+	Settings->LightingPresets.Add(Preset);
+	Settings->DefaultLightingPreset = TEXT("Noon");
+
+	FEDSLevelRotationEntry Level;
+	EDSDemoSettingsTest::ImportStruct(*this, TEXT("(Map=\"/Game/Maps/First.First\")"), Level);
+	Settings->LevelRotation.Add(Level);
+
+	Level = FEDSLevelRotationEntry();
+	EDSDemoSettingsTest::ImportStruct(*this, TEXT("(Map=\"/Game/Maps/Second.Second\",LightingPresets=(\"Storm\",\"Noon\"),DefaultLightingPreset=\"Noon\")"), Level);
+	Settings->LevelRotation.Add(Level);
+
+	Errors.Reset();
+	FEDSDemoRuntimeTable Table;
+	TestTrue(TEXT("Parsed settings are valid"), Table.Build(*Settings, Errors));
+	TestEqual(TEXT("Parsed settings have no errors"), Errors.Num(), 0);
+	TestEqual(TEXT("Two presets"), Table.Presets.Num(), 2);
+	TestEqual(TEXT("Two levels"), Table.Levels.Num(), 2);
+
+	TestEqual(TEXT("Maps are found by short name"), Table.FindLevelIndex(TEXT("Second")), 1);
+	TestEqual(TEXT("Map lookup ignores case"), Table.FindLevelIndex(TEXT("first")), 0);
+	TestEqual(TEXT("Unknown maps are not in the rotation"), Table.FindLevelIndex(TEXT("Elsewhere")), INDEX_NONE);
+
+	TestEqual(TEXT("Maps without overrides use all presets"), Table.GetPresetIndicesForLevel(0).Num(), 2);
+	TestEqual(TEXT("Maps without overrides use the project default"), Table.GetDefaultPresetSlotForLevel(0), 0);
+	TestEqual(TEXT("Override keeps its order"), Table.GetPresetIndicesForLevel(1)[0], 1);
+	TestEqual(TEXT("Override default is a slot in its own list"), Table.GetDefaultPresetSlotForLevel(1), 1);
+
+	// broken configs are reported and skipped
+	const FEDSLightingPreset DuplicatePreset = Settings->LightingPresets[0];
+	Settings->LightingPresets.Add(DuplicatePreset);
+	Settings->LevelRotation[0].LightingPresets.Add(TEXT("Missing"));
+	Settings->LevelRotation.AddDefaulted();
+
+	Errors.Reset();
+	TestFalse(TEXT("Broken settings are invalid"), Table.Build(*Settings, Errors));
+	TestEqual(TEXT("Duplicate preset, unknown preset and missing map are reported"), Errors.Num(), 3);
+	TestEqual(TEXT("Duplicate presets are skipped"), Table.Presets.Num(), 2);
+	TestEqual(TEXT("Bad maps are skipped"), Table.Levels.Num(), 2);
+
+	return true;
+}
+
+#endif
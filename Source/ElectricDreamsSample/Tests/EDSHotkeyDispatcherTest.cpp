@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Input/EDSHotkeyDispatcher.h"
+#include "Misc/AutomationTest.h"
+
+// Fakes a key press for every configured binding and checks it triggers exactly its action
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSHotkeyDispatcherTest, "ElectricDreams.Input.HotkeyDispatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSHotkeyDispatcherTest::RunTest(const FString& Parameters)
+{
+	const TArray<FEDSHotkeyBinding>& Bindings = GetDefault<UEDSDemoSettings>()->HotkeyBindings;
+
+	FEDSHotkeyDispatcher Dispatcher;
+	Dispatcher.Build(Bindings);
+	TestEqual(TEXT("Every binding is indexed"), Dispatcher.GetNumBindings(), Bindings.Num());
+
+	uint32 CoveredActions = 0;
+	for (const FEDSHotkeyBinding& Binding : Bindings)
+	{
+		const uint32 ActionMask = Dispatcher.Dispatch({ Binding.Key }, [&Binding](const FKey& Key) { return Binding.ModifierKeys.Contains(Key); });
+		TestEqual(FString::Printf(TEXT("%s triggers only its action"), *Binding.Key.ToString()), ActionMask, FEDSHotkeyDispatcher::GetActionBit(Binding.Action));
+		CoveredActions |= ActionMask;
+	}
+
+	for (uint8 Action = 0; Action < uint8(EEDSHotkeyAction::Count); ++Action)
+	{
+		TestTrue(FString::Printf(TEXT("Action %d has a default binding"), Action), (CoveredActions & FEDSHotkeyDispatcher::GetActionBit(EEDSHotkeyAction(Action))) != 0);
+	}
+
+	const auto NothingHeld = [](const FKey&) { return false; };
+	TestEqual(TEXT("No keys, no actions"), Dispatcher.Dispatch({}, NothingHeld), 0u);
+	TestEqual(TEXT("Unbound keys are ignored"), Dispatcher.Dispatch({ EKeys::Z }, NothingHeld), 0u);
+	TestEqual(TEXT("Two keys of one action trigger it once"),
+		Dispatcher.Dispatch({ EKeys::F7, EKeys::Gamepad_DPad_Up }, NothingHeld),
+		FEDSHotkeyDispatcher::GetActionBit(EEDSHotkeyAction::NextLightingPreset));
+
+	// a chord wins over the plain key it's built on
+	TArray<FEDSHotkeyBinding> ChordBindings;
+	FEDSHotkeyBinding& PlainBinding = ChordBindings.AddDefaulted_GetRef();
+	PlainBinding.Action = EEDSHotkeyAction::NextLevel;
+	PlainBinding.Key = EKeys::Gamepad_FaceButton_Bottom;
+	FEDSHotkeyBinding& ChordBinding = ChordBindings.AddDefaulted_GetRef();
+	ChordBinding.Action = EEDSHotkeyAction::ToggleVr;
+	ChordBinding.Key = EKeys::Gamepad_FaceButton_Bottom;
+	ChordBinding.ModifierKeys.Add(EKeys::Gamepad_LeftShoulder);
+	Dispatcher.Build(ChordBindings);
+
+	TestEqual(TEXT("Plain key without the modifier"),
+		Dispatcher.Dispatch({ EKeys::Gamepad_FaceButton_Bottom }, NothingHeld),
+		FEDSHotkeyDispatcher::GetActionBit(EEDSHotkeyAction::NextLevel));
+	TestEqual(TEXT("Chord with the modifier held"),
+		Dispatcher.Dispatch({ EKeys::Gamepad_FaceButton_Bottom }, [](const FKey& Key) { return Key == EKeys::Gamepad_LeftShoulder; }),
+		FEDSHotkeyDispatcher::GetActionBit(EEDSHotkeyAction::ToggleVr));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Levels/EDSLevelPreloader.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+// Preloads the small engine entry map and checks the budget, release and failure handling of the preloader
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSLevelPreloaderTest, "ElectricDreams.Levels.Preloader",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSLevelPreloaderTest::RunTest(const FString& Parameters)
+{
+	const FString SmallMap = TEXT("/Engine/Maps/Entry");
+	const FString MissingMap = TEXT("/Game/EDSPreloaderTest/DoesNotExist");
+
+	TSharedRef<FEDSLevelPreloader> Preloader = MakeShared<FEDSLevelPreloader>();
+
+	Preloader->SetPreloadTargets({ SmallMap });
+	TestFalse(TEXT("Nothing loads without a memory budget"), Preloader->IsLoading());
+
+	// the entry map is a few KB on disk, so a budget with a byte left isn't enough for it. Neither is any budget when its size isn't known
+	Preloader->SetMemoryBudgetBytes(1);
+	TestFalse(TEXT("A map bigger than the remaining budget doesn't load"), Preloader->IsLoading() || Preloader->IsPreloaded(SmallMap));
+
+	const int64 ExpectedBytes = Preloader->GetExpectedBytes(SmallMap);
+	if (ExpectedBytes == INDEX_NONE)
+	{
+		Preloader->SetMemoryBudgetBytes(int64(256) * 1024 * 1024);
+		TestFalse(TEXT("A map of unknown size doesn't load"), Preloader->IsLoading() || Preloader->IsPreloaded(SmallMap));
+		AddInfo(FString::Printf(TEXT("This build doesn't know the size of %s, so it can't be preloaded"), *SmallMap));
+		return true;
+	}
+	AddInfo(FString::Printf(TEXT("%s and the dependencies it would load are expected to take %.1f KB"), *SmallMap, double(ExpectedBytes) / 1024.0));
+
+	Preloader->SetMemoryBudgetBytes(int64(256) * 1024 * 1024);
+	TestTrue(TEXT("Setting a budget starts the load"), Preloader->IsLoading() || Preloader->IsPreloaded(SmallMap));
+
+	const double StartTime = FPlatformTime::Seconds();
+	FlushAsyncLoading();
+	AddInfo(FString::Printf(TEXT("Preloading %s took %.2f ms"), *SmallMap, (FPlatformTime::Seconds() - StartTime) * 1000.0));
+
+	TestTrue(TEXT("Small map is preloaded"), Preloader->IsPreloaded(SmallMap));
+	TestEqual(TEXT("One package held"), Preloader->GetNumPreloaded(), 1);
+	TestNotNull(TEXT("Preloaded package is in memory"), FindPackage(nullptr, *SmallMap));
+
+	// a missing map fails without blocking the ones after it
+	AddExpectedError(TEXT("DoesNotExist"), EAutomationExpectedErrorFlags::Contains, 0);
+	Preloader->SetPreloadTargets({ MissingMap, SmallMap });
+	FlushAsyncLoading();
+	TestFalse(TEXT("Missing map is not preloaded"), Preloader->IsPreloaded(MissingMap));
+	TestTrue(TEXT("Already preloaded map is kept"), Preloader->IsPreloaded(SmallMap));
+	TestFalse(TEXT("Nothing left to load"), Preloader->IsLoading());
+
+	Preloader->ReleaseAllExcept(MissingMap);
+	TestEqual(TEXT("Released packages are dropped"), Preloader->GetNumPreloaded(), 0);
+	TestEqual(TEXT("Released packages don't count against the budget"), Preloader->GetHeldBytes(), int64(0));
+
+	return true;
+}
+
+#endif
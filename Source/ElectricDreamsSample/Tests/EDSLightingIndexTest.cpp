@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EDSTestWorld.h"
+#include "Lighting/EDSLightingIndexSubsystem.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Components/ExponentialHeightFogComponent.h"
+#include "Components/SkyLightComponent.h"
+#include "Engine/DirectionalLight.h"
+#include "Engine/ExponentialHeightFog.h"
+#include "Engine/SkyLight.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+// Follows the lighting index through runtime changes, and compares the old per actor scan against it in a synthetic world with 100k actors
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSLightingIndexUpdatesTest, "ElectricDreams.Lighting.IndexUpdates",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSLightingIndexUpdatesTest::RunTest(const FString& Parameters)
+{
+	const FEDSScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	UEDSLightingIndexSubsystem* LightingIndex = World->GetSubsystem<UEDSLightingIndexSubsystem>();
+	if (!TestNotNull(TEXT("Lighting index subsystem"), LightingIndex))
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<UDirectionalLightComponent*> DirectionalLights;
+	TArray<USkyLightComponent*> SkyLights;
+	TArray<UExponentialHeightFogComponent*> FogComponents;
+
+	// spawned at runtime
+	ADirectionalLight* Sun = World->SpawnActor<ADirectionalLight>(ADirectionalLight::StaticClass(), FTransform::Identity, SpawnParameters);
+	LightingIndex->GetDirectionalLights(DirectionalLights);
+	TestEqual(TEXT("Spawned actors are indexed"), DirectionalLights.Num(), 1);
+
+	// unregistered and registered again, e.g. by a construction script rerun
+	UDirectionalLightComponent* SunComponent = DirectionalLights.Num() ? DirectionalLights[0] : nullptr;
+	if (!TestNotNull(TEXT("Directional light component"), SunComponent))
+	{
+		return false;
+	}
+	SunComponent->UnregisterComponent();
+	LightingIndex->GetDirectionalLights(DirectionalLights);
+	TestEqual(TEXT("Unregistered components are skipped"), DirectionalLights.Num(), 0);
+	SunComponent->RegisterComponent();
+	LightingIndex->GetDirectionalLights(DirectionalLights);
+	TestEqual(TEXT("Registered again they are back"), DirectionalLights.Num(), 1);
+
+	// a component added to an actor that was already indexed
+	USkyLightComponent* AddedSkyLight = NewObject<USkyLightComponent>(Sun);
+	AddedSkyLight->RegisterComponent();
+	LightingIndex->IndexActor(Sun);
+	LightingIndex->GetSkyLights(SkyLights);
+	TestEqual(TEXT("Components added after spawning are indexed"), SkyLights.Num(), 1);
+	LightingIndex->IndexActor(Sun);
+	TestEqual(TEXT("Indexing an actor twice adds nothing"), LightingIndex->GetNumIndexedComponents(), 2);
+
+	// a level streaming out and back in, as the engine announces it
+	AExponentialHeightFog* Fog = World->SpawnActor<AExponentialHeightFog>(AExponentialHeightFog::StaticClass(), FTransform::Identity, SpawnParameters);
+	FWorldDelegates::LevelRemovedFromWorld.Broadcast(World->PersistentLevel, World);
+	TestEqual(TEXT("Removed levels leave the index"), LightingIndex->GetNumIndexedComponents(), 0);
+	FWorldDelegates::LevelAddedToWorld.Broadcast(World->PersistentLevel, World);
+	LightingIndex->GetHeightFogs(FogComponents);
+	TestEqual(TEXT("Added levels are indexed"), FogComponents.Num(), 1);
+	TestEqual(TEXT("Added levels bring all their components"), LightingIndex->GetNumIndexedComponents(), 3);
+
+	Fog->Destroy();
+	LightingIndex->GetHeightFogs(FogComponents);
+	TestEqual(TEXT("Destroyed actors leave the index"), FogComponents.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSLightingIndexBenchmark, "ElectricDreams.Lighting.IndexBenchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter
+)
+
+bool FEDSLightingIndexBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumFillerActors = 100000;
+
+	const FEDSScopedTestWorld TestWorld;
+	UWorld* const World = TestWorld.GetWorld();
+
+	UEDSLightingIndexSubsystem* LightingIndex = World->GetSubsystem<UEDSLightingIndexSubsystem>();
+	if (!TestNotNull(TEXT("Lighting index subsystem"), LightingIndex))
+	{
+		return false;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 ActorIndex = 0; ActorIndex < NumFillerActors; ++ActorIndex)
+	{
+		World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	}
+
+	World->SpawnActor<ADirectionalLight>(ADirectionalLight::StaticClass(), FTransform::Identity, SpawnParameters);
+	World->SpawnActor<ASkyLight>(ASkyLight::StaticClass(), FTransform::Identity, SpawnParameters);
+	AExponentialHeightFog* Fog = World->SpawnActor<AExponentialHeightFog>(AExponentialHeightFog::StaticClass(), FTransform::Identity, SpawnParameters);
+	Fog->Tags.Add(TEXT("EDSBenchmarkFog"));
+
+	// what ApplyLightingPreset used to do
+	double StartTime = FPlatformTime::Seconds();
+	int32 ScannedComponents = 0;
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		TInlineComponentArray<UDirectionalLightComponent*> DirectionalLights(*ActorIt);
+		TInlineComponentArray<USkyLightComponent*> SkyLights(*ActorIt);
+		TInlineComponentArray<UExponentialHeightFogComponent*> FogComponents(*ActorIt);
+		ScannedComponents += DirectionalLights.Num() + SkyLights.Num() + FogComponents.Num();
+	}
+	const double ScanMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	TArray<UDirectionalLightComponent*> DirectionalLights;
+	TArray<USkyLightComponent*> SkyLights;
+	TArray<UExponentialHeightFogComponent*> FogComponents;
+	LightingIndex->GetDirectionalLights(DirectionalLights);
+	LightingIndex->GetSkyLights(SkyLights);
+	LightingIndex->GetHeightFogs(FogComponents);
+	const double IndexMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	AddInfo(FString::Printf(TEXT("%d actors: actor scan %.3f ms, lighting index %.3f ms"), NumFillerActors + 3, ScanMilliseconds, IndexMilliseconds));
+
+	TestEqual(TEXT("Index finds the same components as the scan"), DirectionalLights.Num() + SkyLights.Num() + FogComponents.Num(), ScannedComponents);
+	TestEqual(TEXT("One directional light"), DirectionalLights.Num(), 1);
+	TestEqual(TEXT("One sky light"), SkyLights.Num(), 1);
+	TestEqual(TEXT("One height fog"), FogComponents.Num(), 1);
+
+	FEDSLightingComponentFilter TagFilter;
+	TagFilter.Tag = TEXT("EDSBenchmarkFog");
+	LightingIndex->GetHeightFogs(FogComponents, TagFilter);
+	TestEqual(TEXT("Tag filter matches the tagged actor"), FogComponents.Num(), 1);
+	LightingIndex->GetDirectionalLights(DirectionalLights, TagFilter);
+	TestEqual(TEXT("Tag filter skips untagged actors"), DirectionalLights.Num(), 0);
+
+	return true;
+}
+
+#endif
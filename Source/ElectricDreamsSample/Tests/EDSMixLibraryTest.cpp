@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Audio/EDSAudioSettings.h"
+#include "Audio/EDSMixLibrarySubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "SoundControlBusMix.h"
+#include "UObject/Package.h"
+
+// Loads mixes created by the test through the mix library and checks they resolve, stay resident and can be found by name
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSMixLibraryTest, "ElectricDreams.Audio.MixLibrary",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSMixLibraryTest::RunTest(const FString& Parameters)
+{
+	UPackage* TestPackage = CreatePackage(TEXT("/Temp/EDSMixLibraryTest"));
+	USoundControlBusMix* BaseMix = NewObject<USoundControlBusMix>(TestPackage, TEXT("CBM_TestBase"), RF_Public | RF_Transient);
+	USoundControlBusMix* QuietMix = NewObject<USoundControlBusMix>(TestPackage, TEXT("CBM_TestQuiet"), RF_Public | RF_Transient);
+
+	UEDSAudioSettings* Settings = NewObject<UEDSAudioSettings>(GetTransientPackage());
+	Settings->DefaultControlBusMix = FSoftObjectPath(BaseMix);
+	Settings->LiveControlBusMix.Reset();
+
+	FEDSNamedControlBusMix& NamedMix = Settings->NamedControlBusMixes.AddDefaulted_GetRef();
+	NamedMix.Name = TEXT("Quiet");
+	NamedMix.Mix = FSoftObjectPath(QuietMix);
+
+	UEDSMixLibrarySubsystem* MixLibrary = NewObject<UEDSMixLibrarySubsystem>(GetTransientPackage());
+
+	int32 NumCallbacks = 0;
+	MixLibrary->RequestMixes(*Settings, FSimpleDelegate::CreateLambda([&NumCallbacks]() { ++NumCallbacks; }));
+	MixLibrary->RequestMixes(*Settings, FSimpleDelegate::CreateLambda([&NumCallbacks]() { ++NumCallbacks; }));
+	MixLibrary->WaitForMixes();
+
+	TestTrue(TEXT("Mixes are loaded"), MixLibrary->HasLoadedMixes());
+	TestEqual(TEXT("Every request got its callback once"), NumCallbacks, 2);
+	TestEqual(TEXT("Default mix resolves"), MixLibrary->GetDefaultMix(), BaseMix);
+	TestNull(TEXT("Unset live mix stays empty"), MixLibrary->GetLiveMix());
+	TestEqual(TEXT("Named mix resolves"), MixLibrary->GetNamedMix(TEXT("Quiet")), QuietMix);
+	TestNull(TEXT("Unknown named mix"), MixLibrary->GetNamedMix(TEXT("Loud")));
+
+	// mixes stay resident through garbage collection, the same as across map travel
+	MixLibrary->AddToRoot();
+	Settings->AddToRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	TestEqual(TEXT("Resident mix survives garbage collection"), MixLibrary->GetNamedMix(TEXT("Quiet")), QuietMix);
+
+	MixLibrary->RequestMixes(*Settings, FSimpleDelegate::CreateLambda([&NumCallbacks]() { ++NumCallbacks; }));
+	TestEqual(TEXT("Requests after the load complete right away"), NumCallbacks, 3);
+
+	MixLibrary->RemoveFromRoot();
+	Settings->RemoveFromRoot();
+	MixLibrary->Deinitialize();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "VR/EDSVrStateMachine.h"
+#include "Misc/AutomationTest.h"
+
+// Runs the VR state machine against a fake XR runtime, so it works without a headset or an XR plugin
+
+namespace EDSVrStateMachineTest
+{
+	class FFakeVrRuntime : public IEDSVrRuntime
+	{
+	public:
+		virtual FEDSVrRuntimeState QueryState() const override
+		{
+			FEDSVrRuntimeState State;
+			State.bHasXrSystem = bAvailable;
+			State.bHasHmdDevice = bAvailable;
+			State.bHasStereoDevice = bAvailable;
+			State.bHmdConnected = bAvailable && bConnected;
+			State.bHmdEnabled = State.bHmdConnected && bEnabled;
+			State.bStereoEnabled = State.bHmdEnabled;
+			State.XrSystemName = TEXT("FakeXR");
+			return State;
+		}
+
+		virtual void SetVrEnabled(bool bEnable) override
+		{
+			bEnabled = bEnable;
+			++NumEnableCalls;
+		}
+
+		virtual FEDSVrRenderSettings CaptureRenderSettings() const override
+		{
+			return RenderSettings;
+		}
+
+		virtual void ApplyRenderSettings(const FEDSVrRenderSettings& Settings) override
+		{
+			RenderSettings = Settings;
+			++NumRenderSettingBatches;
+		}
+
+		bool bAvailable = true;
+		bool bConnected = false;
+		bool bEnabled = false;
+		int32 NumEnableCalls = 0;
+		int32 NumRenderSettingBatches = 0;
+		FEDSVrRenderSettings RenderSettings;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSVrStateMachineTest, "ElectricDreams.VR.StateMachine",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSVrStateMachineTest::RunTest(const FString& Parameters)
+{
+	using namespace EDSVrStateMachineTest;
+
+	FEDSVrRenderSettings FlatSettings;
+	FlatSettings.Dlssg = 1;
+	FlatSettings.DlssSr = 1;
+	FlatSettings.DeepDvc = 0;
+	FlatSettings.HiddenAreaMask = 0;
+	FlatSettings.OpenXRDepthLayer = 1;
+
+	FEDSVrBackoffSettings Backoff;
+	Backoff.InitialDelaySeconds = 0.25f;
+	Backoff.MaxDelaySeconds = 1.0f;
+	Backoff.DelayMultiplier = 2.0f;
+	Backoff.TimeoutSeconds = 3.0f;
+
+	FFakeVrRuntime Runtime;
+	Runtime.RenderSettings = FlatSettings;
+
+	FEDSVrStateMachine StateMachine(Runtime);
+	TArray<EEDSVrState> Transitions;
+	StateMachine.OnStateChanged.BindLambda([&Transitions](EEDSVrState, EEDSVrState NewState, const FEDSVrRuntimeState&) { Transitions.Add(NewState); });
+
+	// no runtime, nothing happens
+	Runtime.bAvailable = false;
+	TestFalse(TEXT("Enable fails without an XR runtime"), StateMachine.RequestEnable(0.0, Backoff));
+	TestEqual(TEXT("Stays inactive"), StateMachine.GetState(), EEDSVrState::Inactive);
+	TestEqual(TEXT("Render settings untouched"), Runtime.NumRenderSettingBatches, 0);
+
+	// headset not connected yet: backoff until the runtime reports it
+	Runtime.bAvailable = true;
+	TestTrue(TEXT("Enable starts"), StateMachine.RequestEnable(0.0, Backoff));
+	TestEqual(TEXT("Enabling"), StateMachine.GetState(), EEDSVrState::Enabling);
+	TestTrue(TEXT("VR render settings applied up front"), Runtime.RenderSettings == FEDSVrRenderSettings::ForVr());
+	TestEqual(TEXT("In one batch"), Runtime.NumRenderSettingBatches, 1);
+	TestEqual(TEXT("First attempt right away"), StateMachine.GetNumAttempts(), 1);
+
+	StateMachine.Tick(0.1);
+	TestEqual(TEXT("No retry before the initial delay"), StateMachine.GetNumAttempts(), 1);
+	StateMachine.Tick(0.25);
+	TestEqual(TEXT("Retry after the initial delay"), StateMachine.GetNumAttempts(), 2);
+	StateMachine.Tick(0.5);
+	TestEqual(TEXT("Delay doubles"), StateMachine.GetNumAttempts(), 2);
+	StateMachine.Tick(0.75);
+	TestEqual(TEXT("Retry after the doubled delay"), StateMachine.GetNumAttempts(), 3);
+
+	Runtime.bConnected = true;
+	StateMachine.NotifyRuntimeChanged(0.8);
+	TestEqual(TEXT("Headset event enables right away"), StateMachine.GetState(), EEDSVrState::Active);
+	TestEqual(TEXT("Still one render settings batch"), Runtime.NumRenderSettingBatches, 1);
+
+	const int32 NumEnableCallsWhenActive = Runtime.NumEnableCalls;
+	StateMachine.Tick(10.0);
+	TestEqual(TEXT("Nothing polled while active"), Runtime.NumEnableCalls, NumEnableCallsWhenActive);
+
+	// headset lost and found again
+	Runtime.bConnected = false;
+	StateMachine.NotifyHeadsetLost(11.0);
+	TestEqual(TEXT("Lost headset goes back to enabling"), StateMachine.GetState(), EEDSVrState::Enabling);
+	Runtime.bConnected = true;
+	StateMachine.NotifyRuntimeChanged(11.1);
+	TestEqual(TEXT("Reconnect is active again"), StateMachine.GetState(), EEDSVrState::Active);
+	TestEqual(TEXT("Reconnect doesn't touch render settings"), Runtime.NumRenderSettingBatches, 1);
+
+	StateMachine.RequestDisable();
+	TestEqual(TEXT("Disable goes inactive"), StateMachine.GetState(), EEDSVrState::Inactive);
+	TestFalse(TEXT("HMD turned off"), Runtime.bEnabled);
+	TestTrue(TEXT("Flat render settings restored"), Runtime.RenderSettings == FlatSettings);
+	TestEqual(TEXT("Restored in one batch"), Runtime.NumRenderSettingBatches, 2);
+	TestFalse(TEXT("Disabling isn't a timeout"), StateMachine.HasTimedOut());
+
+	// the headset never shows up
+	Runtime.bConnected = false;
+	StateMachine.RequestEnable(20.0, Backoff);
+	for (double Now = 20.0; Now <= 25.0 && StateMachine.GetState() == EEDSVrState::Enabling; Now += 0.05)
+	{
+		StateMachine.Tick(Now);
+	}
+	TestEqual(TEXT("Gives up after the timeout"), StateMachine.GetState(), EEDSVrState::Inactive);
+	TestTrue(TEXT("Reports the timeout"), StateMachine.HasTimedOut());
+	TestEqual(TEXT("0, 0.25, 0.75, 1.75, 2.75 and 3.75 s"), StateMachine.GetNumAttempts(), 6);
+	TestTrue(TEXT("Flat render settings restored after the timeout"), Runtime.RenderSettings == FlatSettings);
+	TestEqual(TEXT("One batch on the way in, one on the way out"), Runtime.NumRenderSettingBatches, 4);
+
+	TestEqual(TEXT("Transitions"), Transitions, TArray<EEDSVrState>({
+		EEDSVrState::Enabling, EEDSVrState::Active,
+		EEDSVrState::Enabling, EEDSVrState::Active,
+		EEDSVrState::Inactive,
+		EEDSVrState::Enabling, EEDSVrState::Inactive }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEDSVrStateMachineTravelTest, "ElectricDreams.VR.StateMachineTravel",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FEDSVrStateMachineTravelTest::RunTest(const FString& Parameters)
+{
+	using namespace EDSVrStateMachineTest;
+
+	FEDSVrRenderSettings FlatSettings;
+	FlatSettings.Dlssg = 1;
+	FlatSettings.DlssSr = 1;
+	FlatSettings.DeepDvc = 1;
+	FlatSettings.HiddenAreaMask = 1;
+	FlatSettings.OpenXRDepthLayer = 1;
+
+	FFakeVrRuntime Runtime;
+	Runtime.RenderSettings = FlatSettings;
+	Runtime.bConnected = true;
+
+	// VR is on when the world goes away, the next world's bStartInVR or F10 asks again
+	{
+		FEDSVrStateMachine StateMachine(Runtime);
+		StateMachine.RequestEnable(0.0, FEDSVrBackoffSettings());
+		TestEqual(TEXT("Active before travel"), StateMachine.GetState(), EEDSVrState::Active);
+
+		TestTrue(TEXT("Enabling again after travel succeeds"), StateMachine.RequestEnable(1.0, FEDSVrBackoffSettings()));
+		TestEqual(TEXT("Enabling again doesn't touch render settings"), Runtime.NumRenderSettingBatches, 1);
+
+		// the headset drops out and comes back, the VR settings are still on meanwhile
+		Runtime.bConnected = false;
+		StateMachine.NotifyHeadsetLost(2.0);
+		TestTrue(TEXT("Enabling while reconnecting succeeds"), StateMachine.RequestEnable(2.1, FEDSVrBackoffSettings()));
+		Runtime.bConnected = true;
+		StateMachine.NotifyRuntimeChanged(2.2);
+
+		StateMachine.RequestDisable();
+		TestTrue(TEXT("Disabling restores the settings from before VR, not the VR ones"), Runtime.RenderSettings == FlatSettings);
+	}
+
+	// the game instance shuts down with VR on, as UEDSVrSubsystem::Deinitialize does
+	{
+		FEDSVrStateMachine StateMachine(Runtime);
+		StateMachine.RequestEnable(10.0, FEDSVrBackoffSettings());
+		TestTrue(TEXT("VR render settings applied"), Runtime.RenderSettings == FEDSVrRenderSettings::ForVr());
+
+		StateMachine.RequestDisable();
+		TestTrue(TEXT("Teardown restores the flat render settings"), Runtime.RenderSettings == FlatSettings);
+		TestFalse(TEXT("Teardown turns the HMD off"), Runtime.bEnabled);
+	}
+
+	// the headset was turned on outside of the game
+	Runtime.bEnabled = true;
+	{
+		FEDSVrStateMachine StateMachine(Runtime);
+		StateMachine.SyncWithRuntime();
+		TestEqual(TEXT("A running headset is picked up as active"), StateMachine.GetState(), EEDSVrState::Active);
+		TestTrue(TEXT("And gets the VR render settings"), Runtime.RenderSettings == FEDSVrRenderSettings::ForVr());
+
+		StateMachine.RequestDisable();
+		TestTrue(TEXT("Turning it off restores the flat render settings"), Runtime.RenderSettings == FlatSettings);
+	}
+
+	// or came up later without being asked for
+	{
+		FEDSVrStateMachine StateMachine(Runtime);
+		Runtime.bEnabled = false;
+		StateMachine.SyncWithRuntime();
+		TestEqual(TEXT("An idle headset stays inactive"), StateMachine.GetState(), EEDSVrState::Inactive);
+
+		Runtime.bEnabled = true;
+		StateMachine.NotifyRuntimeChanged(20.0);
+		TestEqual(TEXT("A headset event picks it up"), StateMachine.GetState(), EEDSVrState::Active);
+
+		StateMachine.RequestDisable();
+		TestTrue(TEXT("Flat render settings restored"), Runtime.RenderSettings == FlatSettings);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,292 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSVrStateMachine.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "IHeadMountedDisplay.h"
+#include "IStereoRendering.h"
+#include "IXRTrackingSystem.h"
+
+namespace EDSVrStateMachine
+{
+	const TCHAR* DlssgCVarName = TEXT("r.Streamline.DLSSG.Enable");
+	const TCHAR* DlssSrCVarName = TEXT("r.NGX.DLSS.Enable");
+	const TCHAR* DeepDvcCVarName = TEXT("r.Streamline.DeepDVC.Enable");
+	const TCHAR* HiddenAreaMaskCVarName = TEXT("vr.HiddenAreaMask");
+	const TCHAR* OpenXRDepthLayerCVarName = TEXT("xr.OpenXRAllowDepthLayer");
+
+	static int32 GetValue(const IConsoleVariable* CVar)
+	{
+		return CVar != nullptr ? CVar->GetInt() : INDEX_NONE;
+	}
+
+	static void SetValue(IConsoleVariable* CVar, int32 Value)
+	{
+		if (CVar != nullptr && Value != INDEX_NONE && CVar->GetInt() != Value)
+		{
+			CVar->Set(Value, ECVF_SetByGameSetting);
+		}
+	}
+}
+
+FEDSVrRenderSettings FEDSVrRenderSettings::ForVr()
+{
+	FEDSVrRenderSettings Settings;
+	Settings.Dlssg = 0;
+	Settings.DlssSr = 0;
+	Settings.DeepDvc = 0;
+	Settings.HiddenAreaMask = 0;
+	Settings.OpenXRDepthLayer = 0;
+	return Settings;
+}
+
+FEDSVrRuntimeState FEDSEngineVrRuntime::QueryState() const
+{
+	FEDSVrRuntimeState State;
+	if (GEngine == nullptr)
+	{
+		return State;
+	}
+
+	State.bHasXrSystem = GEngine->XRSystem.IsValid();
+	if (State.bHasXrSystem)
+	{
+		State.XrSystemName = GEngine->XRSystem->GetSystemName().ToString();
+		if (IHeadMountedDisplay* HmdDevice = GEngine->XRSystem->GetHMDDevice())
+		{
+			State.bHasHmdDevice = true;
+			State.bHmdConnected = HmdDevice->IsHMDConnected();
+			State.bHmdEnabled = HmdDevice->IsHMDEnabled();
+		}
+	}
+
+	State.bHasStereoDevice = GEngine->StereoRenderingDevice.IsValid();
+	if (State.bHasStereoDevice)
+	{
+		State.bStereoEnabled = GEngine->StereoRenderingDevice->IsStereoEnabled();
+	}
+
+	return State;
+}
+
+void FEDSEngineVrRuntime::SetVrEnabled(bool bEnable)
+{
+	if (GEngine == nullptr)
+	{
+		return;
+	}
+
+	if (IHeadMountedDisplay* HmdDevice = GEngine->XRSystem.IsValid() ? GEngine->XRSystem->GetHMDDevice() : nullptr)
+	{
+		HmdDevice->EnableHMD(bEnable);
+	}
+
+	if (GEngine->StereoRenderingDevice.IsValid())
+	{
+		GEngine->StereoRenderingDevice->EnableStereo(bEnable);
+	}
+}
+
+FEDSVrRenderSettings FEDSEngineVrRuntime::CaptureRenderSettings() const
+{
+	FindConsoleVariables();
+
+	FEDSVrRenderSettings Settings;
+	Settings.Dlssg = EDSVrStateMachine::GetValue(DlssgCVar);
+	Settings.DlssSr = EDSVrStateMachine::GetValue(DlssSrCVar);
+	Settings.DeepDvc = EDSVrStateMachine::GetValue(DeepDvcCVar);
+	Settings.HiddenAreaMask = EDSVrStateMachine::GetValue(HiddenAreaMaskCVar);
+	Settings.OpenXRDepthLayer = EDSVrStateMachine::GetValue(OpenXRDepthLayerCVar);
+	return Settings;
+}
+
+void FEDSEngineVrRuntime::ApplyRenderSettings(const FEDSVrRenderSettings& Settings)
+{
+	FindConsoleVariables();
+
+	EDSVrStateMachine::SetValue(DlssgCVar, Settings.Dlssg);
+	EDSVrStateMachine::SetValue(DlssSrCVar, Settings.DlssSr);
+	EDSVrStateMachine::SetValue(DeepDvcCVar, Settings.DeepDvc);
+	EDSVrStateMachine::SetValue(HiddenAreaMaskCVar, Settings.HiddenAreaMask);
+	EDSVrStateMachine::SetValue(OpenXRDepthLayerCVar, Settings.OpenXRDepthLayer);
+
+	UE_LOG(LogTemp, Display, TEXT("VR render settings | %s=%d | %s=%d | %s=%d | %s=%d | %s=%d"),
+		EDSVrStateMachine::DlssgCVarName, EDSVrStateMachine::GetValue(DlssgCVar),
+		EDSVrStateMachine::DlssSrCVarName, EDSVrStateMachine::GetValue(DlssSrCVar),
+		EDSVrStateMachine::DeepDvcCVarName, EDSVrStateMachine::GetValue(DeepDvcCVar),
+		EDSVrStateMachine::HiddenAreaMaskCVarName, EDSVrStateMachine::GetValue(HiddenAreaMaskCVar),
+		EDSVrStateMachine::OpenXRDepthLayerCVarName, EDSVrStateMachine::GetValue(OpenXRDepthLayerCVar));
+}
+
+void FEDSEngineVrRuntime::FindConsoleVariables() const
+{
+	// plugin cvars may register late, look again for the ones that are still missing
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	DlssgCVar = DlssgCVar ? DlssgCVar : ConsoleManager.FindConsoleVariable(EDSVrStateMachine::DlssgCVarName);
+	DlssSrCVar = DlssSrCVar ? DlssSrCVar : ConsoleManager.FindConsoleVariable(EDSVrStateMachine::DlssSrCVarName);
+	DeepDvcCVar = DeepDvcCVar ? DeepDvcCVar : ConsoleManager.FindConsoleVariable(EDSVrStateMachine::DeepDvcCVarName);
+	HiddenAreaMaskCVar = HiddenAreaMaskCVar ? HiddenAreaMaskCVar : ConsoleManager.FindConsoleVariable(EDSVrStateMachine::HiddenAreaMaskCVarName);
+	OpenXRDepthLayerCVar = OpenXRDepthLayerCVar ? OpenXRDepthLayerCVar : ConsoleManager.FindConsoleVariable(EDSVrStateMachine::OpenXRDepthLayerCVarName);
+}
+
+FEDSVrStateMachine::FEDSVrStateMachine(IEDSVrRuntime& InRuntime)
+	: Runtime(InRuntime)
+{
+}
+
+bool FEDSVrStateMachine::RequestEnable(double NowSeconds, const FEDSVrBackoffSettings& InBackoff)
+{
+	if (State != EEDSVrState::Inactive)
+	{
+		return true;
+	}
+
+	if (!Runtime.QueryState().IsAvailable())
+	{
+		return false;
+	}
+
+	Backoff = InBackoff;
+	bTimedOut = false;
+
+	// switch the render features off before the HMD comes up, not after
+	ApplyVrRenderSettings();
+
+	StartEnabling(NowSeconds, true);
+	return true;
+}
+
+void FEDSVrStateMachine::RequestDisable()
+{
+	if (State == EEDSVrState::Inactive)
+	{
+		return;
+	}
+
+	Runtime.SetVrEnabled(false);
+	ReturnToFlat();
+}
+
+void FEDSVrStateMachine::NotifyRuntimeChanged(double NowSeconds)
+{
+	if (State == EEDSVrState::Enabling)
+	{
+		TryEnable(NowSeconds);
+	}
+	else if (State == EEDSVrState::Active && !Runtime.QueryState().IsFullyActive())
+	{
+		NotifyHeadsetLost(NowSeconds);
+	}
+	else if (State == EEDSVrState::Inactive)
+	{
+		SyncWithRuntime();
+	}
+}
+
+void FEDSVrStateMachine::SyncWithRuntime()
+{
+	if (State != EEDSVrState::Inactive)
+	{
+		return;
+	}
+
+	const FEDSVrRuntimeState RuntimeState = Runtime.QueryState();
+	if (RuntimeState.IsFullyActive())
+	{
+		bTimedOut = false;
+		ApplyVrRenderSettings();
+		SetState(EEDSVrState::Active, RuntimeState);
+	}
+}
+
+void FEDSVrStateMachine::NotifyHeadsetLost(double NowSeconds)
+{
+	if (State == EEDSVrState::Active)
+	{
+		// the runtime just told us it's gone, give it a moment before asking again
+		StartEnabling(NowSeconds, false);
+	}
+}
+
+void FEDSVrStateMachine::Tick(double NowSeconds)
+{
+	if (State == EEDSVrState::Enabling && NowSeconds >= NextAttemptSeconds)
+	{
+		TryEnable(NowSeconds);
+	}
+}
+
+void FEDSVrStateMachine::StartEnabling(double NowSeconds, bool bAttemptNow)
+{
+	EnableStartSeconds = NowSeconds;
+	CurrentDelaySeconds = FMath::Max(Backoff.InitialDelaySeconds, 0.0f);
+	NextAttemptSeconds = NowSeconds + CurrentDelaySeconds;
+	NumAttempts = 0;
+
+	SetState(EEDSVrState::Enabling, Runtime.QueryState());
+
+	if (bAttemptNow)
+	{
+		TryEnable(NowSeconds);
+	}
+}
+
+void FEDSVrStateMachine::TryEnable(double NowSeconds)
+{
+	++NumAttempts;
+
+	FEDSVrRuntimeState RuntimeState = Runtime.QueryState();
+	if (!RuntimeState.IsFullyActive())
+	{
+		Runtime.SetVrEnabled(true);
+		RuntimeState = Runtime.QueryState();
+	}
+
+	if (RuntimeState.IsFullyActive())
+	{
+		SetState(EEDSVrState::Active, RuntimeState);
+		return;
+	}
+
+	if (NowSeconds - EnableStartSeconds >= Backoff.TimeoutSeconds)
+	{
+		bTimedOut = true;
+		ReturnToFlat();
+		return;
+	}
+
+	NextAttemptSeconds = NowSeconds + CurrentDelaySeconds;
+	CurrentDelaySeconds = FMath::Min(CurrentDelaySeconds * FMath::Max(Backoff.DelayMultiplier, 1.0f), FMath::Max(Backoff.MaxDelaySeconds, Backoff.InitialDelaySeconds));
+}
+
+void FEDSVrStateMachine::ApplyVrRenderSettings()
+{
+	// a capture now would see the VR settings, keep the flat ones from when they went on
+	if (!bHasFlatRenderSettings)
+	{
+		FlatRenderSettings = Runtime.CaptureRenderSettings();
+		bHasFlatRenderSettings = true;
+	}
+	Runtime.ApplyRenderSettings(FEDSVrRenderSettings::ForVr());
+}
+
+void FEDSVrStateMachine::ReturnToFlat()
+{
+	if (bHasFlatRenderSettings)
+	{
+		Runtime.ApplyRenderSettings(FlatRenderSettings);
+		bHasFlatRenderSettings = false;
+	}
+
+	SetState(EEDSVrState::Inactive, Runtime.QueryState());
+}
+
+void FEDSVrStateMachine::SetState(EEDSVrState NewState, const FEDSVrRuntimeState& RuntimeState)
+{
+	const EEDSVrState OldState = State;
+	State = NewState;
+	if (OldState != NewState)
+	{
+		OnStateChanged.ExecuteIfBound(OldState, NewState, RuntimeState);
+	}
+}
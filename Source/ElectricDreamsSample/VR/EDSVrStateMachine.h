@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct IConsoleVariable;
+
+/** Snapshot of the XR runtime */
+struct FEDSVrRuntimeState
+{
+	bool bHasXrSystem = false;
+	bool bHasHmdDevice = false;
+	bool bHasStereoDevice = false;
+	bool bHmdConnected = false;
+	bool bHmdEnabled = false;
+	bool bStereoEnabled = false;
+	FString XrSystemName = TEXT("None");
+
+	bool IsAvailable() const { return bHasXrSystem && bHasHmdDevice && bHasStereoDevice; }
+	bool IsFullyActive() const { return IsAvailable() && bHmdConnected && bHmdEnabled && bStereoEnabled; }
+};
+
+/** Render features that don't work in VR. They are switched together, once per VR transition. INDEX_NONE marks a missing cvar */
+struct FEDSVrRenderSettings
+{
+	int32 Dlssg = INDEX_NONE;
+	int32 DlssSr = INDEX_NONE;
+	int32 DeepDvc = INDEX_NONE;
+	int32 HiddenAreaMask = INDEX_NONE;
+	int32 OpenXRDepthLayer = INDEX_NONE;
+
+	/** Everything off */
+	static FEDSVrRenderSettings ForVr();
+
+	bool operator==(const FEDSVrRenderSettings& Other) const
+	{
+		return Dlssg == Other.Dlssg && DlssSr == Other.DlssSr && DeepDvc == Other.DeepDvc && HiddenAreaMask == Other.HiddenAreaMask && OpenXRDepthLayer == Other.OpenXRDepthLayer;
+	}
+};
+
+/** Everything the VR state machine touches outside of itself, so it can run against a fake runtime */
+class IEDSVrRuntime
+{
+public:
+	virtual ~IEDSVrRuntime() = default;
+
+	virtual FEDSVrRuntimeState QueryState() const = 0;
+
+	/** Asks the runtime to turn the HMD and stereo rendering on or off */
+	virtual void SetVrEnabled(bool bEnable) = 0;
+
+	virtual FEDSVrRenderSettings CaptureRenderSettings() const = 0;
+
+	/** Applies all settings in one go */
+	virtual void ApplyRenderSettings(const FEDSVrRenderSettings& Settings) = 0;
+};
+
+/** The XR system of GEngine and the render feature cvars */
+class ELECTRICDREAMSSAMPLE_API FEDSEngineVrRuntime : public IEDSVrRuntime
+{
+public:
+	virtual FEDSVrRuntimeState QueryState() const override;
+	virtual void SetVrEnabled(bool bEnable) override;
+	virtual FEDSVrRenderSettings CaptureRenderSettings() const override;
+	virtual void ApplyRenderSettings(const FEDSVrRenderSettings& Settings) override;
+
+private:
+	void FindConsoleVariables() const;
+
+	mutable IConsoleVariable* DlssgCVar = nullptr;
+	mutable IConsoleVariable* DlssSrCVar = nullptr;
+	mutable IConsoleVariable* DeepDvcCVar = nullptr;
+	mutable IConsoleVariable* HiddenAreaMaskCVar = nullptr;
+	mutable IConsoleVariable* OpenXRDepthLayerCVar = nullptr;
+};
+
+/** How often to retry enabling VR while the runtime isn't ready */
+struct FEDSVrBackoffSettings
+{
+	float InitialDelaySeconds = 0.25f;
+	float MaxDelaySeconds = 2.0f;
+	float DelayMultiplier = 2.0f;
+
+	/** Gives up and goes back to flat rendering after this long */
+	float TimeoutSeconds = 6.0f;
+};
+
+enum class EEDSVrState : uint8
+{
+	Inactive,
+	Enabling,
+	Active
+};
+
+/**
+ * Turns VR on and off. Enabling retries with exponential backoff until the runtime reports an active HMD,
+ * and retries right away whenever the XR runtime signals a headset change, so nothing has to be polled
+ * while VR is settled. The VR render settings go on in one batch when enabling starts and the previous
+ * settings come back in one batch when VR turns off. The flat settings are captured once per VR session,
+ * never while the VR ones are applied.
+ */
+class ELECTRICDREAMSSAMPLE_API FEDSVrStateMachine
+{
+public:
+	DECLARE_DELEGATE_ThreeParams(FOnStateChanged, EEDSVrState /*OldState*/, EEDSVrState /*NewState*/, const FEDSVrRuntimeState& /*RuntimeState*/);
+
+	explicit FEDSVrStateMachine(IEDSVrRuntime& InRuntime);
+
+	/** Starts enabling VR. Returns false if there is no XR runtime to enable */
+	bool RequestEnable(double NowSeconds, const FEDSVrBackoffSettings& InBackoff);
+
+	/** Turns VR off, or stops trying to turn it on */
+	void RequestDisable();
+
+	/** Headset connected or tracking initialized, retries right away when enabling */
+	void NotifyRuntimeChanged(double NowSeconds);
+
+	/** Takes over a headset that was turned on outside of the state machine, applying the VR render settings */
+	void SyncWithRuntime();
+
+	/** The headset went away while active, keeps trying to get it back */
+	void NotifyHeadsetLost(double NowSeconds);
+
+	/** Only does work when a retry is due */
+	void Tick(double NowSeconds);
+
+	EEDSVrState GetState() const { return State; }
+	int32 GetNumAttempts() const { return NumAttempts; }
+
+	/** True when the last enable gave up after the backoff timeout */
+	bool HasTimedOut() const { return bTimedOut; }
+
+	FOnStateChanged OnStateChanged;
+
+private:
+	void StartEnabling(double NowSeconds, bool bAttemptNow);
+	void TryEnable(double NowSeconds);
+	void ApplyVrRenderSettings();
+	void ReturnToFlat();
+	void SetState(EEDSVrState NewState, const FEDSVrRuntimeState& RuntimeState);
+
+	IEDSVrRuntime& Runtime;
+	EEDSVrState State = EEDSVrState::Inactive;
+	FEDSVrBackoffSettings Backoff;
+	FEDSVrRenderSettings FlatRenderSettings;
+	double EnableStartSeconds = 0.0;
+	double NextAttemptSeconds = 0.0;
+	float CurrentDelaySeconds = 0.0f;
+	int32 NumAttempts = 0;
+	bool bHasFlatRenderSettings = false;
+	bool bTimedOut = false;
+};
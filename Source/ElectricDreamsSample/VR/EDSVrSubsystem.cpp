@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EDSVrSubsystem.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CoreDelegates.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(EDSVrSubsystem)
+
+static TAutoConsoleVariable<float> CVarVrEnableRetryInitialSeconds(
+	TEXT("ElectricDreams.VR.EnableRetryInitialSeconds"),
+	0.25f,
+	TEXT("Delay in seconds before the first retry when VR doesn't come up right away. Doubles with every retry (default = 0.25)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVrEnableRetryMaxSeconds(
+	TEXT("ElectricDreams.VR.EnableRetryMaxSeconds"),
+	2.0f,
+	TEXT("Longest delay in seconds between VR enable retries (default = 2)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVrEnableTimeoutSeconds(
+	TEXT("ElectricDreams.VR.EnableTimeoutSeconds"),
+	6.0f,
+	TEXT("Time in seconds after which enabling VR gives up and restores the flat render settings (default = 6)"),
+	ECVF_Default);
+
+void UEDSVrSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Runtime = MakeUnique<FEDSEngineVrRuntime>();
+	StateMachine = MakeUnique<FEDSVrStateMachine>(*Runtime);
+	StateMachine->OnStateChanged.BindUObject(this, &UEDSVrSubsystem::OnStateChanged);
+
+	// a headset started before the game instance, e.g. by -vr or the previous PIE session's runtime
+	StateMachine->SyncWithRuntime();
+
+	FCoreDelegates::VRHeadsetReconnected.AddUObject(this, &UEDSVrSubsystem::OnRuntimeChanged);
+	FCoreDelegates::VRHeadsetTrackingInitializedDelegate.AddUObject(this, &UEDSVrSubsystem::OnRuntimeChanged);
+	FCoreDelegates::VRHeadsetLost.AddUObject(this, &UEDSVrSubsystem::OnHeadsetLost);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UEDSVrSubsystem::Tick));
+}
+
+void UEDSVrSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	FCoreDelegates::VRHeadsetReconnected.RemoveAll(this);
+	FCoreDelegates::VRHeadsetTrackingInitializedDelegate.RemoveAll(this);
+	FCoreDelegates::VRHeadsetLost.RemoveAll(this);
+
+	// hand the flat render settings back, nothing else is going to restore them
+	StateMachine->OnStateChanged.Unbind();
+	StateMachine->RequestDisable();
+
+	StateMachine.Reset();
+	Runtime.Reset();
+
+	Super::Deinitialize();
+}
+
+void UEDSVrSubsystem::ToggleVr()
+{
+	if (StateMachine->GetState() != EEDSVrState::Inactive)
+	{
+		StateMachine->RequestDisable();
+		return;
+	}
+
+	if (!StateMachine->RequestEnable(FPlatformTime::Seconds(), GetBackoffSettings()) && GEngine != nullptr)
+	{
+		const FEDSVrRuntimeState RuntimeState = Runtime->QueryState();
+		GEngine->AddOnScreenDebugMessage(
+			-1,
+			6.0f,
+			FColor::Red,
+			FString::Printf(
+				TEXT("VR unavailable. XR=%s HMD=%d Stereo=%d. Ensure OpenXR is enabled and SteamVR is running."),
+				*RuntimeState.XrSystemName,
+				RuntimeState.bHasHmdDevice ? 1 : 0,
+				RuntimeState.bHasStereoDevice ? 1 : 0
+			)
+		);
+	}
+}
+
+void UEDSVrSubsystem::StartInVrIfRequested()
+{
+	if (bStartInVrAttempted)
+	{
+		return;
+	}
+	bStartInVrAttempted = true;
+
+	bool bShouldStartInVr = false;
+	if (GConfig != nullptr &&
+		GConfig->GetBool(TEXT("/Script/EngineSettings.GeneralProjectSettings"), TEXT("bStartInVR"), bShouldStartInVr, GGameIni) &&
+		bShouldStartInVr)
+	{
+		StateMachine->RequestEnable(FPlatformTime::Seconds(), GetBackoffSettings());
+	}
+}
+
+EEDSVrState UEDSVrSubsystem::GetState() const
+{
+	return StateMachine.IsValid() ? StateMachine->GetState() : EEDSVrState::Inactive;
+}
+
+bool UEDSVrSubsystem::Tick(float DeltaTime)
+{
+	StateMachine->Tick(FPlatformTime::Seconds());
+	return true;
+}
+
+FEDSVrBackoffSettings UEDSVrSubsystem::GetBackoffSettings() const
+{
+	FEDSVrBackoffSettings Backoff;
+	Backoff.InitialDelaySeconds = CVarVrEnableRetryInitialSeconds.GetValueOnGameThread();
+	Backoff.MaxDelaySeconds = CVarVrEnableRetryMaxSeconds.GetValueOnGameThread();
+	Backoff.TimeoutSeconds = CVarVrEnableTimeoutSeconds.GetValueOnGameThread();
+	return Backoff;
+}
+
+void UEDSVrSubsystem::OnRuntimeChanged()
+{
+	StateMachine->NotifyRuntimeChanged(FPlatformTime::Seconds());
+}
+
+void UEDSVrSubsystem::OnHeadsetLost()
+{
+	StateMachine->NotifyHeadsetLost(FPlatformTime::Seconds());
+}
+
+void UEDSVrSubsystem::OnStateChanged(EEDSVrState OldState, EEDSVrState NewState, const FEDSVrRuntimeState& RuntimeState)
+{
+	if (GEngine == nullptr)
+	{
+		return;
+	}
+
+	const FString RuntimeDetails = FString::Printf(
+		TEXT("XR=%s | HMDConnected=%d HMDEnabled=%d StereoEnabled=%d"),
+		*RuntimeState.XrSystemName,
+		RuntimeState.bHmdConnected ? 1 : 0,
+		RuntimeState.bHmdEnabled ? 1 : 0,
+		RuntimeState.bStereoEnabled ? 1 : 0
+	);
+
+	switch (NewState)
+	{
+	case EEDSVrState::Enabling:
+		if (OldState == EEDSVrState::Inactive)
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("VR preflight: DLSS SR/FG, DeepDVC, hidden area mask and depth layer forced OFF."));
+			GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("VR enable requested. Attempting to activate OpenXR/SteamVR session..."));
+		}
+		else
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, FString::Printf(TEXT("VR headset lost, reconnecting | %s"), *RuntimeDetails));
+		}
+		break;
+
+	case EEDSVrState::Active:
+		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, FString::Printf(TEXT("VR Enabled | %s"), *RuntimeDetails));
+		break;
+
+	case EEDSVrState::Inactive:
+		if (StateMachine->HasTimedOut())
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 7.0f, FColor::Yellow, FString::Printf(TEXT("VR enable timed out | %s. Keep SteamVR+PSVR2 app running and retry."), *RuntimeDetails));
+		}
+		else
+		{
+			GEngine->AddOnScreenDebugMessage(-1, 5.0f, RuntimeState.bHmdEnabled || RuntimeState.bStereoEnabled ? FColor::Yellow : FColor::Green, FString::Printf(TEXT("VR Disable Requested | %s"), *RuntimeDetails));
+		}
+		break;
+	}
+}
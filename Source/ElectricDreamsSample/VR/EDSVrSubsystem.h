@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "VR/EDSVrStateMachine.h"
+
+#include "EDSVrSubsystem.generated.h"
+
+/**
+ * Owns the VR state machine for the lifetime of the game instance, so VR and the flat render settings captured
+ * when it turned on survive map travel. A headset that is already running when the game instance starts, or
+ * that comes up later without being asked for, is picked up as active VR.
+ */
+UCLASS()
+class ELECTRICDREAMSSAMPLE_API UEDSVrSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	// USubsystem implementation Begin
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// USubsystem implementation End
+
+	/** Turns VR off when it's on or coming up, on otherwise */
+	void ToggleVr();
+
+	/** Enables VR if the project is set to start in VR. Only the first call per game instance does anything */
+	void StartInVrIfRequested();
+
+	EEDSVrState GetState() const;
+
+private:
+	bool Tick(float DeltaTime);
+	FEDSVrBackoffSettings GetBackoffSettings() const;
+	void OnRuntimeChanged();
+	void OnHeadsetLost();
+	void OnStateChanged(EEDSVrState OldState, EEDSVrState NewState, const FEDSVrRuntimeState& RuntimeState);
+
+	TUniquePtr<FEDSEngineVrRuntime> Runtime;
+	TUniquePtr<FEDSVrStateMachine> StateMachine;
+	FTSTicker::FDelegateHandle TickHandle;
+	bool bStartInVrAttempted = false;
+};